@@ -88,6 +88,23 @@ typedef struct {
    #endif
    bool                              production_build;
    xraudio_internal_capture_params_t internal_capture_params;
+   xraudio_callback_dispatch_t       callback_dispatch;
+   xraudio_dispatch_object_t         obj_dispatch;
+   xraudio_beamformer_config_t       beamformer_config;
+   xraudio_keyword_commit_config_t   keyword_commit_config;
+   uint32_t                          input_frame_period;
+   uint32_t                          input_capture_rate;
+   uint8_t                           input_idle_frame_qty;
+   bool                              standby;
+   xraudio_init_report_t             init_report;
+   int                               speculative_pipe;
+   xraudio_keyword_models_config_t   keyword_models_config;
+   xraudio_governor_config_t         governor_config;
+   xraudio_governor_callback_t       governor_callback;
+   void *                            governor_param;
+   xraudio_dsp_snapshot_t            dsp_snapshot_kwd;
+   xraudio_dsp_snapshot_t            dsp_snapshot_dga;
+   xraudio_stream_buffer_t           stream_buffer_lent; // set by the main thread while a pool buffer is delivered to the data callback
 } xraudio_obj_t;
 
 typedef struct {
@@ -98,6 +115,9 @@ typedef struct {
    #endif
    xraudio_hal_obj_t        hal_obj;
    uint8_t                  hal_user_cnt;
+   bool                     hal_standby;      // the hal is held open in standby with no users
+   uint32_t                 hal_reuse_qty;
+   uint32_t                 hal_open_time_us;
    xraudio_power_mode_t     power_mode;
    bool                     privacy_mode;
    xraudio_hal_dsp_config_t dsp_config;
@@ -127,14 +147,16 @@ static xraudio_result_t xraudio_message_queue_main_open(xraudio_obj_t *obj);
 static void             xraudio_message_queue_main_close(xraudio_obj_t *obj);
 static xraudio_result_t xraudio_audio_hal_open(xraudio_obj_t *obj);
 static void             xraudio_audio_hal_close(xraudio_obj_t *obj);
+static void             xraudio_audio_hal_standby_release(void);
 static bool             xraudio_object_is_valid(xraudio_obj_t *obj);
+static xraudio_result_t xraudio_record_to_memory_internal(xraudio_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, uint32_t sample_qty, bool circular, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param);
 
 // This variable contains data that is applicable to the entire process (ie. not per thread or object)
 static xraudio_process_t g_xraudio_process = {
    #ifdef XRAUDIO_RESOURCE_MGMT
    .shm = -1, .shared_mem = NULL, .user_cnt = 0,
    #endif
-   .hal_obj = NULL, .hal_user_cnt = 0, .power_mode = XRAUDIO_POWER_MODE_FULL, .privacy_mode = false,
+   .hal_obj = NULL, .hal_user_cnt = 0, .hal_standby = false, .hal_reuse_qty = 0, .hal_open_time_us = 0, .power_mode = XRAUDIO_POWER_MODE_FULL, .privacy_mode = false,
    .dsp_config = { .ppr_enabled = false,
                    .dga_enabled = false,
                    .eos_enabled = false,
@@ -273,6 +295,30 @@ xraudio_object_t xraudio_object_create(const json_t *json_obj_xraudio_config) {
    obj->internal_capture_params.file_qty_max  = 0;
    obj->internal_capture_params.file_size_max = 0;
    obj->internal_capture_params.dir_path      = NULL;
+   obj->callback_dispatch                     = XRAUDIO_CALLBACK_DISPATCH_INLINE;
+   obj->obj_dispatch                          = NULL;
+   memset(&obj->beamformer_config, 0, sizeof(obj->beamformer_config));
+   obj->keyword_commit_config.latency_max_ms  = XRAUDIO_KEYWORD_COMMIT_LATENCY_DEFAULT;
+   obj->keyword_commit_config.margin          = 0.0;
+   obj->input_frame_period                    = XRAUDIO_INPUT_FRAME_PERIOD;
+   obj->input_capture_rate                    = XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE;
+   obj->input_idle_frame_qty                  = 1;
+   obj->standby                               = false;
+   memset(&obj->init_report, 0, sizeof(obj->init_report));
+   obj->speculative_pipe                      = -1;
+   memset(&obj->keyword_models_config, 0, sizeof(obj->keyword_models_config));
+   obj->keyword_models_config.budget_us       = XRAUDIO_KEYWORD_BUDGET_DEFAULT;
+   memset(&obj->dsp_snapshot_kwd, 0, sizeof(obj->dsp_snapshot_kwd));
+   memset(&obj->dsp_snapshot_dga, 0, sizeof(obj->dsp_snapshot_dga));
+   obj->stream_buffer_lent                    = NULL;
+   obj->governor_config.enable                = false;
+   obj->governor_config.level_max             = XRAUDIO_SHED_LEVEL_PPR_BYPASS;
+   obj->governor_config.load_high_pct         = XRAUDIO_GOVERNOR_LOAD_HIGH_DEFAULT;
+   obj->governor_config.load_low_pct          = XRAUDIO_GOVERNOR_LOAD_LOW_DEFAULT;
+   obj->governor_config.escalate_ms           = XRAUDIO_GOVERNOR_ESCALATE_DEFAULT;
+   obj->governor_config.recover_ms            = XRAUDIO_GOVERNOR_RECOVER_DEFAULT;
+   obj->governor_callback                     = NULL;
+   obj->governor_param                        = NULL;
 
    if(NULL == json_obj_xraudio_config) {
       XLOGD_INFO("json_obj_xraudio_config is null, using defaults");
@@ -328,6 +374,9 @@ void xraudio_object_destroy(xraudio_object_t object) {
       #ifdef XRAUDIO_RESOURCE_MGMT
       xraudio_resource_release(obj);
       #endif
+      if(obj->standby) {
+         xraudio_audio_hal_standby_release();
+      }
       obj->identifier = 0;
 
       if(obj->json_obj_input != NULL) {
@@ -342,6 +391,13 @@ void xraudio_object_destroy(xraudio_object_t object) {
          json_decref(obj->json_obj_hal);
          obj->json_obj_hal = NULL;
       }
+      for(uint8_t index = 0; index < obj->keyword_models_config.model_qty; index++) {
+         json_decref(obj->keyword_models_config.models[index].jkwd_config);
+      }
+      obj->keyword_models_config.model_qty = 0;
+
+      xraudio_dsp_snapshot_free(&obj->dsp_snapshot_kwd);
+      xraudio_dsp_snapshot_free(&obj->dsp_snapshot_dga);
 
       if(sem_destroy(&obj->mutex_api) < 0) {
          int errsv = errno;
@@ -587,6 +643,9 @@ xraudio_result_t xraudio_open(xraudio_object_t object, xraudio_power_mode_t powe
              ((XRAUDIO_DEVICE_INPUT_LOCAL_GET(input) != XRAUDIO_DEVICE_INPUT_NONE)  && (obj->resource_id_record   >= XRAUDIO_RESOURCE_ID_INPUT_INVALID))) { // Only care about resources for local mic
       XLOGD_ERROR("invalid resource allocation.");
       result = XRAUDIO_RESULT_ERROR_RESOURCE;
+   } else if((output != XRAUDIO_DEVICE_OUTPUT_NONE) && (obj->input_frame_period != XRAUDIO_OUTPUT_FRAME_PERIOD)) { // The microphone and speaker frames are processed on the same timer
+      XLOGD_ERROR("microphone frame period <%u> ms is not supported with speaker frame period <%u> ms", obj->input_frame_period, XRAUDIO_OUTPUT_FRAME_PERIOD);
+      result = XRAUDIO_RESULT_ERROR_PARAMS;
    } else {
       obj->devices_input  = input;
       obj->devices_output = output;
@@ -608,6 +667,9 @@ xraudio_result_t xraudio_open(xraudio_object_t object, xraudio_power_mode_t powe
       } else if(format->channel_qty < XRAUDIO_INPUT_DEFAULT_CHANNEL_QTY || format->channel_qty > XRAUDIO_INPUT_MAX_CHANNEL_QTY) {
          XLOGD_ERROR("invalid channel qty %u", format->channel_qty);
          result = XRAUDIO_RESULT_ERROR_PARAMS;
+      } else if((format->sample_rate * obj->input_frame_period) % 1000 != 0) {
+         XLOGD_ERROR("sample rate %u Hz is not a whole quantity of samples per %u ms frame", format->sample_rate, obj->input_frame_period);
+         result = XRAUDIO_RESULT_ERROR_PARAMS;
       } else {
          obj->input_format = *format;
       }
@@ -617,6 +679,11 @@ xraudio_result_t xraudio_open(xraudio_object_t object, xraudio_power_mode_t powe
       obj->input_format.channel_qty = XRAUDIO_INPUT_DEFAULT_CHANNEL_QTY;
    }
 
+   if(result == XRAUDIO_RESULT_OK && obj->input_capture_rate != XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE && obj->input_format.sample_rate != XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE) { // Only decimate to the default rate
+      XLOGD_ERROR("sample rate %u Hz is not supported with capture sample rate %u Hz", obj->input_format.sample_rate, obj->input_capture_rate);
+      result = XRAUDIO_RESULT_ERROR_PARAMS;
+   }
+
    if(result != XRAUDIO_RESULT_OK) {
       XRAUDIO_API_MUTEX_UNLOCK();
       return(result);
@@ -624,6 +691,9 @@ xraudio_result_t xraudio_open(xraudio_object_t object, xraudio_power_mode_t powe
 
    g_xraudio_process.privacy_mode = privacy_mode;
 
+   rdkx_timestamp_t timestamp_open, timestamp;
+   rdkx_timestamp_get(&timestamp_open);
+
    if(XRAUDIO_RESULT_OK != xraudio_audio_hal_open(obj)) {
       result = XRAUDIO_RESULT_ERROR_INTERNAL;
    } else if(XRAUDIO_RESULT_OK != xraudio_message_queue_main_open(obj)) {
@@ -634,9 +704,12 @@ xraudio_result_t xraudio_open(xraudio_object_t object, xraudio_power_mode_t powe
    if(result == XRAUDIO_RESULT_OK) {
       XLOGD_INFO("input sample rate %u Hz %u-bit %s privacy <%s>", obj->input_format.sample_rate, obj->input_format.sample_size * 8, xraudio_channel_qty_str(obj->input_format.channel_qty), privacy_mode ? "YES" : "NO");
 
+      obj->init_report.hal_time_us = g_xraudio_process.hal_open_time_us;
+      rdkx_timestamp_get(&timestamp);
+
       if((obj->devices_input != XRAUDIO_DEVICE_INPUT_NONE) && (obj->devices_input != XRAUDIO_DEVICE_INPUT_HFP)) { // Create microphone object
          obj->obj_input = xraudio_input_object_create(g_xraudio_process.hal_obj, obj->user_id, obj->msgq_main, obj->capabilities_record, g_xraudio_process.dsp_config, obj->json_obj_input);
-         result = xraudio_input_open(obj->obj_input, obj->devices_input, power_mode, privacy_mode, obj->resource_id_record, obj->capabilities_record, obj->input_format);
+         result = xraudio_input_open(obj->obj_input, obj->devices_input, power_mode, privacy_mode, obj->resource_id_record, obj->capabilities_record, obj->input_format, obj->input_frame_period, obj->input_capture_rate);
       }
 
       if(result == XRAUDIO_RESULT_ERROR_MIC_OPEN) {
@@ -648,11 +721,14 @@ xraudio_result_t xraudio_open(xraudio_object_t object, xraudio_power_mode_t powe
       }
 
       xraudio_hal_dsp_config_get(&g_xraudio_process.dsp_config);
+      obj->init_report.input_time_us = (uint32_t)rdkx_timestamp_since_us(timestamp);
+      rdkx_timestamp_get(&timestamp);
 
       if(obj->devices_output != XRAUDIO_DEVICE_OUTPUT_NONE) { // Create speaker object
          obj->obj_output = xraudio_output_object_create(g_xraudio_process.hal_obj, obj->user_id, obj->msgq_main, obj->capabilities_playback, g_xraudio_process.dsp_config, obj->json_obj_output);
          xraudio_output_open(obj->obj_output, obj->devices_output, power_mode, obj->resource_id_playback, obj->capabilities_playback);
       }
+      obj->init_report.output_time_us = (uint32_t)rdkx_timestamp_since_us(timestamp);
 
       // Launch main xraudio thread
       if(XRAUDIO_RESULT_OK != main_thread_launch(obj)) {
@@ -672,6 +748,12 @@ xraudio_result_t xraudio_open(xraudio_object_t object, xraudio_power_mode_t powe
       } else {
          g_xraudio_process.power_mode   = power_mode;
          obj->opened                    = true;
+
+         if(obj->obj_output != NULL && obj->standby) { // Open the speaker stream ahead of the first playback
+            xraudio_output_standby_enable(obj->obj_output);
+         }
+         obj->init_report.open_time_us = (uint32_t)rdkx_timestamp_since_us(timestamp_open);
+         XLOGD_INFO("open time <%u> us - hal <%u> us input <%u> us output <%u> us", obj->init_report.open_time_us, obj->init_report.hal_time_us, obj->init_report.input_time_us, obj->init_report.output_time_us);
       }
    }
    XRAUDIO_API_MUTEX_UNLOCK();
@@ -710,6 +792,12 @@ void xraudio_close(xraudio_object_t object) {
 
       xraudio_audio_hal_close(obj);
 
+      #ifdef XRAUDIO_TRACE_ENABLED
+      if(g_xraudio_process.hal_user_cnt == 0) { // The trace recorder is shared by the objects in the process
+         xraudio_trace_recorder_close();
+      }
+      #endif
+
       obj->opened = false;
    }
    XRAUDIO_API_MUTEX_UNLOCK();
@@ -776,6 +864,342 @@ xraudio_result_t xraudio_internal_capture_params_set(xraudio_object_t object, xr
    return(result);
 }
 
+xraudio_result_t xraudio_callback_dispatch_set(xraudio_object_t object, xraudio_callback_dispatch_t dispatch) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if((uint32_t)dispatch >= XRAUDIO_CALLBACK_DISPATCH_INVALID) {
+      XLOGD_ERROR("Invalid dispatch <%s>", xraudio_callback_dispatch_str(dispatch));
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("callback dispatch must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->callback_dispatch = dispatch;
+
+   XLOGD_INFO("dispatch <%s>", xraudio_callback_dispatch_str(dispatch));
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_beamformer_config_set(xraudio_object_t object, const xraudio_beamformer_config_t *config) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(config == NULL) {
+      XLOGD_ERROR("Null config");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   if((config->enable || config->doa_enable) && (config->mic_qty < 2 || config->mic_qty > XRAUDIO_INPUT_MAX_CHANNEL_QTY)) {
+      XLOGD_ERROR("invalid config - mic qty <%u>", config->mic_qty);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   if(config->enable && (config->beam_qty == 0 || config->beam_qty > XRAUDIO_BEAM_QTY_MAX || config->beam_qty_kwd == 0 || config->beam_qty_kwd > config->beam_qty)) {
+      XLOGD_ERROR("invalid config - beam qty <%u> kwd beam qty <%u>", config->beam_qty, config->beam_qty_kwd);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("beamformer config must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->beamformer_config = *config;
+
+   XLOGD_INFO("enable <%s> doa <%s> mic qty <%u> beam qty <%u> kwd beam qty <%u>", config->enable ? "YES" : "NO", config->doa_enable ? "YES" : "NO", config->mic_qty, config->beam_qty, config->beam_qty_kwd);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_keyword_commit_config_set(xraudio_object_t object, const xraudio_keyword_commit_config_t *config) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(config == NULL) {
+      XLOGD_ERROR("Null config");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   if(config->latency_max_ms > XRAUDIO_KEYWORD_COMMIT_LATENCY_MAX || config->margin < 0.0) {
+      XLOGD_ERROR("invalid config - latency max <%u> ms margin <%f>", config->latency_max_ms, config->margin);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("keyword commit config must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->keyword_commit_config = *config;
+
+   XLOGD_INFO("latency max <%u> ms margin <%f>", config->latency_max_ms, config->margin);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_input_frame_period_set(xraudio_object_t object, uint32_t frame_period) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(frame_period < XRAUDIO_INPUT_FRAME_PERIOD_MIN || frame_period > XRAUDIO_INPUT_FRAME_PERIOD || (XRAUDIO_INPUT_FRAME_PERIOD % frame_period) != 0) {
+      XLOGD_ERROR("invalid frame period <%u> ms", frame_period);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("frame period must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->input_frame_period = frame_period;
+
+   XLOGD_INFO("frame period <%u> ms", frame_period);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_input_capture_rate_set(xraudio_object_t object, uint32_t sample_rate) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(sample_rate < XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE || sample_rate > XRAUDIO_INPUT_MAX_CAPTURE_SAMPLE_RATE || (sample_rate % XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE) != 0) {
+      XLOGD_ERROR("invalid capture sample rate <%u> Hz", sample_rate);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("capture sample rate must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->input_capture_rate = sample_rate;
+
+   XLOGD_INFO("capture sample rate <%u> Hz", sample_rate);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_input_idle_frame_qty_set(xraudio_object_t object, uint8_t frame_qty) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(frame_qty < 1 || frame_qty > XRAUDIO_INPUT_MAX_IDLE_FRAME_QTY) {
+      XLOGD_ERROR("invalid idle frame qty <%u>", frame_qty);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("idle frame qty must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->input_idle_frame_qty = frame_qty;
+
+   XLOGD_INFO("idle frame qty <%u>", frame_qty);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_keyword_models_set(xraudio_object_t object, const xraudio_keyword_models_config_t *config) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(config == NULL) {
+      XLOGD_ERROR("Null config");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   if(config->model_qty > XRAUDIO_KEYWORD_MODEL_QTY_MAX) {
+      XLOGD_ERROR("invalid model qty <%u>", config->model_qty);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   for(uint8_t index = 0; index < config->model_qty; index++) {
+      const xraudio_keyword_model_config_t *model = &config->models[index];
+      if(model->jkwd_config == NULL || !json_is_object(model->jkwd_config)) {
+         XLOGD_ERROR("model <%u> jkwd_config is not object", index);
+         return(XRAUDIO_RESULT_ERROR_PARAMS);
+      }
+      if(strnlen(model->name, sizeof(model->name)) >= sizeof(model->name)) {
+         XLOGD_ERROR("model <%u> name is not terminated", index);
+         return(XRAUDIO_RESULT_ERROR_PARAMS);
+      }
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("keyword models must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   for(uint8_t index = 0; index < config->model_qty; index++) {
+      json_incref(config->models[index].jkwd_config);
+   }
+   for(uint8_t index = 0; index < obj->keyword_models_config.model_qty; index++) {
+      json_decref(obj->keyword_models_config.models[index].jkwd_config);
+   }
+   obj->keyword_models_config = *config;
+
+   for(uint8_t index = 0; index < config->model_qty; index++) {
+      XLOGD_INFO("model <%u> name <%s> sensitivity <%f>", index, config->models[index].name, config->models[index].sensitivity);
+   }
+   XLOGD_INFO("model qty <%u> budget <%u> us", config->model_qty, config->budget_us);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_stream_speculative_set(xraudio_object_t object, int pipe) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("speculative stream must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->speculative_pipe = (pipe < 0) ? -1 : pipe;
+
+   XLOGD_INFO("pipe <%d>", obj->speculative_pipe);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_stream_speculative_stats_get(xraudio_object_t object, xraudio_stream_speculative_stats_t *stats) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(stats == NULL) {
+      XLOGD_ERROR("Null stats");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the counters are updated atomically by the main thread
+   xraudio_in_speculative_stats_get(stats);
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_governor_config_set(xraudio_object_t object, const xraudio_governor_config_t *config, xraudio_governor_callback_t callback, void *param) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(config == NULL) {
+      XLOGD_ERROR("Null config");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   if((uint32_t)config->level_max >= XRAUDIO_SHED_LEVEL_INVALID || config->load_high_pct > 100 || config->load_low_pct >= config->load_high_pct) {
+      XLOGD_ERROR("invalid config - level max <%s> load high <%u> low <%u>", xraudio_shed_level_str(config->level_max), config->load_high_pct, config->load_low_pct);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("governor config must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->governor_config   = *config;
+   obj->governor_callback = callback;
+   obj->governor_param    = param;
+
+   XLOGD_INFO("enable <%s> level max <%s> load high <%u> low <%u> escalate <%u> ms recover <%u> ms", config->enable ? "YES" : "NO", xraudio_shed_level_str(config->level_max), config->load_high_pct, config->load_low_pct, config->escalate_ms, config->recover_ms);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_governor_stats_get(xraudio_object_t object, xraudio_governor_stats_t *stats) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(stats == NULL) {
+      XLOGD_ERROR("Null stats");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the statistics are updated atomically by the main thread
+   xraudio_in_governor_stats_get(stats);
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_input_channel_report_get(xraudio_object_t object, xraudio_input_channel_report_t *report) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(report == NULL) {
+      XLOGD_ERROR("Null report");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the report is updated atomically by the main thread
+   xraudio_in_channel_report_get(report);
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_input_power_report_get(xraudio_object_t object, xraudio_input_power_report_t *report) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(report == NULL) {
+      XLOGD_ERROR("Null report");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the report is updated atomically by the main thread
+   xraudio_in_power_report_get(report);
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_callback_dispatch_stats_get(xraudio_object_t object, xraudio_callback_dispatch_stats_t *stats) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(stats == NULL) {
+      XLOGD_ERROR("Null stats");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened || obj->obj_dispatch == NULL) {
+      XLOGD_ERROR("dispatch thread is not running");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   xraudio_dispatch_stats_get(obj->obj_dispatch, stats);
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
 xraudio_result_t xraudio_internal_capture_delete_files(xraudio_object_t object, const char *dir_path) {
    xraudio_obj_t *obj = (xraudio_obj_t *)object;
    if(!xraudio_object_is_valid(obj)) {
@@ -1151,6 +1575,8 @@ void xraudio_shared_mem_unlock(xraudio_object_t object) {
 
 xraudio_result_t xraudio_audio_hal_open(xraudio_obj_t *obj) {
    XLOGD_INFO("hal obj %p user count %u", g_xraudio_process.hal_obj, g_xraudio_process.hal_user_cnt);
+   rdkx_timestamp_t timestamp;
+   rdkx_timestamp_get(&timestamp);
 
    // Get qahw handle from process global memory
    if(g_xraudio_process.hal_obj == NULL) {
@@ -1160,9 +1586,19 @@ xraudio_result_t xraudio_audio_hal_open(xraudio_obj_t *obj) {
          XLOGD_ERROR("hal open failed.");
          return(XRAUDIO_RESULT_ERROR_INTERNAL);
       }
+   } else if(g_xraudio_process.hal_standby) { // Reuse the hal held in standby
+      bool privacy_mode = g_xraudio_process.privacy_mode;
+      if(xraudio_hal_privacy_mode_get(g_xraudio_process.hal_obj, &privacy_mode) && privacy_mode != g_xraudio_process.privacy_mode) { // privacy mode changed while closed
+         if(!xraudio_hal_privacy_mode(g_xraudio_process.hal_obj, g_xraudio_process.privacy_mode)) {
+            XLOGD_ERROR("unable to set privacy mode <%s>", g_xraudio_process.privacy_mode ? "ENABLE" : "DISABLE");
+         }
+      }
+      g_xraudio_process.hal_standby = false;
+      g_xraudio_process.hal_reuse_qty++;
    }
    g_xraudio_process.hal_user_cnt++;
-   XLOGD_INFO("hal obj %p", g_xraudio_process.hal_obj);
+   g_xraudio_process.hal_open_time_us = (uint32_t)rdkx_timestamp_since_us(timestamp);
+   XLOGD_INFO("hal obj %p open time %u us", g_xraudio_process.hal_obj, g_xraudio_process.hal_open_time_us);
    return(XRAUDIO_RESULT_OK);
 }
 
@@ -1170,18 +1606,43 @@ void xraudio_audio_hal_close(xraudio_obj_t *obj) {
    XLOGD_INFO("hal obj %p user count %u", g_xraudio_process.hal_obj, g_xraudio_process.hal_user_cnt);
    g_xraudio_process.hal_user_cnt--;
    if((g_xraudio_process.hal_user_cnt == 0) && (g_xraudio_process.hal_obj != NULL)) {
+      if(obj->standby) { // Hold the hal open for the next open
+         XLOGD_INFO("standby");
+         g_xraudio_process.hal_standby = true;
+         return;
+      }
       XLOGD_INFO("");
       xraudio_hal_close(g_xraudio_process.hal_obj);
       g_xraudio_process.hal_obj = NULL;
    }
 }
 
+void xraudio_audio_hal_standby_release(void) {
+   if(!g_xraudio_process.hal_standby) {
+      return;
+   }
+   g_xraudio_process.hal_standby = false;
+   if((g_xraudio_process.hal_user_cnt == 0) && (g_xraudio_process.hal_obj != NULL)) {
+      XLOGD_INFO("hal obj %p", g_xraudio_process.hal_obj);
+      xraudio_hal_close(g_xraudio_process.hal_obj);
+      g_xraudio_process.hal_obj = NULL;
+   }
+}
+
 xraudio_result_t main_thread_launch(xraudio_obj_t *obj) {
    if(obj->main_thread.running) {
       XLOGD_ERROR("already running...");
       return(XRAUDIO_RESULT_ERROR_INTERNAL);
    }
 
+   if(obj->callback_dispatch == XRAUDIO_CALLBACK_DISPATCH_THREAD) {
+      obj->obj_dispatch = xraudio_dispatch_object_create();
+      if(obj->obj_dispatch == NULL) {
+         XLOGD_ERROR("unable to create dispatch object");
+         return(XRAUDIO_RESULT_ERROR_INTERNAL);
+      }
+   }
+
    sem_t semaphore;
    sem_init(&semaphore, 0, 0);
 
@@ -1196,9 +1657,30 @@ xraudio_result_t main_thread_launch(xraudio_obj_t *obj) {
    params.internal_capture_params        = obj->internal_capture_params;
    params.json_obj_input                 = obj->json_obj_input;
    params.json_obj_output                = obj->json_obj_output;
+   params.obj_dispatch                   = obj->obj_dispatch;
+   params.beamformer_config              = obj->beamformer_config;
+   params.keyword_commit_config          = obj->keyword_commit_config;
+   params.input_frame_period             = obj->input_frame_period;
+   params.input_capture_rate             = obj->input_capture_rate;
+   params.input_idle_frame_qty           = obj->input_idle_frame_qty;
+   params.privacy_mode                   = g_xraudio_process.privacy_mode;
+   params.input_devices                  = obj->devices_input;
+   params.input_mic_qty                  = obj->obj_input ? xraudio_input_mic_qty_get(obj->obj_input) : 0;
+   params.speculative_pipe               = obj->speculative_pipe;
+   params.keyword_models_config          = obj->keyword_models_config;
+   params.governor_config                = obj->governor_config;
+   params.governor_callback              = obj->governor_callback;
+   params.governor_param                 = obj->governor_param;
+   params.dsp_snapshot_kwd               = &obj->dsp_snapshot_kwd;
+   params.dsp_snapshot_dga               = &obj->dsp_snapshot_dga;
+   params.stream_buffer_lent             = &obj->stream_buffer_lent;
 
    if(!xraudio_thread_create(&obj->main_thread, "xraudio_main", xraudio_main_thread, &params)) {
       XLOGD_ERROR("unable to launch thread");
+      if(obj->obj_dispatch != NULL) {
+         xraudio_dispatch_object_destroy(obj->obj_dispatch);
+         obj->obj_dispatch = NULL;
+      }
       return(XRAUDIO_RESULT_ERROR_INTERNAL);
    }
 
@@ -1244,11 +1726,17 @@ void main_thread_terminate(xraudio_obj_t *obj) {
 
    if(rc != 0) { // no response received
       XLOGD_INFO("Do NOT wait for thread to exit");
+      obj->obj_dispatch = NULL; // the main thread may still be queuing events so the dispatch object is not destroyed
    } else {
       // Wait for thread to exit
       XLOGD_INFO("Waiting for thread to exit");
       xraudio_thread_join(&obj->main_thread);
       XLOGD_INFO("thread exited.");
+
+      if(obj->obj_dispatch != NULL) { // Deliver any pending events and terminate the dispatch thread
+         xraudio_dispatch_object_destroy(obj->obj_dispatch);
+         obj->obj_dispatch = NULL;
+      }
    }
 }
 
@@ -1385,6 +1873,53 @@ xraudio_result_t xraudio_detect_keyword(xraudio_object_t object, keyword_callbac
    return(result);
 }
 
+xraudio_result_t xraudio_detect_reload(xraudio_object_t object, json_t *jkwd_config, xraudio_keyword_sensitivity_t keyword_sensitivity) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(jkwd_config != NULL && !json_is_object(jkwd_config)) {
+      XLOGD_ERROR("jkwd_config is not object");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+      XLOGD_ERROR("microphone not opened!");
+      result = XRAUDIO_RESULT_ERROR_INPUT;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(!xraudio_in_detect_reload_begin()) {
+      XLOGD_ERROR("reload in progress");
+      result = XRAUDIO_RESULT_ERROR_STATE;
+   } else {
+      result = xraudio_input_keyword_reload(obj->obj_input, jkwd_config, keyword_sensitivity);
+   }
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_detect_reload_status_get(xraudio_object_t object, xraudio_detect_reload_status_t *status) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(status == NULL) {
+      XLOGD_ERROR("Null status");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the status is updated atomically by the main thread
+   xraudio_in_detect_reload_status_get(status);
+   return(XRAUDIO_RESULT_OK);
+}
+
 xraudio_result_t xraudio_detect_stop(xraudio_object_t object) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
@@ -1421,33 +1956,240 @@ xraudio_result_t xraudio_detect_sensitivity_limits_get(xraudio_object_t object,
       return(XRAUDIO_RESULT_ERROR_PARAMS);
    }
 
-   xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
+   xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
+   XRAUDIO_API_MUTEX_LOCK();
+
+   sem_t semaphore;
+   sem_init(&semaphore, 0, 0);
+
+   xraudio_main_queue_msg_detect_sensitivity_limits_get_t msg;
+   msg.header.type = XRAUDIO_MAIN_QUEUE_MSG_TYPE_DETECT_SENSITIVITY_LIMITS_GET;
+   msg.min         = keyword_sensitivity_min;
+   msg.max         = keyword_sensitivity_max;
+   msg.semaphore   = &semaphore;
+   msg.result      = &result;
+
+   queue_msg_push(obj->msgq_main, (const char*)&msg, sizeof(msg));
+
+   sem_wait(&semaphore);
+   sem_destroy(&semaphore);
+
+   if(result != XRAUDIO_RESULT_OK) {
+      XLOGD_ERROR("unable to get keyword detector sensitivity limits");
+   }
+
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_record_sound_intensity_transfer(xraudio_object_t object, const char *fifo_name) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+      XLOGD_ERROR("microphone not opened!");
+      result = XRAUDIO_RESULT_ERROR_INPUT;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else {
+      result = xraudio_input_sound_intensity_transfer(obj->obj_input, fifo_name);
+   }
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_record_to_file(xraudio_object_t object, xraudio_devices_input_t source, xraudio_container_t container, const char *audio_file_path, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   bool has_mutex = true;
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+      XLOGD_ERROR("microphone not opened!");
+      result = XRAUDIO_RESULT_ERROR_INPUT;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else {
+      if(callback == NULL) { // Synchronous
+         XRAUDIO_API_MUTEX_UNLOCK();
+         has_mutex = false;
+      }
+      result = xraudio_input_record_to_file(obj->obj_input, source, container, audio_file_path, from, offset, until, callback, param);
+   }
+   if(has_mutex) {
+      XRAUDIO_API_MUTEX_UNLOCK();
+   }
+   return(result);
+}
+
+xraudio_result_t xraudio_record_to_memory_internal(xraudio_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, uint32_t sample_qty, bool circular, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   bool has_mutex = true;
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+      XLOGD_ERROR("microphone not opened!");
+      result = XRAUDIO_RESULT_ERROR_INPUT;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else {
+      if(callback == NULL) { // Synchronous
+         XRAUDIO_API_MUTEX_UNLOCK();
+         has_mutex = false;
+      }
+      result = xraudio_input_record_to_memory(obj->obj_input, source, buf_samples, sample_qty, circular, from, offset, until, callback, param);
+   }
+   if(has_mutex) {
+      XRAUDIO_API_MUTEX_UNLOCK();
+   }
+   return(result);
+}
+
+xraudio_result_t xraudio_record_to_memory(xraudio_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, uint32_t sample_qty, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param) {
+   return(xraudio_record_to_memory_internal(object, source, buf_samples, sample_qty, false, from, offset, until, callback, param));
+}
+
+xraudio_result_t xraudio_record_to_memory_circular(xraudio_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, uint32_t sample_qty, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param) {
+   return(xraudio_record_to_memory_internal(object, source, buf_samples, sample_qty, true, from, offset, until, callback, param));
+}
+
+xraudio_result_t xraudio_record_to_memory_index_get(xraudio_object_t object, xraudio_devices_input_t source, uint32_t *index, uint32_t *sample_qty_valid) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_OK;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(index == NULL || sample_qty_valid == NULL) {
+      XLOGD_ERROR("Null params");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   // The api mutex keeps the input object from being destroyed during the read.  The main thread never takes it, so polling does not stall the recording.
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(!xraudio_input_memory_ring_index_get(obj->obj_input, source, index, sample_qty_valid)) {
+      result = XRAUDIO_RESULT_ERROR_STATE;
+   }
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_frame_features_get(xraudio_object_t object, uint8_t chan, xraudio_frame_features_t *features) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_OK;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(features == NULL) {
+      XLOGD_ERROR("Null features");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+      XLOGD_ERROR("microphone not opened!");
+      result = XRAUDIO_RESULT_ERROR_INPUT;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(!xraudio_input_frame_features_get(obj->obj_input, chan, features)) {
+      result = XRAUDIO_RESULT_ERROR_PARAMS;
+   }
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_doa_get(xraudio_object_t object, xraudio_doa_t *doa) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_OK;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(doa == NULL) {
+      XLOGD_ERROR("Null doa");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+      XLOGD_ERROR("microphone not opened!");
+      result = XRAUDIO_RESULT_ERROR_INPUT;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(!xraudio_input_doa_get(obj->obj_input, doa)) {
+      result = XRAUDIO_RESULT_ERROR_STATE;
+   }
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_record_stop(xraudio_object_t object, xraudio_devices_input_t source) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+
    XRAUDIO_API_MUTEX_LOCK();
-
-   sem_t semaphore;
-   sem_init(&semaphore, 0, 0);
-
-   xraudio_main_queue_msg_detect_sensitivity_limits_get_t msg;
-   msg.header.type = XRAUDIO_MAIN_QUEUE_MSG_TYPE_DETECT_SENSITIVITY_LIMITS_GET;
-   msg.min         = keyword_sensitivity_min;
-   msg.max         = keyword_sensitivity_max;
-   msg.semaphore   = &semaphore;
-   msg.result      = &result;
-
-   queue_msg_push(obj->msgq_main, (const char*)&msg, sizeof(msg));
-
-   sem_wait(&semaphore);
-   sem_destroy(&semaphore);
-
-   if(result != XRAUDIO_RESULT_OK) {
-      XLOGD_ERROR("unable to get keyword detector sensitivity limits");
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+      XLOGD_ERROR("microphone not opened!");
+      result = XRAUDIO_RESULT_ERROR_INPUT;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else {
+      result = xraudio_input_stop(obj->obj_input, source, -1);
    }
-
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_record_sound_intensity_transfer(xraudio_object_t object, const char *fifo_name) {
+xraudio_result_t xraudio_stream_time_minimum(xraudio_object_t object, xraudio_devices_input_t source, uint16_t ms) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
@@ -1466,20 +2208,19 @@ xraudio_result_t xraudio_record_sound_intensity_transfer(xraudio_object_t object
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      result = xraudio_input_sound_intensity_transfer(obj->obj_input, fifo_name);
+      result = xraudio_input_stream_time_minimum(obj->obj_input, source, ms);
    }
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_record_to_file(xraudio_object_t object, xraudio_devices_input_t source, xraudio_container_t container, const char *audio_file_path, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param) {
+xraudio_result_t xraudio_stream_keyword_info(xraudio_object_t object, xraudio_devices_input_t source, uint32_t keyword_begin, uint32_t keyword_duration) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
       XLOGD_ERROR("Invalid object.");
       return(XRAUDIO_RESULT_ERROR_OBJECT);
    }
-   bool has_mutex = true;
 
    XRAUDIO_API_MUTEX_LOCK();
    if(!obj->opened) {
@@ -1492,26 +2233,19 @@ xraudio_result_t xraudio_record_to_file(xraudio_object_t object, xraudio_devices
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      if(callback == NULL) { // Synchronous
-         XRAUDIO_API_MUTEX_UNLOCK();
-         has_mutex = false;
-      }
-      result = xraudio_input_record_to_file(obj->obj_input, source, container, audio_file_path, from, offset, until, callback, param);
-   }
-   if(has_mutex) {
-      XRAUDIO_API_MUTEX_UNLOCK();
+      result = xraudio_input_stream_keyword_info(obj->obj_input, source, keyword_begin, keyword_duration);
    }
+   XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_record_to_memory(xraudio_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, uint32_t sample_qty, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param) {
+xraudio_result_t xraudio_stream_sound_intensity_transfer(xraudio_object_t object, const char *fifo_name) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
       XLOGD_ERROR("Invalid object.");
       return(XRAUDIO_RESULT_ERROR_OBJECT);
    }
-   bool has_mutex = true;
 
    XRAUDIO_API_MUTEX_LOCK();
    if(!obj->opened) {
@@ -1524,19 +2258,13 @@ xraudio_result_t xraudio_record_to_memory(xraudio_object_t object, xraudio_devic
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      if(callback == NULL) { // Synchronous
-         XRAUDIO_API_MUTEX_UNLOCK();
-         has_mutex = false;
-      }
-      result = xraudio_input_record_to_memory(obj->obj_input, source, buf_samples, sample_qty, from, offset, until, callback, param);
-   }
-   if(has_mutex) {
-      XRAUDIO_API_MUTEX_UNLOCK();
+      result = xraudio_input_sound_intensity_transfer(obj->obj_input, fifo_name);
    }
+   XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_record_stop(xraudio_object_t object, xraudio_devices_input_t source) {
+xraudio_result_t xraudio_stream_latency_mode_set(xraudio_object_t object, xraudio_devices_input_t source, xraudio_stream_latency_mode_t latency_mode) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
@@ -1548,20 +2276,20 @@ xraudio_result_t xraudio_record_stop(xraudio_object_t object, xraudio_devices_in
    if(!obj->opened) {
       XLOGD_ERROR("xraudio is not open!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
-   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+   } else if(XRAUDIO_DEVICE_INPUT_LOCAL_GET(obj->devices_input) == XRAUDIO_DEVICE_INPUT_NONE) {
       XLOGD_ERROR("microphone not opened!");
       result = XRAUDIO_RESULT_ERROR_INPUT;
    } else if(obj->obj_input == NULL) {
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      result = xraudio_input_stop(obj->obj_input, source, -1);
+      result = xraudio_input_latency_mode_set(obj->obj_input, source, latency_mode);
    }
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_stream_time_minimum(xraudio_object_t object, xraudio_devices_input_t source, uint16_t ms) {
+xraudio_result_t xraudio_stream_frame_group_quantity_set(xraudio_object_t object, xraudio_devices_input_t source, uint8_t quantity) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
@@ -1580,13 +2308,13 @@ xraudio_result_t xraudio_stream_time_minimum(xraudio_object_t object, xraudio_de
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      result = xraudio_input_stream_time_minimum(obj->obj_input, source, ms);
+      result = xraudio_input_frame_group_quantity_set(obj->obj_input, source, quantity);
    }
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_stream_keyword_info(xraudio_object_t object, xraudio_devices_input_t source, uint32_t keyword_begin, uint32_t keyword_duration) {
+xraudio_result_t xraudio_stream_latency_budget_set(xraudio_object_t object, xraudio_devices_input_t source, uint16_t budget_ms) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
@@ -1605,13 +2333,13 @@ xraudio_result_t xraudio_stream_keyword_info(xraudio_object_t object, xraudio_de
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      result = xraudio_input_stream_keyword_info(obj->obj_input, source, keyword_begin, keyword_duration);
+      result = xraudio_input_latency_budget_set(obj->obj_input, source, budget_ms);
    }
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_stream_sound_intensity_transfer(xraudio_object_t object, const char *fifo_name) {
+xraudio_result_t xraudio_stream_identifier_set(xraudio_object_t object, xraudio_devices_input_t source, const char *identifier) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
@@ -1630,13 +2358,13 @@ xraudio_result_t xraudio_stream_sound_intensity_transfer(xraudio_object_t object
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      result = xraudio_input_sound_intensity_transfer(obj->obj_input, fifo_name);
+      result = xraudio_input_stream_identifer_set(obj->obj_input, source, identifier);
    }
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_stream_latency_mode_set(xraudio_object_t object, xraudio_devices_input_t source, xraudio_stream_latency_mode_t latency_mode) {
+xraudio_result_t xraudio_stream_framing_set(xraudio_object_t object, xraudio_devices_input_t source, xraudio_stream_framing_t framing) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
@@ -1648,20 +2376,20 @@ xraudio_result_t xraudio_stream_latency_mode_set(xraudio_object_t object, xraudi
    if(!obj->opened) {
       XLOGD_ERROR("xraudio is not open!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
-   } else if(XRAUDIO_DEVICE_INPUT_LOCAL_GET(obj->devices_input) == XRAUDIO_DEVICE_INPUT_NONE) {
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
       XLOGD_ERROR("microphone not opened!");
       result = XRAUDIO_RESULT_ERROR_INPUT;
    } else if(obj->obj_input == NULL) {
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      result = xraudio_input_latency_mode_set(obj->obj_input, source, latency_mode);
+      result = xraudio_input_stream_framing_set(obj->obj_input, source, framing);
    }
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_stream_frame_group_quantity_set(xraudio_object_t object, xraudio_devices_input_t source, uint8_t quantity) {
+xraudio_result_t xraudio_stream_sample_format_set(xraudio_object_t object, xraudio_devices_input_t source, xraudio_stream_sample_format_t sample_format, xraudio_stream_channel_layout_t channel_layout) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
@@ -1680,13 +2408,13 @@ xraudio_result_t xraudio_stream_frame_group_quantity_set(xraudio_object_t object
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      result = xraudio_input_frame_group_quantity_set(obj->obj_input, source, quantity);
+      result = xraudio_input_stream_sample_format_set(obj->obj_input, source, sample_format, channel_layout);
    }
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_stream_identifier_set(xraudio_object_t object, xraudio_devices_input_t source, const char *identifier) {
+xraudio_result_t xraudio_stream_buffer_pool_set(xraudio_object_t object, xraudio_devices_input_t source, uint8_t buffer_qty) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
    if(!xraudio_object_is_valid(obj)) {
@@ -1705,12 +2433,35 @@ xraudio_result_t xraudio_stream_identifier_set(xraudio_object_t object, xraudio_
       XLOGD_ERROR("microphone object is NULL!");
       result = XRAUDIO_RESULT_ERROR_OPEN;
    } else {
-      result = xraudio_input_stream_identifer_set(obj->obj_input, source, identifier);
+      result = xraudio_input_stream_buffer_pool_set(obj->obj_input, source, buffer_qty);
    }
    XRAUDIO_API_MUTEX_UNLOCK();
    return(result);
 }
 
+xraudio_stream_buffer_t xraudio_stream_buffer_retain(xraudio_object_t object) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(NULL);
+   }
+   // No api mutex since this is called from the data callback on the main thread
+   return(xraudio_in_stream_buffer_retain(obj->stream_buffer_lent));
+}
+
+void xraudio_stream_buffer_release(xraudio_object_t object, xraudio_stream_buffer_t buffer) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   if(buffer == NULL) {
+      XLOGD_ERROR("NULL buffer");
+      return;
+   }
+   xraudio_in_stream_buffer_release(buffer);
+}
+
 xraudio_result_t xraudio_stream_to_fifo(xraudio_object_t object, xraudio_devices_input_t source, const char *fifo_name, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
@@ -1775,6 +2526,50 @@ xraudio_result_t xraudio_stream_to_pipe(xraudio_object_t object, xraudio_devices
    return(result);
 }
 
+xraudio_result_t xraudio_stream_arm(xraudio_object_t object, xraudio_devices_input_t source, xraudio_dst_pipe_t dsts[], xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param) {
+   xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
+   xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(dsts == NULL || callback == NULL) {
+      XLOGD_ERROR("invalid params - dsts <%p> callback <%p>", dsts, callback);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(!obj->opened) {
+      XLOGD_ERROR("xraudio is not open!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else if(obj->devices_input == XRAUDIO_DEVICE_INPUT_NONE) {
+      XLOGD_ERROR("microphone not opened!");
+      result = XRAUDIO_RESULT_ERROR_INPUT;
+   } else if(obj->obj_input == NULL) {
+      XLOGD_ERROR("microphone object is NULL!");
+      result = XRAUDIO_RESULT_ERROR_OPEN;
+   } else {
+      result = xraudio_input_stream_arm(obj->obj_input, source, dsts, format_decoded, callback, param);
+   }
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_stream_armed_report_get(xraudio_object_t object, xraudio_stream_armed_report_t *report) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(report == NULL) {
+      XLOGD_ERROR("Null report");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the report is updated atomically by the main thread
+   xraudio_in_stream_armed_report_get(report);
+   return(XRAUDIO_RESULT_OK);
+}
+
 xraudio_result_t xraudio_stream_to_user(xraudio_object_t object, xraudio_devices_input_t source, audio_in_data_callback_t data, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param) {
    xraudio_obj_t *  obj    = (xraudio_obj_t *)object;
    xraudio_result_t result = XRAUDIO_RESULT_ERROR_INVALID;
@@ -2490,6 +3285,21 @@ xraudio_result_t xraudio_power_mode_update(xraudio_object_t object, xraudio_powe
    return(result);
 }
 
+xraudio_result_t xraudio_dsp_state_report_get(xraudio_object_t object, xraudio_dsp_state_report_t *report) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(report == NULL) {
+      XLOGD_ERROR("Null report");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the report is updated atomically by the main thread
+   xraudio_in_dsp_state_report_get(report);
+   return(XRAUDIO_RESULT_OK);
+}
+
 xraudio_result_t xraudio_privacy_mode_update(xraudio_object_t object, xraudio_devices_input_t input, bool enable) {
    xraudio_obj_t *obj = (xraudio_obj_t *)object;
    if(!xraudio_object_is_valid(obj)) {
@@ -2537,6 +3347,168 @@ xraudio_result_t xraudio_privacy_mode_update(xraudio_object_t object, xraudio_de
    return(result);
 }
 
+xraudio_result_t xraudio_privacy_report_get(xraudio_object_t object, xraudio_privacy_report_t *report) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(report == NULL) {
+      XLOGD_ERROR("Null report");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the report is updated atomically by the main thread
+   xraudio_in_privacy_report_get(report);
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_standby_set(xraudio_object_t object, bool enable) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+
+   XRAUDIO_API_MUTEX_LOCK();
+   if(obj->opened) {
+      XLOGD_ERROR("standby must be set before calling open.");
+      XRAUDIO_API_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_OPEN);
+   }
+   obj->standby = enable;
+
+   if(!enable) {
+      xraudio_audio_hal_standby_release();
+   }
+
+   XLOGD_INFO("standby <%s>", enable ? "ENABLE" : "DISABLE");
+   XRAUDIO_API_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_standby_report_get(xraudio_object_t object, xraudio_standby_report_t *report) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(report == NULL) {
+      XLOGD_ERROR("Null report");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   XRAUDIO_API_MUTEX_LOCK();
+   report->hal_held         = g_xraudio_process.hal_standby;
+   report->hal_reuse_qty    = g_xraudio_process.hal_reuse_qty;
+   report->hal_open_time_us = g_xraudio_process.hal_open_time_us;
+   XRAUDIO_API_MUTEX_UNLOCK();
+
+   // The speaker and microphone fields are updated atomically by the main thread
+   xraudio_in_standby_report_get(report);
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_latency_histogram_get(xraudio_object_t object, xraudio_latency_stage_t stage, xraudio_latency_histogram_t *histogram) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if((uint32_t)stage >= XRAUDIO_LATENCY_STAGE_INVALID || histogram == NULL) {
+      XLOGD_ERROR("invalid params - stage <%s> histogram <%p>", xraudio_latency_stage_str(stage), histogram);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   // No api mutex since the histograms are updated atomically
+   xraudio_latency_histogram_read(stage, histogram);
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_latency_histogram_reset(xraudio_object_t object) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   xraudio_latency_reset();
+   XLOGD_INFO("latency histograms reset");
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_trace_start(xraudio_object_t object, const xraudio_trace_config_t *config) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(config == NULL || config->event_qty == 0 || config->event_qty > XRAUDIO_TRACE_EVENT_QTY_MAX) {
+      XLOGD_ERROR("invalid params - event qty <%u>", (config == NULL) ? 0 : config->event_qty);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   #ifdef XRAUDIO_TRACE_ENABLED
+   if(!xraudio_trace_recorder_start(config)) {
+      return(XRAUDIO_RESULT_ERROR_INTERNAL);
+   }
+   return(XRAUDIO_RESULT_OK);
+   #else
+   XLOGD_ERROR("trace is not supported");
+   return(XRAUDIO_RESULT_ERROR_INTERNAL);
+   #endif
+}
+
+xraudio_result_t xraudio_trace_stop(xraudio_object_t object) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   #ifdef XRAUDIO_TRACE_ENABLED
+   xraudio_trace_recorder_stop();
+   return(XRAUDIO_RESULT_OK);
+   #else
+   XLOGD_ERROR("trace is not supported");
+   return(XRAUDIO_RESULT_ERROR_INTERNAL);
+   #endif
+}
+
+xraudio_result_t xraudio_trace_export(xraudio_object_t object, const char *filename) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(filename == NULL) {
+      XLOGD_ERROR("invalid params - filename");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   #ifdef XRAUDIO_TRACE_ENABLED
+   if(!xraudio_trace_recorder_export(filename)) {
+      return(XRAUDIO_RESULT_ERROR_FILE_OPEN);
+   }
+   return(XRAUDIO_RESULT_OK);
+   #else
+   XLOGD_ERROR("trace is not supported");
+   return(XRAUDIO_RESULT_ERROR_INTERNAL);
+   #endif
+}
+
+xraudio_result_t xraudio_init_report_get(xraudio_object_t object, xraudio_init_report_t *report) {
+   xraudio_obj_t *obj = (xraudio_obj_t *)object;
+   if(!xraudio_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(report == NULL) {
+      XLOGD_ERROR("Null report");
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   XRAUDIO_API_MUTEX_LOCK();
+   *report = obj->init_report;
+   XRAUDIO_API_MUTEX_UNLOCK();
+
+   // The plugin fields are updated atomically by the main thread
+   xraudio_in_init_report_get(report);
+   return(XRAUDIO_RESULT_OK);
+}
+
 xraudio_result_t xraudio_privacy_mode_get(xraudio_object_t object, xraudio_devices_input_t input, bool *enabled) {
    xraudio_obj_t *obj = (xraudio_obj_t *)object;
    if(!xraudio_object_is_valid(obj)) {
@@ -57,12 +57,15 @@
 
 #define XRAUDIO_INPUT_MIN_SAMPLE_RATE          (16000)                             ///< Minimum input sample rate supported (in Hertz)
 #define XRAUDIO_INPUT_MAX_SAMPLE_RATE          (16000)                             ///< Maximum input sample rate supported (in Hertz)
+#define XRAUDIO_INPUT_MAX_CAPTURE_SAMPLE_RATE  (48000)                             ///< Maximum microphone capture sample rate supported (in Hertz)
 
 #define XRAUDIO_INPUT_MIN_SAMPLE_SIZE          (XRAUDIO_INPUT_DEFAULT_SAMPLE_SIZE) ///< Minimum input sample size supported (in bytes)
 #define XRAUDIO_INPUT_MAX_SAMPLE_SIZE          (4)                                 ///< Maximum input sample size supported (in bytes)
 
 #define XRAUDIO_INPUT_MIN_CHANNEL_QTY          (XRAUDIO_INPUT_DEFAULT_CHANNEL_QTY) ///< Minimum input channel quantity
-#define XRAUDIO_INPUT_MAX_CHANNEL_QTY          (4)                                 ///< Maximum input channel quantity
+#ifndef XRAUDIO_INPUT_MAX_CHANNEL_QTY
+#define XRAUDIO_INPUT_MAX_CHANNEL_QTY          (4)                                 ///< Maximum input channel quantity (set at build time for larger arrays, the hal must use the same value)
+#endif
 
 #define XRAUDIO_INPUT_MAX_DEVICE_QTY           (3)                                 ///< Maximum input devices (ff, ptt, mic)
 
@@ -70,6 +73,8 @@
 #define XRAUDIO_INPUT_MAX_FRAME_GROUP_QTY      (10)                                ///< Maximum input frame group quantity
 #define XRAUDIO_INPUT_DEFAULT_FRAME_GROUP_QTY  (XRAUDIO_INPUT_MIN_FRAME_GROUP_QTY) ///< Default input frame group quantity
 
+#define XRAUDIO_INPUT_MAX_IDLE_FRAME_QTY       (10)                                ///< Maximum quantity of frames read per wakeup in idle mode
+
 #define XRAUDIO_PRE_DETECTION_DURATION_MAX     (5000)                              ///< Maximum amount of audio data saved prior to keyword detection
 
 #define XRAUDIO_STREAM_TIME_MINIMUM_MAX        (500)                               ///< Maxmium minimum audio data threshold
@@ -88,6 +93,33 @@
 
 #define XRAUDIO_STREAM_ID_SIZE_MAX             (64)
 
+#define XRAUDIO_STREAM_BUFFER_QTY_MAX          (16)                                ///< Maximum quantity of buffers in a stream buffer pool
+
+#define XRAUDIO_BEAM_QTY_MAX                   (8)                                 ///< Maximum quantity of steered beams formed by the beamformer
+
+#define XRAUDIO_MEMORY_RING_SAMPLE_QTY_MAX     (0x3FFFFFFF)                        ///< Maximum quantity of samples in a circular record to memory buffer
+
+#define XRAUDIO_KEYWORD_COMMIT_LATENCY_DEFAULT (100)                               ///< Default maximum time to wait for other keyword detectors after the first trigger (in milliseconds)
+#define XRAUDIO_KEYWORD_COMMIT_LATENCY_MAX     (1000)                              ///< Maximum time to wait for other keyword detectors after the first trigger (in milliseconds)
+
+#define XRAUDIO_KEYWORD_MODEL_QTY_MAX          (3)                                 ///< Maximum quantity of additional keyword models
+#define XRAUDIO_KEYWORD_NAME_SIZE_MAX          (32)                                ///< Maximum size of a keyword name (including the terminating null)
+#define XRAUDIO_KEYWORD_BUDGET_DEFAULT         (10000)                             ///< Default processing time budget per frame for all keyword models (in microseconds)
+#define XRAUDIO_KEYWORD_INDEX_PRIMARY          (0)                                 ///< Keyword index of the keyword model in the xraudio input configuration
+
+#define XRAUDIO_GOVERNOR_LOAD_HIGH_DEFAULT     (85)                                ///< Default load above which the governor sheds processing (in percent of the frame period)
+#define XRAUDIO_GOVERNOR_LOAD_LOW_DEFAULT      (60)                                ///< Default load below which the governor restores processing (in percent of the frame period)
+#define XRAUDIO_GOVERNOR_ESCALATE_DEFAULT      (500)                               ///< Default time the load must stay high before each shed step (in milliseconds)
+#define XRAUDIO_GOVERNOR_RECOVER_DEFAULT       (5000)                              ///< Default time the load must stay low before each restore step (in milliseconds)
+
+#define XRAUDIO_STREAM_FRAME_HEADER_MAGIC      (0x58524146)                        ///< Magic value at the beginning of each stream frame header ("XRAF")
+#define XRAUDIO_STREAM_FRAME_FLAG_KEYWORD_END  (0x0001)                            ///< The end of the keyword occurs within or before this frame group
+#define XRAUDIO_STREAM_FRAME_FLAG_EOS          (0x0002)                            ///< The stream ends with this frame group (end of speech or end of source data)
+#define XRAUDIO_STREAM_FRAME_FLAG_GAP          (0x0004)                            ///< One or more frame groups prior to this one were dropped by this destination
+#define XRAUDIO_STREAM_FRAME_FLAG_SPECULATIVE  (0x0008)                            ///< The frame group belongs to a speculative stream sent before the keyword was confirmed
+#define XRAUDIO_STREAM_FRAME_FLAG_RETRACT      (0x0010)                            ///< The speculative stream is retracted and all of its frame groups must be discarded
+#define XRAUDIO_STREAM_FRAME_FLAG_CONFIRM      (0x0020)                            ///< The speculative stream is confirmed by the keyword detection
+
 #define XRAUDIO_INPUT_DEFAULT_KEYWORD_SENSITIVITY  (0.3)                           ///< Default keyword detector sensitivity
 /// @}
 
@@ -231,10 +263,107 @@ typedef enum {
    XRAUDIO_KEYWORD_CONFIG_INVALID = 15, ///< Invalid keyword config type
 } xraudio_keyword_config_t;
 
+/// @brief Stream Framing Types
+/// @details The stream framing enumeration indicates how audio data is packaged when streaming to a pipe, fifo or user-defined handler.
+typedef enum {
+   XRAUDIO_STREAM_FRAMING_NONE    = 0, ///< Raw audio data is streamed with no framing (default)
+   XRAUDIO_STREAM_FRAMING_HEADER  = 1, ///< Each frame group is preceded by an xraudio_stream_frame_header_t
+   XRAUDIO_STREAM_FRAMING_INVALID = 2, ///< Invalid stream framing type
+} xraudio_stream_framing_t;
+
+/// @brief Stream Sample Format Types
+/// @details The stream sample format enumeration indicates the sample type of PCM audio data streamed to a pipe, fifo or user-defined handler.
+typedef enum {
+   XRAUDIO_STREAM_SAMPLE_FORMAT_INT16   = 0, ///< 16-bit signed integer samples (default)
+   XRAUDIO_STREAM_SAMPLE_FORMAT_INT32   = 1, ///< 32-bit signed integer samples
+   XRAUDIO_STREAM_SAMPLE_FORMAT_FLOAT32 = 2, ///< 32-bit floating point samples in the range [-1.0, 1.0)
+   XRAUDIO_STREAM_SAMPLE_FORMAT_INVALID = 3, ///< Invalid stream sample format
+} xraudio_stream_sample_format_t;
+
+/// @brief Stream Channel Layout Types
+/// @details The stream channel layout enumeration indicates which microphone channels are streamed and how they are arranged in each frame group.
+typedef enum {
+   XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO        = 0, ///< Active channel only (default)
+   XRAUDIO_STREAM_CHANNEL_LAYOUT_INTERLEAVED = 1, ///< All microphone channels, interleaved sample by sample
+   XRAUDIO_STREAM_CHANNEL_LAYOUT_PLANAR      = 2, ///< All microphone channels, each channel's samples for the frame group stored contiguously in channel order
+   XRAUDIO_STREAM_CHANNEL_LAYOUT_INVALID     = 3, ///< Invalid stream channel layout
+} xraudio_stream_channel_layout_t;
+
+/// @brief Callback Dispatch Types
+/// @details The callback dispatch enumeration indicates which thread invokes the event callbacks.
+typedef enum {
+   XRAUDIO_CALLBACK_DISPATCH_INLINE  = 0, ///< Callbacks are invoked on the xraudio main thread (default)
+   XRAUDIO_CALLBACK_DISPATCH_THREAD  = 1, ///< Event callbacks are queued and invoked on a dedicated dispatch thread
+   XRAUDIO_CALLBACK_DISPATCH_INVALID = 2, ///< Invalid callback dispatch type
+} xraudio_callback_dispatch_t;
+
+/// @brief Keyword Commit Reasons
+/// @details The keyword commit reason enumeration indicates why the keyword detection was reported after the first detector triggered.
+typedef enum {
+   XRAUDIO_KEYWORD_COMMIT_ALL_TRIGGERED = 0, ///< Every keyword detector instance triggered (instances skipped by load shedding do not count as triggered)
+   XRAUDIO_KEYWORD_COMMIT_MARGIN        = 1, ///< The selected channel led every other channel by the commit margin
+   XRAUDIO_KEYWORD_COMMIT_TIMEOUT       = 2, ///< The maximum commit latency elapsed
+   XRAUDIO_KEYWORD_COMMIT_INVALID       = 3, ///< Invalid keyword commit reason
+} xraudio_keyword_commit_reason_t;
+
+/// @brief Shed Levels
+/// @details The shed level enumeration indicates how much processing the overload governor has shed.  Each level also sheds the processing of the levels below it.
+typedef enum {
+   XRAUDIO_SHED_LEVEL_NONE          = 0, ///< Full processing
+   XRAUDIO_SHED_LEVEL_METERS        = 1, ///< The sound intensity meters are not updated
+   XRAUDIO_SHED_LEVEL_KWD_SECONDARY = 2, ///< Keyword detection runs only on the active keyword channel
+   XRAUDIO_SHED_LEVEL_EOS_SINGLE    = 3, ///< End of speech detection runs only on the active channel
+   XRAUDIO_SHED_LEVEL_PPR_BYPASS    = 4, ///< The preprocessor is bypassed
+   XRAUDIO_SHED_LEVEL_INVALID       = 5, ///< Invalid shed level
+} xraudio_shed_level_t;
+
+/// @brief Latency Stages
+/// @details The latency stage enumeration identifies the latency histograms.  The microphone pipeline stages are timed on each frame or frame group they process and the end to end
+/// histograms are timed from the capture or keyword detection to the delivery to the stream.
+typedef enum {
+   XRAUDIO_LATENCY_STAGE_HAL_READ              = 0,  ///< Microphone frame read from the HAL
+   XRAUDIO_LATENCY_STAGE_UNPACK                = 1,  ///< Decimation and unpacking of the HAL frame into channels
+   XRAUDIO_LATENCY_STAGE_PPR                   = 2,  ///< Preprocessor
+   XRAUDIO_LATENCY_STAGE_DGA                   = 3,  ///< Dynamic gain calculation or application
+   XRAUDIO_LATENCY_STAGE_KWD                   = 4,  ///< Keyword detection of a frame
+   XRAUDIO_LATENCY_STAGE_EOS                   = 5,  ///< End of speech detection of a frame on all channels
+   XRAUDIO_LATENCY_STAGE_CONVERT               = 6,  ///< Sample format conversion
+   XRAUDIO_LATENCY_STAGE_WRITE_PIPE            = 7,  ///< Frame processing for a stream to pipe, including the conversion, gain and write
+   XRAUDIO_LATENCY_STAGE_WRITE_FILE            = 8,  ///< Frame processing for a recording to file
+   XRAUDIO_LATENCY_STAGE_WRITE_MEMORY          = 9,  ///< Frame processing for a recording to memory
+   XRAUDIO_LATENCY_STAGE_WRITE_USER            = 10, ///< Frame processing for a stream to a data callback, including the callback
+   XRAUDIO_LATENCY_STAGE_CALLBACK              = 11, ///< Application callback (data callbacks and dispatched event callbacks)
+   XRAUDIO_LATENCY_STAGE_CAPTURE_TO_DELIVERY   = 12, ///< Capture of the first sample of a frame group to its delivery to the stream
+   XRAUDIO_LATENCY_STAGE_KEYWORD_TO_FIRST_BYTE = 13, ///< Keyword detection to the first write to the stream
+   XRAUDIO_LATENCY_STAGE_INVALID               = 14, ///< Invalid latency stage
+} xraudio_latency_stage_t;
+
+/// @brief Input Processing Modes
+/// @details The processing mode enumeration indicates how the microphone frames were read and processed on a wakeup of the main thread.
+typedef enum {
+   XRAUDIO_INPUT_PROCESS_MODE_FRAME   = 0, ///< One frame is read and processed per wakeup
+   XRAUDIO_INPUT_PROCESS_MODE_IDLE    = 1, ///< Several frames buffered by the HAL are read and processed per wakeup while only keyword detection is active
+   XRAUDIO_INPUT_PROCESS_MODE_INVALID = 2, ///< Invalid processing mode
+} xraudio_input_process_mode_t;
+
+/// @brief DSP Plugins
+/// @details The DSP plugin enumeration indicates the signal processing component whose adapted state is saved and restored.
+typedef enum {
+   XRAUDIO_DSP_PLUGIN_EOS     = 0, ///< End of speech detector
+   XRAUDIO_DSP_PLUGIN_KWD     = 1, ///< Keyword detector
+   XRAUDIO_DSP_PLUGIN_DGA     = 2, ///< Dynamic gain adjustment
+   XRAUDIO_DSP_PLUGIN_PPR     = 3, ///< Preprocessor
+   XRAUDIO_DSP_PLUGIN_INVALID = 4, ///< Invalid plugin
+} xraudio_dsp_plugin_t;
+
 /// @brief xraudio object type
 /// @details The xraudio object type is returned by the xraudio_object_create api.  It is used in all subsequent calls to xraudio api's.
 typedef void *          xraudio_object_t;
 
+/// @brief xraudio stream buffer type
+/// @details The xraudio stream buffer type is a reference to a frame group buffer lent to the client by the xraudio_stream_buffer_retain api.
+typedef void *          xraudio_stream_buffer_t;
+
 /// @brief xraudio sample
 /// @details The xraudio sample is used to store a single 16-bit signed sample of audio.
 typedef int16_t         xraudio_sample_t;
@@ -254,6 +383,10 @@ typedef struct {
    xraudio_kwd_chan_result_t channels[XRAUDIO_INPUT_MAX_CHANNEL_QTY];
    const char *               detector_name;
    const char *               dsp_name;
+   xraudio_keyword_commit_reason_t commit_reason;   ///< Reason the detection was reported
+   uint32_t                        commit_delay_ms; ///< Time from the first trigger until the detection was reported (in milliseconds)
+   uint8_t                         keyword_index;   ///< Keyword that was detected (XRAUDIO_KEYWORD_INDEX_PRIMARY or one plus the index of the additional keyword model)
+   const char *                    keyword_name;    ///< Name of the additional keyword model that was detected (NULL for the primary keyword)
 } xraudio_keyword_detector_result_t;
 
 typedef struct {
@@ -274,8 +407,235 @@ typedef struct {
    uint32_t samples_lost;
    uint32_t decoder_failures;
    uint32_t samples_buffered_max;
+   uint32_t buffers_unavailable;  ///< Frame groups delivered without a lent buffer because the stream buffer pool was exhausted
+   uint32_t frame_groups_written; ///< Frame groups written to the destination
+   uint32_t frames_written;       ///< Frames written to the destination (frames_written / frame_groups_written is the effective frame group quantity)
 } xraudio_audio_stats_t;
 
+/// @brief xraudio microphone position structure
+/// @details The position of a microphone in the plane of the array, relative to any fixed origin.
+typedef struct {
+   float x_mm; ///< X coordinate (in millimeters)
+   float y_mm; ///< Y coordinate (in millimeters)
+} xraudio_mic_position_t;
+
+/// @brief xraudio beamformer configuration structure
+/// @details The microphone array geometry and the configuration of the delay and sum beamformer used as the keyword detector front end and the direction of arrival estimator.
+/// Beams are steered at angles evenly spaced around the array, starting with beam 0 along the positive X axis and increasing counterclockwise.  Angles follow the same convention.
+typedef struct {
+   bool                   enable;                                       ///< Enable the beamformer
+   bool                   doa_enable;                                   ///< Enable the direction of arrival estimator
+   uint8_t                mic_qty;                                      ///< Quantity of microphones in the array (must match the microphone channel quantity)
+   xraudio_mic_position_t mic_positions[XRAUDIO_INPUT_MAX_CHANNEL_QTY]; ///< Position of each microphone channel
+   uint8_t                beam_qty;                                     ///< Quantity of steered beams [1, XRAUDIO_BEAM_QTY_MAX]
+   uint8_t                beam_qty_kwd;                                 ///< Quantity of the strongest beams processed by the keyword detector [1, beam_qty]
+} xraudio_beamformer_config_t;
+
+/// @brief xraudio direction of arrival structure
+/// @details The direction of arrival estimate tracked across frames.
+typedef struct {
+   bool     valid;      ///< True if a direction has been estimated since the microphone was opened
+   bool     active;     ///< True if speech activity updated the estimate in the most recent frame
+   uint16_t angle;      ///< Direction of arrival (in degrees counterclockwise from the positive X axis)
+   uint8_t  confidence; ///< Confidence of the most recent update [0, 100]
+} xraudio_doa_t;
+
+/// @brief xraudio keyword commit configuration structure
+/// @details Controls when a keyword detection is reported after the first keyword detector instance triggers.  The detection is reported when every instance has triggered,
+/// when the selected channel leads by the margin or when the maximum latency elapses, whichever occurs first.
+typedef struct {
+   uint32_t latency_max_ms; ///< Maximum time to wait for other instances after the first trigger (in milliseconds, rounded down to whole frames) [0, XRAUDIO_KEYWORD_COMMIT_LATENCY_MAX]
+   float    margin;         ///< Lead of the selected channel over every other channel required to report immediately, in units of the channel selection criterion (score or dB).  Zero disables.
+} xraudio_keyword_commit_config_t;
+
+/// @brief xraudio keyword model configuration structure
+/// @details Configures an additional keyword model.
+typedef struct {
+   char                          name[XRAUDIO_KEYWORD_NAME_SIZE_MAX]; ///< Name reported in the keyword detection result
+   json_t *                      jkwd_config;                         ///< Keyword detector configuration (model) of the keyword
+   xraudio_keyword_sensitivity_t sensitivity;                         ///< Keyword detector sensitivity
+} xraudio_keyword_model_config_t;
+
+/// @brief xraudio keyword models configuration structure
+/// @details Configures the keyword models which run in addition to the keyword model in the xraudio input configuration.
+typedef struct {
+   uint8_t                        model_qty;                             ///< Quantity of additional keyword models [0, XRAUDIO_KEYWORD_MODEL_QTY_MAX]
+   xraudio_keyword_model_config_t models[XRAUDIO_KEYWORD_MODEL_QTY_MAX]; ///< Additional keyword models
+   uint32_t                       budget_us;                             ///< Processing time budget per frame for all keyword models (in microseconds, zero for no limit)
+} xraudio_keyword_models_config_t;
+
+/// @brief xraudio speculative stream statistics structure
+/// @details The statistics collected for the speculative stream.
+typedef struct {
+   uint32_t tentative_qty; ///< Speculative streams started when a keyword detector triggered
+   uint32_t hit_qty;       ///< Speculative streams confirmed by the keyword detection
+   uint32_t retract_qty;   ///< Speculative streams retracted
+   uint32_t lead_ms_total; ///< Total audio sent ahead of the confirmation in confirmed streams (in milliseconds)
+} xraudio_stream_speculative_stats_t;
+
+/// @brief xraudio keyword detector reload status structure
+/// @details The status of the keyword detector reload requested by xraudio_detect_reload.
+typedef struct {
+   bool             in_progress;   ///< True while the new keyword detector is loading or waiting to be swapped in
+   xraudio_result_t result;        ///< Result of the most recent reload
+   uint32_t         reload_qty;    ///< Quantity of keyword detectors swapped in since xraudio was opened
+   uint32_t         load_time_ms;  ///< Time to load and initialize the most recent keyword detector on the background thread (in milliseconds)
+   uint32_t         swap_delay_us; ///< Time from the most recent keyword detector being ready until it was swapped in (in microseconds)
+   uint32_t         swap_time_us;  ///< Time the main thread spent swapping in the most recent keyword detector (in microseconds)
+} xraudio_detect_reload_status_t;
+
+/// @brief xraudio frame features structure
+/// @details Signal features calculated once per frame for each microphone channel.  Levels are relative to full scale.
+typedef struct {
+   float    rms;                ///< Root mean square level [0.0, 1.0]
+   float    peak;               ///< Peak absolute level [0.0, 1.0]
+   float    dc_offset;          ///< Mean sample value [-1.0, 1.0]
+   float    zero_crossing_rate; ///< Fraction of adjacent samples which change sign [0.0, 1.0]
+   uint32_t clip_qty;           ///< Quantity of samples at full scale
+   uint32_t sample_qty;         ///< Quantity of samples in the frame
+} xraudio_frame_features_t;
+
+/// @brief xraudio callback dispatch statistics structure
+/// @details The statistics collected by the callback dispatch thread.
+typedef struct {
+   uint32_t events_dispatched; ///< Events invoked on the dispatch thread
+   uint32_t events_inline;     ///< Events invoked on the main thread because the dispatch queue was full
+   uint64_t wait_total_us;     ///< Total time events spent in the queue (in microseconds)
+   uint32_t wait_max_us;       ///< Maximum time an event spent in the queue (in microseconds)
+   uint32_t callback_max_us;   ///< Maximum time spent in a single callback (in microseconds)
+} xraudio_callback_dispatch_stats_t;
+
+/// @brief xraudio overload governor configuration structure
+/// @details Controls when the overload governor sheds and restores processing based on the smoothed processing time of each frame relative to the frame period.
+typedef struct {
+   bool                 enable;        ///< True to enable the overload governor
+   xraudio_shed_level_t level_max;     ///< Highest shed level the governor may step to
+   uint8_t              load_high_pct; ///< Load above which the governor steps up one shed level (in percent of the frame period)
+   uint8_t              load_low_pct;  ///< Load below which the governor steps down one shed level (in percent of the frame period, less than load_high_pct)
+   uint32_t             escalate_ms;   ///< Time the load must stay above load_high_pct before each step up (in milliseconds)
+   uint32_t             recover_ms;    ///< Time the load must stay below load_low_pct before each step down (in milliseconds)
+} xraudio_governor_config_t;
+
+/// @brief xraudio overload governor statistics structure
+/// @details The statistics collected by the overload governor.
+typedef struct {
+   xraudio_shed_level_t level;                                    ///< Current shed level
+   uint32_t             change_qty;                               ///< Quantity of shed level changes
+   uint32_t             overrun_qty;                              ///< Quantity of frames which finished processing after the next frame was due
+   uint32_t             load_pct;                                 ///< Smoothed load (in percent of the frame period)
+   uint32_t             level_time_ms[XRAUDIO_SHED_LEVEL_INVALID]; ///< Time spent recording at each shed level (in milliseconds)
+} xraudio_governor_stats_t;
+
+/// @brief xraudio input channel report structure
+/// @details The memory allocated for the microphone and reference channels at open and the processing time of each microphone channel.
+typedef struct {
+   uint8_t  mic_qty;                                ///< Quantity of microphone channels (reported by the HAL for XRAUDIO_DEVICE_INPUT_ARRAY)
+   uint8_t  ec_ref_qty;                             ///< Quantity of echo canceller reference channels
+   uint8_t  keyword_chan_qty;                       ///< Quantity of asr and keyword channels with a pre-detection buffer
+   uint32_t frame_memory_bytes;                     ///< Memory allocated for the frame buffers of each microphone and reference channel (in bytes)
+   uint32_t keyword_memory_bytes;                   ///< Memory allocated for each asr and keyword channel (in bytes)
+   uint32_t memory_bytes;                           ///< Total memory allocated for the channels (in bytes)
+   uint32_t time_us[XRAUDIO_INPUT_MAX_CHANNEL_QTY]; ///< Smoothed processing time of one frame on each microphone channel (in microseconds)
+} xraudio_input_channel_report_t;
+
+/// @brief xraudio input power report structure
+/// @details The wakeups of the main thread to process the microphone and the time spent processing in each mode since the previous report.
+typedef struct {
+   xraudio_input_process_mode_t mode;                                           ///< Processing mode of the most recent wakeup
+   uint8_t                      idle_frame_qty;                                 ///< Quantity of frames read per wakeup in idle mode
+   uint32_t                     wakeup_qty[XRAUDIO_INPUT_PROCESS_MODE_INVALID];      ///< Quantity of wakeups in each mode
+   uint32_t                     time_ms[XRAUDIO_INPUT_PROCESS_MODE_INVALID];         ///< Time spent in each mode (in milliseconds)
+   uint32_t                     busy_ms[XRAUDIO_INPUT_PROCESS_MODE_INVALID];         ///< Time spent processing in each mode (in milliseconds)
+   float                        wakeups_per_sec[XRAUDIO_INPUT_PROCESS_MODE_INVALID]; ///< Average wakeups per second in each mode
+   float                        residency_pct[XRAUDIO_INPUT_PROCESS_MODE_INVALID];   ///< Time spent processing in each mode (in percent of the time spent in the mode)
+} xraudio_input_power_report_t;
+
+/// @brief xraudio privacy report structure
+/// @details The suspension of the microphone input pipeline while privacy mode is enabled, since xraudio was opened.
+typedef struct {
+   bool     suspended;              ///< True while the input pipeline is suspended
+   uint32_t suspend_qty;            ///< Quantity of times the input pipeline was suspended
+   uint32_t suspend_time_ms;        ///< Time spent suspended, including the current suspension (in milliseconds)
+   uint32_t wakeup_qty;             ///< Quantity of frame timer wakeups while suspended (only while the speaker is open)
+   uint32_t memory_released_bytes;  ///< Memory released by the most recent suspension (in bytes).  Zero, the frame buffers stay allocated so a resume never allocates
+   uint32_t resume_time_us;         ///< Time taken by the most recent resume (in microseconds)
+   uint32_t resume_time_max_us;     ///< Longest time taken by a resume (in microseconds)
+} xraudio_privacy_report_t;
+
+/// @brief xraudio DSP state report structure
+/// @details The snapshots of the adapted DSP plugin state taken before a power mode change or the release of a plugin, since the xraudio object was created.
+typedef struct {
+   uint32_t save_qty[XRAUDIO_DSP_PLUGIN_INVALID];        ///< Quantity of snapshots saved for each plugin
+   uint32_t restore_qty[XRAUDIO_DSP_PLUGIN_INVALID];     ///< Quantity of snapshots restored to each plugin
+   uint32_t reject_qty[XRAUDIO_DSP_PLUGIN_INVALID];      ///< Quantity of snapshots rejected by each plugin on restore
+   uint32_t size_bytes[XRAUDIO_DSP_PLUGIN_INVALID];      ///< Size of the most recent snapshot of each plugin (in bytes, zero if the plugin does not support snapshots)
+   uint32_t restore_time_us[XRAUDIO_DSP_PLUGIN_INVALID]; ///< Time taken by the most recent restore of each plugin (in microseconds)
+} xraudio_dsp_state_report_t;
+
+/// @brief xraudio armed stream report structure
+/// @details The streams armed ahead of the keyword detection and the time from the detection to the first write to the pipe, since the xraudio object was created.
+typedef struct {
+   uint32_t armed_qty;           ///< Quantity of streams armed
+   uint32_t attach_qty;          ///< Quantity of armed streams attached at the keyword detection
+   uint32_t release_qty;         ///< Quantity of armed streams stopped before the keyword was detected
+   uint32_t attach_time_us;      ///< Time taken to attach the most recent armed stream (in microseconds)
+   uint32_t first_byte_armed_us; ///< Time from the keyword detection to the first write to the pipe for the most recent armed stream (in microseconds)
+   uint32_t first_byte_us;       ///< Time from the keyword detection to the first write to the pipe for the most recent stream requested after the detection (in microseconds)
+} xraudio_stream_armed_report_t;
+
+/// @brief xraudio standby report structure
+/// @details The reuse of the audio HAL held in standby and the entry to and exit from standby of the speaker stream, since the process started.
+typedef struct {
+   bool     hal_held;             ///< The audio HAL is held open in standby
+   uint32_t hal_reuse_qty;        ///< Quantity of opens which reused the audio HAL held in standby
+   uint32_t hal_open_time_us;     ///< Time taken to open the audio HAL for the most recent open (in microseconds)
+   uint32_t input_first_read_us;  ///< Time taken by the first microphone read of the most recent session (in microseconds)
+   uint32_t output_entry_qty;     ///< Quantity of speaker standby entries
+   uint32_t output_exit_qty;      ///< Quantity of playbacks started on the speaker stream held in standby
+   uint32_t output_reopen_qty;    ///< Quantity of playbacks which reopened the stream held in standby since their format differed
+   uint32_t output_entry_time_us; ///< Time from the most recent standby entry request until the first silence was written (in microseconds)
+   uint32_t output_exit_time_us;  ///< Time from the most recent playback request on the stream held in standby until its first frame (in microseconds)
+} xraudio_standby_report_t;
+
+/// @brief xraudio initialization report structure
+/// @details The time taken by each step of the most recent xraudio_open().  The keyword detector is initialized by a separate thread while the main thread initializes the other plugins.
+typedef struct {
+   uint32_t open_time_us;    ///< Time taken by xraudio_open() (in microseconds)
+   uint32_t hal_time_us;     ///< Time taken to open the audio HAL (in microseconds)
+   uint32_t input_time_us;   ///< Time taken to create and open the microphone input, including the preprocessor (in microseconds)
+   uint32_t output_time_us;  ///< Time taken to create and open the speaker output (in microseconds)
+   uint32_t thread_time_us;  ///< Time taken by the main thread to initialize, including the plugins (in microseconds)
+   uint32_t kwd_time_us;     ///< Time taken to initialize the keyword detector and load its models (in microseconds)
+   uint32_t dga_time_us;     ///< Time taken to initialize the dynamic gain and restore its state (in microseconds)
+   uint32_t decoder_time_us; ///< Time taken to create the input decoders (in microseconds)
+   uint32_t capture_time_us; ///< Time taken to scan the internal capture directory at the first internal capture (in microseconds)
+} xraudio_init_report_t;
+
+#define XRAUDIO_LATENCY_BUCKET_QTY (16) ///< Quantity of buckets in each latency histogram
+
+/// @brief xraudio latency histogram structure
+/// @details The distribution of the latency of a stage.  The percentiles are the upper limit of the bucket which holds them, or the maximum if it is lower.
+typedef struct {
+   uint32_t bucket_limit_us[XRAUDIO_LATENCY_BUCKET_QTY]; ///< Upper limit of each bucket (in microseconds), the last bucket holds all larger latencies
+   uint32_t bucket_qty[XRAUDIO_LATENCY_BUCKET_QTY];      ///< Quantity of latencies in each bucket
+   uint32_t sample_qty;                                  ///< Total quantity of latencies
+   uint32_t max_us;                                      ///< Maximum latency (in microseconds)
+   uint32_t p50_us;                                      ///< Median latency (in microseconds)
+   uint32_t p90_us;                                      ///< 90th percentile latency (in microseconds)
+   uint32_t p99_us;                                      ///< 99th percentile latency (in microseconds)
+} xraudio_latency_histogram_t;
+
+#define XRAUDIO_TRACE_EVENT_QTY_MAX (1 << 20) ///< Maximum quantity of events held by the trace ring
+
+/// @brief xraudio trace configuration structure
+/// @details The configuration of the trace recorder.  A trigger keeps the events leading up to it, exports them and stops the recording.
+typedef struct {
+   uint32_t    event_qty;        ///< Quantity of events held by the ring, rounded up to a power of 2 (the oldest events are overwritten)
+   uint32_t    trigger_frame_us; ///< Trigger when a frame timer wakeup takes longer than this (in microseconds, 0 for no trigger)
+   bool        trigger_overrun;  ///< Trigger when a microphone frame finishes after the next frame was due
+   const char *trigger_filename; ///< File the trace is exported to when triggered (NULL for no trigger)
+} xraudio_trace_config_t;
+
 typedef struct {
    int                          pipe;
    xraudio_input_record_from_t  from;
@@ -283,6 +643,20 @@ typedef struct {
    xraudio_input_record_until_t until;
 } xraudio_dst_pipe_t;
 
+/// @brief xraudio stream frame header structure
+/// @details When stream framing is enabled, this header precedes each frame group written to the destination.  All fields are in host byte order.
+/// The timestamp is the monotonic capture time for local microphones and the arrival time for external sources.
+typedef struct {
+   uint32_t magic;        ///< XRAUDIO_STREAM_FRAME_HEADER_MAGIC
+   uint16_t header_size;  ///< Size of this header (in bytes)
+   uint16_t flags;        ///< Bitwise XRAUDIO_STREAM_FRAME_FLAG_* values
+   uint32_t sequence;     ///< Frame group sequence number, starting at zero at the beginning of the stream
+   uint32_t sample_qty;   ///< Number of samples per channel in the payload (zero for encoded payloads)
+   uint64_t timestamp;    ///< Monotonic time of the first sample in the payload (in microseconds)
+   uint32_t payload_size; ///< Size of the payload which follows this header (in bytes)
+   uint32_t reserved;     ///< Reserved for future use
+} xraudio_stream_frame_header_t;
+
 /// @}
 
 /// @addtogroup XRAUDIO_CALLBACKS
@@ -311,6 +685,8 @@ typedef int  (*audio_out_data_callback_t)(xraudio_sample_t *frame, uint32_t samp
 
 /// @brief xraudio audio in data callback
 /// @details The xraudio audio in data callback is used to send incoming audio frames to the xraudio client.
+/// When stream framing is enabled, frame points to an xraudio_stream_frame_header_t followed by the payload.  The sample_qty parameter does not include the header.
+/// When a stream sample format other than XRAUDIO_STREAM_SAMPLE_FORMAT_INT16 is set, the payload must be cast to the selected sample type.  The sample_qty parameter is the total quantity of samples for all channels.
 typedef int  (*audio_in_data_callback_t)(xraudio_devices_input_t source, xraudio_sample_t *frame, uint32_t sample_qty, void *param);
 
 /// @brief xraudio resource notification callback
@@ -321,6 +697,10 @@ typedef void (*resource_notification_callback_t)(xraudio_resource_event_t event,
 /// @details The xraudio thread poll callback is used to inform the xraudio client when the xraudio thread is responsive.
 typedef void (*xraudio_thread_poll_func_t)(void);
 
+/// @brief xraudio overload governor callback
+/// @details The xraudio overload governor callback is used to inform the xraudio client when the shed level changes.
+typedef void (*xraudio_governor_callback_t)(xraudio_shed_level_t level_prev, xraudio_shed_level_t level, void *param);
+
 /// @}
 
 /// @addtogroup XRAUDIO_FUNCTIONS
@@ -361,6 +741,81 @@ xraudio_result_t xraudio_internal_capture_params_set(xraudio_object_t object, xr
 /// @brief Deletes files written by internal capture
 /// @details Allow the user the ability to delete files which were created by internal audio capture on recording operations.  This must be called prior to xraudio_open().
 xraudio_result_t xraudio_internal_capture_delete_files(xraudio_object_t object, const char *dir_path);
+/// @brief Set the callback dispatch type
+/// @details Selects the thread on which recording, playback and keyword event callbacks are invoked.  With XRAUDIO_CALLBACK_DISPATCH_THREAD, events are queued by the main thread and delivered in order
+/// on a dedicated thread so a slow callback does not delay audio processing.  Event parameters are copied and remain valid only for the duration of the callback.  Audio data callbacks are always
+/// invoked inline on the main thread.  This must be called prior to xraudio_open().  Default is XRAUDIO_CALLBACK_DISPATCH_INLINE.
+xraudio_result_t xraudio_callback_dispatch_set(xraudio_object_t object, xraudio_callback_dispatch_t dispatch);
+/// @brief Set the beamformer configuration
+/// @details Configures the microphone array geometry, the direction of arrival estimator and the delay and sum beamformer which forms steered beams from the microphone channels.
+/// When the direction of arrival estimator is enabled, the signal direction reported by the sound intensity transfer and the keyword detection result use its estimate.  When the beamformer is enabled, keyword detection runs on the strongest beam_qty_kwd
+/// beams instead of on every microphone channel and the direction of arrival in the keyword detection result is the angle of the detecting beam (in degrees).  The audio
+/// streamed after detection, including the keyword pre-roll, is taken from the beam of the detecting instance.  This must be called prior to xraudio_open().
+/// Default is disabled.
+xraudio_result_t xraudio_beamformer_config_set(xraudio_object_t object, const xraudio_beamformer_config_t *config);
+/// @brief Set the keyword commit configuration
+/// @details Configures how long the keyword detection is held after the first instance triggers, waiting for other instances so the best channel is selected.  Channels which have not triggered
+/// are treated as having a zero score (or SNR).  A margin commit is deferred while the lead of the selected channel is shrinking from the previous frame.  The reason and the delay are reported in
+/// the keyword detection result.  This must be called prior to xraudio_open().  Default is a maximum latency of XRAUDIO_KEYWORD_COMMIT_LATENCY_DEFAULT with the margin disabled.
+xraudio_result_t xraudio_keyword_commit_config_set(xraudio_object_t object, const xraudio_keyword_commit_config_t *config);
+/// @brief Set the microphone frame period
+/// @details Sets the period (in milliseconds) at which frames are read from the microphone and processed.  The period must be at least XRAUDIO_INPUT_FRAME_PERIOD_MIN and evenly divide
+/// XRAUDIO_INPUT_FRAME_PERIOD (5, 10 or 20 milliseconds).  A shorter period reduces the latency from capture to stream and the end of speech reaction time, while the default
+/// (and longest) period minimizes wakeups.  The frame size of the streams, the keyword and end of speech detectors and the preprocessor follow the period.  xraudio_open() fails if a
+/// speaker output is opened with a period other than the speaker frame period, or if the sample rate does not give a whole quantity of samples per frame.  This must be called
+/// prior to xraudio_open().  Default is XRAUDIO_INPUT_FRAME_PERIOD.
+xraudio_result_t xraudio_input_frame_period_set(xraudio_object_t object, uint32_t frame_period);
+/// @brief Set the microphone capture sample rate
+/// @details Sets the rate (in Hertz) at which the HAL captures the microphone and echo reference channels.  The rate must be an integer multiple of XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE
+/// up to XRAUDIO_INPUT_MAX_CAPTURE_SAMPLE_RATE (16000, 32000 or 48000).  When it is above the input sample rate, xraudio decimates each frame with a polyphase FIR before any other
+/// processing, so the streams, detectors and preprocessor run at the input sample rate as before.  The input capture points and the direction of arrival estimate use the
+/// frame at the capture rate.  xraudio_open() fails if the input format sample rate is not XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE with a higher capture rate.  This must be called prior
+/// to xraudio_open().  Default is XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE (no decimation).
+xraudio_result_t xraudio_input_capture_rate_set(xraudio_object_t object, uint32_t sample_rate);
+/// @brief Set the idle mode frame quantity
+/// @details Sets the quantity of frames read per wakeup while the microphone is open and no stream is active (only keyword detection is running).  In this idle mode the main thread
+/// sleeps until the HAL has buffered frame_qty frames, then reads and processes them in one batch, reducing the wakeups by the same factor.  Every frame is still processed by the
+/// keyword detector.  The thread returns to reading one frame per wakeup as soon as a keyword is triggered or a stream starts, and the frames already buffered are processed without
+/// waiting for the next timeout.  The quantity is reduced to fit the HAL input buffer when it reports its size.  Idle mode is not used when the HAL signals each frame on a file
+/// descriptor or while the speaker is open.  This must be called prior to xraudio_open().  Default is 1 (idle mode disabled).
+xraudio_result_t xraudio_input_idle_frame_qty_set(xraudio_object_t object, uint8_t frame_qty);
+/// @brief Set the additional keyword models
+/// @details Configures keyword models which are detected in addition to the keyword model in the xraudio input configuration.  The additional models share the frame buffers, the pre-detection
+/// history, the dynamic gain and the signal features with the primary model.  Each additional model runs a single instance on the first keyword channel.  When the primary model and the additional
+/// models together exceed the processing budget in a frame, the remaining models are deferred and catch up from the pre-detection history in later frames, which delays their detections
+/// by up to 200 milliseconds.  The first keyword detected is reported through the keyword callback with its keyword index and name in the keyword detection result.  A reference to each
+/// jkwd_config is held until the object is destroyed.  This must be called prior to xraudio_open().  Default is no additional keyword models with a budget of XRAUDIO_KEYWORD_BUDGET_DEFAULT.
+xraudio_result_t xraudio_keyword_models_set(xraudio_object_t object, const xraudio_keyword_models_config_t *config);
+/// @brief Set the speculative stream destination
+/// @details Sets a pipe to which audio is streamed as soon as a keyword detector triggers, before the detection is confirmed.  The keyword audio from the detecting channel is written
+/// first, followed by each live frame until the keyword is reported or rejected.  Every write is framed with an xraudio_stream_frame_header_t carrying XRAUDIO_STREAM_FRAME_FLAG_SPECULATIVE and the sequence
+/// restarts at zero for each speculative stream.  The stream ends with a header with no payload carrying XRAUDIO_STREAM_FRAME_FLAG_CONFIRM just before the keyword callback, or
+/// XRAUDIO_STREAM_FRAME_FLAG_RETRACT if the detection is rejected or moves to another channel.  The sample_qty of the final header is the quantity of samples sent, so the client can continue
+/// with a regular stream from XRAUDIO_INPUT_RECORD_FROM_KEYWORD_BEGIN using that quantity as the offset.  The pipe must be non-blocking and is not closed by xraudio.
+/// This must be called prior to xraudio_open().  Default is -1 (disabled).
+xraudio_result_t xraudio_stream_speculative_set(xraudio_object_t object, int pipe);
+/// @brief Get the speculative stream statistics
+/// @details Returns the hit and retract counters for the speculative stream since xraudio was opened.  May be called from any thread.
+xraudio_result_t xraudio_stream_speculative_stats_get(xraudio_object_t object, xraudio_stream_speculative_stats_t *stats);
+/// @brief Get the callback dispatch statistics
+/// @details Returns the statistics for the dispatch thread.  xraudio must be open with XRAUDIO_CALLBACK_DISPATCH_THREAD.
+xraudio_result_t xraudio_callback_dispatch_stats_get(xraudio_object_t object, xraudio_callback_dispatch_stats_t *stats);
+/// @brief Set the overload governor configuration
+/// @details Configures the overload governor which measures the processing time of each microphone frame.  Under sustained overload it steps through the shed levels up to level_max,
+/// one level per escalate_ms of high load, and steps back down one level per recover_ms of low load.  The callback, if not NULL, is invoked on each level change through the configured
+/// callback dispatch.  This must be called prior to xraudio_open().  Default is disabled.
+xraudio_result_t xraudio_governor_config_set(xraudio_object_t object, const xraudio_governor_config_t *config, xraudio_governor_callback_t callback, void *param);
+/// @brief Get the overload governor statistics
+/// @details Returns the shed level, the load and the time spent at each shed level since xraudio was opened.  May be called from any thread.
+xraudio_result_t xraudio_governor_stats_get(xraudio_object_t object, xraudio_governor_stats_t *stats);
+/// @brief Get the input channel report
+/// @details Returns the quantity of channels captured from the microphone, the memory allocated for them when xraudio was opened and the smoothed processing time of the frame features,
+/// end of speech and keyword detection on each microphone channel.  May be called from any thread.
+xraudio_result_t xraudio_input_channel_report_get(xraudio_object_t object, xraudio_input_channel_report_t *report);
+/// @brief Get the input power report
+/// @details Returns the wakeups per second of the main thread and the time spent processing the microphone, in per frame and idle mode, since the previous report (or since xraudio
+/// was opened for the first report).  The counts are cleared when read so they do not wrap as long as the report is read at least every 24 days.  May be called from any thread.
+xraudio_result_t xraudio_input_power_report_get(xraudio_object_t object, xraudio_input_power_report_t *report);
 
 /// @brief Open an xraudio device(s)
 /// @details Open the specified input and output devices.  The microphone input format can optionally be specified using the format parameter.  Prior to opening the devices, the resources must have previously been granted.
@@ -379,6 +834,12 @@ void             xraudio_thread_poll(xraudio_object_t object, xraudio_thread_pol
 /// @details Updates the power mode.  This call is synchronous and the new mode is active after the call returns.
 xraudio_result_t xraudio_power_mode_update(xraudio_object_t object, xraudio_power_mode_t power_mode);
 
+/// @brief Gets the xraudio DSP state report
+/// @details When xraudio is built with XRAUDIO_DSP_STATE_ENABLED, the adapted state of the EOS, KWD, DGA and preprocess plugins is saved before a power mode change and restored after it.
+/// The keyword detector state is also kept when its session ends or is suspended and the DGA state is kept when xraudio is closed, so the state converged in a previous session is
+/// restored when the next one begins.  The report contains the quantity and size of the snapshots and the time taken to restore them.  May be called from any thread.
+xraudio_result_t xraudio_dsp_state_report_get(xraudio_object_t object, xraudio_dsp_state_report_t *report);
+
 /// @brief Updates the xraudio privacy mode
 /// @details Updates the privacy mode.  This call is synchronous and the new mode is active after the call returns.  if enable is true, privacy mode is enabled.  Otherwise it is disabled.
 xraudio_result_t xraudio_privacy_mode_update(xraudio_object_t object, xraudio_devices_input_t input, bool enable);
@@ -387,6 +848,53 @@ xraudio_result_t xraudio_privacy_mode_update(xraudio_object_t object, xraudio_de
 /// @details Gets the privacy mode. The input parameter is a boolean with true indicating privacy mode is enabled, otherwise it is disabled
 xraudio_result_t xraudio_privacy_mode_get(xraudio_object_t object, xraudio_devices_input_t input, bool *enabled);
 
+/// @brief Gets the xraudio privacy report
+/// @details While privacy mode is enabled and no stream is active, the microphone input pipeline is suspended.  The frame timer is stopped, the keyword detector sessions release
+/// their working memory, the frame buffers are freed and the audio buffered prior to the suspension is discarded.  The pipeline resumes when privacy mode is disabled or a stream is
+/// started.  The report contains the time spent suspended, the wakeups and memory released while suspended and the time taken to resume.  May be called from any thread.
+xraudio_result_t xraudio_privacy_report_get(xraudio_object_t object, xraudio_privacy_report_t *report);
+
+/// @brief Set the xraudio standby
+/// @details When enabled, the audio HAL is held open when xraudio is closed so the next xraudio_open() reuses it, and the speaker stream is opened by xraudio_open() and held open
+/// between playbacks while silence is written to it.  A playback in the format of the held stream starts on its next frame without opening the stream.  A playback in another format
+/// reopens the stream, which is then held in that format.  While the speaker stream is held, the microphone is read one frame per wakeup.  Disabling the standby closes the audio HAL
+/// if it is held and no xraudio object is open.  This must be called prior to xraudio_open().  Default is disabled.
+xraudio_result_t xraudio_standby_set(xraudio_object_t object, bool enable);
+
+/// @brief Gets the xraudio standby report
+/// @details The report contains the reuse of the audio HAL held in standby, the time taken by the HAL open and the first microphone read and the standby entry and exit latency of the
+/// speaker stream.  May be called from any thread.
+xraudio_result_t xraudio_standby_report_get(xraudio_object_t object, xraudio_standby_report_t *report);
+
+/// @brief Gets the xraudio initialization report
+/// @details The report contains the time taken by the most recent xraudio_open() and by each component it initializes.  The internal capture directory and the speaker end of speech
+/// detector are initialized at their first use, so their time is not included in the open time.  May be called from any thread.
+xraudio_result_t xraudio_init_report_get(xraudio_object_t object, xraudio_init_report_t *report);
+
+/// @brief Gets a latency histogram
+/// @details Gets the histogram of the latency of the specified stage since xraudio was loaded or the histograms were last reset.  The histograms are shared by all xraudio
+/// objects in the process.  May be called from any thread.
+xraudio_result_t xraudio_latency_histogram_get(xraudio_object_t object, xraudio_latency_stage_t stage, xraudio_latency_histogram_t *histogram);
+
+/// @brief Start the trace recorder
+/// @details Allocates the trace ring and starts recording the timeline of the microphone pipeline stages, the frame timer wakeups, the main thread messages, the HAL
+/// writes and the dispatched callbacks.  Any previous events are discarded.  The trace recorder is only available when xraudio is built with XRAUDIO_TRACE_ENABLED,
+/// otherwise XRAUDIO_RESULT_ERROR_INTERNAL is returned.  The trace is shared by all xraudio objects in the process.
+xraudio_result_t xraudio_trace_start(xraudio_object_t object, const xraudio_trace_config_t *config);
+
+/// @brief Stop the trace recorder
+/// @details Stops recording events.  The events held by the ring can still be exported.
+xraudio_result_t xraudio_trace_stop(xraudio_object_t object);
+
+/// @brief Export the trace
+/// @details Writes the events held by the ring to the specified file in the Chrome trace event JSON format, which is also loaded by Perfetto.  Recording is only paused while
+/// the ring is copied.
+xraudio_result_t xraudio_trace_export(xraudio_object_t object, const char *filename);
+
+/// @brief Resets the latency histograms
+/// @details Clears the histograms of all stages.  A latency recorded while the histograms are reset may be kept.  May be called from any thread.
+xraudio_result_t xraudio_latency_histogram_reset(xraudio_object_t object);
+
 // Recording APIs - Synchronous if callback is NULL
 /// @brief Set keyword detection parameters
 /// @details Sets the keyword detection parameters.  The parameters will remain persistent until the xraudio object is destroyed.  The parameters will take effect on the next call to xraudio_keyword_detect.
@@ -394,6 +902,15 @@ xraudio_result_t xraudio_detect_params(xraudio_object_t object, xraudio_keyword_
 /// @brief Start keyword detection
 /// @details Starts a keyword detection session.  The detector begins processing incoming audio data and provides keyword detection events by invoking the callback.
 xraudio_result_t xraudio_detect_keyword(xraudio_object_t object, keyword_callback_t callback, void *param);
+/// @brief Reload the keyword detector
+/// @details Loads a new keyword detector instance with the specified configuration (model) and sensitivity on a background thread while detection continues with the current instance.
+/// Once the new instance is initialized, it replaces the current instance at the next frame boundary where no detection is pending.  The audio history used for the keyword pre-roll is preserved.
+/// If jkwd_config is NULL the default configuration is used.  A reference to jkwd_config is held while the instance is in use.  Returns immediately; the progress, result and swap latency are
+/// available from xraudio_detect_reload_status_get.  The keyword detector plugin must support creating a second instance while the first is running.
+xraudio_result_t xraudio_detect_reload(xraudio_object_t object, json_t *jkwd_config, xraudio_keyword_sensitivity_t keyword_sensitivity);
+/// @brief Get the keyword detector reload status
+/// @details Returns the status of the most recent keyword detector reload.  May be called from any thread.
+xraudio_result_t xraudio_detect_reload_status_get(xraudio_object_t object, xraudio_detect_reload_status_t *status);
 /// @brief Stop keyword detection
 /// @details Stop the keyword detection session.  The detector stops processing incoming audio data.
 xraudio_result_t xraudio_detect_stop(xraudio_object_t object);
@@ -412,6 +929,27 @@ xraudio_result_t xraudio_record_to_file(xraudio_object_t object, xraudio_devices
 /// The recording will continue until the condition in the until parameter is reached or an error occurs.
 /// The operation is performed synchronously if the callback parameter is NULL.  Otherwise the operation is performed asynchronously with recording events delivered via the callback.
 xraudio_result_t xraudio_record_to_memory(xraudio_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, uint32_t sample_qty, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param);
+/// @brief Record incoming audio data to a circular memory buffer
+/// @details Record the incoming audio stream to the memory location specified in the buf_samples parameter, wrapping to the beginning when the end of the buffer is reached.  The
+/// end of buffer event is never sent.  The most recent audio can be read from the buffer at any time, without stopping the recording, using the index from
+/// xraudio_record_to_memory_index_get.  The recording will continue until the condition in the until parameter is reached, xraudio_record_stop is called or an error occurs.
+/// The operation is performed synchronously if the callback parameter is NULL.  Otherwise the operation is performed asynchronously with recording events delivered via the callback.
+xraudio_result_t xraudio_record_to_memory_circular(xraudio_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, uint32_t sample_qty, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param);
+/// @brief Get the write index of the circular memory buffer
+/// @details Returns the index of the sample that will be written next and the quantity of valid samples preceding it (wrapping at the end of the buffer) for the circular
+/// recording started on the specified source.  The most recent N samples
+/// end at buf_samples[index - 1].  The samples following the index are the next to be overwritten, so a client copying out data should leave a margin of at least one frame group.
+/// May be called from any thread.  The index remains valid after the recording stops until the next circular recording is started.
+xraudio_result_t xraudio_record_to_memory_index_get(xraudio_object_t object, xraudio_devices_input_t source, uint32_t *index, uint32_t *sample_qty_valid);
+/// @brief Get the features of the most recent frame
+/// @details Returns the signal features of the most recent microphone frame for the specified channel.  The features are calculated once per frame while the microphone is
+/// being read, starting with the frame after the first call to this function (or earlier when the direction of arrival is being estimated).  Until then an error is returned.
+xraudio_result_t xraudio_frame_features_get(xraudio_object_t object, uint8_t chan, xraudio_frame_features_t *features);
+/// @brief Get the direction of arrival
+/// @details Returns the most recent direction of arrival estimate.  The direction of arrival estimator must be enabled in the beamformer configuration.  The estimate is updated
+/// each frame while speech activity is present.  While the estimate is valid, its angle overrides the per channel doa (beam angle or channel position) of every triggered channel
+/// in the keyword detection result.  May be called from any thread.
+xraudio_result_t xraudio_doa_get(xraudio_object_t object, xraudio_doa_t *doa);
 /// @brief Stop an active recording session
 /// @details This function stops the active recording session.
 xraudio_result_t xraudio_record_stop(xraudio_object_t object, xraudio_devices_input_t source);
@@ -431,9 +969,42 @@ xraudio_result_t xraudio_stream_latency_mode_set(xraudio_object_t object, xraudi
 /// @details When streaming the audio data will be written in frame sized chunks to the destination.  Setting the frame group quantity increases the size of audio data written to the streaming interface
 /// a multiple of the frame size.  This allows the client to process incoming audio data in larger sized chunks.  The default quantity is XRAUDIO_INPUT_DEFAULT_FRAME_GROUP_QTY.
 xraudio_result_t xraudio_stream_frame_group_quantity_set(xraudio_object_t object, xraudio_devices_input_t source, uint8_t quantity);
+/// @brief Set the stream latency budget
+/// @details Sets the latency (in milliseconds) that the client can tolerate between the capture of a frame and its delivery.  When the budget is non-zero, the frame group quantity is chosen
+/// adaptively in place of the quantity set by xraudio_stream_frame_group_quantity_set().  Each stream starts with single frames and the group grows while the speech is steady, up to the
+/// quantity of frames that fits within the budget (limited to XRAUDIO_INPUT_MAX_FRAME_GROUP_QTY).  A partial group is written immediately at the keyword, an end of speech detector event
+/// and the end of the stream.  The quantity of frames and frame groups written is reported in the stream statistics.  The adaptive quantity applies to the primary stream of the source.
+/// The budget remains in effect for subsequent streams until changed.  Default is 0 (fixed frame group quantity).
+xraudio_result_t xraudio_stream_latency_budget_set(xraudio_object_t object, xraudio_devices_input_t source, uint16_t budget_ms);
 /// @brief Set the stream identifier string
 /// @details Prior to streaming, the stream identifer string can be set to provide an identifier for the stream.
 xraudio_result_t xraudio_stream_identifier_set(xraudio_object_t object, xraudio_devices_input_t source, const char *identifier);
+/// @brief Set the stream framing
+/// @details Prior to streaming, sets the framing used for pipe, fifo and user streams.  When framing is enabled, each frame group is preceded by a header containing a sequence number, capture timestamp,
+/// sample quantity and flags for the keyword end, end of stream and dropped frame groups.  A header with no payload is sent if an event occurs after the last frame group was written.
+/// The framing remains in effect for subsequent streams until changed.  Default is XRAUDIO_STREAM_FRAMING_NONE.
+xraudio_result_t xraudio_stream_framing_set(xraudio_object_t object, xraudio_devices_input_t source, xraudio_stream_framing_t framing);
+/// @brief Set the stream sample format and channel layout
+/// @details Prior to streaming, sets the sample format and channel layout of PCM audio data written to pipe, fifo and user streams.  Samples are converted directly from the microphone frame buffers
+/// so multi-channel clients do not need to convert or interleave the audio themselves.  External sources are mono so only the sample format applies to them.  Pre-detection (keyword) audio is converted
+/// to the sample format in the mono layout.  It is not available in the interleaved and planar layouts, so pipe and fifo streams of a local source in those layouts must start from
+/// XRAUDIO_INPUT_RECORD_FROM_LIVE.  Dynamic gain is only applied to the default format.  The settings remain in effect for subsequent streams until changed.
+/// Default is XRAUDIO_STREAM_SAMPLE_FORMAT_INT16 and XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO.
+xraudio_result_t xraudio_stream_sample_format_set(xraudio_object_t object, xraudio_devices_input_t source, xraudio_stream_sample_format_t sample_format, xraudio_stream_channel_layout_t channel_layout);
+/// @brief Set the stream buffer pool quantity
+/// @details Prior to streaming to a user-defined handler, sets the quantity of preallocated frame group buffers which can be lent to the client.  When the quantity is non-zero, each frame group is
+/// delivered to the data callback in a buffer from the pool.  The client may call xraudio_stream_buffer_retain from within the data callback to keep the buffer after the callback returns and
+/// process it on another thread, then call xraudio_stream_buffer_release when done.  If all buffers are retained, frame groups are delivered without a lent buffer and the buffers_unavailable
+/// statistic is incremented.  A buffer that is still retained when the quantity changes or xraudio is closed is freed when it is released.  The quantity remains in effect for subsequent streams until changed.  Default is zero (no lending).
+/// The buffers are allocated by this call, so XRAUDIO_RESULT_ERROR_STATE is returned while the source is recording or streaming.
+xraudio_result_t xraudio_stream_buffer_pool_set(xraudio_object_t object, xraudio_devices_input_t source, uint8_t buffer_qty);
+/// @brief Retain the frame group buffer being delivered
+/// @details Must be called from within the data callback.  Returns a reference to the buffer holding the frame group that is being delivered, or NULL if the frame group was not delivered in a
+/// lent buffer.  The frame pointer passed to the data callback remains valid until the reference is released.
+xraudio_stream_buffer_t xraudio_stream_buffer_retain(xraudio_object_t object);
+/// @brief Release a frame group buffer
+/// @details Returns a buffer obtained from xraudio_stream_buffer_retain to the stream buffer pool.  May be called from any thread.
+void             xraudio_stream_buffer_release(xraudio_object_t object, xraudio_stream_buffer_t buffer);
 /// @brief Stream incoming audio data to a fifo
 /// @details Stream the incoming audio stream to the named pipe (fifo).  The recording will continue until the condition in the until parameter is reached or an error occurs.
 /// The operation is performed synchronously if the callback parameter is NULL.  Otherwise the operation is performed asynchronously with recording events delivered via the callback.
@@ -442,6 +1013,16 @@ xraudio_result_t xraudio_stream_to_fifo(xraudio_object_t object, xraudio_devices
 /// @details Stream the incoming audio stream to the specified array of pipes.  The recording will continue until the condition in the until parameter is reached or an error occurs.
 /// The operation is performed synchronously if the callback parameter is NULL.  Otherwise the operation is performed asynchronously with recording events delivered via the callback.
 xraudio_result_t xraudio_stream_to_pipe(xraudio_object_t object, xraudio_devices_input_t source, xraudio_dst_pipe_t dsts[], xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param);
+/// @brief Arm a stream to a pipe for the next keyword detection
+/// @details Sets up the stream to the specified array of pipes while xraudio_detect_keyword() is waiting for the keyword.  The stream is attached by the main thread in the frame in
+/// which the keyword is detected, so audio is written to the pipes without waiting for the client to handle the keyword callback.  The parameters are the same as xraudio_stream_to_pipe()
+/// and are validated when the stream is armed.  Keyword information set with xraudio_stream_keyword_info() is captured when the stream is armed.  The operation is always asynchronous,
+/// so the callback must be provided and recording events are delivered via the callback once the stream is attached.  xraudio_stream_to_pipe() must not be called for the detection.
+/// xraudio_stream_stop() releases the stream if the keyword has not been detected and closes the pipes.  Only local microphone sources may be armed.
+xraudio_result_t xraudio_stream_arm(xraudio_object_t object, xraudio_devices_input_t source, xraudio_dst_pipe_t dsts[], xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param);
+/// @brief Get the armed stream report
+/// @details Returns the quantity of armed streams and the time from the keyword detection to the first write to the pipe for armed streams and streams requested after the detection.
+xraudio_result_t xraudio_stream_armed_report_get(xraudio_object_t object, xraudio_stream_armed_report_t *report);
 /// @brief Stream incoming audio data to a user-defined handler
 /// @details Stream the incoming audio stream to the user-defined handler in the data parameter.  The streaming will continue until the condition in the until parameter is reached or an error occurs.
 /// The operation is performed synchronously if the callback parameter is NULL.  Otherwise the operation is performed asynchronously with recording events delivered via the callback.
@@ -563,6 +1144,24 @@ const char *     xraudio_ppr_command_str(xraudio_ppr_command_t command);
 const char *     xraudio_keyword_criterion_str(xraudio_kwd_criterion_t criterion);
 /// @brief Convert the xraudio_stream_latency_mode_t type to a string
 const char *     xraudio_stream_latency_mode_str(xraudio_stream_latency_mode_t latency_mode);
+/// @brief Convert the xraudio_stream_framing_t type to a string
+const char *     xraudio_stream_framing_str(xraudio_stream_framing_t framing);
+/// @brief Convert the xraudio_stream_sample_format_t type to a string
+const char *     xraudio_stream_sample_format_str(xraudio_stream_sample_format_t sample_format);
+/// @brief Convert the xraudio_stream_channel_layout_t type to a string
+const char *     xraudio_stream_channel_layout_str(xraudio_stream_channel_layout_t channel_layout);
+/// @brief Convert the xraudio_callback_dispatch_t type to a string
+const char *     xraudio_callback_dispatch_str(xraudio_callback_dispatch_t dispatch);
+/// @brief Convert the xraudio_keyword_commit_reason_t type to a string
+const char *     xraudio_keyword_commit_reason_str(xraudio_keyword_commit_reason_t reason);
+/// @brief Convert the xraudio_shed_level_t type to a string
+const char *     xraudio_shed_level_str(xraudio_shed_level_t level);
+/// @brief Convert the xraudio_input_process_mode_t type to a string
+const char *     xraudio_input_process_mode_str(xraudio_input_process_mode_t mode);
+/// @brief Convert the xraudio_dsp_plugin_t type to a string
+const char *     xraudio_dsp_plugin_str(xraudio_dsp_plugin_t plugin);
+/// @brief Convert the xraudio_latency_stage_t type to a string
+const char *     xraudio_latency_stage_str(xraudio_latency_stage_t stage);
 
 /// @brief Generate a wave file header
 /// @details Generate a wave header at the memory location specified by the header parameter using the specified audio_format, num_channels, sample_rate, bits_per_sample and pcm_data_size parameters.
@@ -31,6 +31,10 @@ void xraudio_atomic_int_set(xraudio_atomic_int_t *atomic, int new_val) {
 bool xraudio_atomic_compare_and_set(xraudio_atomic_int_t *atomic, int old_val, int new_val) {
     return(atomic_compare_exchange_strong(atomic, &old_val, new_val));
 }
+
+int xraudio_atomic_int_add(xraudio_atomic_int_t *atomic, int value) {
+    return(atomic_fetch_add(atomic, value));
+}
 #else
 static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -58,4 +62,13 @@ bool xraudio_atomic_compare_and_set(xraudio_atomic_int_t *atomic, int old_val, i
     pthread_mutex_unlock(&g_mutex);
     return(ret);
 }
+
+int xraudio_atomic_int_add(xraudio_atomic_int_t *atomic, int value) {
+    int ret;
+    pthread_mutex_lock(&g_mutex);
+    ret = *atomic;
+    *atomic = (int)((unsigned int)ret + (unsigned int)value); // wraps like the atomic version
+    pthread_mutex_unlock(&g_mutex);
+    return(ret);
+}
 #endif
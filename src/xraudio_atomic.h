@@ -44,5 +44,6 @@ typedef volatile int xraudio_atomic_int_t;
 int  xraudio_atomic_int_get(xraudio_atomic_int_t *atomic);
 void xraudio_atomic_int_set(xraudio_atomic_int_t *atomic, int new_val);
 bool xraudio_atomic_compare_and_set(xraudio_atomic_int_t *atomic, int old_val, int new_val);
+int  xraudio_atomic_int_add(xraudio_atomic_int_t *atomic, int value); // returns the previous value
 
 #endif
@@ -0,0 +1,295 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "xraudio.h"
+#include "xraudio_private.h"
+#include "xraudio_beam.h"
+
+#define XRAUDIO_BEAM_IDENTIFIER          (0x58524246)
+#define XRAUDIO_BEAM_TAP_QTY             (8)       // fractional delay filter length
+#define XRAUDIO_BEAM_DELAY_MAX           (48)      // maximum integer steering delay (in samples)
+#define XRAUDIO_BEAM_SPEED_OF_SOUND      (343.0)   // meters per second
+#define XRAUDIO_BEAM_ENERGY_SMOOTHING    (0.8)     // weight of the previous energy estimate
+#define XRAUDIO_BEAM_HYSTERESIS          (1.26)    // a beam must be 1 dB stronger to replace a selected beam
+#define XRAUDIO_BEAM_HISTORY_QTY         (XRAUDIO_BEAM_DELAY_MAX + XRAUDIO_BEAM_TAP_QTY - 1)
+
+typedef struct {
+   uint32_t delay;                            // integer part of the steering delay
+   float    coef[XRAUDIO_BEAM_TAP_QTY];       // fractional part of the steering delay, normalized by the mic quantity
+} xraudio_beam_filter_t;
+
+typedef struct {
+   uint32_t              identifier;
+   uint8_t               mic_qty;
+   uint8_t               beam_qty;
+   uint8_t               beam_qty_kwd;
+   uint32_t              sample_qty_max;
+   xraudio_beam_filter_t filters[XRAUDIO_BEAM_QTY_MAX][XRAUDIO_INPUT_MAX_CHANNEL_QTY];
+   float *               history[XRAUDIO_INPUT_MAX_CHANNEL_QTY]; // previous samples followed by the current frame for each mic
+   float *               beams[XRAUDIO_BEAM_QTY_MAX];
+   float                 energy[XRAUDIO_BEAM_QTY_MAX];
+   uint8_t               selected[XRAUDIO_BEAM_QTY_MAX];
+   uint8_t               selected_qty;
+} xraudio_beam_obj_t;
+
+static bool xraudio_beam_object_is_valid(xraudio_beam_obj_t *obj);
+static void xraudio_beam_filter_design(xraudio_beam_filter_t *filter, float delay);
+static void xraudio_beam_filter_apply(float * restrict beam, const float * restrict history, const xraudio_beam_filter_t *filter, uint32_t sample_qty);
+
+xraudio_beam_object_t xraudio_beam_object_create(const xraudio_beamformer_config_t *config, uint32_t sample_rate, uint32_t sample_qty_max) {
+   if(config == NULL || config->mic_qty < 2 || config->mic_qty > XRAUDIO_INPUT_MAX_CHANNEL_QTY || config->beam_qty == 0 || config->beam_qty > XRAUDIO_BEAM_QTY_MAX ||
+      config->beam_qty_kwd == 0 || config->beam_qty_kwd > config->beam_qty || sample_qty_max == 0) {
+      XLOGD_ERROR("invalid config");
+      return(NULL);
+   }
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)calloc(1, sizeof(xraudio_beam_obj_t));
+
+   if(obj == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      return(NULL);
+   }
+   obj->mic_qty        = config->mic_qty;
+   obj->beam_qty       = config->beam_qty;
+   obj->beam_qty_kwd   = config->beam_qty_kwd;
+   obj->sample_qty_max = sample_qty_max;
+
+   // Steering delays for beams evenly spaced around the array.  For a plane wave arriving from angle theta, the mic with the largest projection
+   // onto the arrival direction hears the wavefront first so it is delayed the most to align with the others.
+   for(uint8_t beam = 0; beam < obj->beam_qty; beam++) {
+      float theta = 2.0 * M_PI * beam / obj->beam_qty;
+      float projection[XRAUDIO_INPUT_MAX_CHANNEL_QTY];
+      float projection_min = 0.0;
+
+      for(uint8_t mic = 0; mic < obj->mic_qty; mic++) {
+         projection[mic] = (config->mic_positions[mic].x_mm * cosf(theta) + config->mic_positions[mic].y_mm * sinf(theta)) / 1000.0;
+         if(mic == 0 || projection[mic] < projection_min) {
+            projection_min = projection[mic];
+         }
+      }
+      for(uint8_t mic = 0; mic < obj->mic_qty; mic++) {
+         float delay = (projection[mic] - projection_min) * sample_rate / XRAUDIO_BEAM_SPEED_OF_SOUND;
+         if(delay > XRAUDIO_BEAM_DELAY_MAX) {
+            XLOGD_ERROR("mic <%u> delay <%.1f> samples exceeds max - array too large", mic, delay);
+            xraudio_beam_object_destroy(obj);
+            return(NULL);
+         }
+         xraudio_beam_filter_design(&obj->filters[beam][mic], delay);
+      }
+   }
+
+   for(uint8_t mic = 0; mic < obj->mic_qty; mic++) {
+      obj->history[mic] = (float *)calloc(XRAUDIO_BEAM_HISTORY_QTY + sample_qty_max, sizeof(float));
+      if(obj->history[mic] == NULL) {
+         XLOGD_ERROR("Out of memory.");
+         xraudio_beam_object_destroy(obj);
+         return(NULL);
+      }
+   }
+   for(uint8_t beam = 0; beam < obj->beam_qty; beam++) {
+      obj->beams[beam] = (float *)calloc(sample_qty_max, sizeof(float));
+      if(obj->beams[beam] == NULL) {
+         XLOGD_ERROR("Out of memory.");
+         xraudio_beam_object_destroy(obj);
+         return(NULL);
+      }
+   }
+   obj->identifier = XRAUDIO_BEAM_IDENTIFIER;
+   xraudio_beam_reset(obj);
+
+   XLOGD_INFO("mic qty <%u> beam qty <%u> kwd beam qty <%u>", obj->mic_qty, obj->beam_qty, obj->beam_qty_kwd);
+   return(obj);
+}
+
+void xraudio_beam_object_destroy(xraudio_beam_object_t object) {
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)object;
+   if(obj == NULL) {
+      return;
+   }
+   for(uint8_t mic = 0; mic < XRAUDIO_INPUT_MAX_CHANNEL_QTY; mic++) {
+      if(obj->history[mic] != NULL) {
+         free(obj->history[mic]);
+      }
+   }
+   for(uint8_t beam = 0; beam < XRAUDIO_BEAM_QTY_MAX; beam++) {
+      if(obj->beams[beam] != NULL) {
+         free(obj->beams[beam]);
+      }
+   }
+   obj->identifier = 0;
+   free(obj);
+}
+
+bool xraudio_beam_object_is_valid(xraudio_beam_obj_t *obj) {
+   if(obj != NULL && obj->identifier == XRAUDIO_BEAM_IDENTIFIER) {
+      return(true);
+   }
+   return(false);
+}
+
+uint8_t xraudio_beam_mic_qty_get(xraudio_beam_object_t object) {
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)object;
+   if(!xraudio_beam_object_is_valid(obj)) {
+      return(0);
+   }
+   return(obj->mic_qty);
+}
+
+uint8_t xraudio_beam_kwd_qty_get(xraudio_beam_object_t object) {
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)object;
+   if(!xraudio_beam_object_is_valid(obj)) {
+      return(0);
+   }
+   return(obj->beam_qty_kwd);
+}
+
+void xraudio_beam_reset(xraudio_beam_object_t object) {
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)object;
+   if(!xraudio_beam_object_is_valid(obj)) {
+      return;
+   }
+   for(uint8_t mic = 0; mic < obj->mic_qty; mic++) {
+      memset(obj->history[mic], 0, (XRAUDIO_BEAM_HISTORY_QTY + obj->sample_qty_max) * sizeof(float));
+   }
+   for(uint8_t beam = 0; beam < obj->beam_qty; beam++) {
+      obj->energy[beam] = 0.0;
+   }
+   for(uint8_t index = 0; index < obj->beam_qty_kwd; index++) { // spread the initial selection around the array
+      obj->selected[index] = (index * obj->beam_qty) / obj->beam_qty_kwd;
+   }
+   obj->selected_qty = obj->beam_qty_kwd;
+}
+
+// Windowed sinc fractional delay.  The filter adds a fixed latency of (XRAUDIO_BEAM_TAP_QTY / 2 - 1) samples which is common to all mics.
+void xraudio_beam_filter_design(xraudio_beam_filter_t *filter, float delay) {
+   uint32_t delay_int  = (uint32_t)delay;
+   float    delay_frac = delay - delay_int;
+   float    center     = (XRAUDIO_BEAM_TAP_QTY / 2 - 1) + delay_frac;
+   float    sum        = 0.0;
+
+   for(uint32_t tap = 0; tap < XRAUDIO_BEAM_TAP_QTY; tap++) {
+      float x      = tap - center;
+      float sinc   = (fabsf(x) < 1.0e-6) ? 1.0 : sinf(M_PI * x) / (M_PI * x);
+      float window = 0.54 + 0.46 * cosf(M_PI * x / (XRAUDIO_BEAM_TAP_QTY / 2)); // hamming window centered on the delay
+      filter->coef[tap] = sinc * window;
+      sum += filter->coef[tap];
+   }
+   for(uint32_t tap = 0; tap < XRAUDIO_BEAM_TAP_QTY; tap++) { // unity gain at DC
+      filter->coef[tap] /= sum;
+   }
+   filter->delay = delay_int;
+}
+
+// Accumulate one mic into a beam through its fractional delay filter
+void xraudio_beam_filter_apply(float * restrict beam, const float * restrict history, const xraudio_beam_filter_t *filter, uint32_t sample_qty) {
+   for(uint32_t tap = 0; tap < XRAUDIO_BEAM_TAP_QTY; tap++) {
+      const float *src  = &history[XRAUDIO_BEAM_HISTORY_QTY - filter->delay - tap];
+      float        coef = filter->coef[tap];
+      for(uint32_t i = 0; i < sample_qty; i++) {
+         beam[i] += coef * src[i];
+      }
+   }
+}
+
+void xraudio_beam_process(xraudio_beam_object_t object, const float *samples[], uint32_t sample_qty) {
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)object;
+   if(!xraudio_beam_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   if(sample_qty > obj->sample_qty_max) {
+      XLOGD_ERROR("sample qty <%u> exceeds max <%u>", sample_qty, obj->sample_qty_max);
+      return;
+   }
+   for(uint8_t mic = 0; mic < obj->mic_qty; mic++) { // Append the frame to the mic history
+      memcpy(&obj->history[mic][XRAUDIO_BEAM_HISTORY_QTY], samples[mic], sample_qty * sizeof(float));
+   }
+   float gain = 1.0 / obj->mic_qty;
+
+   for(uint8_t beam = 0; beam < obj->beam_qty; beam++) {
+      float *beam_samples = obj->beams[beam];
+      memset(beam_samples, 0, sample_qty * sizeof(float));
+
+      for(uint8_t mic = 0; mic < obj->mic_qty; mic++) {
+         xraudio_beam_filter_apply(beam_samples, obj->history[mic], &obj->filters[beam][mic], sample_qty);
+      }
+      float energy = 0.0;
+      for(uint32_t i = 0; i < sample_qty; i++) {
+         beam_samples[i] *= gain;
+         energy          += beam_samples[i] * beam_samples[i];
+      }
+      obj->energy[beam] = XRAUDIO_BEAM_ENERGY_SMOOTHING * obj->energy[beam] + (1.0 - XRAUDIO_BEAM_ENERGY_SMOOTHING) * (energy / sample_qty);
+   }
+
+   for(uint8_t mic = 0; mic < obj->mic_qty; mic++) { // Keep the most recent samples for the next frame
+      memmove(&obj->history[mic][0], &obj->history[mic][sample_qty], XRAUDIO_BEAM_HISTORY_QTY * sizeof(float));
+   }
+}
+
+const float *xraudio_beam_samples_get(xraudio_beam_object_t object, uint8_t beam) {
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)object;
+   if(!xraudio_beam_object_is_valid(obj) || beam >= obj->beam_qty) {
+      return(NULL);
+   }
+   return(obj->beams[beam]);
+}
+
+// Select the strongest beams.  A selected beam is only replaced by a beam which is clearly stronger so the keyword detector instances are not
+// switched between beams on every frame.  The selection is held while a keyword is being detected.
+uint8_t xraudio_beam_select(xraudio_beam_object_t object, uint8_t *beams, uint8_t beam_qty, bool hold) {
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)object;
+   if(!xraudio_beam_object_is_valid(obj) || beams == NULL) {
+      return(0);
+   }
+   if(!hold) {
+      for(uint8_t beam = 0; beam < obj->beam_qty; beam++) {
+         bool    is_selected = false;
+         uint8_t weakest     = 0;
+         for(uint8_t index = 0; index < obj->selected_qty; index++) {
+            if(obj->selected[index] == beam) {
+               is_selected = true;
+               break;
+            }
+            if(obj->energy[obj->selected[index]] < obj->energy[obj->selected[weakest]]) {
+               weakest = index;
+            }
+         }
+         if(!is_selected && obj->energy[beam] > XRAUDIO_BEAM_HYSTERESIS * obj->energy[obj->selected[weakest]]) {
+            obj->selected[weakest] = beam;
+         }
+      }
+   }
+   if(beam_qty > obj->selected_qty) {
+      beam_qty = obj->selected_qty;
+   }
+   memcpy(beams, obj->selected, beam_qty);
+   return(beam_qty);
+}
+
+uint16_t xraudio_beam_doa_get(xraudio_beam_object_t object, uint8_t beam) {
+   xraudio_beam_obj_t *obj = (xraudio_beam_obj_t *)object;
+   if(!xraudio_beam_object_is_valid(obj) || beam >= obj->beam_qty) {
+      return(0);
+   }
+   return((uint16_t)((360 * beam) / obj->beam_qty));
+}
@@ -0,0 +1,41 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef __XRAUDIO_BEAM_H__
+#define __XRAUDIO_BEAM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xraudio.h"
+
+typedef void * xraudio_beam_object_t;
+
+xraudio_beam_object_t xraudio_beam_object_create(const xraudio_beamformer_config_t *config, uint32_t sample_rate, uint32_t sample_qty_max);
+void                  xraudio_beam_object_destroy(xraudio_beam_object_t object);
+
+uint8_t               xraudio_beam_mic_qty_get(xraudio_beam_object_t object);
+uint8_t               xraudio_beam_kwd_qty_get(xraudio_beam_object_t object);
+void                  xraudio_beam_reset(xraudio_beam_object_t object);
+void                  xraudio_beam_process(xraudio_beam_object_t object, const float *samples[], uint32_t sample_qty);
+const float *         xraudio_beam_samples_get(xraudio_beam_object_t object, uint8_t beam);
+uint8_t               xraudio_beam_select(xraudio_beam_object_t object, uint8_t *beams, uint8_t beam_qty, bool hold);
+uint16_t              xraudio_beam_doa_get(xraudio_beam_object_t object, uint8_t beam);
+
+#endif
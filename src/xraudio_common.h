@@ -43,11 +43,14 @@
 /// @brief Macros for constant values
 /// @details The xraudio library provides macros for some parameters which may change in the future.
 
-#define XRAUDIO_INPUT_FRAME_PERIOD             (20)                                ///< input frame period, milliseconds
+#define XRAUDIO_INPUT_FRAME_PERIOD             (20)                                ///< default and maximum input frame period, milliseconds
+#define XRAUDIO_INPUT_FRAME_PERIOD_MIN         (5)                                 ///< minimum input frame period, milliseconds
 #define XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE      (16000)                             ///< input sample rate per channel, Hz
 #define XRAUDIO_INPUT_DEFAULT_SAMPLE_SIZE      (2)                                 ///< Default input sample size, bytes
 #define XRAUDIO_INPUT_DEFAULT_CHANNEL_QTY      (1)                                 ///< Input channel quantity
-#define XRAUDIO_INPUT_MAX_CHANNEL_QTY          (4)                                 ///< Maximum input channel quantity
+#ifndef XRAUDIO_INPUT_MAX_CHANNEL_QTY
+#define XRAUDIO_INPUT_MAX_CHANNEL_QTY          (4)                                 ///< Maximum input channel quantity (set at build time for larger arrays, the hal must use the same value)
+#endif
 #define XRAUDIO_INPUT_MAX_CHANNEL_QTY_EC_REF   (6)                                 ///< Maximum echo canceller reference channel quantity
 
 #define XRAUDIO_OUTPUT_FRAME_PERIOD            (20)                                ///< Output frame period in milliseconds
@@ -88,6 +91,7 @@ typedef uint32_t xraudio_devices_input_t;
 #define XRAUDIO_DEVICE_INPUT_QUAD              (0x0004)
 #define XRAUDIO_DEVICE_INPUT_HFP               (0x0008)
 #define XRAUDIO_DEVICE_INPUT_MIC_TAP           (0x0010)
+#define XRAUDIO_DEVICE_INPUT_ARRAY             (0x10000) ///< Microphone array, the HAL reports the quantity of microphones when it is opened
 
 #define XRAUDIO_DEVICE_INPUT_EC_REF_NONE       (0x0000)
 #define XRAUDIO_DEVICE_INPUT_EC_REF_MONO       (0x0020)
@@ -98,7 +102,7 @@ typedef uint32_t xraudio_devices_input_t;
 #define XRAUDIO_DEVICE_INPUT_FF                (0x0200)
 #define XRAUDIO_DEVICE_INPUT_INVALID           (0xFFFF)
 
-#define XRAUDIO_DEVICE_INPUT_LOCAL_GET(x)      (x & 0x001F)
+#define XRAUDIO_DEVICE_INPUT_LOCAL_GET(x)      (x & 0x1001F)
 #define XRAUDIO_DEVICE_INPUT_EC_REF_GET(x)     (x & 0x00E0)
 #define XRAUDIO_DEVICE_INPUT_EXTERNAL_GET(x)   (x & 0xFF00)
 #define XRAUDIO_DEVICE_INPUT_CONTAINS(x, y)    (x & y)
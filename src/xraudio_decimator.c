@@ -0,0 +1,212 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "xraudio.h"
+#include "xraudio_private.h"
+#include "xraudio_decimator.h"
+
+// Polyphase decimator.  The anti-alias filter is a linear phase FIR which is only evaluated at the retained output samples, so each output
+// sample costs one tap per polyphase branch for each of the factor branches and the discarded samples cost nothing.  Each channel keeps the
+// last tap_qty - 1 input samples ahead of the new frame in one contiguous window, so every output is a unit stride dot product with no wrap.
+// The converted input frame stays in the window and serves as the wideband tap.
+
+#define XRAUDIO_DECIMATOR_IDENTIFIER    (0x58524443)
+#define XRAUDIO_DECIMATOR_FACTOR_MAX    (3)
+#define XRAUDIO_DECIMATOR_PHASE_TAP_QTY (32)      // taps per polyphase branch
+#define XRAUDIO_DECIMATOR_CUTOFF        (0.88)    // cutoff as a fraction of the output nyquist frequency
+#define XRAUDIO_DECIMATOR_TAP_QTY_MAX   (XRAUDIO_DECIMATOR_PHASE_TAP_QTY * XRAUDIO_DECIMATOR_FACTOR_MAX)
+
+typedef struct {
+   uint32_t identifier;
+   uint32_t factor;
+   uint32_t tap_qty;
+   uint8_t  chan_qty_max;
+   uint32_t sample_qty_max;
+   uint32_t sample_qty_last; // input samples per channel in the most recent frame
+   uint32_t window_size;     // history plus one frame (in samples)
+   float    taps[XRAUDIO_DECIMATOR_TAP_QTY_MAX];
+   float *  window;          // chan_qty_max windows of window_size samples
+} xraudio_decimator_obj_t;
+
+static bool xraudio_decimator_object_is_valid(xraudio_decimator_obj_t *obj);
+static void xraudio_decimator_filter(xraudio_decimator_obj_t *obj, float * restrict window, uint32_t sample_qty_out, float * restrict samples_out);
+
+xraudio_decimator_object_t xraudio_decimator_object_create(uint32_t factor, uint8_t chan_qty_max, uint32_t sample_qty_max) {
+   if(factor < 2 || factor > XRAUDIO_DECIMATOR_FACTOR_MAX || chan_qty_max == 0 || sample_qty_max == 0 || (sample_qty_max % factor) != 0) {
+      XLOGD_ERROR("invalid params factor <%u> chan qty <%u> sample qty <%u>", factor, chan_qty_max, sample_qty_max);
+      return(NULL);
+   }
+   xraudio_decimator_obj_t *obj = (xraudio_decimator_obj_t *)calloc(1, sizeof(xraudio_decimator_obj_t));
+
+   if(obj == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      return(NULL);
+   }
+   obj->factor         = factor;
+   obj->tap_qty        = XRAUDIO_DECIMATOR_PHASE_TAP_QTY * factor;
+   obj->chan_qty_max   = chan_qty_max;
+   obj->sample_qty_max = sample_qty_max;
+   obj->window_size    = obj->tap_qty - 1 + sample_qty_max;
+   obj->window         = (float *)calloc((size_t)chan_qty_max * obj->window_size, sizeof(float));
+
+   if(obj->window == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      free(obj);
+      return(NULL);
+   }
+
+   // Blackman windowed sinc normalized to unity gain at DC
+   float cutoff = 0.5 * XRAUDIO_DECIMATOR_CUTOFF / factor; // cycles per input sample
+   float center = (obj->tap_qty - 1) / 2.0;
+   float sum    = 0.0;
+   for(uint32_t index = 0; index < obj->tap_qty; index++) {
+      float x      = index - center;
+      float sinc   = (x == 0.0) ? 2.0 * cutoff : sinf(2.0 * M_PI * cutoff * x) / (M_PI * x);
+      float window = 0.42 - 0.5 * cosf(2.0 * M_PI * index / (obj->tap_qty - 1)) + 0.08 * cosf(4.0 * M_PI * index / (obj->tap_qty - 1));
+      obj->taps[index] = sinc * window;
+      sum += obj->taps[index];
+   }
+   for(uint32_t index = 0; index < obj->tap_qty; index++) {
+      obj->taps[index] /= sum;
+   }
+   obj->identifier = XRAUDIO_DECIMATOR_IDENTIFIER;
+
+   XLOGD_INFO("factor <%u> taps <%u> chan qty max <%u> delay <%u> samples", factor, obj->tap_qty, chan_qty_max, (obj->tap_qty - 1) / 2);
+   return(obj);
+}
+
+void xraudio_decimator_object_destroy(xraudio_decimator_object_t object) {
+   xraudio_decimator_obj_t *obj = (xraudio_decimator_obj_t *)object;
+   if(!xraudio_decimator_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   obj->identifier = 0;
+   free(obj->window);
+   free(obj);
+}
+
+bool xraudio_decimator_object_is_valid(xraudio_decimator_obj_t *obj) {
+   if(obj != NULL && obj->identifier == XRAUDIO_DECIMATOR_IDENTIFIER) {
+      return(true);
+   }
+   return(false);
+}
+
+uint32_t xraudio_decimator_factor_get(xraudio_decimator_object_t object) {
+   xraudio_decimator_obj_t *obj = (xraudio_decimator_obj_t *)object;
+   if(!xraudio_decimator_object_is_valid(obj)) {
+      return(1);
+   }
+   return(obj->factor);
+}
+
+void xraudio_decimator_reset(xraudio_decimator_object_t object) {
+   xraudio_decimator_obj_t *obj = (xraudio_decimator_obj_t *)object;
+   if(!xraudio_decimator_object_is_valid(obj)) {
+      return;
+   }
+   memset(obj->window, 0, (size_t)obj->chan_qty_max * obj->window_size * sizeof(float));
+   obj->sample_qty_last = 0;
+}
+
+// Decimates chan_qty planar channels of sample_qty_in samples each from buffer_in to buffer_out (sample_qty_in / factor samples per channel).
+bool xraudio_decimator_process(xraudio_decimator_object_t object, const void *buffer_in, void *buffer_out, uint8_t chan_qty, uint32_t sample_qty_in, uint8_t sample_size) {
+   xraudio_decimator_obj_t *obj = (xraudio_decimator_obj_t *)object;
+   if(!xraudio_decimator_object_is_valid(obj)) {
+      return(false);
+   }
+   if(chan_qty > obj->chan_qty_max || sample_qty_in == 0 || sample_qty_in > obj->sample_qty_max || (sample_qty_in % obj->factor) != 0 || (sample_size != 2 && sample_size != 4)) {
+      XLOGD_ERROR("invalid params chan qty <%u> sample qty <%u> sample size <%u>", chan_qty, sample_qty_in, sample_size);
+      return(false);
+   }
+   uint32_t history_qty    = obj->tap_qty - 1;
+   uint32_t sample_qty_out = sample_qty_in / obj->factor;
+   float    samples_out[sample_qty_out];
+
+   for(uint8_t chan = 0; chan < chan_qty; chan++) {
+      float *window = &obj->window[chan * obj->window_size];
+      float *frame  = &window[history_qty];
+
+      if(sample_size == 4) {
+         const int32_t *in  = &((const int32_t *)buffer_in)[chan * sample_qty_in];
+         int32_t *      out = &((int32_t *)buffer_out)[chan * sample_qty_out];
+         for(uint32_t index = 0; index < sample_qty_in; index++) {
+            frame[index] = in[index];
+         }
+         xraudio_decimator_filter(obj, window, sample_qty_out, samples_out);
+         for(uint32_t index = 0; index < sample_qty_out; index++) {
+            float sample = samples_out[index];
+            out[index] = (sample >= 2147483520.0) ? INT32_MAX : (sample <= -2147483648.0) ? INT32_MIN : (int32_t)lrintf(sample);
+         }
+      } else {
+         const int16_t *in  = &((const int16_t *)buffer_in)[chan * sample_qty_in];
+         int16_t *      out = &((int16_t *)buffer_out)[chan * sample_qty_out];
+         for(uint32_t index = 0; index < sample_qty_in; index++) {
+            frame[index] = in[index];
+         }
+         xraudio_decimator_filter(obj, window, sample_qty_out, samples_out);
+         for(uint32_t index = 0; index < sample_qty_out; index++) {
+            float sample = samples_out[index];
+            out[index] = (sample >= 32767.0) ? INT16_MAX : (sample <= -32768.0) ? INT16_MIN : (int16_t)lrintf(sample);
+         }
+      }
+      // Keep the tail of this frame as the history for the next one (the frame itself is left in place for the wideband tap)
+      memmove(window, &window[sample_qty_in], history_qty * sizeof(float));
+   }
+   obj->sample_qty_last = sample_qty_in;
+   return(true);
+}
+
+// The taps are symmetric so the window is used in place without reversing them.  Two accumulators of four lanes each hide the multiply-add latency.
+void xraudio_decimator_filter(xraudio_decimator_obj_t *obj, float * restrict window, uint32_t sample_qty_out, float * restrict samples_out) {
+   const float * restrict taps = obj->taps;
+   uint32_t tap_qty = obj->tap_qty;
+   uint32_t factor  = obj->factor;
+
+   for(uint32_t index = 0; index < sample_qty_out; index++) {
+      const float * restrict x = &window[index * factor];
+      xraudio_f32x4_t acc_0 = xraudio_f32x4_set(0.0);
+      xraudio_f32x4_t acc_1 = xraudio_f32x4_set(0.0);
+      uint32_t tap = 0;
+      for(; tap + 8 <= tap_qty; tap += 8) {
+         acc_0 = xraudio_f32x4_madd(acc_0, xraudio_f32x4_load(&taps[tap]),     xraudio_f32x4_load(&x[tap]));
+         acc_1 = xraudio_f32x4_madd(acc_1, xraudio_f32x4_load(&taps[tap + 4]), xraudio_f32x4_load(&x[tap + 4]));
+      }
+      float acc = xraudio_f32x4_sum(xraudio_f32x4_add(acc_0, acc_1));
+      for(; tap < tap_qty; tap++) {
+         acc += taps[tap] * x[tap];
+      }
+      samples_out[index] = acc;
+   }
+}
+
+// Returns the most recent frame of channel chan at the input rate, or NULL if no frame has been processed.
+const float *xraudio_decimator_input_get(xraudio_decimator_object_t object, uint8_t chan) {
+   xraudio_decimator_obj_t *obj = (xraudio_decimator_obj_t *)object;
+   if(!xraudio_decimator_object_is_valid(obj) || chan >= obj->chan_qty_max || obj->sample_qty_last == 0) {
+      return(NULL);
+   }
+   return(&obj->window[chan * obj->window_size + obj->tap_qty - 1]);
+}
@@ -0,0 +1,38 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef __XRAUDIO_DECIMATOR_H__
+#define __XRAUDIO_DECIMATOR_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xraudio.h"
+
+typedef void * xraudio_decimator_object_t;
+
+xraudio_decimator_object_t xraudio_decimator_object_create(uint32_t factor, uint8_t chan_qty_max, uint32_t sample_qty_max);
+void                       xraudio_decimator_object_destroy(xraudio_decimator_object_t object);
+
+uint32_t                   xraudio_decimator_factor_get(xraudio_decimator_object_t object);
+void                       xraudio_decimator_reset(xraudio_decimator_object_t object);
+bool                       xraudio_decimator_process(xraudio_decimator_object_t object, const void *buffer_in, void *buffer_out, uint8_t chan_qty, uint32_t sample_qty_in, uint8_t sample_size);
+const float *              xraudio_decimator_input_get(xraudio_decimator_object_t object, uint8_t chan);
+
+#endif
@@ -96,6 +96,28 @@ void                 xraudio_dga_update(xraudio_dga_object_t object, uint8_t *pc
 /// @param[in]    sample_qty
 void                 xraudio_dga_apply(xraudio_dga_object_t object, float *samples, uint32_t sample_qty);
 
+/// @brief Retrieve the size of an xraudio DGA state snapshot
+/// @details Retrieves the size of the buffer needed to save the adapted state of the dynamic gain (current gain, level estimate, etc).  Only called when xraudio is built with XRAUDIO_DSP_STATE_ENABLED.
+/// @param[in] object Reference to an xraudio DGA object.
+/// @return The function returns the size of the snapshot in bytes or zero if the state cannot be saved.
+uint32_t             xraudio_dga_snapshot_size(xraudio_dga_object_t object);
+
+/// @brief Save an xraudio DGA state snapshot
+/// @details Saves the adapted state of the dynamic gain (current gain, level estimate, etc) so it can be restored after the DGA is reinitialized.
+/// @param[in]  object Reference to an xraudio DGA object.
+/// @param[out] state  Pointer to the snapshot buffer.
+/// @param[in]  size   Size of the snapshot buffer in bytes.
+/// @return The function returns true for success and false for failure.
+bool                 xraudio_dga_snapshot_save(xraudio_dga_object_t object, void *state, uint32_t size);
+
+/// @brief Restore an xraudio DGA state snapshot
+/// @details Restores a snapshot saved by xraudio_dga_snapshot_save.  The snapshot must be rejected if it does not match the current configuration of the DGA.
+/// @param[in] object Reference to an xraudio DGA object.
+/// @param[in] state  Pointer to the snapshot buffer.
+/// @param[in] size   Size of the snapshot in bytes.
+/// @return The function returns true for success and false for failure.
+bool                 xraudio_dga_snapshot_restore(xraudio_dga_object_t object, const void *state, uint32_t size);
+
 /// @}
 
 #ifdef __cplusplus
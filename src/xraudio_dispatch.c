@@ -0,0 +1,401 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sched.h>
+#include "xraudio.h"
+#include "xraudio_private.h"
+#include "xraudio_atomic.h"
+#include "xraudio_dispatch.h"
+
+#define XRAUDIO_DISPATCH_IDENTIFIER (0x58524443)
+
+#if (XRAUDIO_DISPATCH_EVENT_QTY_MAX & (XRAUDIO_DISPATCH_EVENT_QTY_MAX - 1)) != 0
+#error XRAUDIO_DISPATCH_EVENT_QTY_MAX must be a power of 2
+#endif
+
+typedef enum {
+   XRAUDIO_DISPATCH_EVENT_TYPE_AUDIO_IN  = 0,
+   XRAUDIO_DISPATCH_EVENT_TYPE_AUDIO_OUT = 1,
+   XRAUDIO_DISPATCH_EVENT_TYPE_KEYWORD   = 2,
+   XRAUDIO_DISPATCH_EVENT_TYPE_GOVERNOR  = 3,
+   XRAUDIO_DISPATCH_EVENT_TYPE_TERMINATE = 4,
+} xraudio_dispatch_event_type_t;
+
+typedef struct {
+   audio_in_callback_t               callback;
+   xraudio_devices_input_t           source;
+   audio_in_callback_event_t         event;
+   bool                              has_param;
+   union {
+      xraudio_audio_stats_t          stats;
+      xraudio_stream_keyword_info_t  kwd_info;
+   } param;
+   void *                            user_param;
+} xraudio_dispatch_audio_in_t;
+
+typedef struct {
+   audio_out_callback_t              callback;
+   audio_out_callback_event_t        event;
+   void *                            param;
+} xraudio_dispatch_audio_out_t;
+
+typedef struct {
+   keyword_callback_t                callback;
+   xraudio_devices_input_t           source;
+   keyword_callback_event_t          event;
+   void *                            param;
+   bool                              has_result;
+   xraudio_keyword_detector_result_t result;
+   xraudio_input_format_t            format;
+} xraudio_dispatch_keyword_t;
+
+typedef struct {
+   xraudio_governor_callback_t       callback;
+   xraudio_shed_level_t              level_prev;
+   xraudio_shed_level_t              level;
+   void *                            param;
+} xraudio_dispatch_governor_t;
+
+typedef struct {
+   xraudio_dispatch_event_type_t     type;
+   rdkx_timestamp_t                  timestamp; // time at which the event was queued
+   union {
+      xraudio_dispatch_audio_in_t    audio_in;
+      xraudio_dispatch_audio_out_t   audio_out;
+      xraudio_dispatch_keyword_t     keyword;
+      xraudio_dispatch_governor_t    governor;
+   } data;
+} xraudio_dispatch_event_t;
+
+typedef struct {
+   xraudio_atomic_int_t              sequence; // slot is writable when equal to the enqueue position, readable when equal to the position + 1
+   xraudio_dispatch_event_t          event;
+} xraudio_dispatch_slot_t;
+
+typedef struct {
+   uint32_t                          identifier;
+   xraudio_dispatch_slot_t           slots[XRAUDIO_DISPATCH_EVENT_QTY_MAX];
+   xraudio_atomic_int_t              pos_enqueue;  // shared by the producers
+   unsigned int                      pos_dequeue;  // owned by the dispatch thread
+   sem_t                             semaphore;    // count of events ready to be dispatched
+   xraudio_thread_t                  thread;
+   pthread_mutex_t                   mutex_stats;
+   xraudio_callback_dispatch_stats_t stats;
+   xraudio_atomic_int_t              events_inline;
+} xraudio_dispatch_obj_t;
+
+static bool  xraudio_dispatch_object_is_valid(xraudio_dispatch_obj_t *obj);
+static bool  xraudio_dispatch_enqueue(xraudio_dispatch_obj_t *obj, xraudio_dispatch_event_t *event);
+static void  xraudio_dispatch_event_invoke(xraudio_dispatch_event_t *event);
+static void *xraudio_dispatch_thread(void *param);
+
+xraudio_dispatch_object_t xraudio_dispatch_object_create(void) {
+   xraudio_dispatch_obj_t *obj = (xraudio_dispatch_obj_t *)malloc(sizeof(xraudio_dispatch_obj_t));
+
+   if(obj == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      return(NULL);
+   }
+   memset(obj, 0, sizeof(*obj));
+
+   for(unsigned int index = 0; index < XRAUDIO_DISPATCH_EVENT_QTY_MAX; index++) {
+      xraudio_atomic_int_set(&obj->slots[index].sequence, (int)index);
+   }
+   xraudio_atomic_int_set(&obj->pos_enqueue, 0);
+   xraudio_atomic_int_set(&obj->events_inline, 0);
+   obj->pos_dequeue = 0;
+   sem_init(&obj->semaphore, 0, 0);
+   pthread_mutex_init(&obj->mutex_stats, NULL);
+   obj->identifier = XRAUDIO_DISPATCH_IDENTIFIER;
+
+   if(!xraudio_thread_create(&obj->thread, "xraudio_dispatch", xraudio_dispatch_thread, obj)) {
+      XLOGD_ERROR("unable to launch thread");
+      sem_destroy(&obj->semaphore);
+      pthread_mutex_destroy(&obj->mutex_stats);
+      obj->identifier = 0;
+      free(obj);
+      return(NULL);
+   }
+   return(obj);
+}
+
+void xraudio_dispatch_object_destroy(xraudio_dispatch_object_t object) {
+   xraudio_dispatch_obj_t *obj = (xraudio_dispatch_obj_t *)object;
+   if(!xraudio_dispatch_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   if(pthread_equal(pthread_self(), obj->thread.id)) {
+      XLOGD_ERROR("cannot be destroyed from a callback");
+      return;
+   }
+
+   // The terminate event is queued behind any pending events so they are all delivered first
+   xraudio_dispatch_event_t event;
+   event.type = XRAUDIO_DISPATCH_EVENT_TYPE_TERMINATE;
+   while(!xraudio_dispatch_enqueue(obj, &event)) {
+      usleep(1000);
+   }
+   xraudio_thread_join(&obj->thread);
+
+   xraudio_callback_dispatch_stats_t stats = {0};
+   xraudio_dispatch_stats_get(obj, &stats);
+   XLOGD_INFO("events dispatched <%u> inline <%u> wait max <%u> us callback max <%u> us", stats.events_dispatched, stats.events_inline, stats.wait_max_us, stats.callback_max_us);
+
+   sem_destroy(&obj->semaphore);
+   pthread_mutex_destroy(&obj->mutex_stats);
+   obj->identifier = 0;
+   free(obj);
+}
+
+bool xraudio_dispatch_object_is_valid(xraudio_dispatch_obj_t *obj) {
+   if(obj != NULL && obj->identifier == XRAUDIO_DISPATCH_IDENTIFIER) {
+      return(true);
+   }
+   return(false);
+}
+
+void xraudio_dispatch_audio_in(xraudio_dispatch_object_t object, audio_in_callback_t callback, xraudio_devices_input_t source, audio_in_callback_event_t event, void *event_param, void *user_param) {
+   xraudio_dispatch_obj_t *obj = (xraudio_dispatch_obj_t *)object;
+   if(callback == NULL) {
+      return;
+   }
+   if(obj == NULL) {
+      (*callback)(source, event, event_param, user_param);
+      return;
+   }
+   xraudio_dispatch_event_t dispatch_event;
+   xraudio_dispatch_audio_in_t *audio_in = &dispatch_event.data.audio_in;
+
+   dispatch_event.type  = XRAUDIO_DISPATCH_EVENT_TYPE_AUDIO_IN;
+   audio_in->callback   = callback;
+   audio_in->source     = source;
+   audio_in->event      = event;
+   audio_in->has_param  = (event_param != NULL);
+   audio_in->user_param = user_param;
+   if(event_param != NULL) { // Copy the event parameter since it is only valid for the duration of the call
+      if(event == AUDIO_IN_CALLBACK_EVENT_STREAM_KWD_INFO) {
+         audio_in->param.kwd_info = *((xraudio_stream_keyword_info_t *)event_param);
+      } else {
+         audio_in->param.stats    = *((xraudio_audio_stats_t *)event_param);
+      }
+   }
+
+   if(!xraudio_dispatch_enqueue(obj, &dispatch_event)) {
+      XLOGD_WARN("queue full, invoking inline");
+      xraudio_atomic_int_add(&obj->events_inline, 1);
+      (*callback)(source, event, event_param, user_param);
+   }
+}
+
+void xraudio_dispatch_audio_out(xraudio_dispatch_object_t object, audio_out_callback_t callback, audio_out_callback_event_t event, void *param) {
+   xraudio_dispatch_obj_t *obj = (xraudio_dispatch_obj_t *)object;
+   if(callback == NULL) {
+      return;
+   }
+   if(obj == NULL) {
+      (*callback)(event, param);
+      return;
+   }
+   xraudio_dispatch_event_t dispatch_event;
+
+   dispatch_event.type                     = XRAUDIO_DISPATCH_EVENT_TYPE_AUDIO_OUT;
+   dispatch_event.data.audio_out.callback  = callback;
+   dispatch_event.data.audio_out.event     = event;
+   dispatch_event.data.audio_out.param     = param;
+
+   if(!xraudio_dispatch_enqueue(obj, &dispatch_event)) {
+      XLOGD_WARN("queue full, invoking inline");
+      xraudio_atomic_int_add(&obj->events_inline, 1);
+      (*callback)(event, param);
+   }
+}
+
+void xraudio_dispatch_keyword(xraudio_dispatch_object_t object, keyword_callback_t callback, xraudio_devices_input_t source, keyword_callback_event_t event, void *param, xraudio_keyword_detector_result_t *detector_result, xraudio_input_format_t format) {
+   xraudio_dispatch_obj_t *obj = (xraudio_dispatch_obj_t *)object;
+   if(callback == NULL) {
+      return;
+   }
+   if(obj == NULL) {
+      callback(source, event, param, detector_result, format);
+      return;
+   }
+   xraudio_dispatch_event_t dispatch_event;
+   xraudio_dispatch_keyword_t *keyword = &dispatch_event.data.keyword;
+
+   dispatch_event.type  = XRAUDIO_DISPATCH_EVENT_TYPE_KEYWORD;
+   keyword->callback    = callback;
+   keyword->source      = source;
+   keyword->event       = event;
+   keyword->param       = param;
+   keyword->has_result  = (detector_result != NULL);
+   keyword->format      = format;
+   if(detector_result != NULL) { // Copy the result since the detector reuses it for the next session
+      keyword->result = *detector_result;
+   }
+
+   if(!xraudio_dispatch_enqueue(obj, &dispatch_event)) {
+      XLOGD_WARN("queue full, invoking inline");
+      xraudio_atomic_int_add(&obj->events_inline, 1);
+      callback(source, event, param, detector_result, format);
+   }
+}
+
+void xraudio_dispatch_governor(xraudio_dispatch_object_t object, xraudio_governor_callback_t callback, xraudio_shed_level_t level_prev, xraudio_shed_level_t level, void *param) {
+   xraudio_dispatch_obj_t *obj = (xraudio_dispatch_obj_t *)object;
+   if(callback == NULL) {
+      return;
+   }
+   if(obj == NULL) {
+      (*callback)(level_prev, level, param);
+      return;
+   }
+   xraudio_dispatch_event_t dispatch_event;
+
+   dispatch_event.type                     = XRAUDIO_DISPATCH_EVENT_TYPE_GOVERNOR;
+   dispatch_event.data.governor.callback   = callback;
+   dispatch_event.data.governor.level_prev = level_prev;
+   dispatch_event.data.governor.level      = level;
+   dispatch_event.data.governor.param      = param;
+
+   if(!xraudio_dispatch_enqueue(obj, &dispatch_event)) {
+      XLOGD_WARN("queue full, invoking inline");
+      xraudio_atomic_int_add(&obj->events_inline, 1);
+      (*callback)(level_prev, level, param);
+   }
+}
+
+void xraudio_dispatch_stats_get(xraudio_dispatch_object_t object, xraudio_callback_dispatch_stats_t *stats) {
+   xraudio_dispatch_obj_t *obj = (xraudio_dispatch_obj_t *)object;
+   if(!xraudio_dispatch_object_is_valid(obj) || stats == NULL) {
+      return;
+   }
+   pthread_mutex_lock(&obj->mutex_stats);
+   *stats = obj->stats;
+   pthread_mutex_unlock(&obj->mutex_stats);
+   stats->events_inline = (uint32_t)xraudio_atomic_int_get(&obj->events_inline);
+}
+
+// Bounded multi-producer queue.  Each slot's sequence number tells a producer whether the slot is free for its position, so producers
+// only contend on the enqueue position and never block.
+bool xraudio_dispatch_enqueue(xraudio_dispatch_obj_t *obj, xraudio_dispatch_event_t *event) {
+   xraudio_dispatch_slot_t *slot;
+   unsigned int pos = (unsigned int)xraudio_atomic_int_get(&obj->pos_enqueue);
+
+   rdkx_timestamp_get(&event->timestamp);
+
+   do {
+      slot = &obj->slots[pos & (XRAUDIO_DISPATCH_EVENT_QTY_MAX - 1)];
+      int diff = (int)((unsigned int)xraudio_atomic_int_get(&slot->sequence) - pos);
+      if(diff < 0) { // queue is full
+         return(false);
+      }
+      if(diff == 0 && xraudio_atomic_compare_and_set(&obj->pos_enqueue, (int)pos, (int)(pos + 1))) {
+         break;
+      }
+      pos = (unsigned int)xraudio_atomic_int_get(&obj->pos_enqueue);
+   } while(1);
+
+   slot->event = *event;
+   xraudio_atomic_int_set(&slot->sequence, (int)(pos + 1));
+   sem_post(&obj->semaphore);
+   return(true);
+}
+
+void xraudio_dispatch_event_invoke(xraudio_dispatch_event_t *event) {
+   switch(event->type) {
+      case XRAUDIO_DISPATCH_EVENT_TYPE_AUDIO_IN: {
+         xraudio_dispatch_audio_in_t *audio_in = &event->data.audio_in;
+         (*audio_in->callback)(audio_in->source, audio_in->event, audio_in->has_param ? &audio_in->param : NULL, audio_in->user_param);
+         break;
+      }
+      case XRAUDIO_DISPATCH_EVENT_TYPE_AUDIO_OUT: {
+         (*event->data.audio_out.callback)(event->data.audio_out.event, event->data.audio_out.param);
+         break;
+      }
+      case XRAUDIO_DISPATCH_EVENT_TYPE_KEYWORD: {
+         xraudio_dispatch_keyword_t *keyword = &event->data.keyword;
+         keyword->callback(keyword->source, keyword->event, keyword->param, keyword->has_result ? &keyword->result : NULL, keyword->format);
+         break;
+      }
+      case XRAUDIO_DISPATCH_EVENT_TYPE_GOVERNOR: {
+         xraudio_dispatch_governor_t *governor = &event->data.governor;
+         (*governor->callback)(governor->level_prev, governor->level, governor->param);
+         break;
+      }
+      default: {
+         break;
+      }
+   }
+}
+
+void *xraudio_dispatch_thread(void *param) {
+   xraudio_dispatch_obj_t *obj = (xraudio_dispatch_obj_t *)param;
+   bool running = true;
+
+   while(running) {
+      if(sem_wait(&obj->semaphore) != 0) {
+         if(errno != EINTR) {
+            XLOGD_ERROR("sem_wait <%s>", strerror(errno));
+         }
+         continue;
+      }
+
+      xraudio_dispatch_slot_t *slot = &obj->slots[obj->pos_dequeue & (XRAUDIO_DISPATCH_EVENT_QTY_MAX - 1)];
+      while(xraudio_atomic_int_get(&slot->sequence) != (int)(obj->pos_dequeue + 1)) { // published before the semaphore is posted
+         sched_yield();
+      }
+      xraudio_dispatch_event_t event = slot->event;
+      xraudio_atomic_int_set(&slot->sequence, (int)(obj->pos_dequeue + XRAUDIO_DISPATCH_EVENT_QTY_MAX));
+      obj->pos_dequeue++;
+
+      if(event.type == XRAUDIO_DISPATCH_EVENT_TYPE_TERMINATE) {
+         running = false;
+         continue;
+      }
+
+      uint32_t wait_us = (uint32_t)rdkx_timestamp_since_us(event.timestamp);
+      rdkx_timestamp_t begin;
+      rdkx_timestamp_get(&begin);
+
+      xraudio_dispatch_event_invoke(&event);
+
+      uint32_t callback_us = (uint32_t)rdkx_timestamp_since_us(begin);
+      xraudio_latency_record(XRAUDIO_LATENCY_STAGE_CALLBACK, callback_us);
+      XRAUDIO_TRACE(XRAUDIO_TRACE_EVENT_CALLBACK, event.type, ((uint64_t)begin.tv_sec * 1000000) + (begin.tv_nsec / 1000), callback_us);
+
+      pthread_mutex_lock(&obj->mutex_stats);
+      obj->stats.events_dispatched++;
+      obj->stats.wait_total_us += wait_us;
+      if(wait_us > obj->stats.wait_max_us) {
+         obj->stats.wait_max_us = wait_us;
+      }
+      if(callback_us > obj->stats.callback_max_us) {
+         obj->stats.callback_max_us = callback_us;
+      }
+      pthread_mutex_unlock(&obj->mutex_stats);
+   }
+   return(NULL);
+}
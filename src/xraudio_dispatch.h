@@ -0,0 +1,42 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef __XRAUDIO_DISPATCH_H__
+#define __XRAUDIO_DISPATCH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xraudio.h"
+
+#define XRAUDIO_DISPATCH_EVENT_QTY_MAX (32) // must be a power of 2
+
+typedef void * xraudio_dispatch_object_t;
+
+// A NULL dispatch object invokes the callback inline on the calling thread
+xraudio_dispatch_object_t xraudio_dispatch_object_create(void);
+void                      xraudio_dispatch_object_destroy(xraudio_dispatch_object_t object);
+
+void                      xraudio_dispatch_audio_in(xraudio_dispatch_object_t object, audio_in_callback_t callback, xraudio_devices_input_t source, audio_in_callback_event_t event, void *event_param, void *user_param);
+void                      xraudio_dispatch_audio_out(xraudio_dispatch_object_t object, audio_out_callback_t callback, audio_out_callback_event_t event, void *param);
+void                      xraudio_dispatch_governor(xraudio_dispatch_object_t object, xraudio_governor_callback_t callback, xraudio_shed_level_t level_prev, xraudio_shed_level_t level, void *param);
+void                      xraudio_dispatch_keyword(xraudio_dispatch_object_t object, keyword_callback_t callback, xraudio_devices_input_t source, keyword_callback_event_t event, void *param, xraudio_keyword_detector_result_t *detector_result, xraudio_input_format_t format);
+void                      xraudio_dispatch_stats_get(xraudio_dispatch_object_t object, xraudio_callback_dispatch_stats_t *stats);
+
+#endif
@@ -0,0 +1,319 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "xraudio.h"
+#include "xraudio_private.h"
+#include "xraudio_doa.h"
+
+// Direction of arrival estimator.  The generalized cross correlation with phase transform (GCC-PHAT) is calculated for each microphone pair
+// and the steered response power (SRP) is evaluated at candidate angles around the array by summing each pair's correlation at the lag
+// expected for that angle.  The estimate is only updated while the frame energy is well above the tracked noise floor.
+
+#define XRAUDIO_DOA_IDENTIFIER        (0x5852444F)
+#define XRAUDIO_DOA_FFT_SIZE_MAX      (1024)    // 20 ms frame at 48 kHz plus the maximum lag
+#define XRAUDIO_DOA_ANGLE_QTY         (72)      // 5 degree resolution
+#define XRAUDIO_DOA_PAIR_QTY_MAX      ((XRAUDIO_INPUT_MAX_CHANNEL_QTY * (XRAUDIO_INPUT_MAX_CHANNEL_QTY - 1)) / 2)
+#define XRAUDIO_DOA_SPEED_OF_SOUND    (343.0)   // meters per second
+#define XRAUDIO_DOA_ACTIVITY_RATIO    (4.0)     // frame rms must be 12 dB above the noise floor
+#define XRAUDIO_DOA_NOISE_FLOOR_RISE  (1.005)   // per frame rise of the noise floor tracker (about 1.3 dB per second)
+#define XRAUDIO_DOA_NOISE_FLOOR_MIN   (1.0e-5)  // -100 dBFS
+#define XRAUDIO_DOA_SMOOTHING         (0.7)     // weight of the previous direction
+
+typedef struct {
+   float re;
+   float im;
+} xraudio_doa_complex_t;
+
+typedef struct {
+   uint8_t mic_a;
+   uint8_t mic_b;
+} xraudio_doa_pair_t;
+
+typedef struct {
+   uint32_t              identifier;
+   uint8_t               mic_qty;
+   uint8_t               pair_qty;
+   uint32_t              fft_size;
+   uint32_t              fft_bits;
+   xraudio_doa_pair_t    pairs[XRAUDIO_DOA_PAIR_QTY_MAX];
+   float                 lags[XRAUDIO_DOA_ANGLE_QTY][XRAUDIO_DOA_PAIR_QTY_MAX]; // expected lag of mic a relative to mic b (in samples)
+   xraudio_doa_complex_t twiddles[XRAUDIO_DOA_FFT_SIZE_MAX / 2];
+   uint16_t              bit_reverse[XRAUDIO_DOA_FFT_SIZE_MAX];
+   xraudio_doa_complex_t *spectra;     // fft_size spectrum of each mic
+   xraudio_doa_complex_t cross[XRAUDIO_DOA_FFT_SIZE_MAX];
+   float *               correlation; // fft_size correlation of each pair
+   float                 noise_floor;
+   float                 direction_x;
+   float                 direction_y;
+   bool                  direction_valid;
+} xraudio_doa_obj_t;
+
+static bool  xraudio_doa_object_is_valid(xraudio_doa_obj_t *obj);
+static void  xraudio_doa_fft(xraudio_doa_obj_t *obj, xraudio_doa_complex_t *data, bool inverse);
+static float xraudio_doa_correlation_get(xraudio_doa_obj_t *obj, const float *correlation, float lag);
+
+xraudio_doa_object_t xraudio_doa_object_create(const xraudio_beamformer_config_t *config, uint32_t sample_rate, uint32_t sample_qty_max) {
+   if(config == NULL || config->mic_qty < 2 || config->mic_qty > XRAUDIO_INPUT_MAX_CHANNEL_QTY || sample_qty_max == 0 || sample_qty_max > XRAUDIO_DOA_FFT_SIZE_MAX) {
+      XLOGD_ERROR("invalid config");
+      return(NULL);
+   }
+   xraudio_doa_obj_t *obj = (xraudio_doa_obj_t *)calloc(1, sizeof(xraudio_doa_obj_t));
+
+   if(obj == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      return(NULL);
+   }
+   obj->mic_qty  = config->mic_qty;
+   obj->fft_size = 1;
+   obj->fft_bits = 0;
+
+   // Pairs
+   obj->pair_qty = 0;
+   float lag_max = 0.0;
+   for(uint8_t mic_a = 0; mic_a < obj->mic_qty; mic_a++) {
+      for(uint8_t mic_b = mic_a + 1; mic_b < obj->mic_qty; mic_b++) {
+         xraudio_doa_pair_t *pair = &obj->pairs[obj->pair_qty];
+         pair->mic_a = mic_a;
+         pair->mic_b = mic_b;
+
+         float dx = (config->mic_positions[mic_b].x_mm - config->mic_positions[mic_a].x_mm) / 1000.0;
+         float dy = (config->mic_positions[mic_b].y_mm - config->mic_positions[mic_a].y_mm) / 1000.0;
+
+         for(uint32_t angle = 0; angle < XRAUDIO_DOA_ANGLE_QTY; angle++) {
+            float theta = 2.0 * M_PI * angle / XRAUDIO_DOA_ANGLE_QTY;
+            // The mic with the larger projection onto the arrival direction hears the wavefront first
+            obj->lags[angle][obj->pair_qty] = (dx * cosf(theta) + dy * sinf(theta)) * sample_rate / XRAUDIO_DOA_SPEED_OF_SOUND;
+            if(fabsf(obj->lags[angle][obj->pair_qty]) > lag_max) {
+               lag_max = fabsf(obj->lags[angle][obj->pair_qty]);
+            }
+         }
+         obj->pair_qty++;
+      }
+   }
+
+   // Smallest power of two which holds the frame and the maximum lag without circular wrap
+   while(obj->fft_size < sample_qty_max + (uint32_t)ceilf(lag_max) + 1) {
+      obj->fft_size <<= 1;
+      obj->fft_bits++;
+   }
+   if(obj->fft_size > XRAUDIO_DOA_FFT_SIZE_MAX) {
+      XLOGD_ERROR("fft size <%u> exceeds max - array too large", obj->fft_size);
+      free(obj);
+      return(NULL);
+   }
+   obj->spectra     = (xraudio_doa_complex_t *)malloc(obj->mic_qty * obj->fft_size * sizeof(xraudio_doa_complex_t));
+   obj->correlation = (float *)malloc(obj->pair_qty * obj->fft_size * sizeof(float));
+   if(obj->spectra == NULL || obj->correlation == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      free(obj->spectra);
+      free(obj->correlation);
+      free(obj);
+      return(NULL);
+   }
+   for(uint32_t index = 0; index < obj->fft_size / 2; index++) {
+      obj->twiddles[index].re =  cosf(2.0 * M_PI * index / obj->fft_size);
+      obj->twiddles[index].im = -sinf(2.0 * M_PI * index / obj->fft_size);
+   }
+   for(uint32_t index = 0; index < obj->fft_size; index++) {
+      uint32_t reversed = 0;
+      for(uint32_t bit = 0; bit < obj->fft_bits; bit++) {
+         if(index & (1 << bit)) {
+            reversed |= 1 << (obj->fft_bits - 1 - bit);
+         }
+      }
+      obj->bit_reverse[index] = reversed;
+   }
+   obj->identifier = XRAUDIO_DOA_IDENTIFIER;
+   xraudio_doa_reset(obj);
+
+   XLOGD_INFO("mic qty <%u> pair qty <%u> fft size <%u> max lag <%.1f> samples", obj->mic_qty, obj->pair_qty, obj->fft_size, lag_max);
+   return(obj);
+}
+
+void xraudio_doa_object_destroy(xraudio_doa_object_t object) {
+   xraudio_doa_obj_t *obj = (xraudio_doa_obj_t *)object;
+   if(!xraudio_doa_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   obj->identifier = 0;
+   free(obj->spectra);
+   free(obj->correlation);
+   free(obj);
+}
+
+bool xraudio_doa_object_is_valid(xraudio_doa_obj_t *obj) {
+   if(obj != NULL && obj->identifier == XRAUDIO_DOA_IDENTIFIER) {
+      return(true);
+   }
+   return(false);
+}
+
+uint8_t xraudio_doa_mic_qty_get(xraudio_doa_object_t object) {
+   xraudio_doa_obj_t *obj = (xraudio_doa_obj_t *)object;
+   if(!xraudio_doa_object_is_valid(obj)) {
+      return(0);
+   }
+   return(obj->mic_qty);
+}
+
+void xraudio_doa_reset(xraudio_doa_object_t object) {
+   xraudio_doa_obj_t *obj = (xraudio_doa_obj_t *)object;
+   if(!xraudio_doa_object_is_valid(obj)) {
+      return;
+   }
+   obj->noise_floor     = XRAUDIO_DOA_NOISE_FLOOR_MIN;
+   obj->direction_x     = 0.0;
+   obj->direction_y     = 0.0;
+   obj->direction_valid = false;
+}
+
+// In place iterative radix-2 FFT.  The inverse transform is not scaled since only the location of the correlation peak is used.
+void xraudio_doa_fft(xraudio_doa_obj_t *obj, xraudio_doa_complex_t *data, bool inverse) {
+   uint32_t size = obj->fft_size;
+
+   for(uint32_t index = 0; index < size; index++) {
+      uint32_t reversed = obj->bit_reverse[index];
+      if(reversed > index) {
+         xraudio_doa_complex_t temp = data[index];
+         data[index]    = data[reversed];
+         data[reversed] = temp;
+      }
+   }
+   for(uint32_t span = 1; span < size; span <<= 1) {
+      uint32_t stride = size / (span << 1);
+      for(uint32_t group = 0; group < size; group += (span << 1)) {
+         for(uint32_t index = 0; index < span; index++) {
+            xraudio_doa_complex_t w = obj->twiddles[index * stride];
+            if(inverse) {
+               w.im = -w.im;
+            }
+            xraudio_doa_complex_t *a = &data[group + index];
+            xraudio_doa_complex_t *b = &data[group + index + span];
+            float re = b->re * w.re - b->im * w.im;
+            float im = b->re * w.im + b->im * w.re;
+            b->re = a->re - re;
+            b->im = a->im - im;
+            a->re += re;
+            a->im += im;
+         }
+      }
+   }
+}
+
+// Cubic (Catmull-Rom) interpolation of the correlation at a fractional lag.  The phase transform leaves a narrow peak so linear interpolation
+// would bias the estimate toward whole sample lags.  Negative lags are stored at the end of the buffer.
+float xraudio_doa_correlation_get(xraudio_doa_obj_t *obj, const float *correlation, float lag) {
+   uint32_t mask     = obj->fft_size - 1;
+   float    position = (lag < 0.0) ? lag + obj->fft_size : lag;
+   uint32_t index    = (uint32_t)position;
+   float    frac     = position - index;
+   float    c0       = correlation[(index - 1) & mask];
+   float    c1       = correlation[index & mask];
+   float    c2       = correlation[(index + 1) & mask];
+   float    c3       = correlation[(index + 2) & mask];
+
+   return(c1 + 0.5 * frac * ((c2 - c0) + frac * ((2.0 * c0 - 5.0 * c1 + 4.0 * c2 - c3) + frac * (3.0 * (c1 - c2) + c3 - c0))));
+}
+
+void xraudio_doa_process(xraudio_doa_object_t object, const float *samples[], uint32_t sample_qty, float rms, xraudio_doa_t *doa) {
+   xraudio_doa_obj_t *obj = (xraudio_doa_obj_t *)object;
+   if(!xraudio_doa_object_is_valid(obj) || doa == NULL) {
+      return;
+   }
+   doa->active = false;
+
+   // Track the noise floor with a fast fall and slow rise
+   if(rms < obj->noise_floor) {
+      obj->noise_floor = (rms > XRAUDIO_DOA_NOISE_FLOOR_MIN) ? rms : XRAUDIO_DOA_NOISE_FLOOR_MIN;
+   } else {
+      obj->noise_floor *= XRAUDIO_DOA_NOISE_FLOOR_RISE;
+   }
+
+   if(rms >= XRAUDIO_DOA_ACTIVITY_RATIO * obj->noise_floor && sample_qty + 1 < obj->fft_size) {
+      for(uint8_t mic = 0; mic < obj->mic_qty; mic++) {
+         xraudio_doa_complex_t *spectrum = &obj->spectra[mic * obj->fft_size];
+         for(uint32_t index = 0; index < sample_qty; index++) {
+            spectrum[index].re = samples[mic][index];
+            spectrum[index].im = 0.0;
+         }
+         memset(&spectrum[sample_qty], 0, (obj->fft_size - sample_qty) * sizeof(xraudio_doa_complex_t));
+         xraudio_doa_fft(obj, spectrum, false);
+      }
+
+      for(uint8_t pair = 0; pair < obj->pair_qty; pair++) {
+         const xraudio_doa_complex_t *a = &obj->spectra[obj->pairs[pair].mic_a * obj->fft_size];
+         const xraudio_doa_complex_t *b = &obj->spectra[obj->pairs[pair].mic_b * obj->fft_size];
+
+         for(uint32_t index = 0; index < obj->fft_size; index++) { // cross spectrum with phase transform weighting
+            float re  = a[index].re * b[index].re + a[index].im * b[index].im;
+            float im  = a[index].im * b[index].re - a[index].re * b[index].im;
+            float mag = sqrtf(re * re + im * im) + 1.0e-12;
+            obj->cross[index].re = re / mag;
+            obj->cross[index].im = im / mag;
+         }
+         xraudio_doa_fft(obj, obj->cross, true);
+
+         for(uint32_t index = 0; index < obj->fft_size; index++) {
+            obj->correlation[pair * obj->fft_size + index] = obj->cross[index].re;
+         }
+      }
+
+      float    power_max  = 0.0;
+      float    power_sum  = 0.0;
+      uint32_t angle_max  = 0;
+      for(uint32_t angle = 0; angle < XRAUDIO_DOA_ANGLE_QTY; angle++) {
+         float power = 0.0;
+         for(uint8_t pair = 0; pair < obj->pair_qty; pair++) {
+            power += xraudio_doa_correlation_get(obj, &obj->correlation[pair * obj->fft_size], obj->lags[angle][pair]);
+         }
+         power_sum += power;
+         if(angle == 0 || power > power_max) {
+            power_max = power;
+            angle_max = angle;
+         }
+      }
+
+      // Confidence is the peak relative to the mean response
+      float power_mean = power_sum / XRAUDIO_DOA_ANGLE_QTY;
+      float confidence = (power_max > 0.0 && power_max > power_mean) ? (power_max - power_mean) / power_max : 0.0;
+      float theta      = 2.0 * M_PI * angle_max / XRAUDIO_DOA_ANGLE_QTY;
+
+      // Smooth on the unit circle so the track does not jump at 0/360 degrees.  Every update, including the first, is weighted by its confidence.
+      obj->direction_x     = XRAUDIO_DOA_SMOOTHING * obj->direction_x + (1.0 - XRAUDIO_DOA_SMOOTHING) * confidence * cosf(theta);
+      obj->direction_y     = XRAUDIO_DOA_SMOOTHING * obj->direction_y + (1.0 - XRAUDIO_DOA_SMOOTHING) * confidence * sinf(theta);
+      obj->direction_valid = (obj->direction_x != 0.0 || obj->direction_y != 0.0);
+      doa->active     = true;
+      doa->confidence = (uint8_t)(confidence * 100.0);
+   }
+
+   if(obj->direction_valid) {
+      float degrees = atan2f(obj->direction_y, obj->direction_x) * 180.0 / M_PI;
+      if(degrees < 0.0) {
+         degrees += 360.0;
+      }
+      doa->valid = true;
+      doa->angle = ((uint16_t)(degrees + 0.5)) % 360;
+   }
+}
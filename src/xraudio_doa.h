@@ -0,0 +1,37 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef __XRAUDIO_DOA_H__
+#define __XRAUDIO_DOA_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xraudio.h"
+
+typedef void * xraudio_doa_object_t;
+
+xraudio_doa_object_t xraudio_doa_object_create(const xraudio_beamformer_config_t *config, uint32_t sample_rate, uint32_t sample_qty_max);
+void                 xraudio_doa_object_destroy(xraudio_doa_object_t object);
+
+uint8_t              xraudio_doa_mic_qty_get(xraudio_doa_object_t object);
+void                 xraudio_doa_reset(xraudio_doa_object_t object);
+void                 xraudio_doa_process(xraudio_doa_object_t object, const float *samples[], uint32_t sample_qty, float rms, xraudio_doa_t *doa);
+
+#endif
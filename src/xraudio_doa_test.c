@@ -0,0 +1,153 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "xraudio.h"
+#include "xraudio_doa.h"
+
+// Synthetic geometry check of the direction of arrival estimator.  A far field source made of tones is delayed onto each microphone for a known
+// angle and the estimate is compared with it.
+
+#define DOA_TEST_SAMPLE_RATE     (16000)
+#define DOA_TEST_SAMPLE_QTY      (320)     // 20 ms
+#define DOA_TEST_FRAME_QTY       (10)
+#define DOA_TEST_TONE_QTY        (48)
+#define DOA_TEST_ANGLE_TOLERANCE (5)       // estimator resolution
+#define DOA_TEST_SPEED_OF_SOUND  (343.0)
+#define DOA_TEST_RMS             (0.1)     // well above the noise floor
+
+typedef struct {
+   float frequency;
+   float phase;
+} doa_test_tone_t;
+
+static doa_test_tone_t g_tones[DOA_TEST_TONE_QTY];
+static uint32_t        g_random = 1;
+
+static float doa_test_random(void) { // [0, 1)
+   g_random = g_random * 1103515245 + 12345;
+   return((g_random >> 8) / 16777216.0);
+}
+
+// Samples of the source for a mic at the given position.  The mic with the larger projection onto the arrival direction hears the wavefront first.
+static void doa_test_frame(const xraudio_mic_position_t *position, float angle, uint32_t frame, float *samples) {
+   float theta = angle * M_PI / 180.0;
+   float lead  = (position->x_mm * cosf(theta) + position->y_mm * sinf(theta)) / 1000.0 / DOA_TEST_SPEED_OF_SOUND;
+
+   for(uint32_t index = 0; index < DOA_TEST_SAMPLE_QTY; index++) {
+      double t   = (double)(frame * DOA_TEST_SAMPLE_QTY + index) / DOA_TEST_SAMPLE_RATE + lead;
+      float  sum = 0.0;
+      for(uint32_t tone = 0; tone < DOA_TEST_TONE_QTY; tone++) {
+         sum += sin(2.0 * M_PI * g_tones[tone].frequency * t + g_tones[tone].phase);
+      }
+      samples[index] = sum * 1000.0;
+   }
+}
+
+static void doa_test_noise(float *samples) {
+   for(uint32_t index = 0; index < DOA_TEST_SAMPLE_QTY; index++) {
+      samples[index] = (doa_test_random() - 0.5) * 10000.0;
+   }
+}
+
+static uint16_t doa_test_angle_error(uint16_t a, uint16_t b) {
+   uint16_t error = (a > b) ? a - b : b - a;
+   return((error > 180) ? 360 - error : error);
+}
+
+// Run the source from each angle around the array, optionally after a first frame of uncorrelated noise
+static uint32_t doa_test_geometry(const char *name, const xraudio_beamformer_config_t *config, bool noise_first) {
+   float        buffers[XRAUDIO_INPUT_MAX_CHANNEL_QTY][DOA_TEST_SAMPLE_QTY];
+   const float *samples[XRAUDIO_INPUT_MAX_CHANNEL_QTY];
+   uint32_t     fail_qty = 0;
+
+   xraudio_doa_object_t doa_obj = xraudio_doa_object_create(config, DOA_TEST_SAMPLE_RATE, DOA_TEST_SAMPLE_QTY);
+   if(doa_obj == NULL) {
+      printf("%s: unable to create doa object\n", name);
+      return(1);
+   }
+   for(uint8_t mic = 0; mic < config->mic_qty; mic++) {
+      samples[mic] = buffers[mic];
+   }
+
+   for(uint16_t angle = 0; angle < 360; angle += 15) {
+      xraudio_doa_t doa;
+      memset(&doa, 0, sizeof(doa));
+      xraudio_doa_reset(doa_obj);
+
+      if(noise_first) {
+         for(uint8_t mic = 0; mic < config->mic_qty; mic++) {
+            doa_test_noise(buffers[mic]);
+         }
+         xraudio_doa_process(doa_obj, samples, DOA_TEST_SAMPLE_QTY, DOA_TEST_RMS, &doa);
+      }
+      for(uint32_t frame = 0; frame < DOA_TEST_FRAME_QTY; frame++) {
+         for(uint8_t mic = 0; mic < config->mic_qty; mic++) {
+            doa_test_frame(&config->mic_positions[mic], angle, frame, buffers[mic]);
+         }
+         xraudio_doa_process(doa_obj, samples, DOA_TEST_SAMPLE_QTY, DOA_TEST_RMS, &doa);
+      }
+
+      if(!doa.valid || doa_test_angle_error(doa.angle, angle) > DOA_TEST_ANGLE_TOLERANCE) {
+         printf("%s: FAIL angle <%u> estimate <%u> valid <%s> confidence <%u>\n", name, angle, doa.angle, doa.valid ? "YES" : "NO", doa.confidence);
+         fail_qty++;
+      }
+   }
+   xraudio_doa_object_destroy(doa_obj);
+
+   printf("%s: %s\n", name, (fail_qty == 0) ? "PASS" : "FAIL");
+   return(fail_qty);
+}
+
+int main(int argc, char* argv[]) {
+   xraudio_beamformer_config_t config;
+   uint32_t                    fail_qty = 0;
+
+   for(uint32_t tone = 0; tone < DOA_TEST_TONE_QTY; tone++) {
+      g_tones[tone].frequency = 200.0 + 5800.0 * doa_test_random();
+      g_tones[tone].phase     = 2.0 * M_PI * doa_test_random();
+   }
+
+   // Square array, 65 mm across the diagonal
+   memset(&config, 0, sizeof(config));
+   config.mic_qty    = 4;
+   config.doa_enable = true;
+   for(uint8_t mic = 0; mic < config.mic_qty; mic++) {
+      config.mic_positions[mic].x_mm = 32.5 * cosf(mic * M_PI / 2.0);
+      config.mic_positions[mic].y_mm = 32.5 * sinf(mic * M_PI / 2.0);
+   }
+   fail_qty += doa_test_geometry("square", &config, false);
+   fail_qty += doa_test_geometry("square after noise", &config, true);
+
+   // Triangle array, 40 mm from the center
+   memset(&config, 0, sizeof(config));
+   config.mic_qty    = 3;
+   config.doa_enable = true;
+   for(uint8_t mic = 0; mic < config.mic_qty; mic++) {
+      config.mic_positions[mic].x_mm = 40.0 * cosf(mic * 2.0 * M_PI / 3.0);
+      config.mic_positions[mic].y_mm = 40.0 * sinf(mic * 2.0 * M_PI / 3.0);
+   }
+   fail_qty += doa_test_geometry("triangle", &config, false);
+
+   return((fail_qty == 0) ? 0 : 1);
+}
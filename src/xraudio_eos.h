@@ -139,6 +139,28 @@ unsigned char        xraudio_eos_signal_level_get(xraudio_eos_object_t object);
 /// @return The function returns the current signal to noise ratio in DB.
 float                xraudio_eos_signal_to_noise_ratio_get(xraudio_eos_object_t object);
 
+/// @brief Retrieve the size of an xraudio EOS state snapshot
+/// @details Retrieves the size of the buffer needed to save the adapted state of the end of speech detector (noise floor estimate, etc).  Only called when xraudio is built with XRAUDIO_DSP_STATE_ENABLED.
+/// @param[in] object Reference to an xraudio EOS object.
+/// @return The function returns the size of the snapshot in bytes or zero if the state cannot be saved.
+uint32_t             xraudio_eos_snapshot_size(xraudio_eos_object_t object);
+
+/// @brief Save an xraudio EOS state snapshot
+/// @details Saves the adapted state of the end of speech detector (noise floor estimate, etc) so it can be restored after the EOS is reinitialized.
+/// @param[in]  object Reference to an xraudio EOS object.
+/// @param[out] state  Pointer to the snapshot buffer.
+/// @param[in]  size   Size of the snapshot buffer in bytes.
+/// @return The function returns true for success and false for failure.
+bool                 xraudio_eos_snapshot_save(xraudio_eos_object_t object, void *state, uint32_t size);
+
+/// @brief Restore an xraudio EOS state snapshot
+/// @details Restores a snapshot saved by xraudio_eos_snapshot_save.  The snapshot must be rejected if it does not match the current configuration of the EOS.
+/// @param[in] object Reference to an xraudio EOS object.
+/// @param[in] state  Pointer to the snapshot buffer.
+/// @param[in] size   Size of the snapshot in bytes.
+/// @return The function returns true for success and false for failure.
+bool                 xraudio_eos_snapshot_restore(xraudio_eos_object_t object, const void *state, uint32_t size);
+
 /// @}
 
 #ifdef __cplusplus
@@ -0,0 +1,153 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "xraudio.h"
+#include "xraudio_private.h"
+#include "xraudio_governor.h"
+
+// Overload governor.  The processing time of each frame is smoothed and compared to the frame period.  While the load stays above the high
+// threshold the shed level steps up one level at a time, and while it stays below the low threshold for the (longer) recovery time it steps
+// back down.  A frame which finished after the next frame was due counts as full load.
+
+#define XRAUDIO_GOVERNOR_IDENTIFIER (0x5852474F)
+#define XRAUDIO_GOVERNOR_SMOOTHING  (8)   // weight of the previous load
+
+typedef struct {
+   uint32_t                  identifier;
+   xraudio_governor_config_t config;
+   uint32_t                  frame_period_us;
+   uint32_t                  escalate_frame_qty;
+   uint32_t                  recover_frame_qty;
+   uint32_t                  load_us;        // smoothed processing time per frame
+   uint32_t                  high_frame_qty; // consecutive frames above the high threshold
+   uint32_t                  low_frame_qty;  // consecutive frames below the low threshold
+   xraudio_shed_level_t      level;
+   uint32_t                  change_qty;
+   uint32_t                  overrun_qty;
+   uint64_t                  level_time_us[XRAUDIO_SHED_LEVEL_INVALID];
+} xraudio_governor_obj_t;
+
+static bool xraudio_governor_object_is_valid(xraudio_governor_obj_t *obj);
+
+xraudio_governor_object_t xraudio_governor_object_create(const xraudio_governor_config_t *config, uint32_t frame_period_us) {
+   if(config == NULL || config->level_max >= XRAUDIO_SHED_LEVEL_INVALID || config->load_low_pct >= config->load_high_pct || frame_period_us == 0) {
+      XLOGD_ERROR("invalid config");
+      return(NULL);
+   }
+   xraudio_governor_obj_t *obj = (xraudio_governor_obj_t *)calloc(1, sizeof(xraudio_governor_obj_t));
+
+   if(obj == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      return(NULL);
+   }
+   obj->config             = *config;
+   obj->frame_period_us    = frame_period_us;
+   obj->escalate_frame_qty = (config->escalate_ms * 1000) / frame_period_us;
+   obj->recover_frame_qty  = (config->recover_ms  * 1000) / frame_period_us;
+   obj->level              = XRAUDIO_SHED_LEVEL_NONE;
+   obj->identifier         = XRAUDIO_GOVERNOR_IDENTIFIER;
+
+   if(obj->escalate_frame_qty == 0) {
+      obj->escalate_frame_qty = 1;
+   }
+   if(obj->recover_frame_qty == 0) {
+      obj->recover_frame_qty = 1;
+   }
+
+   XLOGD_INFO("level max <%s> load high <%u%%> low <%u%%> escalate <%u> frames recover <%u> frames", xraudio_shed_level_str(config->level_max), config->load_high_pct, config->load_low_pct, obj->escalate_frame_qty, obj->recover_frame_qty);
+   return(obj);
+}
+
+void xraudio_governor_object_destroy(xraudio_governor_object_t object) {
+   xraudio_governor_obj_t *obj = (xraudio_governor_obj_t *)object;
+   if(!xraudio_governor_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   obj->identifier = 0;
+   free(obj);
+}
+
+bool xraudio_governor_object_is_valid(xraudio_governor_obj_t *obj) {
+   if(obj != NULL && obj->identifier == XRAUDIO_GOVERNOR_IDENTIFIER) {
+      return(true);
+   }
+   return(false);
+}
+
+xraudio_shed_level_t xraudio_governor_update(xraudio_governor_object_t object, uint32_t frame_time_us, bool overrun) {
+   xraudio_governor_obj_t *obj = (xraudio_governor_obj_t *)object;
+   if(!xraudio_governor_object_is_valid(obj)) {
+      return(XRAUDIO_SHED_LEVEL_NONE);
+   }
+   if(overrun) {
+      obj->overrun_qty++;
+      if(frame_time_us < obj->frame_period_us) {
+         frame_time_us = obj->frame_period_us;
+      }
+   }
+   obj->level_time_us[obj->level] += obj->frame_period_us;
+
+   obj->load_us = (obj->load_us * (XRAUDIO_GOVERNOR_SMOOTHING - 1) + frame_time_us) / XRAUDIO_GOVERNOR_SMOOTHING;
+
+   uint32_t load_pct = (obj->load_us * 100) / obj->frame_period_us;
+   xraudio_shed_level_t level = obj->level;
+
+   if(load_pct > obj->config.load_high_pct) {
+      obj->low_frame_qty = 0;
+      if(++obj->high_frame_qty >= obj->escalate_frame_qty && level < obj->config.level_max) {
+         level = (xraudio_shed_level_t)(level + 1);
+      }
+   } else if(load_pct < obj->config.load_low_pct) {
+      obj->high_frame_qty = 0;
+      if(++obj->low_frame_qty >= obj->recover_frame_qty && level > XRAUDIO_SHED_LEVEL_NONE) {
+         level = (xraudio_shed_level_t)(level - 1);
+      }
+   } else {
+      obj->high_frame_qty = 0;
+      obj->low_frame_qty  = 0;
+   }
+
+   if(level != obj->level) { // Each step requires a new sustained period
+      XLOGD_WARN("shed level <%s> to <%s> load <%u%%>", xraudio_shed_level_str(obj->level), xraudio_shed_level_str(level), load_pct);
+      obj->level          = level;
+      obj->high_frame_qty = 0;
+      obj->low_frame_qty  = 0;
+      obj->change_qty++;
+   }
+   return(obj->level);
+}
+
+void xraudio_governor_stats_read(xraudio_governor_object_t object, xraudio_governor_stats_t *stats) {
+   xraudio_governor_obj_t *obj = (xraudio_governor_obj_t *)object;
+   if(!xraudio_governor_object_is_valid(obj) || stats == NULL) {
+      return;
+   }
+   stats->level       = obj->level;
+   stats->change_qty  = obj->change_qty;
+   stats->overrun_qty = obj->overrun_qty;
+   stats->load_pct    = (obj->load_us * 100) / obj->frame_period_us;
+   for(uint32_t level = 0; level < XRAUDIO_SHED_LEVEL_INVALID; level++) {
+      stats->level_time_ms[level] = (uint32_t)(obj->level_time_us[level] / 1000);
+   }
+}
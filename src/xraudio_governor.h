@@ -0,0 +1,36 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef __XRAUDIO_GOVERNOR_H__
+#define __XRAUDIO_GOVERNOR_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xraudio.h"
+
+typedef void * xraudio_governor_object_t;
+
+xraudio_governor_object_t xraudio_governor_object_create(const xraudio_governor_config_t *config, uint32_t frame_period_us);
+void                      xraudio_governor_object_destroy(xraudio_governor_object_t object);
+
+xraudio_shed_level_t      xraudio_governor_update(xraudio_governor_object_t object, uint32_t frame_time_us, bool overrun);
+void                      xraudio_governor_stats_read(xraudio_governor_object_t object, xraudio_governor_stats_t *stats);
+
+#endif
@@ -169,6 +169,7 @@ typedef struct {
    uint8_t              pcm_bit_qty;
    xraudio_power_mode_t power_mode;
    bool                 privacy_mode;
+   uint8_t              mic_qty;      ///< in: quantity of microphones for the device (0 for XRAUDIO_DEVICE_INPUT_ARRAY), out: quantity of microphones in the capture
 } xraudio_device_input_configuration_t;
 
 typedef struct {
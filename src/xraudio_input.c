@@ -32,6 +32,7 @@
 #include <jansson.h>
 #include "xraudio.h"
 #include "xraudio_private.h"
+#include "xraudio_atomic.h"
 
 #define POLAR_ACTIVITY_PERIOD_IN_MSEC    (50)
 
@@ -40,6 +41,11 @@
 #define XRAUDIO_RECORD_MUTEX_LOCK()   sem_wait(&obj->mutex_record)
 #define XRAUDIO_RECORD_MUTEX_UNLOCK() sem_post(&obj->mutex_record)
 
+#define XRAUDIO_INPUT_DOA_ANGLE_MASK       (0x000001FF)
+#define XRAUDIO_INPUT_DOA_CONFIDENCE_SHIFT (16)
+#define XRAUDIO_INPUT_DOA_ACTIVE           (0x01000000)
+#define XRAUDIO_INPUT_DOA_VALID            (0x02000000)
+
 //#define INPUT_TIMING_DATA
 #ifdef INPUT_TIMING_DATA
 #define INPUT_TIMING_SAMPLE_QTY (20 * 1000 / 20)
@@ -47,6 +53,7 @@ typedef struct {
    rdkx_timestamp_t optimal;      // Elapsed time at which the sample should be taken
    rdkx_timestamp_t actual;       // Actual time when the sample was taken
    rdkx_timestamp_t time_read;    // Amount of time to read the PCM data
+   rdkx_timestamp_t time_convert; // Amount of time to decimate and unpack the PCM data
    rdkx_timestamp_t time_eos;     // Amount of time to run end of speech algorithm
    rdkx_timestamp_t time_snd_foc; // Amount of time to run sound focus algorithm
    rdkx_timestamp_t time_process; // Amount of time to process the data
@@ -80,19 +87,34 @@ typedef struct {
 typedef struct {
    xraudio_input_state_t         state;
    uint8_t                       frame_group_qty;
+   uint16_t                      latency_budget_ms;
    char                          stream_identifer[XRAUDIO_STREAM_ID_SIZE_MAX];
    uint16_t                      stream_time_minimum;
    uint32_t                      stream_keyword_begin;
    uint32_t                      stream_keyword_duration;
    xraudio_stream_latency_mode_t latency_mode;
+   xraudio_stream_framing_t      framing;
+   xraudio_stream_sample_format_t  sample_format;
+   xraudio_stream_channel_layout_t channel_layout;
+   xraudio_stream_buffer_t       buffer_pool[XRAUDIO_STREAM_BUFFER_QTY_MAX];
+   uint8_t                       buffer_pool_qty;
+   uint32_t                      buffer_pool_sample_qty; // size of each buffer in the pool (in samples)
    xraudio_input_record_from_t   from[XRAUDIO_FIFO_QTY_MAX];
    int32_t                       offset[XRAUDIO_FIFO_QTY_MAX];
    xraudio_input_record_until_t  until[XRAUDIO_FIFO_QTY_MAX];
    xraudio_input_format_t        format_out;
    xraudio_sample_t *            audio_buf_samples;
    unsigned long                 audio_buf_sample_qty;
+   bool                          audio_buf_circular;
    int                           fifo_sound_intensity;
 
+   // Write index of the circular record to memory buffer, in samples.  The buffer sample quantity is added once the buffer has wrapped so the client
+   // can tell how much of the buffer is valid from a single read.  Negative when no circular recording has started.  The sequence is odd while the
+   // main thread replaces the index and sample quantity so a reader retries instead of pairing an index with the quantity of another buffer.
+   xraudio_atomic_int_t          memory_ring_sequence;
+   xraudio_atomic_int_t          memory_ring_index;
+   xraudio_atomic_int_t          memory_ring_sample_qty;
+
    // Only one of these can be set at a time
    int                           fifo_audio_data[XRAUDIO_FIFO_QTY_MAX];
    FILE *                        fh;
@@ -117,8 +139,12 @@ typedef struct {
 
    char                          fifo_name[XRAUDIO_FIFO_NAME_LENGTH_MAX];
    xraudio_input_statistics_t    statistics;
+   uint8_t                       mic_qty;  // quantity of microphones in the capture
    #ifdef XRAUDIO_EOS_ENABLED
    xraudio_eos_object_t          obj_eos[XRAUDIO_INPUT_MAX_CHANNEL_QTY];
+   uint8_t                       eos_qty;  // end of speech detectors are created at open for each microphone
+   json_t *                      jeos_config;
+   xraudio_dsp_snapshot_t        eos_snapshot[XRAUDIO_INPUT_MAX_CHANNEL_QTY];
    #endif
    #ifdef XRAUDIO_SDF_ENABLED
    xraudio_sdf_object_t          obj_sdf;
@@ -126,6 +152,7 @@ typedef struct {
    #endif
    #ifdef XRAUDIO_PPR_ENABLED
    xraudio_ppr_object_t          obj_ppr;
+   xraudio_dsp_snapshot_t        ppr_snapshot;
    #endif
    xraudio_input_capture_t       capture;
    xraudio_input_detect_params_t detect_params;
@@ -138,20 +165,26 @@ typedef struct {
    #endif
    xraudio_hal_dsp_config_t      dsp_config;
    char *                        dsp_name;
+   xraudio_atomic_int_t          features_sequence; // odd while the main thread is updating the features
+   xraudio_atomic_int_t          features_requested; // set once the features have been read so the main thread starts calculating them
+   uint8_t                       features_chan_qty;
+   xraudio_frame_features_t      features[XRAUDIO_INPUT_MAX_CHANNEL_QTY];
+   xraudio_atomic_int_t          doa_track; // packed XRAUDIO_INPUT_DOA_* fields so the estimate is read atomically
+   uint32_t                      frame_period; // microphone frame period (in milliseconds)
 } xraudio_input_obj_t;
 
 static bool             xraudio_input_object_is_valid(xraudio_input_obj_t *obj);
 static void             xraudio_input_queue_msg_push(xraudio_input_obj_t *obj, const char *msg, size_t msg_len);
 static void             xraudio_input_dispatch_idle_start(xraudio_input_obj_t *obj);
 static void             xraudio_input_dispatch_idle_stop(xraudio_input_obj_t *obj);
-static xraudio_result_t xraudio_input_dispatch_record(xraudio_input_obj_t *obj, xraudio_devices_input_t source, xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param);
+static xraudio_result_t xraudio_input_dispatch_record(xraudio_input_obj_t *obj, xraudio_devices_input_t source, xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param, bool armed);
 static xraudio_result_t xraudio_input_dispatch_detect(xraudio_input_obj_t *obj, keyword_callback_t callback, void *param, bool synchronous);
 static xraudio_result_t xraudio_input_dispatch_detect_params(xraudio_input_obj_t *obj);
 static xraudio_result_t xraudio_input_dispatch_detect_stop(xraudio_input_obj_t *obj, xraudio_devices_input_t source, audio_in_callback_t callback, void *param);
 static xraudio_result_t xraudio_input_dispatch_stop(xraudio_input_obj_t *obj, xraudio_devices_input_t source, int32_t index, audio_in_callback_t callback, void *param);
 static xraudio_result_t xraudio_input_dispatch_capture(xraudio_input_obj_t *obj, audio_in_callback_t callback, void *param);
 static xraudio_result_t xraudio_input_dispatch_capture_stop(xraudio_input_obj_t *obj);
-static bool             xraudio_input_audio_hal_open(xraudio_input_obj_t *obj, xraudio_devices_input_t device, xraudio_power_mode_t power_mode, bool privacy_mode, xraudio_input_format_t format, uint8_t *pcm_bit_qty, int *fd);
+static bool             xraudio_input_audio_hal_open(xraudio_input_obj_t *obj, xraudio_devices_input_t device, xraudio_power_mode_t power_mode, bool privacy_mode, xraudio_input_format_t format, uint8_t *pcm_bit_qty, uint8_t *mic_qty, int *fd);
 static void             xraudio_input_audio_hal_close(xraudio_input_obj_t *obj);
 static void             xraudio_input_sound_intensity_fifo_open(xraudio_input_obj_t *obj);
 static void             xraudio_input_sound_intensity_fifo_close(xraudio_input_obj_t *obj);
@@ -165,6 +198,8 @@ static void             xraudio_input_stats_sound_focus_print(xraudio_input_obj_
 
 static void             xraudio_input_close_locked(xraudio_input_obj_t *obj);
 static xraudio_result_t xraudio_input_stop_locked(xraudio_input_obj_t *obj, xraudio_devices_input_t source, int32_t index);
+static xraudio_result_t xraudio_input_stream_to_pipe_locked(xraudio_input_obj_t *obj, xraudio_devices_input_t source, xraudio_dst_pipe_t dsts[], xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param, bool armed);
+static xraudio_result_t xraudio_input_stream_to_pipe_revert(xraudio_input_session_t *session, xraudio_input_state_t state, xraudio_result_t result);
 static xraudio_result_t xraudio_input_capture_stop_locked(xraudio_input_obj_t *obj);
 static __inline xraudio_input_session_t *xraudio_input_source_to_session(xraudio_input_obj_t *obj, xraudio_devices_input_t source);
 
@@ -192,7 +227,13 @@ xraudio_input_object_t xraudio_input_object_create(xraudio_hal_obj_t hal_obj, ui
 
       session->state                     = XRAUDIO_INPUT_STATE_CREATED;
       session->frame_group_qty           = XRAUDIO_INPUT_DEFAULT_FRAME_GROUP_QTY;
+      session->latency_budget_ms         = 0;
       session->latency_mode              = XRAUDIO_STREAM_LATENCY_NORMAL;
+      session->framing                   = XRAUDIO_STREAM_FRAMING_NONE;
+      session->sample_format             = XRAUDIO_STREAM_SAMPLE_FORMAT_INT16;
+      session->channel_layout            = XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO;
+      session->buffer_pool_qty           = 0;
+      session->buffer_pool_sample_qty    = 0;
       session->stream_time_minimum       = 0;
       session->stream_keyword_begin      = 0;
       session->stream_keyword_duration   = 0;
@@ -201,7 +242,11 @@ xraudio_input_object_t xraudio_input_object_create(xraudio_hal_obj_t hal_obj, ui
       session->data_callback            = NULL;
       session->audio_buf_samples        = NULL;
       session->audio_buf_sample_qty     = 0;
+      session->audio_buf_circular       = false;
       session->fifo_sound_intensity     = -1;
+      xraudio_atomic_int_set(&session->memory_ring_sequence, 0);
+      xraudio_atomic_int_set(&session->memory_ring_index, -1);
+      xraudio_atomic_int_set(&session->memory_ring_sample_qty, 0);
 
       session->format_out                = (xraudio_input_format_t) { .container   = XRAUDIO_CONTAINER_INVALID,
                                                                       .encoding    = XRAUDIO_ENCODING_INVALID,
@@ -216,6 +261,8 @@ xraudio_input_object_t xraudio_input_object_create(xraudio_hal_obj_t hal_obj, ui
    obj->capabilities             = XRAUDIO_CAPS_INPUT_NONE;
    obj->pcm_bit_qty              = 16;
    obj->fd                       = -1;
+   obj->mic_qty                  = 0;
+   obj->frame_period             = XRAUDIO_INPUT_FRAME_PERIOD;
    obj->format_in                = (xraudio_input_format_t) { .container   = XRAUDIO_CONTAINER_INVALID,
                                                               .encoding    = XRAUDIO_ENCODING_INVALID,
                                                               .sample_rate = XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE,
@@ -224,6 +271,10 @@ xraudio_input_object_t xraudio_input_object_create(xraudio_hal_obj_t hal_obj, ui
    obj->hal_input_obj            = NULL;
    obj->statistics               = (xraudio_input_statistics_t) { .frames_lost = 0 };
    obj->dsp_config               = dsp_config;
+   obj->features_chan_qty        = 0;
+   xraudio_atomic_int_set(&obj->features_sequence, 0);
+   xraudio_atomic_int_set(&obj->features_requested, 0);
+   xraudio_atomic_int_set(&obj->doa_track, 0);
    if(NULL == json_obj_input) {
       XLOGD_INFO("json_obj_input is null, using defaults");
    } else {
@@ -249,7 +300,13 @@ xraudio_input_object_t xraudio_input_object_create(xraudio_hal_obj_t hal_obj, ui
 
    #ifdef XRAUDIO_EOS_ENABLED
    for (uint8_t i = 0; i < XRAUDIO_INPUT_MAX_CHANNEL_QTY; ++i) {
-      obj->obj_eos[i] = xraudio_eos_object_create(false, jeos_config);
+      obj->obj_eos[i] = NULL;
+   }
+   obj->eos_qty     = 0;
+   obj->jeos_config = jeos_config;
+   memset(obj->eos_snapshot, 0, sizeof(obj->eos_snapshot));
+   if(jeos_config != NULL) {
+      json_incref(jeos_config);
    }
    #endif
    #ifdef XRAUDIO_SDF_ENABLED
@@ -258,6 +315,7 @@ xraudio_input_object_t xraudio_input_object_create(xraudio_hal_obj_t hal_obj, ui
    #endif
    #ifdef XRAUDIO_PPR_ENABLED
    obj->obj_ppr                  = xraudio_ppr_object_create(jppr_config);
+   memset(&obj->ppr_snapshot, 0, sizeof(obj->ppr_snapshot));
 
    if(!xraudio_ppr_init(obj->obj_ppr)) {
       XLOGD_ERROR("Preprocess init failed");
@@ -306,12 +364,20 @@ void xraudio_input_object_destroy(xraudio_input_object_t object) {
          xraudio_input_close_locked(obj);
       }
       #ifdef XRAUDIO_EOS_ENABLED
-      for (int i = 0; i < XRAUDIO_INPUT_MAX_CHANNEL_QTY; ++i) {
+      for (int i = 0; i < obj->eos_qty; ++i) {
          if(obj->obj_eos[i] != NULL) {
             xraudio_eos_object_destroy(obj->obj_eos[i]);
             obj->obj_eos[i] = NULL;
          }
       }
+      obj->eos_qty = 0;
+      for(uint8_t chan = 0; chan < XRAUDIO_INPUT_MAX_CHANNEL_QTY; chan++) {
+         xraudio_dsp_snapshot_free(&obj->eos_snapshot[chan]);
+      }
+      if(obj->jeos_config != NULL) {
+         json_decref(obj->jeos_config);
+         obj->jeos_config = NULL;
+      }
       #endif
       #ifdef XRAUDIO_SDF_ENABLED
       if(obj->obj_sdf != NULL) {
@@ -330,11 +396,14 @@ void xraudio_input_object_destroy(xraudio_input_object_t object) {
          xraudio_ppr_object_destroy(obj->obj_ppr);
          obj->obj_ppr = NULL;
       }
+      xraudio_dsp_snapshot_free(&obj->ppr_snapshot);
       #endif
       obj->identifier = 0;
       for(uint32_t group = XRAUDIO_INPUT_SESSION_GROUP_DEFAULT; group < XRAUDIO_INPUT_SESSION_GROUP_QTY; group++) {
          xraudio_input_session_t *session = &obj->sessions[group];
          session->state = XRAUDIO_INPUT_STATE_INVALID;
+         xraudio_in_stream_buffer_pool_destroy(session->buffer_pool, session->buffer_pool_qty);
+         session->buffer_pool_qty = 0;
       }
       XRAUDIO_RECORD_MUTEX_UNLOCK();
 
@@ -358,6 +427,15 @@ xraudio_hal_input_obj_t xraudio_input_hal_obj_get(xraudio_input_object_t object)
    return(obj->hal_input_obj);
 }
 
+uint8_t xraudio_input_mic_qty_get(xraudio_input_object_t object) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(0);
+   }
+   return(obj->mic_qty);
+}
+
 void xraudio_input_queue_msg_push(xraudio_input_obj_t *obj, const char *msg, size_t msg_len) {
    if(msg_len > XRAUDIO_MSG_QUEUE_MSG_SIZE_MAX) {
       XLOGD_ERROR("Message size is too big! (%zd)", msg_len);
@@ -368,7 +446,7 @@ void xraudio_input_queue_msg_push(xraudio_input_obj_t *obj, const char *msg, siz
    }
 }
 
-xraudio_result_t xraudio_input_open(xraudio_input_object_t object, xraudio_devices_input_t device, xraudio_power_mode_t power_mode, bool privacy_mode,  xraudio_resource_id_input_t resource_id, uint16_t capabilities, xraudio_input_format_t format) {
+xraudio_result_t xraudio_input_open(xraudio_input_object_t object, xraudio_devices_input_t device, xraudio_power_mode_t power_mode, bool privacy_mode,  xraudio_resource_id_input_t resource_id, uint16_t capabilities, xraudio_input_format_t format, uint32_t frame_period, uint32_t capture_rate) {
    xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
    if(!xraudio_input_object_is_valid(obj)) {
       XLOGD_ERROR("Invalid object.");
@@ -384,24 +462,48 @@ xraudio_result_t xraudio_input_open(xraudio_input_object_t object, xraudio_devic
       return XRAUDIO_RESULT_ERROR_STATE;
    }
 
+   obj->frame_period = frame_period;
+
    xraudio_input_format_t format_in = format;
    if(capabilities & XRAUDIO_CAPS_INPUT_LOCAL_32_BIT) { // HAL suports 32-bit PCM input
       format_in.sample_size = 4;
    }
 
    uint8_t pcm_bit_qty = 16;
+   uint8_t mic_qty     = 0;
    int     fd          = -1;
 
    xraudio_devices_input_t device_input_local = XRAUDIO_DEVICE_INPUT_LOCAL_GET(device);
    if(device_input_local != XRAUDIO_DEVICE_INPUT_NONE) {
 
-      format_in.channel_qty = (device_input_local == XRAUDIO_DEVICE_INPUT_QUAD) ? 4 : (device_input_local == XRAUDIO_DEVICE_INPUT_TRI) ? 3 : 1;
+      mic_qty = xraudio_devices_input_mic_qty(device_input_local, 0); // zero for an array so the HAL reports the quantity of microphones
+      format_in.channel_qty = (mic_qty > 0) ? mic_qty : XRAUDIO_INPUT_MAX_CHANNEL_QTY;
 
-      if(!xraudio_input_audio_hal_open(obj, XRAUDIO_DEVICE_INPUT_LOCAL_GET(device), power_mode, privacy_mode, format_in, &pcm_bit_qty, &fd)) {
+      xraudio_input_format_t format_hal = format_in;
+      format_hal.sample_rate = capture_rate; // the main thread decimates to the input sample rate
+
+      uint8_t mic_qty_hal = mic_qty;
+      if(!xraudio_input_audio_hal_open(obj, XRAUDIO_DEVICE_INPUT_LOCAL_GET(device), power_mode, privacy_mode, format_hal, &pcm_bit_qty, &mic_qty_hal, &fd)) {
          XLOGD_ERROR("Unable to open microphone interface");
          XRAUDIO_RECORD_MUTEX_UNLOCK();
          return XRAUDIO_RESULT_ERROR_MIC_OPEN;
       }
+      if(mic_qty == 0) {
+         if(mic_qty_hal < XRAUDIO_INPUT_MIN_CHANNEL_QTY || mic_qty_hal > XRAUDIO_INPUT_MAX_CHANNEL_QTY) {
+            XLOGD_ERROR("unsupported microphone array <%s>", xraudio_channel_qty_str(mic_qty_hal));
+            xraudio_input_audio_hal_close(obj);
+            XRAUDIO_RECORD_MUTEX_UNLOCK();
+            return XRAUDIO_RESULT_ERROR_MIC_OPEN;
+         }
+         mic_qty = mic_qty_hal;
+      }
+      format_in.channel_qty = mic_qty;
+
+      #ifdef XRAUDIO_EOS_ENABLED
+      for(; obj->eos_qty < mic_qty; obj->eos_qty++) { // kept until the object is destroyed
+         obj->obj_eos[obj->eos_qty] = xraudio_eos_object_create(false, obj->jeos_config);
+      }
+      #endif
    }
 
    //HAL capabilities and dsp_config might change after open(). For example when Llama loads NSM DSP image
@@ -421,11 +523,12 @@ xraudio_result_t xraudio_input_open(xraudio_input_object_t object, xraudio_devic
    obj->capabilities       = capabilities;
    obj->format_in          = format_in;
    obj->pcm_bit_qty        = pcm_bit_qty;
+   obj->mic_qty            = mic_qty;
    obj->fd                 = fd;
 
    xraudio_input_sound_intensity_fifo_open(obj);
 
-   XLOGD_INFO("sample size <%u> %u-bit pcm using <%s>", obj->format_in.sample_size, obj->pcm_bit_qty, obj->fd >= 0 ? "fd" : "timing");
+   XLOGD_INFO("sample size <%u> %u-bit pcm mics <%u> using <%s>", obj->format_in.sample_size, obj->pcm_bit_qty, obj->mic_qty, obj->fd >= 0 ? "fd" : "timing");
 
    xraudio_input_dispatch_idle_start(obj);
 
@@ -558,12 +661,12 @@ xraudio_result_t xraudio_input_record_to_file(xraudio_input_object_t object, xra
 
    session->state = XRAUDIO_INPUT_STATE_RECORDING;
 
-   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, NULL, callback, param);
+   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, NULL, callback, param, false);
    XRAUDIO_RECORD_MUTEX_UNLOCK();
    return(result);
 }
 
-xraudio_result_t xraudio_input_record_to_memory(xraudio_input_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, unsigned long sample_qty, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param) {
+xraudio_result_t xraudio_input_record_to_memory(xraudio_input_object_t object, xraudio_devices_input_t source, xraudio_sample_t *buf_samples, unsigned long sample_qty, bool circular, xraudio_input_record_from_t from, int32_t offset, xraudio_input_record_until_t until, audio_in_callback_t callback, void *param) {
    xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
    if(!xraudio_input_object_is_valid(obj)) {
       XLOGD_ERROR("Invalid object.");
@@ -592,6 +695,11 @@ xraudio_result_t xraudio_input_record_to_memory(xraudio_input_object_t object, x
       XRAUDIO_RECORD_MUTEX_UNLOCK();
       return(XRAUDIO_RESULT_ERROR_PARAMS);
    }
+   if(circular && sample_qty > XRAUDIO_MEMORY_RING_SAMPLE_QTY_MAX) {
+      XLOGD_ERROR("invalid parameters - circular sample qty %lu", sample_qty);
+      XRAUDIO_RECORD_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
    if((uint32_t)from >= XRAUDIO_INPUT_RECORD_FROM_INVALID || (uint32_t)until >= XRAUDIO_INPUT_RECORD_UNTIL_INVALID) {
       XLOGD_ERROR("invalid from/until param");
       XRAUDIO_RECORD_MUTEX_UNLOCK();
@@ -610,6 +718,7 @@ xraudio_result_t xraudio_input_record_to_memory(xraudio_input_object_t object, x
 
    session->audio_buf_samples     = buf_samples;
    session->audio_buf_sample_qty  = sample_qty;
+   session->audio_buf_circular    = circular;
 
    xraudio_input_sound_intensity_fifo_open(obj);
 
@@ -620,11 +729,11 @@ xraudio_result_t xraudio_input_record_to_memory(xraudio_input_object_t object, x
    session->offset[0] = offset;
    session->until[0]  = until;
 
-   XLOGD_INFO("buffer %p size %lu from <%s> offset <%d> until <%s> <%s>", session->audio_buf_samples, session->audio_buf_sample_qty, xraudio_input_record_from_str(from), offset, xraudio_input_record_until_str(until), (callback == NULL) ? "sync" : "async");
+   XLOGD_INFO("buffer %p size %lu%s from <%s> offset <%d> until <%s> <%s>", session->audio_buf_samples, session->audio_buf_sample_qty, circular ? " circular" : "", xraudio_input_record_from_str(from), offset, xraudio_input_record_until_str(until), (callback == NULL) ? "sync" : "async");
 
    session->state = XRAUDIO_INPUT_STATE_RECORDING;
 
-   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, NULL, callback, param);
+   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, NULL, callback, param, false);
    XRAUDIO_RECORD_MUTEX_UNLOCK();
    return(result);
 }
@@ -708,6 +817,11 @@ xraudio_result_t xraudio_input_stream_to_fifo(xraudio_input_object_t object, xra
       XRAUDIO_RECORD_MUTEX_UNLOCK();
       return(XRAUDIO_RESULT_ERROR_PARAMS);
    }
+   if(from != XRAUDIO_INPUT_RECORD_FROM_LIVE && XRAUDIO_DEVICE_INPUT_LOCAL_GET(source) && session->channel_layout != XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO) { // Pre-detection audio is only kept for the active channel
+      XLOGD_ERROR("invalid from <%s> for channel layout <%s>", xraudio_input_record_from_str(from), xraudio_stream_channel_layout_str(session->channel_layout));
+      XRAUDIO_RECORD_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
 
    // Open fifo
    errno = 0;
@@ -734,7 +848,7 @@ xraudio_result_t xraudio_input_stream_to_fifo(xraudio_input_object_t object, xra
 
    session->state = XRAUDIO_INPUT_STATE_STREAMING;
 
-   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, format_decoded, callback, param);
+   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, format_decoded, callback, param, false);
    XRAUDIO_RECORD_MUTEX_UNLOCK();
    return(result);
 }
@@ -747,8 +861,8 @@ xraudio_result_t xraudio_input_stream_to_pipe(xraudio_input_object_t object, xra
    }
    XRAUDIO_RECORD_MUTEX_LOCK();
 
-   // Check if object contains this source (or SINGLE is requested when TRI or QUAD is available)
-   if(!XRAUDIO_DEVICE_INPUT_CONTAINS(obj->device, source) && !((source == XRAUDIO_DEVICE_INPUT_SINGLE || source == XRAUDIO_DEVICE_INPUT_MIC_TAP) && (obj->device & (XRAUDIO_DEVICE_INPUT_TRI | XRAUDIO_DEVICE_INPUT_QUAD)))) {
+   // Check if object contains this source (or SINGLE is requested when TRI, QUAD or ARRAY is available)
+   if(!XRAUDIO_DEVICE_INPUT_CONTAINS(obj->device, source) && !((source == XRAUDIO_DEVICE_INPUT_SINGLE || source == XRAUDIO_DEVICE_INPUT_MIC_TAP) && (obj->device & (XRAUDIO_DEVICE_INPUT_TRI | XRAUDIO_DEVICE_INPUT_QUAD | XRAUDIO_DEVICE_INPUT_ARRAY)))) {
       XLOGD_ERROR("invalid source <%s>", xraudio_devices_input_str(source));
       XLOGD_ERROR("valid sources  <%s>", xraudio_devices_input_str(obj->device));
       XRAUDIO_RECORD_MUTEX_UNLOCK();
@@ -764,9 +878,55 @@ xraudio_result_t xraudio_input_stream_to_pipe(xraudio_input_object_t object, xra
       return(XRAUDIO_RESULT_ERROR_STATE);
    }
 
+   xraudio_result_t result = xraudio_input_stream_to_pipe_locked(obj, source, dsts, format_decoded, callback, param, false);
+   XRAUDIO_RECORD_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_input_stream_arm(xraudio_input_object_t object, xraudio_devices_input_t source, xraudio_dst_pipe_t dsts[], xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(callback == NULL) { // The client is not blocked until the keyword is detected
+      XLOGD_ERROR("src <%s> armed stream requires a callback", xraudio_devices_input_str(source));
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   if(!XRAUDIO_DEVICE_INPUT_LOCAL_GET(source) || source == XRAUDIO_DEVICE_INPUT_MIC_TAP) { // Only the local keyword detector attaches the stream
+      XLOGD_ERROR("src <%s> cannot be armed", xraudio_devices_input_str(source));
+      return(XRAUDIO_RESULT_ERROR_INPUT);
+   }
+   XRAUDIO_RECORD_MUTEX_LOCK();
+
+   // Check if object contains this source (or SINGLE is requested when TRI, QUAD or ARRAY is available)
+   if(!XRAUDIO_DEVICE_INPUT_CONTAINS(obj->device, source) && !(source == XRAUDIO_DEVICE_INPUT_SINGLE && (obj->device & (XRAUDIO_DEVICE_INPUT_TRI | XRAUDIO_DEVICE_INPUT_QUAD | XRAUDIO_DEVICE_INPUT_ARRAY)))) {
+      XLOGD_ERROR("invalid source <%s>", xraudio_devices_input_str(source));
+      XLOGD_ERROR("valid sources  <%s>", xraudio_devices_input_str(obj->device));
+      XRAUDIO_RECORD_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_INPUT);
+   }
+
+   xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
+
+   // The keyword detector must be waiting for the keyword
+   if(session->state != XRAUDIO_INPUT_STATE_PENDING) {
+      XLOGD_ERROR("src <%s> keyword detection not pending <%s>", xraudio_devices_input_str(source), xraudio_input_state_str(session->state));
+      XRAUDIO_RECORD_MUTEX_UNLOCK();
+      return(XRAUDIO_RESULT_ERROR_STATE);
+   }
+
+   xraudio_result_t result = xraudio_input_stream_to_pipe_locked(obj, source, dsts, format_decoded, callback, param, true);
+   XRAUDIO_RECORD_MUTEX_UNLOCK();
+   return(result);
+}
+
+xraudio_result_t xraudio_input_stream_to_pipe_locked(xraudio_input_obj_t *obj, xraudio_devices_input_t source, xraudio_dst_pipe_t dsts[], xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param, bool armed) {
+   xraudio_input_session_t *session    = xraudio_input_source_to_session(obj, source);
+   xraudio_input_state_t    state_prev = session->state;
+
    if(dsts[0].pipe < 0) {
       XLOGD_ERROR("src <%s> invalid parameters - pipe[0] <%d>", xraudio_devices_input_str(source), dsts[0].pipe);
-      XRAUDIO_RECORD_MUTEX_UNLOCK();
       return(XRAUDIO_RESULT_ERROR_PARAMS);
    }
 
@@ -786,18 +946,19 @@ xraudio_result_t xraudio_input_stream_to_pipe(xraudio_input_object_t object, xra
 
       if((uint32_t)from >= XRAUDIO_INPUT_RECORD_FROM_INVALID || (uint32_t)until >= XRAUDIO_INPUT_RECORD_UNTIL_INVALID) {
          XLOGD_ERROR("src <%s> invalid from/until param", xraudio_devices_input_str(source));
-         XRAUDIO_RECORD_MUTEX_UNLOCK();
-         return(XRAUDIO_RESULT_ERROR_PARAMS);
+         return(xraudio_input_stream_to_pipe_revert(session, state_prev, XRAUDIO_RESULT_ERROR_PARAMS));
       }
       if(from == XRAUDIO_INPUT_RECORD_FROM_KEYWORD_BEGIN && !XRAUDIO_DEVICE_INPUT_LOCAL_GET(source)) {
          XLOGD_ERROR("src <%s> invalid from keyword point on non-local source <%s>", xraudio_devices_input_str(source), xraudio_input_record_from_str(from));
-         XRAUDIO_RECORD_MUTEX_UNLOCK();
-         return(XRAUDIO_RESULT_ERROR_PARAMS);
+         return(xraudio_input_stream_to_pipe_revert(session, state_prev, XRAUDIO_RESULT_ERROR_PARAMS));
       }
       if(from == XRAUDIO_INPUT_RECORD_FROM_BEGINNING && offset < 0) {
          XLOGD_ERROR("src <%s> invalid negative offset from beginning", xraudio_devices_input_str(source));
-         XRAUDIO_RECORD_MUTEX_UNLOCK();
-         return(XRAUDIO_RESULT_ERROR_PARAMS);
+         return(xraudio_input_stream_to_pipe_revert(session, state_prev, XRAUDIO_RESULT_ERROR_PARAMS));
+      }
+      if(from != XRAUDIO_INPUT_RECORD_FROM_LIVE && XRAUDIO_DEVICE_INPUT_LOCAL_GET(source) && session->channel_layout != XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO) { // Pre-detection audio is only kept for the active channel
+         XLOGD_ERROR("src <%s> invalid from <%s> for channel layout <%s>", xraudio_devices_input_str(source), xraudio_input_record_from_str(from), xraudio_stream_channel_layout_str(session->channel_layout));
+         return(xraudio_input_stream_to_pipe_revert(session, state_prev, XRAUDIO_RESULT_ERROR_PARAMS));
       }
 
       int flags = fcntl(pipe, F_GETFL);
@@ -809,8 +970,7 @@ xraudio_result_t xraudio_input_stream_to_pipe(xraudio_input_object_t object, xra
 
          if(fcntl(pipe, F_SETFL, flags) < 0) {
             XLOGD_ERROR("src <%s> unable to set pipe to non-blocking", xraudio_devices_input_str(source));
-            XRAUDIO_RECORD_MUTEX_UNLOCK();
-            return(XRAUDIO_RESULT_ERROR_FIFO_CONTROL);
+            return(xraudio_input_stream_to_pipe_revert(session, state_prev, XRAUDIO_RESULT_ERROR_FIFO_CONTROL));
          }
       }
 
@@ -823,8 +983,7 @@ xraudio_result_t xraudio_input_stream_to_pipe(xraudio_input_object_t object, xra
          XLOGD_INFO("src <%s> calling xraudio_hal_input_stream-start_set with offset %d", xraudio_devices_input_str(source), session->stream_keyword_begin);
          if(!xraudio_hal_input_stream_start_set(obj->hal_input_obj, session->stream_keyword_begin)) {
             XLOGD_ERROR("src <%s> failed to set stream start point", xraudio_devices_input_str(source));
-            XRAUDIO_RECORD_MUTEX_UNLOCK();
-            return(XRAUDIO_RESULT_ERROR_INPUT);
+            return(xraudio_input_stream_to_pipe_revert(session, state_prev, XRAUDIO_RESULT_ERROR_INPUT));
          }
       }
       XLOGD_INFO("src <%s> index <%u> pipe <%d> from <%s> offset <%d> until <%s> <%s>", xraudio_devices_input_str(source), index, pipe, xraudio_input_record_from_str(from), offset, xraudio_input_record_until_str(until), (callback == NULL) ? "sync" : "async");
@@ -834,7 +993,7 @@ xraudio_result_t xraudio_input_stream_to_pipe(xraudio_input_object_t object, xra
 
    session->format_out.container   = XRAUDIO_CONTAINER_NONE;
    session->format_out.encoding    = XRAUDIO_ENCODING_PCM;
-   session->format_out.channel_qty = (source == XRAUDIO_DEVICE_INPUT_QUAD) ? 4 : (source == XRAUDIO_DEVICE_INPUT_TRI) ? 3 : 1;
+   session->format_out.channel_qty = xraudio_devices_input_mic_qty(source, obj->mic_qty);
    session->format_out.sample_size = (format_decoded != NULL) ? format_decoded->sample_size : XRAUDIO_INPUT_DEFAULT_SAMPLE_SIZE;
 
    // Correct channel qty since the caller doesn't know this.  may need to revisit later.
@@ -844,8 +1003,15 @@ xraudio_result_t xraudio_input_stream_to_pipe(xraudio_input_object_t object, xra
 
    session->state = XRAUDIO_INPUT_STATE_STREAMING;
 
-   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, format_decoded, callback, param);
-   XRAUDIO_RECORD_MUTEX_UNLOCK();
+   return(xraudio_input_dispatch_record(obj, source, format_decoded, callback, param, armed));
+}
+
+// Drop the destinations set up before the error and return the session to the state it was in (pending for an armed stream)
+xraudio_result_t xraudio_input_stream_to_pipe_revert(xraudio_input_session_t *session, xraudio_input_state_t state, xraudio_result_t result) {
+   for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
+      session->fifo_audio_data[index] = -1;
+   }
+   session->state = state;
    return(result);
 }
 
@@ -909,7 +1075,7 @@ xraudio_result_t xraudio_input_stream_to_user(xraudio_input_object_t object, xra
 
    session->state = XRAUDIO_INPUT_STATE_STREAMING;
 
-   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, format_decoded, callback, param);
+   xraudio_result_t result = xraudio_input_dispatch_record(obj, source, format_decoded, callback, param, false);
    XRAUDIO_RECORD_MUTEX_UNLOCK();
    return(result);
 }
@@ -1012,6 +1178,19 @@ xraudio_result_t xraudio_input_frame_group_quantity_set(xraudio_object_t object,
    return(XRAUDIO_RESULT_OK);
 }
 
+xraudio_result_t xraudio_input_latency_budget_set(xraudio_object_t object, xraudio_devices_input_t source, uint16_t budget_ms) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+
+   xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
+
+   session->latency_budget_ms = budget_ms;
+   return(XRAUDIO_RESULT_OK);
+}
+
 xraudio_result_t xraudio_input_stream_identifer_set(xraudio_object_t object, xraudio_devices_input_t source, const char *identifer) {
    xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
    if(!xraudio_input_object_is_valid(obj)) {
@@ -1024,6 +1203,80 @@ xraudio_result_t xraudio_input_stream_identifer_set(xraudio_object_t object, xra
    return(XRAUDIO_RESULT_OK);
 }
 
+xraudio_result_t xraudio_input_stream_framing_set(xraudio_object_t object, xraudio_devices_input_t source, xraudio_stream_framing_t framing) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if((uint32_t)framing >= XRAUDIO_STREAM_FRAMING_INVALID) {
+      XLOGD_ERROR("invalid stream framing <%s>", xraudio_stream_framing_str(framing));
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   XLOGD_INFO("stream framing <%s>", xraudio_stream_framing_str(framing));
+
+   xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
+
+   session->framing = framing;
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_input_stream_buffer_pool_set(xraudio_object_t object, xraudio_devices_input_t source, uint8_t buffer_qty) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if(buffer_qty > XRAUDIO_STREAM_BUFFER_QTY_MAX) {
+      XLOGD_ERROR("invalid stream buffer quantity <%u>", buffer_qty);
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   XLOGD_INFO("stream buffer quantity <%u>", buffer_qty);
+
+   xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
+
+   if(session->state != XRAUDIO_INPUT_STATE_CREATED && session->state != XRAUDIO_INPUT_STATE_IDLING) { // The main thread may be lending the current pool
+      XLOGD_ERROR("src <%s> invalid state <%s>", xraudio_devices_input_str(source), xraudio_input_state_str(session->state));
+      return(XRAUDIO_RESULT_ERROR_STATE);
+   }
+
+   // The pool is allocated here rather than on the main thread.  It is sized for the output buffer of the channels in use.
+   uint32_t sample_qty = xraudio_in_frame_buffer_out_sample_qty(obj->device, obj->mic_qty);
+   if(buffer_qty == session->buffer_pool_qty && sample_qty == session->buffer_pool_sample_qty) {
+      return(XRAUDIO_RESULT_OK);
+   }
+   xraudio_in_stream_buffer_pool_destroy(session->buffer_pool, session->buffer_pool_qty);
+   session->buffer_pool_qty        = xraudio_in_stream_buffer_pool_create(session->buffer_pool, buffer_qty, sample_qty);
+   session->buffer_pool_sample_qty = sample_qty;
+   if(session->buffer_pool_qty < buffer_qty) {
+      return(XRAUDIO_RESULT_ERROR_INTERNAL);
+   }
+   return(XRAUDIO_RESULT_OK);
+}
+
+xraudio_result_t xraudio_input_stream_sample_format_set(xraudio_object_t object, xraudio_devices_input_t source, xraudio_stream_sample_format_t sample_format, xraudio_stream_channel_layout_t channel_layout) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+   if((uint32_t)sample_format >= XRAUDIO_STREAM_SAMPLE_FORMAT_INVALID) {
+      XLOGD_ERROR("invalid stream sample format <%s>", xraudio_stream_sample_format_str(sample_format));
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   if((uint32_t)channel_layout >= XRAUDIO_STREAM_CHANNEL_LAYOUT_INVALID) {
+      XLOGD_ERROR("invalid stream channel layout <%s>", xraudio_stream_channel_layout_str(channel_layout));
+      return(XRAUDIO_RESULT_ERROR_PARAMS);
+   }
+   XLOGD_INFO("stream sample format <%s> channel layout <%s>", xraudio_stream_sample_format_str(sample_format), xraudio_stream_channel_layout_str(channel_layout));
+
+   xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
+
+   session->sample_format  = sample_format;
+   session->channel_layout = channel_layout;
+   return(XRAUDIO_RESULT_OK);
+}
+
 xraudio_result_t xraudio_input_keyword_params(xraudio_input_object_t object, xraudio_keyword_phrase_t keyword_phrase, xraudio_keyword_sensitivity_t keyword_sensitivity) {
    xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
    if(!xraudio_input_object_is_valid(obj)) {
@@ -1057,6 +1310,35 @@ xraudio_result_t xraudio_input_keyword_params(xraudio_input_object_t object, xra
    return(XRAUDIO_RESULT_OK);
 }
 
+xraudio_result_t xraudio_input_keyword_reload(xraudio_input_object_t object, json_t *jkwd_config, xraudio_keyword_sensitivity_t keyword_sensitivity) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(XRAUDIO_RESULT_ERROR_OBJECT);
+   }
+
+   XRAUDIO_RECORD_MUTEX_LOCK();
+
+   XLOGD_INFO("keyword sensitivity <%f>", keyword_sensitivity);
+
+   // The new instance is initialized with this sensitivity so subsequent detect requests don't update it
+   obj->detect_params.sensitivity = keyword_sensitivity;
+
+   if(jkwd_config != NULL) {
+      json_incref(jkwd_config);
+   }
+
+   xraudio_queue_msg_detect_reload_t msg;
+   msg.header.type = XRAUDIO_MAIN_QUEUE_MSG_TYPE_DETECT_RELOAD;
+   msg.jkwd_config = jkwd_config;
+   msg.sensitivity = keyword_sensitivity;
+
+   xraudio_input_queue_msg_push(obj, (const char *)&msg, sizeof(msg));
+
+   XRAUDIO_RECORD_MUTEX_UNLOCK();
+   return(XRAUDIO_RESULT_OK);
+}
+
 xraudio_result_t xraudio_input_keyword_detect(xraudio_input_object_t object, keyword_callback_t callback, void *param, bool synchronous) {
    xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
    if(!xraudio_input_object_is_valid(obj)) {
@@ -1101,7 +1383,7 @@ void xraudio_input_keyword_detected(xraudio_input_object_t object) {
 
 #ifdef XRAUDIO_EOS_ENABLED
    if(session->state == XRAUDIO_INPUT_STATE_DETECTING && obj->dsp_config.eos_enabled) {
-      for (int i = 0; i < XRAUDIO_INPUT_MAX_CHANNEL_QTY; ++i) {
+      for (int i = 0; i < obj->eos_qty; ++i) {
          xraudio_eos_state_set_speech_begin(obj->obj_eos[i]);
       }
    }
@@ -1130,21 +1412,139 @@ unsigned char xraudio_input_signal_level_get(xraudio_input_object_t object, uint
       XLOGD_ERROR("Invalid object.");
       return(0);
    }
-   if(chan > XRAUDIO_INPUT_MAX_CHANNEL_QTY) {
+   if(chan >= XRAUDIO_INPUT_MAX_CHANNEL_QTY) {
       XLOGD_ERROR("Bad channel (%hu).", (uint16_t)chan);
       return(0);
    }
 
-#ifdef XRAUDIO_EOS_ENABLED
    xraudio_input_session_t *session = &obj->sessions[XRAUDIO_INPUT_SESSION_GROUP_DEFAULT];
 
-   if(obj->dsp_config.eos_enabled) {
-      if(session->state == XRAUDIO_INPUT_STATE_DETECTING || session->state == XRAUDIO_INPUT_STATE_RECORDING || session->state == XRAUDIO_INPUT_STATE_STREAMING) {
-         return(xraudio_eos_signal_level_get(obj->obj_eos[chan]));
-      }
+   if(session->state != XRAUDIO_INPUT_STATE_DETECTING && session->state != XRAUDIO_INPUT_STATE_RECORDING && session->state != XRAUDIO_INPUT_STATE_STREAMING) {
+      return(0);
+   }
+#ifdef XRAUDIO_EOS_ENABLED
+   if(obj->dsp_config.eos_enabled && chan < obj->eos_qty) {
+      return(xraudio_eos_signal_level_get(obj->obj_eos[chan]));
    }
 #endif
-   return(0);
+   // Without end of speech detection, derive the level from the frame features
+   xraudio_frame_features_t features;
+   if(!xraudio_input_frame_features_get(obj, chan, &features) || features.rms <= 0.0) {
+      return(0);
+   }
+   // Map -60 to 0 dBFS onto 0 to 100 percent
+   float level = (20.0 * log10f(features.rms) + 60.0) * (100.0 / 60.0);
+   if(level <= 0.0) {
+      return(0);
+   }
+   return((level >= 100.0) ? 100 : (unsigned char)level);
+}
+
+void xraudio_input_frame_features_set(xraudio_input_object_t object, const xraudio_frame_features_t *features, uint8_t chan_qty) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   if(chan_qty > XRAUDIO_INPUT_MAX_CHANNEL_QTY) {
+      chan_qty = XRAUDIO_INPUT_MAX_CHANNEL_QTY;
+   }
+   // Sequence lock so readers on other threads never see a partially updated frame.  Only the main thread writes.
+   int sequence = xraudio_atomic_int_get(&obj->features_sequence);
+   xraudio_atomic_int_set(&obj->features_sequence, sequence + 1);
+   memcpy(obj->features, features, chan_qty * sizeof(xraudio_frame_features_t));
+   obj->features_chan_qty = chan_qty;
+   xraudio_atomic_int_set(&obj->features_sequence, sequence + 2);
+}
+
+bool xraudio_input_frame_features_get(xraudio_input_object_t object, uint8_t chan, xraudio_frame_features_t *features) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(false);
+   }
+   if(chan >= XRAUDIO_INPUT_MAX_CHANNEL_QTY || features == NULL) {
+      return(false);
+   }
+   xraudio_atomic_int_set(&obj->features_requested, 1);
+
+   int  sequence;
+   bool valid;
+   do {
+      sequence = xraudio_atomic_int_get(&obj->features_sequence);
+      if(sequence & 1) { // update in progress
+         continue;
+      }
+      valid     = (chan < obj->features_chan_qty);
+      *features = obj->features[chan];
+   } while((sequence & 1) || sequence != xraudio_atomic_int_get(&obj->features_sequence));
+
+   return(valid);
+}
+
+void xraudio_input_memory_ring_begin(xraudio_input_object_t object, xraudio_devices_input_t source, uint32_t sample_qty) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
+
+   // Only the main thread writes
+   int sequence = xraudio_atomic_int_get(&session->memory_ring_sequence);
+   xraudio_atomic_int_set(&session->memory_ring_sequence, sequence + 1);
+   xraudio_atomic_int_set(&session->memory_ring_index, 0);
+   xraudio_atomic_int_set(&session->memory_ring_sample_qty, (int)sample_qty);
+   xraudio_atomic_int_set(&session->memory_ring_sequence, sequence + 2);
+}
+
+void xraudio_input_memory_ring_index_set(xraudio_input_object_t object, xraudio_devices_input_t source, uint32_t index) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
+
+   xraudio_atomic_int_set(&session->memory_ring_index, (int)index);
+}
+
+bool xraudio_input_memory_ring_index_get(xraudio_input_object_t object, xraudio_devices_input_t source, uint32_t *index, uint32_t *sample_qty_valid) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(false);
+   }
+   xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
+   int sequence;
+   int ring_index;
+   int ring_qty;
+
+   do {
+      sequence   = xraudio_atomic_int_get(&session->memory_ring_sequence);
+      ring_index = xraudio_atomic_int_get(&session->memory_ring_index);
+      ring_qty   = xraudio_atomic_int_get(&session->memory_ring_sample_qty);
+   } while((sequence & 1) || sequence != xraudio_atomic_int_get(&session->memory_ring_sequence));
+
+   if(ring_index < 0 || ring_qty <= 0) {
+      return(false);
+   }
+   if(ring_index >= ring_qty) {
+      *index            = (uint32_t)(ring_index - ring_qty);
+      *sample_qty_valid = (uint32_t)ring_qty;
+   } else {
+      *index            = (uint32_t)ring_index;
+      *sample_qty_valid = (uint32_t)ring_index;
+   }
+   return(true);
+}
+
+bool xraudio_input_frame_features_requested(xraudio_input_object_t object) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      return(false);
+   }
+   return(xraudio_atomic_int_get(&obj->features_requested) != 0);
 }
 
 uint16_t xraudio_input_signal_direction_get(xraudio_input_object_t object) {
@@ -1154,14 +1554,35 @@ uint16_t xraudio_input_signal_direction_get(xraudio_input_object_t object) {
       return(0);
    }
 
-   #ifdef XRAUDIO_SDF_ENABLED
    xraudio_input_session_t *session = &obj->sessions[XRAUDIO_INPUT_SESSION_GROUP_DEFAULT];
 
-   if(session->state == XRAUDIO_INPUT_STATE_DETECTING || session->state == XRAUDIO_INPUT_STATE_RECORDING || session->state == XRAUDIO_INPUT_STATE_STREAMING) {
-      return(xraudio_sdf_signal_direction_get(obj->obj_sdf));
+   if(session->state != XRAUDIO_INPUT_STATE_DETECTING && session->state != XRAUDIO_INPUT_STATE_RECORDING && session->state != XRAUDIO_INPUT_STATE_STREAMING) {
+      return(0);
    }
-   #endif
+   xraudio_doa_t doa;
+   if(xraudio_input_doa_get(obj, &doa)) { // direction of arrival estimator takes precedence
+      return(doa.angle);
+   }
+   #ifdef XRAUDIO_SDF_ENABLED
+   return(xraudio_sdf_signal_direction_get(obj->obj_sdf));
+   #else
    return(0);
+   #endif
+}
+
+bool xraudio_input_doa_get(xraudio_input_object_t object, xraudio_doa_t *doa) {
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return(false);
+   }
+   int track = xraudio_atomic_int_get(&obj->doa_track);
+
+   doa->valid      = (track & XRAUDIO_INPUT_DOA_VALID)  ? true : false;
+   doa->active     = (track & XRAUDIO_INPUT_DOA_ACTIVE) ? true : false;
+   doa->angle      = (uint16_t)(track & XRAUDIO_INPUT_DOA_ANGLE_MASK);
+   doa->confidence = (uint8_t)((track >> XRAUDIO_INPUT_DOA_CONFIDENCE_SHIFT) & 0xFF);
+   return(doa->valid);
 }
 
 xraudio_eos_event_t xraudio_input_eos_run(xraudio_input_object_t object, uint8_t chan, float *input_samples, int32_t sample_qty, int16_t *scaled_eos_samples) {
@@ -1171,7 +1592,7 @@ xraudio_eos_event_t xraudio_input_eos_run(xraudio_input_object_t object, uint8_t
       XLOGD_ERROR("Invalid object.");
       return(XRAUDIO_EOS_EVENT_NONE);
    }
-   if(chan > XRAUDIO_INPUT_MAX_CHANNEL_QTY) {
+   if(chan >= obj->eos_qty) {
       XLOGD_ERROR("Bad channel (%hu).", (uint16_t)chan);
       return(0);
    }
@@ -1190,7 +1611,7 @@ void xraudio_input_eos_state_set_speech_begin(xraudio_input_object_t object) {
    }
    if(obj->dsp_config.eos_enabled) {
       XLOGD_DEBUG("Keyword detected. Force VADEOS to start.");
-      for (int i = 0; i < XRAUDIO_INPUT_MAX_CHANNEL_QTY; ++i) {
+      for (int i = 0; i < obj->eos_qty; ++i) {
          xraudio_eos_state_set_speech_begin(obj->obj_eos[i]);
       }
    }
@@ -1234,14 +1655,21 @@ void xraudio_input_ppr_state_set_speech_begin(xraudio_input_object_t object) {
 #endif
 }
 
-void xraudio_input_sound_focus_update(xraudio_input_object_t object, uint32_t sample_qty) {
+void xraudio_input_sound_focus_update(xraudio_input_object_t object, uint32_t sample_qty, const xraudio_doa_t *doa) {
    xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
    if(!xraudio_input_object_is_valid(obj)) {
       XLOGD_ERROR("Invalid object.");
       return;
    }
+   if(doa != NULL && doa->valid) { // Publish the direction of arrival track
+      int track = XRAUDIO_INPUT_DOA_VALID | (doa->angle & XRAUDIO_INPUT_DOA_ANGLE_MASK) | (doa->confidence << XRAUDIO_INPUT_DOA_CONFIDENCE_SHIFT);
+      if(doa->active) {
+         track |= XRAUDIO_INPUT_DOA_ACTIVE;
+      }
+      xraudio_atomic_int_set(&obj->doa_track, track);
+   }
    #ifdef XRAUDIO_SDF_ENABLED
-   if(obj->device != XRAUDIO_DEVICE_INPUT_TRI && obj->device != XRAUDIO_DEVICE_INPUT_QUAD) {
+   if(obj->device != XRAUDIO_DEVICE_INPUT_TRI && obj->device != XRAUDIO_DEVICE_INPUT_QUAD && obj->device != XRAUDIO_DEVICE_INPUT_ARRAY) {
       XLOGD_DEBUG("Sound focus not valid for single microphone");
       return;
    }
@@ -1348,6 +1776,7 @@ xraudio_result_t xraudio_input_stop_locked(xraudio_input_obj_t *obj, xraudio_dev
    if(!more_streams) {
       session->audio_buf_samples       = NULL;
       session->audio_buf_sample_qty    = 0;
+      session->audio_buf_circular      = false;
       session->data_callback           = NULL;
       session->stream_time_minimum     = 0;
       session->stream_keyword_begin    = 0;
@@ -1460,7 +1889,7 @@ void xraudio_input_dispatch_idle_stop(xraudio_input_obj_t *obj) {
    sem_wait(&semaphore);
 }
 
-xraudio_result_t xraudio_input_dispatch_record(xraudio_input_obj_t *obj, xraudio_devices_input_t source, xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param) {
+xraudio_result_t xraudio_input_dispatch_record(xraudio_input_obj_t *obj, xraudio_devices_input_t source, xraudio_input_format_t *format_decoded, audio_in_callback_t callback, void *param, bool armed) {
    bool synchronous = (callback == NULL) ? true : false;
 
    xraudio_input_session_t *session = xraudio_input_source_to_session(obj, source);
@@ -1473,10 +1902,18 @@ xraudio_result_t xraudio_input_dispatch_record(xraudio_input_obj_t *obj, xraudio
    msg.param                   = param;
    msg.semaphore               = NULL;
    msg.frame_group_qty         = session->frame_group_qty;
+   msg.latency_budget_ms       = session->latency_budget_ms;
    msg.fh                      = session->fh;
    msg.audio_buf_samples       = session->audio_buf_samples;
    msg.audio_buf_sample_qty    = session->audio_buf_sample_qty;
+   msg.audio_buf_circular      = session->audio_buf_circular;
    msg.latency_mode            = session->latency_mode;
+   msg.framing                 = session->framing;
+   msg.sample_format           = session->sample_format;
+   msg.channel_layout          = session->channel_layout;
+   msg.buffer_qty              = session->buffer_pool_qty;
+   memcpy(msg.buffer_pool, session->buffer_pool, sizeof(msg.buffer_pool));
+   msg.armed                   = armed;
 
    // Reset latency mode flag back to normal. Latency mode will persist until the end of the stream.
    session->latency_mode       = XRAUDIO_STREAM_LATENCY_NORMAL;
@@ -1642,7 +2079,7 @@ xraudio_result_t xraudio_input_dispatch_capture_stop(xraudio_input_obj_t *obj) {
    return(XRAUDIO_RESULT_OK);
 }
 
-bool xraudio_input_audio_hal_open(xraudio_input_obj_t *obj, xraudio_devices_input_t device, xraudio_power_mode_t power_mode, bool privacy_mode, xraudio_input_format_t format, uint8_t *pcm_bit_qty, int *fd) {
+bool xraudio_input_audio_hal_open(xraudio_input_obj_t *obj, xraudio_devices_input_t device, xraudio_power_mode_t power_mode, bool privacy_mode, xraudio_input_format_t format, uint8_t *pcm_bit_qty, uint8_t *mic_qty, int *fd) {
    #ifdef INPUT_TIMING_DATA
    rdkx_timestamp_get(&obj->timing_data_input_open.begin);
    #endif
@@ -1650,15 +2087,17 @@ bool xraudio_input_audio_hal_open(xraudio_input_obj_t *obj, xraudio_devices_inpu
    xraudio_device_input_configuration_t configuration;
    configuration.fd               = -1;
    configuration.interval.tv_sec  = 0;
-   configuration.interval.tv_usec = 0;
+   configuration.interval.tv_usec = (obj->frame_period != XRAUDIO_INPUT_FRAME_PERIOD) ? obj->frame_period * 1000 : 0; // Only request a period from the HAL when it isn't the default
    configuration.pcm_bit_qty      = *pcm_bit_qty;
    configuration.power_mode       = power_mode;
    configuration.privacy_mode     = privacy_mode;
+   configuration.mic_qty          = *mic_qty;
 
    obj->hal_input_obj = xraudio_hal_input_open(obj->hal_obj, device, format, &configuration);
 
-   // Get the bit qty back from the hal object
+   // Get the bit qty and mic qty back from the hal object
    *pcm_bit_qty = configuration.pcm_bit_qty;
+   *mic_qty     = configuration.mic_qty;
    *fd          = configuration.fd;
    
    #ifdef INPUT_TIMING_DATA
@@ -1763,6 +2202,13 @@ void xraudio_input_stats_timestamp_frame_read(xraudio_input_object_t object) {
    #endif
 }
 
+void xraudio_input_stats_timestamp_frame_convert(xraudio_input_object_t object) {
+   #ifdef INPUT_TIMING_DATA
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   rdkx_timestamp_get(&obj->timing_data_current->time_convert);
+   #endif
+}
+
 void xraudio_input_stats_timestamp_frame_eos(xraudio_input_object_t object) {
    #ifdef INPUT_TIMING_DATA
    xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
@@ -1812,6 +2258,42 @@ void xraudio_input_ppr_info_get(xraudio_input_object_t object, char **dsp_name)
    #endif
 }
 
+void xraudio_input_dsp_state_save(xraudio_input_object_t object) {
+   #ifdef XRAUDIO_DSP_STATE_ENABLED
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   #ifdef XRAUDIO_EOS_ENABLED
+   for(uint8_t chan = 0; chan < obj->eos_qty; chan++) {
+      xraudio_dsp_snapshot_save(&obj->eos_snapshot[chan], XRAUDIO_DSP_PLUGIN_EOS, obj->obj_eos[chan], xraudio_eos_snapshot_size, xraudio_eos_snapshot_save);
+   }
+   #endif
+   #ifdef XRAUDIO_PPR_ENABLED
+   xraudio_dsp_snapshot_save(&obj->ppr_snapshot, XRAUDIO_DSP_PLUGIN_PPR, obj->obj_ppr, xraudio_ppr_snapshot_size, xraudio_ppr_snapshot_save);
+   #endif
+   #endif
+}
+
+void xraudio_input_dsp_state_restore(xraudio_input_object_t object) {
+   #ifdef XRAUDIO_DSP_STATE_ENABLED
+   xraudio_input_obj_t *obj = (xraudio_input_obj_t *)object;
+   if(!xraudio_input_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   #ifdef XRAUDIO_EOS_ENABLED
+   for(uint8_t chan = 0; chan < obj->eos_qty; chan++) {
+      xraudio_dsp_snapshot_restore(&obj->eos_snapshot[chan], XRAUDIO_DSP_PLUGIN_EOS, obj->obj_eos[chan], xraudio_eos_snapshot_restore);
+   }
+   #endif
+   #ifdef XRAUDIO_PPR_ENABLED
+   xraudio_dsp_snapshot_restore(&obj->ppr_snapshot, XRAUDIO_DSP_PLUGIN_PPR, obj->obj_ppr, xraudio_ppr_snapshot_restore);
+   #endif
+   #endif
+}
+
 static void xraudio_input_stats_timing_print(xraudio_input_obj_t *obj) {
    #ifndef INPUT_TIMING_DATA
    XLOGD_INFO("timing data collection is disabled");
@@ -1824,15 +2306,15 @@ static void xraudio_input_stats_timing_print(xraudio_input_obj_t *obj) {
       return;
    }
 
-   int64_t  sum_read =  0, sum_eos =  0, sum_snd_foc =  0, sum_process =  0, sum_capture =  0, sum_total =  0;
-   int64_t  vio_read =  0, vio_eos =  0, vio_snd_foc =  0, vio_process =  0, vio_capture =  0, vio_total =  0;
-   int64_t  max_read =  0, max_eos =  0, max_snd_foc =  0, max_process =  0, max_capture =  0, max_total =  0;
-   int64_t  min_read = LLONG_MAX, min_eos = LLONG_MAX, min_snd_foc = LLONG_MAX, min_process = LLONG_MAX, min_capture = LLONG_MAX, min_total = LLONG_MAX;
-   int64_t  avg_read, avg_eos, avg_snd_foc, avg_process, avg_capture, avg_total;
+   int64_t  sum_read =  0, sum_convert =  0, sum_eos =  0, sum_snd_foc =  0, sum_process =  0, sum_capture =  0, sum_total =  0;
+   int64_t  vio_read =  0, vio_convert =  0, vio_eos =  0, vio_snd_foc =  0, vio_process =  0, vio_capture =  0, vio_total =  0;
+   int64_t  max_read =  0, max_convert =  0, max_eos =  0, max_snd_foc =  0, max_process =  0, max_capture =  0, max_total =  0;
+   int64_t  min_read = LLONG_MAX, min_convert = LLONG_MAX, min_eos = LLONG_MAX, min_snd_foc = LLONG_MAX, min_process = LLONG_MAX, min_capture = LLONG_MAX, min_total = LLONG_MAX;
+   int64_t  avg_read, avg_convert, avg_eos, avg_snd_foc, avg_process, avg_capture, avg_total;
    uint32_t sample_qty = 0;
 
    
-   printf("%12s %12s %12s   %12s %12s %12s %12s %12s %12s\n", "Optimal(ms)", "Actual(ms)", "Delta(us)", "Read(us)", "EOS(us)", "SND FOC(us)", "Process(us)", "Capture(us)", "Total(us)");
+   printf("%12s %12s %12s   %12s %12s %12s %12s %12s %12s %12s\n", "Optimal(ms)", "Actual(ms)", "Delta(us)", "Read(us)", "Convert(us)", "EOS(us)", "SND FOC(us)", "Process(us)", "Capture(us)", "Total(us)");
    for(uint32_t index = 0; index < INPUT_TIMING_SAMPLE_QTY - 1; index++) {
       if(obj->timing_data_begin[index + 1].optimal.tv_sec != 0) { // Ignore last entry which is invalid
          int64_t elapsed_optimal = rdkx_timestamp_subtract_ms(obj->timing_data_begin[0].actual,      obj->timing_data_begin[index].optimal);
@@ -1840,43 +2322,48 @@ static void xraudio_input_stats_timing_print(xraudio_input_obj_t *obj) {
          int64_t elapsed_delta   = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].optimal, obj->timing_data_begin[index].actual);
    
          int64_t elapsed_read    = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].actual,       obj->timing_data_begin[index].time_read);
-         int64_t elapsed_eos     = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].time_read,    obj->timing_data_begin[index].time_eos);
+         int64_t elapsed_convert = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].time_read,    obj->timing_data_begin[index].time_convert);
+         int64_t elapsed_eos     = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].time_convert, obj->timing_data_begin[index].time_eos);
          int64_t elapsed_snd_foc = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].time_eos,     obj->timing_data_begin[index].time_snd_foc);
          int64_t elapsed_process = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].time_snd_foc, obj->timing_data_begin[index].time_process);
          int64_t elapsed_capture = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].time_process, obj->timing_data_begin[index].time_capture);
          int64_t elapsed_total   = rdkx_timestamp_subtract_us(obj->timing_data_begin[index].actual,       obj->timing_data_begin[index].time_capture);
    
-         printf("%12lld %12lld %12lld %1s %12lld %12lld %12lld  %12lld %12lld %12lld\n", elapsed_optimal, elapsed_actual, elapsed_delta, obj->timing_data_begin[index].playback ? "P" : "", elapsed_read, elapsed_eos, elapsed_snd_foc, elapsed_process, elapsed_capture, elapsed_total);
+         printf("%12lld %12lld %12lld %1s %12lld %12lld %12lld %12lld  %12lld %12lld %12lld\n", elapsed_optimal, elapsed_actual, elapsed_delta, obj->timing_data_begin[index].playback ? "P" : "", elapsed_read, elapsed_convert, elapsed_eos, elapsed_snd_foc, elapsed_process, elapsed_capture, elapsed_total);
 
          if(index == 0) { // Ignore first sample in calculations
             continue;
          }
          sample_qty++;
          if(elapsed_read    < min_read)    { min_read    = elapsed_read;    }
+         if(elapsed_convert < min_convert) { min_convert = elapsed_convert; }
          if(elapsed_eos     < min_eos)     { min_eos     = elapsed_eos;     }
          if(elapsed_snd_foc < min_snd_foc) { min_snd_foc = elapsed_snd_foc; }
          if(elapsed_process < min_process) { min_process = elapsed_process; }
          if(elapsed_capture < min_capture) { min_capture = elapsed_capture; }
          if(elapsed_total   < min_total)   { min_total   = elapsed_total;   }
          if(elapsed_read    > max_read)    { max_read    = elapsed_read;    }
+         if(elapsed_convert > max_convert) { max_convert = elapsed_convert; }
          if(elapsed_eos     > max_eos)     { max_eos     = elapsed_eos;     }
          if(elapsed_snd_foc > max_snd_foc) { max_snd_foc = elapsed_snd_foc; }
          if(elapsed_process > max_process) { max_process = elapsed_process; }
          if(elapsed_capture > max_capture) { max_capture = elapsed_capture; }
          if(elapsed_total   > max_total)   { max_total   = elapsed_total;   }
          sum_read    += elapsed_read;
+         sum_convert += elapsed_convert;
          sum_eos     += elapsed_eos;
          sum_snd_foc += elapsed_snd_foc;
          sum_process += elapsed_process;
          sum_capture += elapsed_capture;
          sum_total   += elapsed_total;
 
-         if(elapsed_read    >= XRAUDIO_INPUT_FRAME_PERIOD * 1000) { vio_read++;    }
-         if(elapsed_eos     >= XRAUDIO_INPUT_FRAME_PERIOD * 1000) { vio_eos++;     }
-         if(elapsed_snd_foc >= XRAUDIO_INPUT_FRAME_PERIOD * 1000) { vio_snd_foc++; }
-         if(elapsed_process >= XRAUDIO_INPUT_FRAME_PERIOD * 1000) { vio_process++; }
-         if(elapsed_capture >= XRAUDIO_INPUT_FRAME_PERIOD * 1000) { vio_capture++; }
-         if(elapsed_total   >= XRAUDIO_INPUT_FRAME_PERIOD * 1000) { vio_total++;   }
+         if(elapsed_read    >= obj->frame_period * 1000) { vio_read++;    }
+         if(elapsed_convert >= obj->frame_period * 1000) { vio_convert++; }
+         if(elapsed_eos     >= obj->frame_period * 1000) { vio_eos++;     }
+         if(elapsed_snd_foc >= obj->frame_period * 1000) { vio_snd_foc++; }
+         if(elapsed_process >= obj->frame_period * 1000) { vio_process++; }
+         if(elapsed_capture >= obj->frame_period * 1000) { vio_capture++; }
+         if(elapsed_total   >= obj->frame_period * 1000) { vio_total++;   }
       }
    }
    if(sample_qty == 0) {
@@ -1885,6 +2372,7 @@ static void xraudio_input_stats_timing_print(xraudio_input_obj_t *obj) {
    }
    
    avg_read    = sum_read    / sample_qty;
+   avg_convert = sum_convert / sample_qty;
    avg_eos     = sum_eos     / sample_qty;
    avg_snd_foc = sum_snd_foc / sample_qty;
    avg_process = sum_process / sample_qty;
@@ -1894,6 +2382,7 @@ static void xraudio_input_stats_timing_print(xraudio_input_obj_t *obj) {
    // Print Avg, Max and Min for each step
    printf("        : %12s %12s %12s %12s\n", "Average", "Min", "Max", "Violation");
    printf("MIC READ: %12lld %12lld %12lld %12lld\n", avg_read,    min_read,    max_read,    vio_read);
+   printf("CONVERT : %12lld %12lld %12lld %12lld\n", avg_convert, min_convert, max_convert, vio_convert);
    printf("EOS     : %12lld %12lld %12lld %12lld\n", avg_eos,     min_eos,     max_eos,     vio_eos);
    printf("SND FOC : %12lld %12lld %12lld %12lld\n", avg_snd_foc, min_snd_foc, max_snd_foc, vio_snd_foc);
    printf("PROCESS : %12lld %12lld %12lld %12lld\n", avg_process, min_process, max_process, vio_process);
@@ -98,7 +98,7 @@ typedef struct {
 typedef struct {
    float    score;
    float    snr;
-   uint16_t doa;
+   uint16_t doa;          ///< direction of arrival (in degrees).  The direction of arrival estimate replaces the per channel value when the estimator is enabled and has a valid estimate.
    float    dynamic_gain;
 } xraudio_kwd_chan_result_t;
 
@@ -184,6 +184,28 @@ bool                 xraudio_kwd_sensitivity_limits_get(xraudio_kwd_object_t obj
 /// @param[in]
 bool                 xraudio_kwd_sensitivity_lut_check(xraudio_kwd_object_t object, xraudio_keyword_sensitivity_t *sensitivity_lut, uint8_t sensitivity_lut_size);
 
+/// @brief Retrieve the size of an xraudio KWD state snapshot
+/// @details Retrieves the size of the buffer needed to save the adapted state of the keyword detector session (noise estimate, normalization, etc).  Only called when xraudio is built with XRAUDIO_DSP_STATE_ENABLED.
+/// @param[in] object Reference to an xraudio KWD object.
+/// @return The function returns the size of the snapshot in bytes or zero if the state cannot be saved.
+uint32_t             xraudio_kwd_snapshot_size(xraudio_kwd_object_t object);
+
+/// @brief Save an xraudio KWD state snapshot
+/// @details Saves the adapted state of the keyword detector session (noise estimate, normalization, etc) so it can be restored after the KWD is reinitialized.
+/// @param[in]  object Reference to an xraudio KWD object.
+/// @param[out] state  Pointer to the snapshot buffer.
+/// @param[in]  size   Size of the snapshot buffer in bytes.
+/// @return The function returns true for success and false for failure.
+bool                 xraudio_kwd_snapshot_save(xraudio_kwd_object_t object, void *state, uint32_t size);
+
+/// @brief Restore an xraudio KWD state snapshot
+/// @details Restores a snapshot saved by xraudio_kwd_snapshot_save.  The snapshot must be rejected if it does not match the current configuration of the KWD.
+/// @param[in] object Reference to an xraudio KWD object.
+/// @param[in] state  Pointer to the snapshot buffer.
+/// @param[in] size   Size of the snapshot in bytes.
+/// @return The function returns true for success and false for failure.
+bool                 xraudio_kwd_snapshot_restore(xraudio_kwd_object_t object, const void *state, uint32_t size);
+
 /// @}
 
 #ifdef __cplusplus
@@ -0,0 +1,106 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "xraudio.h"
+#include "xraudio_private.h"
+#include "xraudio_atomic.h"
+#include "xraudio_latency.h"
+
+// Latency histograms.  Each stage counts its samples in fixed buckets.  The counters are only updated with compare and set so any thread
+// can record a sample while the application reads or resets the histograms.  A sample recorded during a reset may be kept.
+
+typedef struct {
+   xraudio_atomic_int_t bucket_qty[XRAUDIO_LATENCY_BUCKET_QTY];
+   xraudio_atomic_int_t max_us;
+} xraudio_latency_stage_histogram_t;
+
+static void xraudio_latency_atomic_max(xraudio_atomic_int_t *atomic, int value);
+
+// upper limit of each bucket (in microseconds), the last bucket holds all larger samples
+static const uint32_t g_latency_bucket_limit_us[XRAUDIO_LATENCY_BUCKET_QTY] = { 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000, 2000000, UINT32_MAX };
+
+static xraudio_latency_stage_histogram_t g_latency_histograms[XRAUDIO_LATENCY_STAGE_INVALID];
+
+void xraudio_latency_record(xraudio_latency_stage_t stage, uint32_t latency_us) {
+   if((uint32_t)stage >= XRAUDIO_LATENCY_STAGE_INVALID) {
+      return;
+   }
+   xraudio_latency_stage_histogram_t *histogram = &g_latency_histograms[stage];
+   uint32_t bucket = 0;
+
+   while(latency_us > g_latency_bucket_limit_us[bucket]) {
+      bucket++;
+   }
+   xraudio_atomic_int_add(&histogram->bucket_qty[bucket], 1);
+   xraudio_latency_atomic_max(&histogram->max_us, (latency_us > INT32_MAX) ? INT32_MAX : (int)latency_us);
+}
+
+void xraudio_latency_histogram_read(xraudio_latency_stage_t stage, xraudio_latency_histogram_t *histogram) {
+   memset(histogram, 0, sizeof(*histogram));
+   if((uint32_t)stage >= XRAUDIO_LATENCY_STAGE_INVALID) {
+      return;
+   }
+   xraudio_latency_stage_histogram_t *stage_histogram = &g_latency_histograms[stage];
+
+   for(uint32_t bucket = 0; bucket < XRAUDIO_LATENCY_BUCKET_QTY; bucket++) {
+      histogram->bucket_limit_us[bucket] = g_latency_bucket_limit_us[bucket];
+      histogram->bucket_qty[bucket]      = (uint32_t)xraudio_atomic_int_get(&stage_histogram->bucket_qty[bucket]);
+      histogram->sample_qty             += histogram->bucket_qty[bucket];
+   }
+   histogram->max_us = (uint32_t)xraudio_atomic_int_get(&stage_histogram->max_us);
+
+   // The percentiles are the upper limit of the bucket which holds them (no larger than the maximum)
+   uint32_t *percentiles[3]    = { &histogram->p50_us, &histogram->p90_us, &histogram->p99_us };
+   uint32_t  percentile_pct[3] = { 50, 90, 99 };
+   for(uint32_t index = 0; index < 3 && histogram->sample_qty > 0; index++) {
+      uint64_t threshold = ((uint64_t)histogram->sample_qty * percentile_pct[index] + 99) / 100;
+      uint64_t sample_qty = 0;
+      for(uint32_t bucket = 0; bucket < XRAUDIO_LATENCY_BUCKET_QTY; bucket++) {
+         sample_qty += histogram->bucket_qty[bucket];
+         if(sample_qty >= threshold) {
+            *percentiles[index] = (histogram->bucket_limit_us[bucket] < histogram->max_us) ? histogram->bucket_limit_us[bucket] : histogram->max_us;
+            break;
+         }
+      }
+   }
+}
+
+void xraudio_latency_reset(void) {
+   for(uint32_t stage = 0; stage < XRAUDIO_LATENCY_STAGE_INVALID; stage++) {
+      xraudio_latency_stage_histogram_t *histogram = &g_latency_histograms[stage];
+      for(uint32_t bucket = 0; bucket < XRAUDIO_LATENCY_BUCKET_QTY; bucket++) {
+         xraudio_atomic_int_set(&histogram->bucket_qty[bucket], 0);
+      }
+      xraudio_atomic_int_set(&histogram->max_us, 0);
+   }
+}
+
+void xraudio_latency_atomic_max(xraudio_atomic_int_t *atomic, int value) {
+   int current;
+   do {
+      current = xraudio_atomic_int_get(atomic);
+      if(current >= value) {
+         return;
+      }
+   } while(!xraudio_atomic_compare_and_set(atomic, current, value));
+}
@@ -0,0 +1,31 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef __XRAUDIO_LATENCY_H__
+#define __XRAUDIO_LATENCY_H__
+
+#include <stdint.h>
+#include "xraudio.h"
+
+void xraudio_latency_record(xraudio_latency_stage_t stage, uint32_t latency_us);
+void xraudio_latency_histogram_read(xraudio_latency_stage_t stage, xraudio_latency_histogram_t *histogram);
+void xraudio_latency_reset(void);
+
+#endif
@@ -40,6 +40,11 @@ typedef struct {
    uint8_t                        user_id;
    xraudio_hal_obj_t              hal_obj;
    xraudio_hal_output_obj_t       hal_output_obj;
+   bool                           standby;          // keep the speaker stream open between playbacks
+   bool                           standby_held;     // the speaker stream is held open in standby
+   bool                           standby_exit;     // the playback is started on the stream held in standby
+   bool                           standby_reopened; // the stream held in standby was reopened in the format of the playback
+   xraudio_output_format_t        standby_format;
    int                            msgq;
    sem_t                          mutex_play;
    xraudio_output_state_t         state;
@@ -61,7 +66,8 @@ typedef struct {
    int8_t                         ramp_enable;
    int8_t                         use_external_gain; // set to 1 to use hal api for volume control or 0 to use volume control library
    #ifdef XRAUDIO_EOS_ENABLED
-   xraudio_eos_object_t           obj_eos;
+   xraudio_eos_object_t           obj_eos;     // created at the first playback or standby entry
+   json_t *                       jeos_config;
    #endif
    #ifdef XRAUDIO_OVC_ENABLED
    xraudio_ovc_object_t           obj_ovc;
@@ -72,13 +78,17 @@ typedef struct {
 static bool             xraudio_output_object_is_valid(xraudio_output_obj_t *obj);
 static long             xraudio_output_container_header_parse(xraudio_output_obj_t *obj, xraudio_container_t container, FILE *fh, const unsigned char *header, unsigned long size, uint32_t *data_length);
 static void             xraudio_output_queue_msg_push(xraudio_output_obj_t *obj, const char *msg, xr_mq_msg_size_t msg_size);
-//static xraudio_result_t xraudio_output_dispatch_idle(xraudio_output_obj_t *obj);
+static xraudio_result_t xraudio_output_dispatch_idle(xraudio_output_obj_t *obj, rdkx_timestamp_t timestamp);
 static xraudio_result_t xraudio_output_dispatch_play(xraudio_output_obj_t *obj, audio_out_callback_t callback, void *param);
 static xraudio_result_t xraudio_output_dispatch_pause(xraudio_output_obj_t *obj, audio_out_callback_t callback, void *param);
 static xraudio_result_t xraudio_output_dispatch_resume(xraudio_output_obj_t *obj, audio_out_callback_t callback, void *param);
 static xraudio_result_t xraudio_output_dispatch_stop(xraudio_output_obj_t *obj, audio_out_callback_t callback, void *param);
 static bool             xraudio_output_audio_hal_open(xraudio_output_obj_t *obj);
 static void             xraudio_output_audio_hal_close(xraudio_output_obj_t *obj);
+static bool             xraudio_output_audio_hal_acquire(xraudio_output_obj_t *obj);
+static void             xraudio_output_standby_enter(xraudio_output_obj_t *obj);
+static void             xraudio_output_standby_exit(xraudio_output_obj_t *obj);
+static void             xraudio_output_eos_create(xraudio_output_obj_t *obj);
 static void             xraudio_output_sound_intensity_fifo_open(xraudio_output_obj_t *obj);
 static void             xraudio_output_sound_intensity_fifo_close(xraudio_output_obj_t *obj);
 
@@ -121,6 +131,11 @@ xraudio_output_object_t xraudio_output_object_create(xraudio_hal_obj_t hal_obj,
    obj->pipe_audio_data      = -1;
    obj->data_callback        = NULL;
    obj->hal_output_obj       = NULL;
+   obj->standby              = false;
+   obj->standby_held         = false;
+   obj->standby_exit         = false;
+   obj->standby_reopened     = false;
+   obj->standby_format       = obj->format;
    obj->fifo_sound_intensity = -1;
    obj->volume_left          = XRAUDIO_VOLUME_NOM;
    obj->volume_right         = XRAUDIO_VOLUME_NOM;
@@ -144,7 +159,11 @@ xraudio_output_object_t xraudio_output_object_create(xraudio_hal_obj_t hal_obj,
       }
    }
 
-   obj->obj_eos              = xraudio_eos_object_create(true, jeos_config);
+   obj->obj_eos              = NULL;
+   obj->jeos_config          = jeos_config;
+   if(jeos_config != NULL) {
+      json_incref(jeos_config);
+   }
    #endif
    obj->use_external_gain    = (capabilities & XRAUDIO_CAPS_OUTPUT_HAL_VOLUME_CONTROL) ? 1 : 0;
    obj->ramp_enable          = 1;
@@ -175,6 +194,10 @@ void xraudio_output_object_destroy(xraudio_output_object_t object) {
          xraudio_eos_object_destroy(obj->obj_eos);
          obj->obj_eos = NULL;
       }
+      if(obj->jeos_config != NULL) {
+         json_decref(obj->jeos_config);
+         obj->jeos_config = NULL;
+      }
       #endif
       #ifdef XRAUDIO_OVC_ENABLED
       if(obj->obj_ovc != NULL) {
@@ -255,14 +278,65 @@ void xraudio_output_close(xraudio_output_object_t object) {
 }
 
 void xraudio_output_close_locked(xraudio_output_obj_t *obj) {
+   obj->standby = false; // The stream held in standby is closed with the speaker
+
    if(obj->state > XRAUDIO_OUTPUT_STATE_IDLING && obj->state < XRAUDIO_OUTPUT_STATE_INVALID) {
       // Stop the playback in process
       xraudio_output_stop_locked(obj);
    }
+   xraudio_output_standby_exit(obj);
 
    obj->state = XRAUDIO_OUTPUT_STATE_CREATED;
 }
 
+void xraudio_output_standby_enable(xraudio_output_object_t object) {
+   xraudio_output_obj_t *obj = (xraudio_output_obj_t *)object;
+   if(!xraudio_output_object_is_valid(obj)) {
+      XLOGD_ERROR("Invalid object.");
+      return;
+   }
+   XRAUDIO_PLAY_MUTEX_LOCK();
+   if(obj->state != XRAUDIO_OUTPUT_STATE_IDLING) {
+      XLOGD_ERROR("session in progress <%s>", xraudio_output_state_str(obj->state));
+      XRAUDIO_PLAY_MUTEX_UNLOCK();
+      return;
+   }
+   obj->standby = true;
+   xraudio_output_eos_create(obj);
+
+   // Open the stream in the default format ahead of the first playback
+   obj->format.container = XRAUDIO_CONTAINER_NONE;
+   obj->format.encoding  = XRAUDIO_ENCODING_PCM;
+   xraudio_output_standby_enter(obj);
+   XRAUDIO_PLAY_MUTEX_UNLOCK();
+}
+
+void xraudio_output_standby_enter(xraudio_output_obj_t *obj) {
+   rdkx_timestamp_t timestamp;
+   rdkx_timestamp_get(&timestamp);
+
+   if(obj->hal_output_obj == NULL && !xraudio_output_audio_hal_open(obj)) {
+      XLOGD_ERROR("Unable to open speaker interface for standby");
+      return;
+   }
+   XLOGD_INFO("Sample rate %u %u-bit %s <standby>", obj->format.sample_rate, obj->format.sample_size * 8, xraudio_channel_qty_str(obj->format.channel_qty));
+
+   obj->standby_format = obj->format;
+   obj->standby_held   = true;
+   xraudio_output_dispatch_idle(obj, timestamp);
+}
+
+void xraudio_output_standby_exit(xraudio_output_obj_t *obj) {
+   if(!obj->standby_held) {
+      return;
+   }
+   XLOGD_INFO("");
+
+   xraudio_output_dispatch_stop(obj, NULL, NULL);
+   xraudio_output_audio_hal_close(obj);
+   obj->standby_held = false;
+}
+
 xraudio_result_t xraudio_output_play_from_file(xraudio_output_object_t object, const char *audio_file_path, audio_out_callback_t callback, void *param) {
    xraudio_output_obj_t *obj = (xraudio_output_obj_t *)object;
    if(!xraudio_output_object_is_valid(obj)) {
@@ -318,7 +392,7 @@ xraudio_result_t xraudio_output_play_from_file(xraudio_output_object_t object, c
       return(XRAUDIO_RESULT_ERROR_FILE_SEEK);
    }
    
-   if(!xraudio_output_audio_hal_open(obj)) {
+   if(!xraudio_output_audio_hal_acquire(obj)) {
       XLOGD_ERROR("Unable to open speaker interface");
       fclose(obj->fh);
       obj->fh = NULL;
@@ -389,7 +463,7 @@ xraudio_result_t xraudio_output_play_from_memory(xraudio_output_object_t object,
       return(XRAUDIO_RESULT_ERROR_PARAMS);
    }
 
-   if(!xraudio_output_audio_hal_open(obj)) {
+   if(!xraudio_output_audio_hal_acquire(obj)) {
       XLOGD_ERROR("Unable to open speaker interface");
       XRAUDIO_PLAY_MUTEX_UNLOCK();
       return(XRAUDIO_RESULT_ERROR_OUTPUT_OPEN);
@@ -457,7 +531,7 @@ xraudio_result_t xraudio_output_play_from_pipe(xraudio_output_object_t object, x
       }
    }
 
-   if(!xraudio_output_audio_hal_open(obj)) {
+   if(!xraudio_output_audio_hal_acquire(obj)) {
       XLOGD_ERROR("Unable to open speaker interface");
       XRAUDIO_PLAY_MUTEX_UNLOCK();
       return(XRAUDIO_RESULT_ERROR_OUTPUT_OPEN);
@@ -510,7 +584,7 @@ xraudio_result_t xraudio_output_play_from_user(xraudio_output_object_t object, x
 
    obj->format = *format;
 
-   if(!xraudio_output_audio_hal_open(obj)) {
+   if(!xraudio_output_audio_hal_acquire(obj)) {
       XLOGD_ERROR("Unable to open speaker interface");
       XRAUDIO_PLAY_MUTEX_UNLOCK();
       return(XRAUDIO_RESULT_ERROR_OUTPUT_OPEN);
@@ -595,22 +669,31 @@ xraudio_result_t xraudio_output_stop_locked(xraudio_output_obj_t *obj) {
 
    xraudio_output_sound_intensity_fifo_close(obj);
 
-   // Close the speaker interface
-   xraudio_output_audio_hal_close(obj);
-
    obj->state = XRAUDIO_OUTPUT_STATE_IDLING;
+
+   if(obj->standby) { // Keep the speaker interface open for the next playback
+      xraudio_output_standby_enter(obj);
+   } else {
+      // Close the speaker interface
+      xraudio_output_audio_hal_close(obj);
+   }
    return(XRAUDIO_RESULT_OK);
 }
 
-//xraudio_result_t xraudio_output_dispatch_idle(xraudio_output_obj_t *obj) {
-//   xraudio_queue_msg_detect_t msg;
-//   msg.header.type          = XRAUDIO_QUEUE_MSG_TYPE_PLAY_IDLE;
-//   xraudio_output_queue_msg_push(obj, (const char *)&msg, sizeof(msg));
-//   return(XRAUDIO_RESULT_OK);
-//}
+xraudio_result_t xraudio_output_dispatch_idle(xraudio_output_obj_t *obj, rdkx_timestamp_t timestamp) {
+   xraudio_queue_msg_play_idle_t msg;
+   msg.header.type    = XRAUDIO_MAIN_QUEUE_MSG_TYPE_PLAY_IDLE;
+   msg.hal_output_obj = obj->hal_output_obj;
+   msg.format         = obj->format;
+   msg.timestamp      = timestamp;
+   xraudio_output_queue_msg_push(obj, (const char *)&msg, sizeof(msg));
+   return(XRAUDIO_RESULT_OK);
+}
 
 xraudio_result_t xraudio_output_dispatch_play(xraudio_output_obj_t *obj, audio_out_callback_t callback, void *param) {
    bool synchronous = (callback == NULL) ? true : false;
+   xraudio_output_eos_create(obj);
+
    xraudio_queue_msg_play_start_t msg;
    msg.header.type          = XRAUDIO_MAIN_QUEUE_MSG_TYPE_PLAY_START;
    msg.hal_output_obj       = obj->hal_output_obj;
@@ -624,6 +707,9 @@ xraudio_result_t xraudio_output_dispatch_play(xraudio_output_obj_t *obj, audio_o
    msg.pipe                 = obj->pipe_audio_data;
    msg.data_callback        = obj->data_callback;
    msg.fifo_sound_intensity = obj->fifo_sound_intensity;
+   msg.standby              = obj->standby_exit;
+   msg.reopened             = obj->standby_reopened;
+   rdkx_timestamp_get(&msg.timestamp);
 
    if(synchronous) { // synchronous
       sem_t semaphore;
@@ -731,6 +817,23 @@ bool xraudio_output_audio_hal_open(xraudio_output_obj_t *obj) {
    return(obj->hal_output_obj != NULL);
 }
 
+bool xraudio_output_audio_hal_acquire(xraudio_output_obj_t *obj) {
+   obj->standby_exit     = obj->standby_held;
+   obj->standby_reopened = false;
+
+   if(obj->standby_held) {
+      if(obj->format.sample_rate == obj->standby_format.sample_rate && obj->format.sample_size == obj->standby_format.sample_size && obj->format.channel_qty == obj->standby_format.channel_qty) {
+         // Play on the stream held in standby
+         obj->standby_held = false;
+         return(true);
+      }
+      XLOGD_INFO("reopen stream held in standby - sample rate %u to %u", obj->standby_format.sample_rate, obj->format.sample_rate);
+      xraudio_output_standby_exit(obj);
+      obj->standby_reopened = true;
+   }
+   return(xraudio_output_audio_hal_open(obj));
+}
+
 void xraudio_output_audio_hal_close(xraudio_output_obj_t *obj) {
    if(obj->hal_output_obj == NULL) {
       XLOGD_ERROR("invalid stream handle");
@@ -975,6 +1078,19 @@ xraudio_result_t xraudio_output_sound_intensity_transfer(xraudio_output_object_t
    return(XRAUDIO_RESULT_OK);
 }
 
+void xraudio_output_eos_create(xraudio_output_obj_t *obj) {
+   #ifdef XRAUDIO_EOS_ENABLED
+   if(obj->obj_eos != NULL || !obj->dsp_config.eos_enabled) {
+      return;
+   }
+   // Created before the main thread writes to the speaker since the output may not be used
+   obj->obj_eos = xraudio_eos_object_create(true, obj->jeos_config);
+   if(obj->obj_eos == NULL) {
+      XLOGD_ERROR("unable to create eos object");
+   }
+   #endif
+}
+
 xraudio_eos_event_t xraudio_output_eos_run(xraudio_output_object_t object, int16_t *input_samples, int32_t sample_qty) {
    xraudio_output_obj_t *obj = (xraudio_output_obj_t *)object;
    if(!xraudio_output_object_is_valid(obj)) {
@@ -982,7 +1098,7 @@ xraudio_eos_event_t xraudio_output_eos_run(xraudio_output_object_t object, int16
       return(XRAUDIO_EOS_EVENT_NONE);
    }
    #ifdef XRAUDIO_EOS_ENABLED
-   return (obj->dsp_config.eos_enabled) ? xraudio_eos_run_int16(obj->obj_eos, input_samples, sample_qty) : XRAUDIO_EOS_EVENT_NONE;
+   return (obj->dsp_config.eos_enabled && obj->obj_eos != NULL) ? xraudio_eos_run_int16(obj->obj_eos, input_samples, sample_qty) : XRAUDIO_EOS_EVENT_NONE;
    #else
    return(XRAUDIO_EOS_EVENT_NONE);
    #endif
@@ -995,7 +1111,7 @@ unsigned char xraudio_output_signal_level_get(xraudio_output_object_t object) {
       return(0);
    }
    #ifdef XRAUDIO_EOS_ENABLED
-   if(obj->state == XRAUDIO_OUTPUT_STATE_PLAYING && obj->dsp_config.eos_enabled) {
+   if(obj->state == XRAUDIO_OUTPUT_STATE_PLAYING && obj->dsp_config.eos_enabled && obj->obj_eos != NULL) {
       return(xraudio_eos_signal_level_get(obj->obj_eos));
    }
    #endif
@@ -1203,6 +1319,8 @@ xraudio_result_t xraudio_output_hfp_start(xraudio_output_object_t object, uint32
    obj->format.sample_size = XRAUDIO_OUTPUT_MIN_SAMPLE_SIZE;
    obj->format.channel_qty = XRAUDIO_OUTPUT_MIN_CHANNEL_QTY;
 
+   xraudio_output_standby_exit(obj); // The HFP audio is not written by the main thread
+
    if(!xraudio_output_audio_hal_open(obj)) {
       XLOGD_ERROR("Unable to open speaker interface");
       XRAUDIO_PLAY_MUTEX_UNLOCK();
@@ -1238,6 +1356,10 @@ xraudio_result_t xraudio_output_hfp_stop(xraudio_output_object_t object) {
    xraudio_output_audio_hal_close(obj);
 
    obj->state = XRAUDIO_OUTPUT_STATE_IDLING;
+
+   if(obj->standby) {
+      xraudio_output_standby_enter(obj);
+   }
    XRAUDIO_PLAY_MUTEX_UNLOCK();
    return(XRAUDIO_RESULT_OK);
 }
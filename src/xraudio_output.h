@@ -42,6 +42,7 @@ xraudio_output_object_t  xraudio_output_object_create(xraudio_hal_obj_t hal_obj,
 void                     xraudio_output_object_destroy(xraudio_output_object_t object);
 void                     xraudio_output_open(xraudio_output_object_t object, xraudio_devices_output_t device, xraudio_power_mode_t power_mode, xraudio_resource_id_output_t resource_id, uint16_t capabilities);
 void                     xraudio_output_close(xraudio_output_object_t object);
+void                     xraudio_output_standby_enable(xraudio_output_object_t object);
 xraudio_hal_output_obj_t xraudio_output_hal_obj_get(xraudio_output_object_t object);
 xraudio_result_t         xraudio_output_play_from_file(xraudio_output_object_t object, const char *audio_file_path, audio_out_callback_t callback, void *param);
 xraudio_result_t         xraudio_output_play_from_memory(xraudio_output_object_t object, xraudio_output_format_t *format, const unsigned char *audio_buf, unsigned long size, audio_out_callback_t callback, void *param);
@@ -249,6 +249,28 @@ void    xraudio_ppr_get_lookback_pcm(
             uint32_t *n_samples_returned              ///< actual number of samples returned
             );
 
+/// @brief Retrieve the size of an xraudio preprocess state snapshot
+/// @details Retrieves the size of the buffer needed to save the adapted state of the preprocess (echo canceller filters, noise estimate, etc).  Only called when xraudio is built with XRAUDIO_DSP_STATE_ENABLED.
+/// @param[in] object Reference to an xraudio preprocess object.
+/// @return The function returns the size of the snapshot in bytes or zero if the state cannot be saved.
+uint32_t             xraudio_ppr_snapshot_size(xraudio_ppr_object_t object);
+
+/// @brief Save an xraudio preprocess state snapshot
+/// @details Saves the adapted state of the preprocess (echo canceller filters, noise estimate, etc) so it can be restored after the preprocess is reinitialized.
+/// @param[in]  object Reference to an xraudio preprocess object.
+/// @param[out] state  Pointer to the snapshot buffer.
+/// @param[in]  size   Size of the snapshot buffer in bytes.
+/// @return The function returns true for success and false for failure.
+bool                 xraudio_ppr_snapshot_save(xraudio_ppr_object_t object, void *state, uint32_t size);
+
+/// @brief Restore an xraudio preprocess state snapshot
+/// @details Restores a snapshot saved by xraudio_ppr_snapshot_save.  The snapshot must be rejected if it does not match the current configuration of the preprocess.
+/// @param[in] object Reference to an xraudio preprocess object.
+/// @param[in] state  Pointer to the snapshot buffer.
+/// @param[in] size   Size of the snapshot in bytes.
+/// @return The function returns true for success and false for failure.
+bool                 xraudio_ppr_snapshot_restore(xraudio_ppr_object_t object, const void *state, uint32_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,14 @@
 #endif
 #include "xraudio_output.h"
 #include "xraudio_input.h"
+#include "xraudio_dispatch.h"
+#include "xraudio_beam.h"
+#include "xraudio_doa.h"
+#include "xraudio_governor.h"
+#include "xraudio_decimator.h"
+#include "xraudio_simd.h"
+#include "xraudio_latency.h"
+#include "xraudio_trace.h"
 
 #ifdef USE_RDKX_LOGGER
 #include "rdkx_logger.h"
@@ -104,7 +112,9 @@ typedef enum {
    XRAUDIO_MAIN_QUEUE_MSG_TYPE_POWER_MODE                      = 20,
    XRAUDIO_MAIN_QUEUE_MSG_TYPE_PRIVACY_MODE                    = 21,
    XRAUDIO_MAIN_QUEUE_MSG_TYPE_PRIVACY_MODE_GET                = 22,
-   XRAUDIO_MAIN_QUEUE_MSG_TYPE_INVALID                         = 23,
+   XRAUDIO_MAIN_QUEUE_MSG_TYPE_DETECT_RELOAD                   = 23,
+   XRAUDIO_MAIN_QUEUE_MSG_TYPE_DETECT_RELOAD_READY             = 24,
+   XRAUDIO_MAIN_QUEUE_MSG_TYPE_INVALID                         = 25,
 } xraudio_main_queue_msg_type_t;
 
 #ifdef XRAUDIO_RESOURCE_MGMT
@@ -148,6 +158,16 @@ typedef struct {
    bool           running;
 } xraudio_thread_t;
 
+typedef struct {
+   void *   data;     // allocated by the first save, released when the owner is destroyed
+   uint32_t capacity;
+   uint32_t size;     // size of the saved state (in bytes), zero when no state is saved
+} xraudio_dsp_snapshot_t;
+
+typedef uint32_t (*xraudio_dsp_snapshot_size_t)(void *object);
+typedef bool     (*xraudio_dsp_snapshot_save_t)(void *object, void *state, uint32_t size);
+typedef bool     (*xraudio_dsp_snapshot_restore_t)(void *object, const void *state, uint32_t size);
+
 typedef struct {
    xr_mq_t                           msgq;
    sem_t *                           semaphore;
@@ -159,6 +179,23 @@ typedef struct {
    json_t*                           json_obj_input;
    json_t*                           json_obj_output;
    xraudio_hal_dsp_config_t          dsp_config;
+   xraudio_dispatch_object_t         obj_dispatch;
+   xraudio_beamformer_config_t       beamformer_config;
+   xraudio_keyword_commit_config_t   keyword_commit_config;
+   uint32_t                          input_frame_period;
+   uint32_t                          input_capture_rate;
+   uint8_t                           input_idle_frame_qty;
+   bool                              privacy_mode;
+   xraudio_devices_input_t           input_devices;
+   uint8_t                           input_mic_qty;
+   int                               speculative_pipe;
+   xraudio_keyword_models_config_t   keyword_models_config;
+   xraudio_governor_config_t         governor_config;
+   xraudio_governor_callback_t       governor_callback;
+   void *                            governor_param;
+   xraudio_dsp_snapshot_t *          dsp_snapshot_kwd; // kept by the xraudio object so the state survives a close
+   xraudio_dsp_snapshot_t *          dsp_snapshot_dga;
+   xraudio_stream_buffer_t *         stream_buffer_lent; // kept by the xraudio object for xraudio_stream_buffer_retain
 } xraudio_main_thread_params_t;
 
 #ifdef XRAUDIO_RESOURCE_MGMT
@@ -230,9 +267,11 @@ typedef struct {
    void *                          param;
    sem_t *                         semaphore;
    uint8_t                         frame_group_qty;
+   uint16_t                        latency_budget_ms;
    FILE *                          fh;
    xraudio_sample_t *              audio_buf_samples;
    unsigned long                   audio_buf_sample_qty;
+   bool                            audio_buf_circular;
    int                             fifo_audio_data[XRAUDIO_FIFO_QTY_MAX];
    xraudio_input_record_from_t     stream_from[XRAUDIO_FIFO_QTY_MAX];
    xraudio_input_record_until_t    stream_until[XRAUDIO_FIFO_QTY_MAX];
@@ -244,6 +283,12 @@ typedef struct {
    uint32_t                        stream_keyword_duration;
    char                            identifier[XRAUDIO_STREAM_ID_SIZE_MAX];
    xraudio_stream_latency_mode_t   latency_mode;
+   xraudio_stream_framing_t        framing;
+   xraudio_stream_sample_format_t  sample_format;
+   xraudio_stream_channel_layout_t channel_layout;
+   xraudio_stream_buffer_t         buffer_pool[XRAUDIO_STREAM_BUFFER_QTY_MAX]; // owned by the input session
+   uint8_t                         buffer_qty;
+   bool                            armed; // held by the main thread until the keyword is detected
 } xraudio_queue_msg_record_start_t;
 
 typedef struct {
@@ -260,6 +305,12 @@ typedef struct {
    xraudio_keyword_sensitivity_t   sensitivity;
 } xraudio_queue_msg_detect_params_t;
 
+typedef struct {
+   xraudio_main_queue_msg_header_t header;
+   json_t *                        jkwd_config;
+   xraudio_keyword_sensitivity_t   sensitivity;
+} xraudio_queue_msg_detect_reload_t;
+
 typedef struct {
    xraudio_main_queue_msg_header_t header;
    xraudio_keyword_sensitivity_t * min;
@@ -303,6 +354,13 @@ typedef struct {
    sem_t *                         semaphore;
 } xraudio_queue_msg_capture_stop_t;
 
+typedef struct {
+   xraudio_main_queue_msg_header_t header;
+   xraudio_hal_output_obj_t        hal_output_obj;
+   xraudio_output_format_t         format;
+   rdkx_timestamp_t                timestamp; // time of the standby entry request
+} xraudio_queue_msg_play_idle_t;
+
 typedef struct {
    xraudio_main_queue_msg_header_t header;
    xraudio_hal_output_obj_t        hal_output_obj;
@@ -316,6 +374,9 @@ typedef struct {
    int                             pipe;
    audio_out_data_callback_t       data_callback;
    int                             fifo_sound_intensity;
+   bool                            standby;   // the speaker stream was held in standby
+   bool                            reopened;  // the stream held in standby was reopened in the format of the playback
+   rdkx_timestamp_t                timestamp; // time of the playback request
 } xraudio_queue_msg_play_start_t;
 
 typedef struct {
@@ -396,6 +457,27 @@ void *xraudio_resource_thread(void *param);
 bool xraudio_thread_create(xraudio_thread_t *thread, const char *name, void *(*start_routine) (void *), void *arg);
 bool xraudio_thread_join(xraudio_thread_t *thread);
 
+xraudio_stream_buffer_t xraudio_in_stream_buffer_retain(xraudio_stream_buffer_t buffer);
+void                    xraudio_in_stream_buffer_release(xraudio_stream_buffer_t buffer);
+uint8_t                 xraudio_in_stream_buffer_pool_create(xraudio_stream_buffer_t *pool, uint8_t buffer_qty, uint32_t sample_qty);
+void                    xraudio_in_stream_buffer_pool_destroy(xraudio_stream_buffer_t *pool, uint8_t buffer_qty);
+uint32_t                xraudio_in_frame_buffer_out_sample_qty(xraudio_devices_input_t devices, uint8_t mic_qty);
+void                    xraudio_in_speculative_stats_get(xraudio_stream_speculative_stats_t *stats);
+bool                    xraudio_in_detect_reload_begin(void);
+void                    xraudio_in_detect_reload_status_get(xraudio_detect_reload_status_t *status);
+void                    xraudio_in_governor_stats_get(xraudio_governor_stats_t *stats);
+void                    xraudio_in_channel_report_get(xraudio_input_channel_report_t *report);
+void                    xraudio_in_power_report_get(xraudio_input_power_report_t *report);
+void                    xraudio_in_privacy_report_get(xraudio_privacy_report_t *report);
+void                    xraudio_in_dsp_state_report_get(xraudio_dsp_state_report_t *report);
+void                    xraudio_in_stream_armed_report_get(xraudio_stream_armed_report_t *report);
+void                    xraudio_in_standby_report_get(xraudio_standby_report_t *report);
+void                    xraudio_in_init_report_get(xraudio_init_report_t *report);
+
+bool xraudio_dsp_snapshot_save(xraudio_dsp_snapshot_t *snapshot, xraudio_dsp_plugin_t plugin, void *object, xraudio_dsp_snapshot_size_t size_get, xraudio_dsp_snapshot_save_t save);
+bool xraudio_dsp_snapshot_restore(xraudio_dsp_snapshot_t *snapshot, xraudio_dsp_plugin_t plugin, void *object, xraudio_dsp_snapshot_restore_t restore);
+void xraudio_dsp_snapshot_free(xraudio_dsp_snapshot_t *snapshot);
+
 const char *xraudio_main_queue_msg_type_str(xraudio_main_queue_msg_type_t type);
 const char *xraudio_input_session_group_str(xraudio_input_session_group_t group);
 
@@ -418,6 +500,8 @@ void xraudio_shared_mem_unlock(xraudio_object_t object);
 bool xraudio_devices_input_local_is_valid(xraudio_devices_input_t devices);
 bool xraudio_devices_input_external_is_valid(xraudio_devices_input_t devices);
 bool xraudio_devices_input_is_valid(xraudio_devices_input_t devices);
+uint8_t xraudio_devices_input_mic_qty(xraudio_devices_input_t devices, uint8_t array_mic_qty);
+uint8_t xraudio_devices_input_ec_ref_qty(xraudio_devices_input_t devices);
 bool xraudio_devices_output_is_valid(xraudio_devices_output_t devices);
 
 bool xraudio_hal_msg_async_handler(void *msg);
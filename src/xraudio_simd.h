@@ -0,0 +1,232 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef __XRAUDIO_SIMD_H__
+#define __XRAUDIO_SIMD_H__
+
+#include <stdint.h>
+
+// Four lane (eight for int16) vector operations used by the sample kernels.  NEON or SSE2 is used when the target provides it, otherwise the lanes are processed in turn.
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define XRAUDIO_SIMD_NEON
+typedef float32x4_t xraudio_f32x4_t;
+typedef int32x4_t   xraudio_i32x4_t;
+typedef int16x8_t   xraudio_i16x8_t;
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define XRAUDIO_SIMD_SSE2
+typedef __m128      xraudio_f32x4_t;
+typedef __m128i     xraudio_i32x4_t;
+typedef __m128i     xraudio_i16x8_t;
+#else
+typedef struct { float   lane[4]; } xraudio_f32x4_t;
+typedef struct { int32_t lane[4]; } xraudio_i32x4_t;
+typedef struct { int16_t lane[8]; } xraudio_i16x8_t;
+#endif
+
+#if defined(XRAUDIO_SIMD_NEON)
+
+static inline xraudio_f32x4_t xraudio_f32x4_load(const float *src)                                                        { return(vld1q_f32(src)); }
+static inline void            xraudio_f32x4_store(float *dst, xraudio_f32x4_t a)                                          { vst1q_f32(dst, a); }
+static inline xraudio_f32x4_t xraudio_f32x4_set(float value)                                                              { return(vdupq_n_f32(value)); }
+static inline xraudio_f32x4_t xraudio_f32x4_add(xraudio_f32x4_t a, xraudio_f32x4_t b)                                     { return(vaddq_f32(a, b)); }
+static inline xraudio_f32x4_t xraudio_f32x4_mul(xraudio_f32x4_t a, xraudio_f32x4_t b)                                     { return(vmulq_f32(a, b)); }
+static inline xraudio_f32x4_t xraudio_f32x4_madd(xraudio_f32x4_t acc, xraudio_f32x4_t a, xraudio_f32x4_t b)               { return(vmlaq_f32(acc, a, b)); }
+static inline xraudio_f32x4_t xraudio_f32x4_max(xraudio_f32x4_t a, xraudio_f32x4_t b)                                     { return(vmaxq_f32(a, b)); }
+static inline xraudio_f32x4_t xraudio_f32x4_abs(xraudio_f32x4_t a)                                                        { return(vabsq_f32(a)); }
+static inline xraudio_i32x4_t xraudio_f32x4_cmplt(xraudio_f32x4_t a, xraudio_f32x4_t b)                                   { return(vreinterpretq_s32_u32(vcltq_f32(a, b))); }
+static inline xraudio_i32x4_t xraudio_f32x4_cmpge(xraudio_f32x4_t a, xraudio_f32x4_t b)                                   { return(vreinterpretq_s32_u32(vcgeq_f32(a, b))); }
+static inline xraudio_i32x4_t xraudio_f32x4_to_i32x4(xraudio_f32x4_t a)                                                   { return(vcvtq_s32_f32(a)); }
+static inline void            xraudio_f32x4_store2(float *dst, xraudio_f32x4_t a, xraudio_f32x4_t b)                      { float32x4x2_t v = { { a, b } }; vst2q_f32(dst, v); }
+static inline void            xraudio_f32x4_store4(float *dst, xraudio_f32x4_t a, xraudio_f32x4_t b, xraudio_f32x4_t c, xraudio_f32x4_t d) { float32x4x4_t v = { { a, b, c, d } }; vst4q_f32(dst, v); }
+
+static inline float xraudio_f32x4_sum(xraudio_f32x4_t a) {
+   float32x2_t sum = vadd_f32(vget_low_f32(a), vget_high_f32(a));
+   sum = vpadd_f32(sum, sum);
+   return(vget_lane_f32(sum, 0));
+}
+
+static inline float xraudio_f32x4_hmax(xraudio_f32x4_t a) {
+   float32x2_t max = vmax_f32(vget_low_f32(a), vget_high_f32(a));
+   max = vpmax_f32(max, max);
+   return(vget_lane_f32(max, 0));
+}
+
+static inline xraudio_i32x4_t xraudio_i32x4_load_i16(const int16_t *src)                                                  { return(vmovl_s16(vld1_s16(src))); }
+static inline void            xraudio_i32x4_store(int32_t *dst, xraudio_i32x4_t a)                                        { vst1q_s32(dst, a); }
+static inline xraudio_i32x4_t xraudio_i32x4_set(int32_t value)                                                            { return(vdupq_n_s32(value)); }
+static inline xraudio_i32x4_t xraudio_i32x4_sub(xraudio_i32x4_t a, xraudio_i32x4_t b)                                     { return(vsubq_s32(a, b)); }
+static inline xraudio_i32x4_t xraudio_i32x4_xor(xraudio_i32x4_t a, xraudio_i32x4_t b)                                     { return(veorq_s32(a, b)); }
+static inline xraudio_i32x4_t xraudio_i32x4_shl16(xraudio_i32x4_t a)                                                      { return(vshlq_n_s32(a, 16)); }
+static inline xraudio_f32x4_t xraudio_i32x4_to_f32x4(xraudio_i32x4_t a)                                                   { return(vcvtq_f32_s32(a)); }
+static inline void            xraudio_i32x4_store2(int32_t *dst, xraudio_i32x4_t a, xraudio_i32x4_t b)                    { int32x4x2_t v = { { a, b } }; vst2q_s32(dst, v); }
+static inline void            xraudio_i32x4_store4(int32_t *dst, xraudio_i32x4_t a, xraudio_i32x4_t b, xraudio_i32x4_t c, xraudio_i32x4_t d) { int32x4x4_t v = { { a, b, c, d } }; vst4q_s32(dst, v); }
+
+static inline int32_t xraudio_i32x4_sum(xraudio_i32x4_t a) {
+   int32x2_t sum = vadd_s32(vget_low_s32(a), vget_high_s32(a));
+   sum = vpadd_s32(sum, sum);
+   return(vget_lane_s32(sum, 0));
+}
+
+static inline xraudio_i16x8_t xraudio_i16x8_load(const int16_t *src)                                                      { return(vld1q_s16(src)); }
+static inline void            xraudio_i16x8_store2(int16_t *dst, xraudio_i16x8_t a, xraudio_i16x8_t b)                    { int16x8x2_t v = { { a, b } }; vst2q_s16(dst, v); }
+static inline void            xraudio_i16x8_store4(int16_t *dst, xraudio_i16x8_t a, xraudio_i16x8_t b, xraudio_i16x8_t c, xraudio_i16x8_t d) { int16x8x4_t v = { { a, b, c, d } }; vst4q_s16(dst, v); }
+
+#elif defined(XRAUDIO_SIMD_SSE2)
+
+static inline xraudio_f32x4_t xraudio_f32x4_load(const float *src)                                                        { return(_mm_loadu_ps(src)); }
+static inline void            xraudio_f32x4_store(float *dst, xraudio_f32x4_t a)                                          { _mm_storeu_ps(dst, a); }
+static inline xraudio_f32x4_t xraudio_f32x4_set(float value)                                                              { return(_mm_set1_ps(value)); }
+static inline xraudio_f32x4_t xraudio_f32x4_add(xraudio_f32x4_t a, xraudio_f32x4_t b)                                     { return(_mm_add_ps(a, b)); }
+static inline xraudio_f32x4_t xraudio_f32x4_mul(xraudio_f32x4_t a, xraudio_f32x4_t b)                                     { return(_mm_mul_ps(a, b)); }
+static inline xraudio_f32x4_t xraudio_f32x4_madd(xraudio_f32x4_t acc, xraudio_f32x4_t a, xraudio_f32x4_t b)               { return(_mm_add_ps(acc, _mm_mul_ps(a, b))); }
+static inline xraudio_f32x4_t xraudio_f32x4_max(xraudio_f32x4_t a, xraudio_f32x4_t b)                                     { return(_mm_max_ps(a, b)); }
+static inline xraudio_f32x4_t xraudio_f32x4_abs(xraudio_f32x4_t a)                                                        { return(_mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)))); }
+static inline xraudio_i32x4_t xraudio_f32x4_cmplt(xraudio_f32x4_t a, xraudio_f32x4_t b)                                   { return(_mm_castps_si128(_mm_cmplt_ps(a, b))); }
+static inline xraudio_i32x4_t xraudio_f32x4_cmpge(xraudio_f32x4_t a, xraudio_f32x4_t b)                                   { return(_mm_castps_si128(_mm_cmpge_ps(a, b))); }
+
+static inline xraudio_i32x4_t xraudio_f32x4_to_i32x4(xraudio_f32x4_t a) { // Saturates like NEON, the conversion returns INT32_MIN for lanes that overflow
+   xraudio_i32x4_t overflow = _mm_castps_si128(_mm_cmpge_ps(a, _mm_set1_ps(2147483648.0f)));
+   return(_mm_xor_si128(_mm_cvttps_epi32(a), overflow));
+}
+
+static inline void xraudio_f32x4_store2(float *dst, xraudio_f32x4_t a, xraudio_f32x4_t b) {
+   _mm_storeu_ps(&dst[0], _mm_unpacklo_ps(a, b));
+   _mm_storeu_ps(&dst[4], _mm_unpackhi_ps(a, b));
+}
+
+static inline void xraudio_f32x4_store4(float *dst, xraudio_f32x4_t a, xraudio_f32x4_t b, xraudio_f32x4_t c, xraudio_f32x4_t d) {
+   _MM_TRANSPOSE4_PS(a, b, c, d);
+   _mm_storeu_ps(&dst[0],  a);
+   _mm_storeu_ps(&dst[4],  b);
+   _mm_storeu_ps(&dst[8],  c);
+   _mm_storeu_ps(&dst[12], d);
+}
+
+static inline float xraudio_f32x4_sum(xraudio_f32x4_t a) {
+   xraudio_f32x4_t shuf = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+   xraudio_f32x4_t sum  = _mm_add_ps(a, shuf);
+   shuf = _mm_movehl_ps(shuf, sum);
+   return(_mm_cvtss_f32(_mm_add_ss(sum, shuf)));
+}
+
+static inline float xraudio_f32x4_hmax(xraudio_f32x4_t a) {
+   xraudio_f32x4_t shuf = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+   xraudio_f32x4_t max  = _mm_max_ps(a, shuf);
+   shuf = _mm_movehl_ps(shuf, max);
+   return(_mm_cvtss_f32(_mm_max_ss(max, shuf)));
+}
+
+static inline xraudio_i32x4_t xraudio_i32x4_load_i16(const int16_t *src) {
+   xraudio_i32x4_t a = _mm_loadl_epi64((const __m128i *)src);
+   return(_mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16));
+}
+
+static inline void            xraudio_i32x4_store(int32_t *dst, xraudio_i32x4_t a)                                        { _mm_storeu_si128((__m128i *)dst, a); }
+static inline xraudio_i32x4_t xraudio_i32x4_set(int32_t value)                                                            { return(_mm_set1_epi32(value)); }
+static inline xraudio_i32x4_t xraudio_i32x4_sub(xraudio_i32x4_t a, xraudio_i32x4_t b)                                     { return(_mm_sub_epi32(a, b)); }
+static inline xraudio_i32x4_t xraudio_i32x4_xor(xraudio_i32x4_t a, xraudio_i32x4_t b)                                     { return(_mm_xor_si128(a, b)); }
+static inline xraudio_i32x4_t xraudio_i32x4_shl16(xraudio_i32x4_t a)                                                      { return(_mm_slli_epi32(a, 16)); }
+static inline xraudio_f32x4_t xraudio_i32x4_to_f32x4(xraudio_i32x4_t a)                                                   { return(_mm_cvtepi32_ps(a)); }
+
+static inline void xraudio_i32x4_store2(int32_t *dst, xraudio_i32x4_t a, xraudio_i32x4_t b) {
+   _mm_storeu_si128((__m128i *)&dst[0], _mm_unpacklo_epi32(a, b));
+   _mm_storeu_si128((__m128i *)&dst[4], _mm_unpackhi_epi32(a, b));
+}
+
+static inline void xraudio_i32x4_store4(int32_t *dst, xraudio_i32x4_t a, xraudio_i32x4_t b, xraudio_i32x4_t c, xraudio_i32x4_t d) {
+   xraudio_i32x4_t ab_lo = _mm_unpacklo_epi32(a, b);
+   xraudio_i32x4_t cd_lo = _mm_unpacklo_epi32(c, d);
+   xraudio_i32x4_t ab_hi = _mm_unpackhi_epi32(a, b);
+   xraudio_i32x4_t cd_hi = _mm_unpackhi_epi32(c, d);
+   _mm_storeu_si128((__m128i *)&dst[0],  _mm_unpacklo_epi64(ab_lo, cd_lo));
+   _mm_storeu_si128((__m128i *)&dst[4],  _mm_unpackhi_epi64(ab_lo, cd_lo));
+   _mm_storeu_si128((__m128i *)&dst[8],  _mm_unpacklo_epi64(ab_hi, cd_hi));
+   _mm_storeu_si128((__m128i *)&dst[12], _mm_unpackhi_epi64(ab_hi, cd_hi));
+}
+
+static inline int32_t xraudio_i32x4_sum(xraudio_i32x4_t a) {
+   a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+   a = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+   return(_mm_cvtsi128_si32(a));
+}
+
+static inline xraudio_i16x8_t xraudio_i16x8_load(const int16_t *src)                                                      { return(_mm_loadu_si128((const __m128i *)src)); }
+
+static inline void xraudio_i16x8_store2(int16_t *dst, xraudio_i16x8_t a, xraudio_i16x8_t b) {
+   _mm_storeu_si128((__m128i *)&dst[0], _mm_unpacklo_epi16(a, b));
+   _mm_storeu_si128((__m128i *)&dst[8], _mm_unpackhi_epi16(a, b));
+}
+
+static inline void xraudio_i16x8_store4(int16_t *dst, xraudio_i16x8_t a, xraudio_i16x8_t b, xraudio_i16x8_t c, xraudio_i16x8_t d) {
+   xraudio_i16x8_t ab_lo = _mm_unpacklo_epi16(a, b);
+   xraudio_i16x8_t cd_lo = _mm_unpacklo_epi16(c, d);
+   xraudio_i16x8_t ab_hi = _mm_unpackhi_epi16(a, b);
+   xraudio_i16x8_t cd_hi = _mm_unpackhi_epi16(c, d);
+   _mm_storeu_si128((__m128i *)&dst[0],  _mm_unpacklo_epi32(ab_lo, cd_lo));
+   _mm_storeu_si128((__m128i *)&dst[8],  _mm_unpackhi_epi32(ab_lo, cd_lo));
+   _mm_storeu_si128((__m128i *)&dst[16], _mm_unpacklo_epi32(ab_hi, cd_hi));
+   _mm_storeu_si128((__m128i *)&dst[24], _mm_unpackhi_epi32(ab_hi, cd_hi));
+}
+
+#else
+
+#define XRAUDIO_SIMD_LANES(expr) for(uint32_t lane = 0; lane < 4; lane++) { expr; }
+
+static inline xraudio_f32x4_t xraudio_f32x4_load(const float *src)                                          { xraudio_f32x4_t r; XRAUDIO_SIMD_LANES(r.lane[lane] = src[lane]); return(r); }
+static inline void            xraudio_f32x4_store(float *dst, xraudio_f32x4_t a)                            { XRAUDIO_SIMD_LANES(dst[lane] = a.lane[lane]); }
+static inline xraudio_f32x4_t xraudio_f32x4_set(float value)                                                { xraudio_f32x4_t r; XRAUDIO_SIMD_LANES(r.lane[lane] = value); return(r); }
+static inline xraudio_f32x4_t xraudio_f32x4_add(xraudio_f32x4_t a, xraudio_f32x4_t b)                       { XRAUDIO_SIMD_LANES(a.lane[lane] += b.lane[lane]); return(a); }
+static inline xraudio_f32x4_t xraudio_f32x4_mul(xraudio_f32x4_t a, xraudio_f32x4_t b)                       { XRAUDIO_SIMD_LANES(a.lane[lane] *= b.lane[lane]); return(a); }
+static inline xraudio_f32x4_t xraudio_f32x4_madd(xraudio_f32x4_t acc, xraudio_f32x4_t a, xraudio_f32x4_t b) { XRAUDIO_SIMD_LANES(acc.lane[lane] += a.lane[lane] * b.lane[lane]); return(acc); }
+static inline xraudio_f32x4_t xraudio_f32x4_max(xraudio_f32x4_t a, xraudio_f32x4_t b)                       { XRAUDIO_SIMD_LANES(a.lane[lane] = (a.lane[lane] > b.lane[lane]) ? a.lane[lane] : b.lane[lane]); return(a); }
+static inline xraudio_f32x4_t xraudio_f32x4_abs(xraudio_f32x4_t a)                                          { XRAUDIO_SIMD_LANES(a.lane[lane] = (a.lane[lane] < 0.0f) ? -a.lane[lane] : a.lane[lane]); return(a); }
+static inline xraudio_i32x4_t xraudio_f32x4_cmplt(xraudio_f32x4_t a, xraudio_f32x4_t b)                     { xraudio_i32x4_t r; XRAUDIO_SIMD_LANES(r.lane[lane] = (a.lane[lane] < b.lane[lane]) ? -1 : 0); return(r); }
+static inline xraudio_i32x4_t xraudio_f32x4_cmpge(xraudio_f32x4_t a, xraudio_f32x4_t b)                     { xraudio_i32x4_t r; XRAUDIO_SIMD_LANES(r.lane[lane] = (a.lane[lane] >= b.lane[lane]) ? -1 : 0); return(r); }
+static inline float           xraudio_f32x4_sum(xraudio_f32x4_t a)                                          { return((a.lane[0] + a.lane[1]) + (a.lane[2] + a.lane[3])); }
+static inline float           xraudio_f32x4_hmax(xraudio_f32x4_t a)                                         { float r = a.lane[0]; XRAUDIO_SIMD_LANES(r = (a.lane[lane] > r) ? a.lane[lane] : r); return(r); }
+static inline void            xraudio_f32x4_store2(float *dst, xraudio_f32x4_t a, xraudio_f32x4_t b)        { XRAUDIO_SIMD_LANES(dst[lane * 2] = a.lane[lane]; dst[lane * 2 + 1] = b.lane[lane]); }
+static inline void            xraudio_f32x4_store4(float *dst, xraudio_f32x4_t a, xraudio_f32x4_t b, xraudio_f32x4_t c, xraudio_f32x4_t d) { XRAUDIO_SIMD_LANES(dst[lane * 4] = a.lane[lane]; dst[lane * 4 + 1] = b.lane[lane]; dst[lane * 4 + 2] = c.lane[lane]; dst[lane * 4 + 3] = d.lane[lane]); }
+
+static inline xraudio_i32x4_t xraudio_f32x4_to_i32x4(xraudio_f32x4_t a) {
+   xraudio_i32x4_t r;
+   XRAUDIO_SIMD_LANES(r.lane[lane] = (a.lane[lane] < (float)INT32_MIN) ? INT32_MIN : (a.lane[lane] >= 2147483648.0f) ? INT32_MAX : (int32_t)a.lane[lane]);
+   return(r);
+}
+
+static inline xraudio_i32x4_t xraudio_i32x4_load_i16(const int16_t *src)                                    { xraudio_i32x4_t r; XRAUDIO_SIMD_LANES(r.lane[lane] = src[lane]); return(r); }
+static inline void            xraudio_i32x4_store(int32_t *dst, xraudio_i32x4_t a)                          { XRAUDIO_SIMD_LANES(dst[lane] = a.lane[lane]); }
+static inline xraudio_i32x4_t xraudio_i32x4_set(int32_t value)                                              { xraudio_i32x4_t r; XRAUDIO_SIMD_LANES(r.lane[lane] = value); return(r); }
+static inline xraudio_i32x4_t xraudio_i32x4_sub(xraudio_i32x4_t a, xraudio_i32x4_t b)                       { XRAUDIO_SIMD_LANES(a.lane[lane] -= b.lane[lane]); return(a); }
+static inline xraudio_i32x4_t xraudio_i32x4_xor(xraudio_i32x4_t a, xraudio_i32x4_t b)                       { XRAUDIO_SIMD_LANES(a.lane[lane] ^= b.lane[lane]); return(a); }
+static inline xraudio_i32x4_t xraudio_i32x4_shl16(xraudio_i32x4_t a)                                        { XRAUDIO_SIMD_LANES(a.lane[lane] *= 65536); return(a); } // int16 range so the product fits
+static inline xraudio_f32x4_t xraudio_i32x4_to_f32x4(xraudio_i32x4_t a)                                     { xraudio_f32x4_t r; XRAUDIO_SIMD_LANES(r.lane[lane] = (float)a.lane[lane]); return(r); }
+static inline int32_t         xraudio_i32x4_sum(xraudio_i32x4_t a)                                          { return(a.lane[0] + a.lane[1] + a.lane[2] + a.lane[3]); }
+static inline void            xraudio_i32x4_store2(int32_t *dst, xraudio_i32x4_t a, xraudio_i32x4_t b)      { XRAUDIO_SIMD_LANES(dst[lane * 2] = a.lane[lane]; dst[lane * 2 + 1] = b.lane[lane]); }
+static inline void            xraudio_i32x4_store4(int32_t *dst, xraudio_i32x4_t a, xraudio_i32x4_t b, xraudio_i32x4_t c, xraudio_i32x4_t d) { XRAUDIO_SIMD_LANES(dst[lane * 4] = a.lane[lane]; dst[lane * 4 + 1] = b.lane[lane]; dst[lane * 4 + 2] = c.lane[lane]; dst[lane * 4 + 3] = d.lane[lane]); }
+
+static inline xraudio_i16x8_t xraudio_i16x8_load(const int16_t *src)                                        { xraudio_i16x8_t r; for(uint32_t lane = 0; lane < 8; lane++) { r.lane[lane] = src[lane]; } return(r); }
+static inline void            xraudio_i16x8_store2(int16_t *dst, xraudio_i16x8_t a, xraudio_i16x8_t b)      { for(uint32_t lane = 0; lane < 8; lane++) { dst[lane * 2] = a.lane[lane]; dst[lane * 2 + 1] = b.lane[lane]; } }
+static inline void            xraudio_i16x8_store4(int16_t *dst, xraudio_i16x8_t a, xraudio_i16x8_t b, xraudio_i16x8_t c, xraudio_i16x8_t d) { for(uint32_t lane = 0; lane < 8; lane++) { dst[lane * 4] = a.lane[lane]; dst[lane * 4 + 1] = b.lane[lane]; dst[lane * 4 + 2] = c.lane[lane]; dst[lane * 4 + 3] = d.lane[lane]; } }
+
+#endif
+
+#endif
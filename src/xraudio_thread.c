@@ -31,6 +31,7 @@
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <sys/param.h>
+#include <sys/uio.h>
 #include <math.h>
 #include "xraudio.h"
 #include "xraudio_private.h"
@@ -42,9 +43,6 @@
 #include "xraudio_opus.h"
 #endif
 
-//#define MASK_FIRST_WRITE_DELAY
-//#define MASK_FIRST_READ_DELAY
-
 #define XRAUDIO_INPUT_SUPERFRAME_MAX_CHANNEL_QTY   (XRAUDIO_INPUT_MAX_CHANNEL_QTY + XRAUDIO_INPUT_MAX_CHANNEL_QTY_EC_REF)
 
 #define XRAUDIO_INPUT_FRAME_SAMPLE_QTY     (XRAUDIO_INPUT_FRAME_PERIOD * XRAUDIO_INPUT_MAX_SAMPLE_RATE / 1000) // X ms @ microphone sample rate
@@ -68,7 +66,6 @@
 #endif
 
 #define STSF_DOA_MULT    (10)               /* direction of arrival angle multiplier */
-#define KEYWORD_TRIGGER_DETECT_THRESHOLD (5) /* Cumulative frames after trigger from all detectors before informing xraudio */
 
 #define CAPTURE_INTERNAL_EXT_WAV       ".wav"
 #define CAPTURE_INTERNAL_EXT_PCM       ".pcm"
@@ -104,6 +101,9 @@
 
 #define XRAUDIO_PRE_KWD_STREAM_LAG_SAMPLES (1600)
 
+// Maximum quantity of samples an additional keyword model may fall behind the live audio when it is deferred
+#define XRAUDIO_KEYWORD_MODEL_LAG_SAMPLES_MAX ((XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE * 200) / 1000)
+
 struct xraudio_session_record_t;
 typedef struct xraudio_session_record_t xraudio_session_record_t;
 struct xraudio_session_record_inst_t;
@@ -122,6 +122,42 @@ typedef struct {
    uint32_t                     pd_index_write;
    uint8_t                      post_frame_count; // count of audio frames since this channel triggered
 } xraudio_keyword_detector_chan_t;
+
+typedef struct {
+   int                          pipe;         // pre-armed destination for the speculative stream (-1 when disabled)
+   bool                         active;       // speculative stream is in progress
+   bool                         gap;          // the destination lost a frame of the speculative stream
+   uint8_t                      chan;         // channel being streamed
+   uint32_t                     sequence;     // frame sequence number within the speculative stream
+   uint32_t                     sample_qty;   // quantity of samples sent in the speculative stream
+   uint32_t                     frame_qty;    // quantity of live frames sent since the speculative stream started
+   uint32_t                     frame_period; // microphone frame period (in milliseconds)
+} xraudio_keyword_speculative_t;
+
+typedef struct {
+   xraudio_thread_t              thread;
+   xr_mq_t                       msgq;               // main queue, notified when the new instance is ready
+   json_t *                      jkwd_config;        // configuration of the new instance
+   json_t *                      jkwd_config_active; // configuration of the current instance (NULL for the default configuration)
+   json_t *                      jkwd_config_old;    // configuration of the replaced instance
+   xraudio_keyword_sensitivity_t sensitivity;
+   uint8_t                       chan_qty;           // quantity of instances initialized by the loader (0 if no session was active)
+   xraudio_kwd_object_t          kwd_object;         // new instance (NULL if the load failed)
+   xraudio_kwd_object_t          kwd_object_old;     // replaced instance, destroyed by the next loader thread
+   xraudio_kwd_criterion_t       criterion;
+   bool                          pending;            // new instance is waiting for a frame without a pending detection
+   uint64_t                      timestamp_ready;
+   uint32_t                      load_time_ms;
+} xraudio_keyword_reload_t;
+
+typedef struct {
+   xraudio_kwd_object_t          kwd_object;
+   char                          name[XRAUDIO_KEYWORD_NAME_SIZE_MAX];
+   xraudio_keyword_sensitivity_t sensitivity;
+   uint32_t                      lag_sample_qty; // buffered samples which have not been processed by this model
+   uint32_t                      cost_us;        // smoothed processing time of one frame
+   uint32_t                      defer_qty;      // quantity of frames deferred in the session
+} xraudio_keyword_model_t;
 #endif
 
 typedef struct {
@@ -130,19 +166,44 @@ typedef struct {
    xraudio_keyword_sensitivity_t     sensitivity;
    bool                              active;
    bool                              triggered;
-   xraudio_keyword_detector_chan_t   channels[XRAUDIO_INPUT_MAX_CHANNEL_QTY];
+   xraudio_keyword_detector_chan_t * channels;                  // one for each asr and keyword channel, allocated when the thread is launched
    uint32_t                          post_frame_count_trigger;  // count of audio frames since the first detector triggered
    uint32_t                          post_frame_count_callback; // count of audio frames since detection callback
    uint8_t                           active_chan;               // kwd active ("best") channel
    xraudio_kwd_criterion_t           criterion;                 // kwd criterion for choosing active channel
+   uint8_t                           instance_qty;              // quantity of kwd instances in the session
+   xraudio_beam_object_t             beam_object;               // beamformer front end (NULL when disabled)
+   uint8_t                           beams[XRAUDIO_BEAM_QTY_MAX]; // beam routed to each kwd instance in the current frame
+   uint8_t                           beam_qty;                  // quantity of kwd instances running on a beam in the current frame
+   bool                              committed;                 // detection decision has been made for the current trigger
+   uint32_t                          commit_frame_qty_max;      // maximum frames to wait for other detectors after the first trigger
+   float                             commit_margin;             // lead of the active channel required to commit early (0 to disable)
+   float                             commit_margin_prev;        // lead of the active channel in the previous frame
+   xraudio_keyword_speculative_t     speculative;               // audio streamed from the first trigger until the detection is reported or rejected
+   xraudio_keyword_reload_t          reload;                    // new instance being loaded in the background
+   xraudio_keyword_model_t           models[XRAUDIO_KEYWORD_MODEL_QTY_MAX]; // additional keyword models run on the first keyword channel
+   uint8_t                           model_qty;
+   uint8_t                           model_next;                // additional keyword model which is scheduled first in the next frame
+   uint32_t                          model_budget_us;           // processing time budget per frame for all keyword models (0 for no limit)
+   bool                              suspended;                 // kwd sessions are released while the input pipeline is suspended
+   xraudio_dsp_snapshot_t *          snapshot;                  // adapted state of the kwd session, restored when the next session begins or resumes
    #endif
    keyword_callback_t                callback;
    void *                            cb_param;
+   xraudio_dispatch_object_t         obj_dispatch;              // event callbacks are invoked inline when NULL
    xraudio_keyword_detector_result_t result;
    uint8_t                           input_kwd_max_channel_qty;
    uint8_t                           input_asr_kwd_channel_qty;
 } xraudio_keyword_detector_t;
 
+#ifdef XRAUDIO_KWD_ENABLED
+typedef struct {
+   xraudio_keyword_detector_t *         detector;
+   json_t *                             jkwd_config;
+   const xraudio_main_thread_params_t * params;
+} xraudio_keyword_detector_init_t;
+#endif
+
 typedef struct {
    FILE *                  fh;
    uint32_t                audio_data_size;
@@ -179,6 +240,7 @@ typedef struct {
    uint32_t                file_qty_max;
    uint32_t                file_size_max;
    uint32_t                file_index;
+   bool                    indexed;  // the directory is scanned for the next file index at the first capture
 } xraudio_capture_internal_t;
 
 typedef struct {
@@ -209,12 +271,35 @@ typedef struct {
    xraudio_audio_frame_float_t frames[XRAUDIO_INPUT_MAX_FRAME_GROUP_QTY];
 } xraudio_audio_group_float_t;
 
+typedef struct {
+   xraudio_stream_frame_header_t header;    // room for the frame header so the payload can be delivered without a copy
+   uint8_t                       samples[]; // int16, int32 or float samples, sized for the channels in use when allocated
+} xraudio_audio_buffer_out_t;
+
+typedef struct {
+   xraudio_atomic_int_t       refcount; // includes the pool's reference, one when the buffer is available to the main thread.  freed when it reaches zero
+   xraudio_audio_buffer_out_t buffer;   // must be last, the samples follow it
+} xraudio_stream_buffer_entry_t;
+
+typedef struct {
+   uint8_t *buffer; // tail of a frame that the fifo only partly accepted
+   uint32_t size;
+   uint32_t offset; // bytes of the tail written so far
+} xraudio_stream_frame_pending_t;
+
+typedef struct {
+   bool                             armed;    // stream is waiting for the keyword detection
+   bool                             detected; // keyword was detected, the stream is attached once the frame is processed
+   xraudio_queue_msg_record_start_t record;   // record start request to attach
+} xraudio_stream_armed_t;
+
 typedef void (*xraudio_handler_unpack_t)(xraudio_session_record_t *session, void *buffer_in, uint8_t chan_qty, xraudio_audio_group_int16_t *frame_buffer_int16, xraudio_audio_group_float_t *frame_buffer_fp32, uint32_t frame_group_index, uint32_t sample_qty_frame);
 
 struct xraudio_session_record_inst_t {
    xraudio_devices_input_t       source;
    bool                          mode_changed;
    xraudio_in_record_t           record_callback;
+   xraudio_latency_stage_t       latency_stage_write;             // latency histogram of the record callback's destination
    int                           fifo_audio_data[XRAUDIO_FIFO_QTY_MAX];
    xraudio_input_record_from_t   stream_from[XRAUDIO_FIFO_QTY_MAX];
    xraudio_input_record_until_t  stream_until[XRAUDIO_FIFO_QTY_MAX];
@@ -222,11 +307,15 @@ struct xraudio_session_record_inst_t {
    xraudio_input_format_t        format_out;
    uint32_t                      frame_size_out;
    uint8_t                       frame_group_qty;
+   uint16_t                      latency_budget_ms; // frame group quantity is adapted to the budget when non-zero
+   uint8_t                       batch_qty;         // adaptive frame group quantity for the next group
 
    FILE *                        fh;
    xraudio_sample_t *            audio_buf_samples;
    uint32_t                      audio_buf_sample_qty;
    uint32_t                      audio_buf_index;
+   bool                          audio_buf_circular;
+   bool                          audio_buf_wrapped;
    audio_in_data_callback_t      data_callback;
 
    bool                          synchronous;
@@ -246,6 +335,18 @@ struct xraudio_session_record_inst_t {
 
    uint32_t                      stream_time_min_value; // samples or bytes depending on source
    xraudio_stream_latency_mode_t latency_mode;
+   xraudio_stream_framing_t      framing;
+   uint32_t                      frame_sequence;                  // sequence number of the next frame header
+   uint16_t                      frame_flags;                     // in-band events pending for the next frame header
+   bool                          frame_gap[XRAUDIO_FIFO_QTY_MAX]; // frame group was dropped by the destination since the last frame header
+   xraudio_stream_frame_pending_t frame_pending[XRAUDIO_FIFO_QTY_MAX]; // completed before the next frame header is written
+   uint64_t                      first_byte_timestamp;            // monotonic time of the keyword detection (in microseconds), cleared by the first write to the stream
+   bool                          first_byte_armed;                // stream was attached from an armed stream
+   xraudio_stream_sample_format_t  sample_format;
+   xraudio_stream_channel_layout_t channel_layout;
+   bool                          sample_convert; // sample format or channel layout differs from the default
+   xraudio_stream_buffer_entry_t *buffer_pool[XRAUDIO_STREAM_BUFFER_QTY_MAX]; // frame group buffers lent to the user data callback, owned by the input session
+   uint8_t                       buffer_pool_qty;
    #ifdef XRAUDIO_KWD_ENABLED
    uint32_t                      pre_detection_sample_qty;
    #endif
@@ -263,18 +364,46 @@ struct xraudio_session_record_inst_t {
 };
 
 struct xraudio_session_record_t {
+   xraudio_dispatch_object_t     obj_dispatch;   // event callbacks are invoked inline when NULL
+   uint32_t                      frame_period;   // microphone frame period (in milliseconds), the buffers are sized for the maximum
+   uint8_t                       input_mic_qty;  // quantity of microphones reported by the HAL at open
    bool                          recording;
    uint8_t                       pcm_bit_qty;
    int                           fd;
    xraudio_input_format_t        format_in;
    uint32_t                      timeout;
    xraudio_handler_unpack_t      handler_unpack;
-   xraudio_audio_group_int16_t   frame_buffer_int16[XRAUDIO_INPUT_SUPERFRAME_MAX_CHANNEL_QTY];
-   xraudio_audio_group_float_t   frame_buffer_fp32[XRAUDIO_INPUT_SUPERFRAME_MAX_CHANNEL_QTY];
+   xraudio_audio_group_int16_t * frame_buffer_int16;    // one for each microphone and reference channel, allocated when the thread is launched
+   xraudio_audio_group_float_t * frame_buffer_fp32;
+   uint8_t                       frame_buffer_chan_qty;
    uint8_t                       frame_group_index;
+   uint64_t                      frame_group_timestamp; // monotonic capture time of the first frame in the group (in microseconds)
    uint32_t                      frame_size_in;
    uint32_t                      frame_sample_qty;
+   xraudio_frame_features_t      frame_features[XRAUDIO_INPUT_MAX_CHANNEL_QTY]; // features of the most recent frame, calculated once for all consumers
+   xraudio_decimator_object_t    obj_decimator;  // decimates the capture rate to the input sample rate, NULL when the HAL captures at the input sample rate
+   xraudio_doa_object_t          obj_doa;
+   xraudio_doa_t                 doa;            // direction of arrival estimate from the most recent active frame
+   xraudio_governor_object_t     obj_governor;
+   xraudio_shed_level_t          shed_level;     // processing shed by the overload governor
+   uint8_t                       channel_mic_qty; // microphone channels allocated at open
+   uint32_t *                    channel_time_us; // processing time of each microphone channel in the current frame
+   uint32_t *                    channel_cost_us; // smoothed processing time of one frame on each microphone channel
+   uint8_t                       idle_frame_qty;    // frames read per wakeup while only keyword detection is active
+   uint8_t                       idle_backlog_qty;  // frames of an idle batch read ahead of their timestamps
+   xraudio_input_process_mode_t  process_mode;      // processing mode of the most recent wakeup
+   uint64_t                      process_timestamp; // monotonic time of the most recent wakeup (in microseconds), zero when not recording
+   uint32_t                      process_busy_us[XRAUDIO_INPUT_PROCESS_MODE_INVALID]; // time not yet added to the power report (less than a millisecond)
+   uint32_t                      process_time_us[XRAUDIO_INPUT_PROCESS_MODE_INVALID]; // time not yet added to the power report (less than a millisecond)
+   bool                          privacy_mode;      // microphone is muted by the HAL
+   bool                          suspended;         // input pipeline is suspended while privacy mode is enabled and no stream is active
+   uint64_t                      suspend_timestamp; // monotonic time of the suspension (in microseconds)
+   uint64_t                      suspend_time_us;   // time spent in the previous suspensions
+   uint32_t                      suspend_qty;
+   uint32_t                      resume_time_max_us;
    xraudio_stream_latency_mode_t latency_mode;
+   xraudio_stream_armed_t        stream_armed;
+   uint64_t                      keyword_timestamp; // monotonic time of the keyword detection (in microseconds), zero once a stream is started
    #ifdef XRAUDIO_DGA_ENABLED
    xraudio_dga_object_t          obj_dga;
    bool                          dynamic_gain_enabled;
@@ -284,15 +413,11 @@ struct xraudio_session_record_t {
    rdkx_timestamp_t              timestamp_next;
    xraudio_capture_session_t     capture_session;
    xraudio_capture_internal_t    capture_internal;
-   #ifdef MASK_FIRST_READ_DELAY
-   xraudio_thread_t              first_read_thread;
-   bool                          first_read_pending;
-   bool                          first_read_complete;
-   #endif
    int                           external_fd;
    xraudio_hal_input_obj_t       external_obj_hal;
    uint8_t                       external_frame_group_qty;
    uint8_t                       external_frame_group_index;
+   uint64_t                      external_frame_group_timestamp;
    uint32_t                      external_frame_size_in;
    uint32_t                      external_frame_size_out;
    uint8_t                       external_frame_buffer[(XRAUDIO_INPUT_EXTERNAL_FRAME_SAMPLE_QTY * sizeof(int16_t)) * XRAUDIO_INPUT_MAX_FRAME_GROUP_QTY];
@@ -304,6 +429,8 @@ struct xraudio_session_record_t {
    bool                          raw_mic_enable;
    uint8_t *                     hal_mic_frame_ptr;
    uint32_t                      hal_mic_frame_size;
+   xraudio_audio_buffer_out_t *  frame_buffer_out;            // converted output samples for pipe and user streams
+   uint32_t                      frame_buffer_out_sample_qty; // capacity of frame_buffer_out and the lent buffers (in samples)
 
    xraudio_session_record_inst_t instances[XRAUDIO_INPUT_SESSION_GROUP_QTY];
 };
@@ -328,11 +455,9 @@ typedef struct {
    uint32_t                  frame_size;
    int                       fifo_sound_intensity;
    rdkx_timestamp_t          timestamp_next;
-   #ifdef MASK_FIRST_WRITE_DELAY
-   xraudio_thread_t          first_write_thread;
-   bool                      first_write_pending;
-   bool                      first_write_complete;
-   #endif
+   bool                      standby;           // speaker stream is held in standby, only silence is written
+   bool                      standby_exit;      // playback started on the speaker stream held in standby, reported at its first frame
+   rdkx_timestamp_t          standby_timestamp; // time of the playback request
 } xraudio_session_playback_t;
 
 typedef struct {
@@ -354,20 +479,6 @@ typedef struct {
    xraudio_decoders_t           decoders;
 } xraudio_thread_state_t;
 
-#ifdef MASK_FIRST_WRITE_DELAY
-typedef struct {
-   xraudio_main_thread_params_t *params;
-   xraudio_session_playback_t *  session;
-} xraudio_thread_first_write_params_t;
-#endif
-
-#ifdef MASK_FIRST_READ_DELAY
-typedef struct {
-   xraudio_main_thread_params_t *params;
-   xraudio_session_record_t *  session;
-} xraudio_thread_first_read_params_t;
-#endif
-
 typedef struct {
    bool                    init;
    int                     msgq;
@@ -383,8 +494,25 @@ static void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraud
 static void xraudio_process_mic_error(xraudio_session_record_t *session);
 static void xraudio_process_input_external_data(xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_decoders_t *decoders);
 static void xraudio_in_flush(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance);
+static uint64_t xraudio_in_frame_timestamp_get(void);
+static void xraudio_in_latency_record(xraudio_latency_stage_t stage, uint64_t timestamp_begin);
+static void xraudio_in_frame_group_adapt(xraudio_session_record_inst_t *instance, uint8_t frame_group_index, bool flush, uint32_t frame_period);
+static void xraudio_in_frame_header_init(xraudio_session_record_inst_t *instance, xraudio_stream_frame_header_t *header, uint16_t flags, uint64_t timestamp, uint32_t sample_qty, uint32_t payload_size);
+static int  xraudio_in_frame_write_fifo(xraudio_session_record_inst_t *instance, uint32_t index, const xraudio_stream_frame_header_t *header, const void *data, size_t data_size);
+static bool xraudio_in_frame_pending_write(xraudio_session_record_inst_t *instance, uint32_t index);
+static void xraudio_in_fifo_close(xraudio_session_record_inst_t *instance, uint32_t index);
+static void xraudio_in_frame_events_flush(xraudio_devices_input_t source, xraudio_session_record_inst_t *instance, uint64_t timestamp);
+static uint32_t xraudio_in_samples_out(xraudio_session_record_t *session, xraudio_session_record_inst_t *instance, xraudio_audio_buffer_out_t *buffer_out, bool is_external, uint8_t chan, uint8_t frame_qty, uint32_t *sample_qty_chan, uint8_t *chan_qty);
+static xraudio_stream_buffer_entry_t *xraudio_in_buffer_pool_acquire(xraudio_session_record_inst_t *instance);
+static void xraudio_in_stream_buffer_unref(xraudio_stream_buffer_entry_t *entry);
+static void xraudio_in_samples_copy_int16(int16_t *dst, const int16_t * const *src, uint8_t chan_qty, uint32_t sample_qty);
+static void xraudio_in_samples_copy_int16_int32(int32_t *dst, const int16_t * const *src, uint8_t chan_qty, uint32_t sample_qty);
+static void xraudio_in_samples_copy_int16_fp32(float *dst, const int16_t *src, uint32_t sample_qty);
+static void xraudio_in_samples_copy_fp32_int32(int32_t *dst, const float * const *src, uint8_t chan_qty, uint32_t sample_qty);
+static void xraudio_in_samples_copy_fp32_fp32(float *dst, const float * const *src, uint8_t chan_qty, uint32_t sample_qty, float scale);
 static int  xraudio_in_write_to_file(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance);
 static int  xraudio_in_write_to_memory(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance);
+static void xraudio_in_write_to_memory_ring(xraudio_input_object_t obj_input, xraudio_devices_input_t source, xraudio_session_record_inst_t *instance, const xraudio_sample_t *samples, uint32_t sample_qty);
 static int  xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance);
 static int  xraudio_in_write_to_user(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance);
 
@@ -392,18 +520,53 @@ static void xraudio_unpack_mono_int16(xraudio_session_record_t *session, void *b
 static void xraudio_unpack_mono_int32(xraudio_session_record_t *session, void *buffer_in, xraudio_audio_group_int16_t *audio_group_int16, xraudio_audio_group_float_t *audio_group_fp32, uint32_t frame_group_index, uint32_t sample_qty_frame);
 static void xraudio_unpack_multi_int16(xraudio_session_record_t *session, void *buffer_in, uint8_t chan_qty, xraudio_audio_group_int16_t *audio_group_int16, xraudio_audio_group_float_t *audio_group_fp32, uint32_t frame_group_index, uint32_t sample_qty_frame);
 static void xraudio_unpack_multi_int32(xraudio_session_record_t *session, void *buffer_in, uint8_t chan_qty, xraudio_audio_group_int16_t *audio_group_int16, xraudio_audio_group_float_t *audio_group_fp32, uint32_t frame_group_index, uint32_t sample_qty_frame);
+static void xraudio_in_frame_features_calculate(const float * restrict samples, uint32_t sample_qty, float full_scale, xraudio_frame_features_t *features);
 
 #ifdef XRAUDIO_KWD_ENABLED
-static void     xraudio_keyword_detector_init(xraudio_keyword_detector_t *detector, json_t* jkwd_config);
+static void     xraudio_keyword_detector_init(xraudio_keyword_detector_t *detector, json_t* jkwd_config, const xraudio_beamformer_config_t *beamformer_config, const xraudio_keyword_commit_config_t *commit_config, const xraudio_keyword_models_config_t *models_config, uint32_t frame_period, xraudio_dispatch_object_t obj_dispatch);
+static xraudio_keyword_commit_reason_t xraudio_keyword_detector_commit_check(xraudio_keyword_detector_t *detector, bool all_triggered);
 static void     xraudio_keyword_detector_term(xraudio_keyword_detector_t *detector);
 static void     xraudio_keyword_detector_session_init(xraudio_keyword_detector_t *detector, uint8_t chan_qty, xraudio_keyword_sensitivity_t sensitivity);
 static bool     xraudio_keyword_detector_session_is_active(xraudio_keyword_detector_t *detector);
 static uint32_t xraudio_keyword_detector_session_pd_avail(xraudio_keyword_detector_t *detector, uint8_t active_chan);
 static void     xraudio_keyword_detector_session_term(xraudio_keyword_detector_t *detector);
 static int      xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance);
+static void     xraudio_in_beam_route(xraudio_main_thread_params_t *params, xraudio_session_record_t *session, uint8_t chan_qty_mic, uint8_t sample_size);
 static void     xraudio_in_write_to_keyword_buffer(xraudio_keyword_detector_chan_t *keyword_detector_chan, float *frame_buffer_fp32, uint32_t sample_qty);
 static bool     xraudio_in_pre_detection_chunks(xraudio_keyword_detector_chan_t *keyword_detector_chan, uint32_t sample_qty, uint32_t offset_from_end, float **chunk_1_data, uint32_t *chunk_1_qty, float **chunk_2_data, uint32_t *chunk_2_qty);
+static void     xraudio_in_pre_detection_write_converted(xraudio_devices_input_t source, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance, const float *samples, uint32_t sample_qty, uint64_t timestamp);
+static void     xraudio_in_speculative_update(xraudio_session_record_t *session, uint32_t frame_group_index, uint32_t sample_qty);
+static void     xraudio_in_speculative_samples_write(xraudio_keyword_speculative_t *speculative, const float *samples, uint32_t sample_qty, uint64_t timestamp, uint32_t sample_rate);
+static bool     xraudio_in_speculative_frame_write(xraudio_keyword_speculative_t *speculative, uint16_t flags, const int16_t *samples, uint32_t sample_qty, uint64_t timestamp);
+static void     xraudio_in_speculative_end(xraudio_keyword_speculative_t *speculative, bool confirm);
+static void *   xraudio_thread_kwd_reload(void *param);
+static void *   xraudio_thread_kwd_init(void *param);
+static void     xraudio_keyword_models_run(xraudio_session_record_t *session, uint8_t chan, uint32_t chan_sample_qty, bool is_armed, uint64_t timestamp_begin);
+static void     xraudio_keyword_models_detected(xraudio_session_record_t *session, uint8_t chan, uint8_t index);
+static void     xraudio_keyword_detector_reload_swap(xraudio_keyword_detector_t *detector);
+static void     xraudio_keyword_detector_suspend(xraudio_keyword_detector_t *detector);
+static void     xraudio_keyword_detector_resume(xraudio_keyword_detector_t *detector);
+static void     xraudio_keyword_detector_state_save(xraudio_keyword_detector_t *detector);
+static void     xraudio_keyword_detector_state_restore(xraudio_keyword_detector_t *detector);
 #endif
+static void     xraudio_in_governor_update(xraudio_main_thread_params_t *params, xraudio_session_record_t *session, uint64_t timestamp_begin, bool overrun);
+static bool     xraudio_in_channels_create(xraudio_session_record_t *session, xraudio_main_thread_params_t *params);
+static void     xraudio_in_channels_destroy(xraudio_session_record_t *session);
+static void     xraudio_in_channel_time_add(xraudio_session_record_t *session, uint8_t chan, uint64_t timestamp_begin);
+static void     xraudio_in_channel_cost_update(xraudio_session_record_t *session, uint8_t chan_qty_mic);
+static uint8_t  xraudio_in_idle_frame_qty(xraudio_thread_state_t *state);
+static void     xraudio_in_process_account(xraudio_session_record_t *session, xraudio_input_process_mode_t mode, uint64_t timestamp_begin);
+static void     xraudio_in_process_time_add(xraudio_atomic_int_t *time_ms, uint32_t *time_us, uint64_t elapsed_us);
+static int      xraudio_in_atomic_int_take(xraudio_atomic_int_t *atomic);
+static void     xraudio_in_suspend_update(xraudio_thread_state_t *state);
+static void     xraudio_in_suspend(xraudio_thread_state_t *state);
+static void     xraudio_in_resume(xraudio_thread_state_t *state);
+static void     xraudio_dsp_state_save(xraudio_thread_state_t *state);
+static void     xraudio_dsp_state_restore(xraudio_thread_state_t *state);
+static void     xraudio_in_stream_armed_attach(xraudio_thread_state_t *state);
+static bool     xraudio_in_stream_armed_release(xraudio_session_record_t *session, xraudio_devices_input_t source);
+static void     xraudio_in_first_byte_written(xraudio_session_record_inst_t *instance);
+static void     xraudio_in_detect_reload_end(xraudio_result_t result, uint32_t load_time_ms, uint32_t swap_delay_us, uint32_t swap_time_us);
 static void xraudio_keyword_detector_session_disarm(xraudio_keyword_detector_t *detector);
 static void xraudio_keyword_detector_session_arm(xraudio_keyword_detector_t *detector, keyword_callback_t callback, void *cb_param, xraudio_keyword_sensitivity_t sensitivity);
 static bool xraudio_keyword_detector_session_is_armed(xraudio_keyword_detector_t *detector);
@@ -430,6 +593,9 @@ static bool xraudio_in_capture_internal_filename_get(char *filename, const char
 #if defined(XRAUDIO_KWD_ENABLED) || defined(XRAUDIO_DGA_ENABLED)
 static void xraudio_samples_convert_fp32_int16(int16_t *samples_int16, float *samples_fp32, uint32_t sample_qty, uint32_t bit_qty);
 #endif
+#ifdef XRAUDIO_DGA_ENABLED
+static void xraudio_in_dga_apply(xraudio_dga_object_t object, float *samples, uint32_t sample_qty);
+#endif
 #ifdef XRAUDIO_PPR_ENABLED
 static void xraudio_preprocess_mic_data(xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_ppr_event_t *ppr_event);
 //static void xraudio_samples_convert_int16_int32(int16_t *int16buf, int32_t *int32buf, uint32_t sample_qty_frame, uint8_t sample_size);
@@ -446,6 +612,7 @@ static time_t   xraudio_get_file_timestamp(char *filename);
 
 static int  xraudio_in_capture_session_to_file_int16(xraudio_capture_point_t *capture_point, int16_t *samples, uint32_t sample_qty);
 static int  xraudio_in_capture_session_to_file_int32(xraudio_capture_point_t *capture_point, int32_t *samples, uint32_t sample_qty);
+static void xraudio_in_capture_session_wideband(xraudio_session_record_t *session, uint8_t *buffer, uint8_t chan_qty, uint32_t sample_qty_channel, uint8_t sample_size);
 #if defined(XRAUDIO_KWD_ENABLED) && defined(XRAUDIO_DGA_ENABLED)
 static int  xraudio_in_capture_session_to_file_float(xraudio_capture_point_t *capture_point, float *samples, uint32_t sample_qty);
 #endif
@@ -478,6 +645,8 @@ static void xraudio_msg_thread_poll(xraudio_thread_state_t *state, void *msg);
 static void xraudio_msg_power_mode(xraudio_thread_state_t *state, void *msg);
 static void xraudio_msg_privacy_mode(xraudio_thread_state_t *state, void *msg);
 static void xraudio_msg_privacy_mode_get(xraudio_thread_state_t *state, void *msg);
+static void xraudio_msg_detect_reload(xraudio_thread_state_t *state, void *msg);
+static void xraudio_msg_detect_reload_ready(xraudio_thread_state_t *state, void *msg);
 
 static void xraudio_encoding_parameters_get(xraudio_input_format_t *format, uint32_t frame_duration, uint32_t *frame_size, uint16_t stream_time_min_ms, uint32_t *min_audio_data_len);
 static bool xraudio_in_aop_adjust_apply(int32_t *buffer, uint32_t sample_qty_frame, int8_t input_aop_adjust_shift);
@@ -505,35 +674,124 @@ static const xraudio_msg_handler_t g_xraudio_msg_handlers[XRAUDIO_MAIN_QUEUE_MSG
    xraudio_msg_thread_poll,
    xraudio_msg_power_mode,
    xraudio_msg_privacy_mode,
-   xraudio_msg_privacy_mode_get
+   xraudio_msg_privacy_mode_get,
+   xraudio_msg_detect_reload,
+   xraudio_msg_detect_reload_ready
 };
 
-#ifdef MASK_FIRST_WRITE_DELAY
-static void *xraudio_thread_first_write(void *param);
-
-xraudio_thread_first_write_params_t g_thread_params_write;
-#endif
+static unsigned char g_frame_silence[2 * XRAUDIO_OUTPUT_FRAME_SIZE_MAX];
 
-#ifdef MASK_FIRST_READ_DELAY
-static void *xraudio_thread_first_read(void *param);
+static xraudio_session_voice_t g_voice_session = {0};
 
-xraudio_thread_first_read_params_t g_thread_params_read;
-#endif
 
-static unsigned char g_frame_silence[2 * XRAUDIO_OUTPUT_FRAME_SIZE_MAX];
 
-static xraudio_session_voice_t g_voice_session = {0};
+// Speculative stream counters, written by the main thread only
+static xraudio_atomic_int_t g_speculative_tentative_qty;
+static xraudio_atomic_int_t g_speculative_hit_qty;
+static xraudio_atomic_int_t g_speculative_retract_qty;
+static xraudio_atomic_int_t g_speculative_lead_ms_total;
+
+// Keyword detector reload status, written by the main thread only (except for the in progress flag which is set by the api)
+static xraudio_atomic_int_t g_detect_reload_in_progress;
+static xraudio_atomic_int_t g_detect_reload_result;
+static xraudio_atomic_int_t g_detect_reload_qty;
+static xraudio_atomic_int_t g_detect_reload_load_time_ms;
+static xraudio_atomic_int_t g_detect_reload_swap_delay_us;
+static xraudio_atomic_int_t g_detect_reload_swap_time_us;
+
+// Overload governor statistics, written by the main thread only
+static xraudio_atomic_int_t g_governor_level;
+static xraudio_atomic_int_t g_governor_change_qty;
+static xraudio_atomic_int_t g_governor_overrun_qty;
+static xraudio_atomic_int_t g_governor_load_pct;
+static xraudio_atomic_int_t g_governor_level_time_ms[XRAUDIO_SHED_LEVEL_INVALID];
+
+// Input channel report, written by the main thread only
+static xraudio_atomic_int_t g_channel_mic_qty;
+static xraudio_atomic_int_t g_channel_ec_ref_qty;
+static xraudio_atomic_int_t g_channel_keyword_qty;
+static xraudio_atomic_int_t g_channel_frame_bytes;
+static xraudio_atomic_int_t g_channel_keyword_bytes;
+static xraudio_atomic_int_t g_channel_memory_bytes;
+static xraudio_atomic_int_t g_channel_time_us[XRAUDIO_INPUT_MAX_CHANNEL_QTY];
+
+// Input power report, accumulated by the main thread and cleared when read
+static xraudio_atomic_int_t g_process_mode;
+static xraudio_atomic_int_t g_process_idle_frame_qty;
+static xraudio_atomic_int_t g_process_wakeup_qty[XRAUDIO_INPUT_PROCESS_MODE_INVALID];
+static xraudio_atomic_int_t g_process_time_ms[XRAUDIO_INPUT_PROCESS_MODE_INVALID];
+static xraudio_atomic_int_t g_process_busy_ms[XRAUDIO_INPUT_PROCESS_MODE_INVALID];
+
+// Privacy report, written by the main thread only
+static xraudio_atomic_int_t g_privacy_suspended;
+static xraudio_atomic_int_t g_privacy_suspend_qty;
+static xraudio_atomic_int_t g_privacy_suspend_begin_ms; // low 32 bits of the monotonic time of the current suspension
+static xraudio_atomic_int_t g_privacy_suspend_time_ms;  // time spent in the previous suspensions
+static xraudio_atomic_int_t g_privacy_wakeup_qty;
+static xraudio_atomic_int_t g_privacy_memory_bytes;
+static xraudio_atomic_int_t g_privacy_resume_time_us;
+static xraudio_atomic_int_t g_privacy_resume_time_max_us;
+
+// DSP state report, written by the main thread only
+static xraudio_atomic_int_t g_dsp_save_qty[XRAUDIO_DSP_PLUGIN_INVALID];
+static xraudio_atomic_int_t g_dsp_restore_qty[XRAUDIO_DSP_PLUGIN_INVALID];
+static xraudio_atomic_int_t g_dsp_reject_qty[XRAUDIO_DSP_PLUGIN_INVALID];
+static xraudio_atomic_int_t g_dsp_size_bytes[XRAUDIO_DSP_PLUGIN_INVALID];
+static xraudio_atomic_int_t g_dsp_restore_time_us[XRAUDIO_DSP_PLUGIN_INVALID];
+
+// Armed stream report, written by the main thread only
+static xraudio_atomic_int_t g_armed_qty;
+static xraudio_atomic_int_t g_armed_attach_qty;
+static xraudio_atomic_int_t g_armed_release_qty;
+static xraudio_atomic_int_t g_armed_attach_time_us;
+static xraudio_atomic_int_t g_armed_first_byte_us;
+static xraudio_atomic_int_t g_first_byte_us;
+
+// Standby report, written by the main thread only
+static xraudio_atomic_int_t g_standby_input_first_read_us;
+static xraudio_atomic_int_t g_standby_output_entry_qty;
+static xraudio_atomic_int_t g_standby_output_exit_qty;
+static xraudio_atomic_int_t g_standby_output_reopen_qty;
+static xraudio_atomic_int_t g_standby_output_entry_time_us;
+static xraudio_atomic_int_t g_standby_output_exit_time_us;
+
+// Init report, written by the main thread and the keyword detector init thread
+static xraudio_atomic_int_t g_init_thread_time_us;
+static xraudio_atomic_int_t g_init_kwd_time_us;
+static xraudio_atomic_int_t g_init_dga_time_us;
+static xraudio_atomic_int_t g_init_decoder_time_us;
+static xraudio_atomic_int_t g_init_capture_time_us;
 
 void *xraudio_main_thread(void *param) {
    xraudio_thread_state_t state = {0};
+   uint64_t timestamp_init = xraudio_in_frame_timestamp_get();
 #ifdef XRAUDIO_KWD_ENABLED
    json_t *jkwd_config = NULL;
+   xraudio_thread_t kwd_init_thread = { .running = false };
+   xraudio_keyword_detector_init_t kwd_init;
 #endif
 #ifdef XRAUDIO_DGA_ENABLED
    json_t *jdga_config = NULL;
 #endif
 
    state.params = *((xraudio_main_thread_params_t *)param);
+   xraudio_atomic_int_set(&g_speculative_tentative_qty, 0);
+   xraudio_atomic_int_set(&g_speculative_hit_qty, 0);
+   xraudio_atomic_int_set(&g_speculative_retract_qty, 0);
+   xraudio_atomic_int_set(&g_speculative_lead_ms_total, 0);
+   xraudio_atomic_int_set(&g_detect_reload_in_progress, 0);
+   xraudio_atomic_int_set(&g_detect_reload_result, XRAUDIO_RESULT_OK);
+   xraudio_atomic_int_set(&g_detect_reload_qty, 0);
+   xraudio_atomic_int_set(&g_detect_reload_load_time_ms, 0);
+   xraudio_atomic_int_set(&g_detect_reload_swap_delay_us, 0);
+   xraudio_atomic_int_set(&g_detect_reload_swap_time_us, 0);
+   xraudio_atomic_int_set(&g_governor_level, XRAUDIO_SHED_LEVEL_NONE);
+   xraudio_atomic_int_set(&g_governor_change_qty, 0);
+   xraudio_atomic_int_set(&g_governor_overrun_qty, 0);
+   xraudio_atomic_int_set(&g_governor_load_pct, 0);
+   for(uint32_t level = 0; level < XRAUDIO_SHED_LEVEL_INVALID; level++) {
+      xraudio_atomic_int_set(&g_governor_level_time_ms[level], 0);
+   }
 
    if(state.params.dsp_config.input_kwd_max_channel_qty > XRAUDIO_INPUT_KWD_MAX_CHANNEL_QTY) {
       XLOGD_WARN("Input kwd chan qty > maximum (%d) - default to max", XRAUDIO_INPUT_KWD_MAX_CHANNEL_QTY);
@@ -550,6 +808,11 @@ void *xraudio_main_thread(void *param) {
       return(NULL);
    }
 
+   if(!xraudio_in_channels_create(&state.record, &state.params)) {
+      sem_post(state.params.semaphore);
+      return(NULL);
+   }
+
    if(!g_voice_session.init) {
       g_voice_session = (xraudio_session_voice_t) { .init              = true,
                                                     .msgq              = state.params.msgq,
@@ -559,7 +822,21 @@ void *xraudio_main_thread(void *param) {
    }
 
    state.record.recording            = false;
+   state.record.obj_dispatch         = state.params.obj_dispatch;
+   state.record.frame_period         = state.params.input_frame_period;
+   state.record.input_mic_qty        = state.params.input_mic_qty;
    state.record.fd                   = -1;
+   state.record.idle_frame_qty       = 1;
+   state.record.idle_backlog_qty     = 0;
+   state.record.process_mode         = XRAUDIO_INPUT_PROCESS_MODE_FRAME;
+   state.record.process_timestamp    = 0;
+   state.record.privacy_mode         = state.params.privacy_mode;
+   state.record.suspended            = false;
+   state.record.suspend_time_us      = 0;
+   state.record.suspend_qty          = 0;
+   state.record.resume_time_max_us   = 0;
+   state.record.stream_armed.armed   = false;
+   state.record.keyword_timestamp    = 0;
    state.record.format_in            = (xraudio_input_format_t) { .container   = XRAUDIO_CONTAINER_INVALID,
                                                                   .encoding    = XRAUDIO_ENCODING_INVALID,
                                                                   .sample_rate = XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE,
@@ -567,16 +844,27 @@ void *xraudio_main_thread(void *param) {
                                                                   .channel_qty = XRAUDIO_INPUT_DEFAULT_CHANNEL_QTY };
    state.record.timeout                = 0;
    state.record.frame_group_index      = 0;
+   state.record.frame_group_timestamp  = 0;
    state.record.frame_size_in          = 0;
    state.record.frame_sample_qty       = 0;
    state.record.latency_mode           = XRAUDIO_STREAM_LATENCY_NORMAL;
 
+   for(uint32_t mode = XRAUDIO_INPUT_PROCESS_MODE_FRAME; mode < XRAUDIO_INPUT_PROCESS_MODE_INVALID; mode++) {
+      state.record.process_busy_us[mode] = 0;
+      state.record.process_time_us[mode] = 0;
+      xraudio_atomic_int_set(&g_process_wakeup_qty[mode], 0);
+      xraudio_atomic_int_set(&g_process_time_ms[mode],    0);
+      xraudio_atomic_int_set(&g_process_busy_ms[mode],    0);
+   }
+
    for(uint32_t group = XRAUDIO_INPUT_SESSION_GROUP_DEFAULT; group < XRAUDIO_INPUT_SESSION_GROUP_QTY; group++) {
       xraudio_session_record_inst_t *instance = &state.record.instances[group];
 
       instance->source                 = XRAUDIO_DEVICE_INPUT_NONE;
       instance->frame_size_out         = 0;
       instance->frame_group_qty        = XRAUDIO_INPUT_DEFAULT_FRAME_GROUP_QTY;
+      instance->latency_budget_ms      = 0;
+      instance->batch_qty              = XRAUDIO_INPUT_MIN_FRAME_GROUP_QTY;
       instance->mode_changed           = false;
       instance->record_callback        = NULL;
       instance->fh                     = NULL;
@@ -590,9 +878,18 @@ void *xraudio_main_thread(void *param) {
       instance->synchronous            = false;
       instance->semaphore              = NULL;
       instance->latency_mode           = XRAUDIO_STREAM_LATENCY_NORMAL;
+      instance->framing                = XRAUDIO_STREAM_FRAMING_NONE;
+      instance->frame_sequence         = 0;
+      instance->frame_flags            = 0;
+      instance->sample_format          = XRAUDIO_STREAM_SAMPLE_FORMAT_INT16;
+      instance->channel_layout         = XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO;
+      instance->sample_convert         = false;
+      instance->buffer_pool_qty        = 0;
 
       for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
          instance->fifo_audio_data[index]     = -1;
+         instance->frame_gap[index]           = false;
+         instance->frame_pending[index].buffer = NULL;
          instance->stream_from[index]         = XRAUDIO_INPUT_RECORD_FROM_INVALID;
          instance->stream_until[index]        = XRAUDIO_INPUT_RECORD_UNTIL_INVALID;
          instance->stream_begin_offset[index] = 0;
@@ -651,9 +948,45 @@ void *xraudio_main_thread(void *param) {
    }
    state.record.keyword_detector.input_kwd_max_channel_qty = state.params.dsp_config.input_kwd_max_channel_qty;
    state.record.keyword_detector.input_asr_kwd_channel_qty = state.params.dsp_config.input_asr_max_channel_qty + state.params.dsp_config.input_kwd_max_channel_qty;
-   xraudio_keyword_detector_init(&state.record.keyword_detector, jkwd_config);
+   state.record.keyword_detector.speculative.pipe          = state.params.speculative_pipe;
+   state.record.keyword_detector.snapshot                  = state.params.dsp_snapshot_kwd;
+
+   // Load the keyword models in a separate thread while the other plugins are initialized.  The detector is not accessed until the thread is joined.
+   kwd_init.detector    = &state.record.keyword_detector;
+   kwd_init.jkwd_config = jkwd_config;
+   kwd_init.params      = &state.params;
+   if(!xraudio_thread_create(&kwd_init_thread, "xraudio_kwd_in", xraudio_thread_kwd_init, &kwd_init)) {
+      xraudio_thread_kwd_init(&kwd_init);
+   }
    #endif
+   state.record.obj_decimator = NULL;
+   state.record.obj_doa = NULL;
+   memset(&state.record.doa, 0, sizeof(state.record.doa));
+   state.record.obj_governor = NULL;
+   state.record.shed_level   = XRAUDIO_SHED_LEVEL_NONE;
+   if(state.params.governor_config.enable) {
+      state.record.obj_governor = xraudio_governor_object_create(&state.params.governor_config, state.params.input_frame_period * 1000);
+      if(state.record.obj_governor == NULL) {
+         XLOGD_ERROR("unable to create governor object");
+      }
+   }
+   uint32_t capture_rate = XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE;
+   if(state.params.input_capture_rate > XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE) {
+      state.record.obj_decimator = xraudio_decimator_object_create(state.params.input_capture_rate / XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE, state.record.frame_buffer_chan_qty, (state.params.input_capture_rate * XRAUDIO_INPUT_FRAME_PERIOD) / 1000);
+      if(state.record.obj_decimator == NULL) {
+         XLOGD_ERROR("unable to create decimator object");
+      } else {
+         capture_rate = state.params.input_capture_rate;
+      }
+   }
+   if(state.params.beamformer_config.doa_enable) { // Estimated on the frame at the capture rate for finer lag resolution
+      state.record.obj_doa = xraudio_doa_object_create(&state.params.beamformer_config, capture_rate, (capture_rate * state.params.input_frame_period) / 1000);
+      if(state.record.obj_doa == NULL) {
+         XLOGD_ERROR("unable to create doa object");
+      }
+   }
    #ifdef XRAUDIO_DGA_ENABLED
+   uint64_t timestamp_dga = xraudio_in_frame_timestamp_get();
    if(NULL == state.params.json_obj_input) {
       XLOGD_INFO("parameter json_obj_input is null, using defaults");
    } else {
@@ -669,12 +1002,14 @@ void *xraudio_main_thread(void *param) {
    }
    state.record.obj_dga                  = xraudio_dga_object_create(jdga_config);
    state.record.dynamic_gain_enabled     = true;
+   #ifdef XRAUDIO_DSP_STATE_ENABLED
+   xraudio_dsp_snapshot_restore(state.params.dsp_snapshot_dga, XRAUDIO_DSP_PLUGIN_DGA, state.record.obj_dga, xraudio_dga_snapshot_restore);
+   #endif
+   xraudio_atomic_int_set(&g_init_dga_time_us, (int)(xraudio_in_frame_timestamp_get() - timestamp_dga));
    #endif
 
    state.record.devices_input                = XRAUDIO_DEVICE_INPUT_NONE;
    state.record.timestamp_next               = (rdkx_timestamp_t) { .tv_sec = 0, .tv_nsec = 0 };
-   memset(state.record.frame_buffer_int16, 0, sizeof(state.record.frame_buffer_int16));
-   memset(state.record.frame_buffer_fp32, 0, sizeof(state.record.frame_buffer_fp32));
 
    memset(&state.record.capture_session, 0, sizeof(state.record.capture_session));
 
@@ -684,7 +1019,8 @@ void *xraudio_main_thread(void *param) {
       state.record.capture_internal.dir_path                = strdup(state.params.internal_capture_params.dir_path);
       state.record.capture_internal.file_qty_max            = state.params.internal_capture_params.file_qty_max;
       state.record.capture_internal.file_size_max           = state.params.internal_capture_params.file_size_max;
-      state.record.capture_internal.file_index              = xraudio_capture_next_file_index(state.params.internal_capture_params.dir_path, state.params.internal_capture_params.file_qty_max);
+      state.record.capture_internal.file_index              = 0;
+      state.record.capture_internal.indexed                 = false;
    } else {
       XLOGD_INFO("internal capture disabled");
       state.record.capture_internal.enabled                 = false;
@@ -692,16 +1028,9 @@ void *xraudio_main_thread(void *param) {
       state.record.capture_internal.file_qty_max            = 0;
       state.record.capture_internal.file_size_max           = 0;
       state.record.capture_internal.file_index              = 0;
-
+      state.record.capture_internal.indexed                 = false;
    }
 
-   #ifdef MASK_FIRST_READ_DELAY
-   state.record.first_read_thread.id      = 0;
-   state.record.first_read_thread.running = false;
-   state.record.first_read_pending        = false;
-   state.record.first_read_complete       = false;
-   #endif
-
    state.record.external_fd                = -1;
    state.record.external_obj_hal           = NULL;
    state.record.external_frame_group_qty   = XRAUDIO_INPUT_DEFAULT_FRAME_GROUP_QTY;
@@ -733,12 +1062,9 @@ void *xraudio_main_thread(void *param) {
    memset(state.playback.frame_buffer, 0, sizeof(state.playback.frame_buffer));
    state.playback.frame_size           = 0;
    state.playback.timestamp_next       = (rdkx_timestamp_t) { .tv_sec = 0, .tv_nsec = 0 };
-   #ifdef MASK_FIRST_WRITE_DELAY
-   state.playback.first_write_thread.id      = 0;
-   state.playback.first_write_thread.running = false;
-   state.playback.first_write_pending        = false;
-   state.playback.first_write_complete       = false;
-   #endif
+   state.playback.standby              = false;
+   state.playback.standby_exit         = false;
+   state.playback.standby_timestamp    = (rdkx_timestamp_t) { .tv_sec = 0, .tv_nsec = 0 };
 
    state.record.input_aop_adjust_shift       = XRAUDIO_IN_AOP_ADJ_DB_TO_SHIFT(state.params.dsp_config.aop_adjust);
    state.record.input_aop_adjust_dB          = state.params.dsp_config.aop_adjust;
@@ -752,6 +1078,7 @@ void *xraudio_main_thread(void *param) {
    state.timer_obj      = rdkx_timer_create(4, true, true);
    state.timer_id_frame = RDXK_TIMER_ID_INVALID;
 
+   uint64_t timestamp_decoder = xraudio_in_frame_timestamp_get();
    #ifdef XRAUDIO_DECODE_ADPCM
    // Create ADPCM decoder
    state.decoders.adpcm = adpcm_decode_create();
@@ -762,8 +1089,14 @@ void *xraudio_main_thread(void *param) {
       XLOGD_ERROR("unable to create opus decoder");
    }
    #endif
+   xraudio_atomic_int_set(&g_init_decoder_time_us, (int)(xraudio_in_frame_timestamp_get() - timestamp_decoder));
+
+   #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_thread_join(&kwd_init_thread);
+   #endif
 
    char msg[XRAUDIO_MSG_QUEUE_MSG_SIZE_MAX];
+   xraudio_atomic_int_set(&g_init_thread_time_us, (int)(xraudio_in_frame_timestamp_get() - timestamp_init));
    XLOGD_DEBUG("Started");
 
    // Unblock the caller that launched this thread
@@ -777,7 +1110,7 @@ void *xraudio_main_thread(void *param) {
       fd_set rfds;
       FD_ZERO(&rfds);
       FD_SET(state.params.msgq, &rfds);
-      if(state.record.fd >= 0) {
+      if(state.record.fd >= 0 && !state.record.suspended) { // HAL is not polled while suspended
          if(state.record.fd > state.params.msgq) {
             nfds = state.record.fd + 1;
          }
@@ -842,7 +1175,10 @@ void *xraudio_main_thread(void *param) {
                XLOGD_DEBUG("val <%llu>", val);
                if(val > 0) {
                   unsigned long timeout;
+                  uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
                   xraudio_process_mic_data(&state.params, &state.record, &timeout);
+                  xraudio_in_stream_armed_attach(&state);
+                  xraudio_in_process_account(&state.record, XRAUDIO_INPUT_PROCESS_MODE_FRAME, timestamp_begin);
                }
             }
          }
@@ -866,15 +1202,27 @@ void *xraudio_main_thread(void *param) {
          if((uint32_t)header->type >= XRAUDIO_MAIN_QUEUE_MSG_TYPE_INVALID) {
             XLOGD_ERROR("invalid msg type <%s>", xraudio_main_queue_msg_type_str(header->type));
          } else {
+            #ifdef XRAUDIO_TRACE_ENABLED
+            uint64_t timestamp_msg = xraudio_in_frame_timestamp_get();
+            #endif
             (*g_xraudio_msg_handlers[header->type])(&state, msg);
+            xraudio_in_suspend_update(&state);
+            XRAUDIO_TRACE(XRAUDIO_TRACE_EVENT_MSG, header->type, timestamp_msg, (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_msg));
          }
       }
    } while(state.running);
 
+   if(state.record.stream_armed.armed) { // The keyword was not detected so close the pipes of the armed stream
+      xraudio_in_stream_armed_release(&state.record, state.record.stream_armed.record.source);
+   }
+
    rdkx_timer_destroy(state.timer_obj);
 
    #ifdef XRAUDIO_DGA_ENABLED
    if(state.record.obj_dga != NULL) {
+      #ifdef XRAUDIO_DSP_STATE_ENABLED
+      xraudio_dsp_snapshot_save(state.params.dsp_snapshot_dga, XRAUDIO_DSP_PLUGIN_DGA, state.record.obj_dga, xraudio_dga_snapshot_size, xraudio_dga_snapshot_save);
+      #endif
       xraudio_dga_object_destroy(state.record.obj_dga);
       state.record.obj_dga = NULL;
    }
@@ -892,9 +1240,30 @@ void *xraudio_main_thread(void *param) {
    #ifdef XRAUDIO_KWD_ENABLED
    xraudio_keyword_detector_term(&state.record.keyword_detector);
    #endif
+   xraudio_in_channels_destroy(&state.record);
+   if(state.record.obj_doa != NULL) {
+      xraudio_doa_object_destroy(state.record.obj_doa);
+      state.record.obj_doa = NULL;
+   }
+   if(state.record.obj_decimator != NULL) {
+      xraudio_decimator_object_destroy(state.record.obj_decimator);
+      state.record.obj_decimator = NULL;
+   }
+   if(state.record.obj_governor != NULL) {
+      xraudio_governor_object_destroy(state.record.obj_governor);
+      state.record.obj_governor = NULL;
+   }
    if(state.record.capture_internal.dir_path != NULL) {
       free(state.record.capture_internal.dir_path);
    }
+   for(uint32_t group = XRAUDIO_INPUT_SESSION_GROUP_DEFAULT; group < XRAUDIO_INPUT_SESSION_GROUP_QTY; group++) {
+      for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
+         if(state.record.instances[group].frame_pending[index].buffer != NULL) {
+            free(state.record.instances[group].frame_pending[index].buffer);
+            state.record.instances[group].frame_pending[index].buffer = NULL;
+         }
+      }
+   }
 
    return(NULL);
 }
@@ -907,10 +1276,13 @@ void xraudio_msg_record_idle_start(xraudio_thread_state_t *state, void *msg) {
 
    instance->source                        = XRAUDIO_DEVICE_INPUT_NONE;
    instance->frame_group_qty               = XRAUDIO_INPUT_DEFAULT_FRAME_GROUP_QTY;
+   instance->latency_budget_ms             = 0;
    instance->frame_size_out                = 0;
    instance->fh                            = NULL;
    instance->audio_buf_samples             = NULL;
    instance->audio_buf_sample_qty          = 0;
+   instance->audio_buf_circular            = false;
+   instance->audio_buf_wrapped             = false;
    instance->data_callback                 = NULL;
    instance->callback                      = NULL;
    instance->param                         = NULL;
@@ -940,11 +1312,30 @@ void xraudio_msg_record_idle_start(xraudio_thread_state_t *state, void *msg) {
    //XLOGD_INFO("record device = %s", xraudio_devices_input_str(state->record.devices_input));
 
    // Set timeout for next chunk (in microseconds)
-   state->record.timeout           = XRAUDIO_INPUT_FRAME_PERIOD * 1000;
-   state->record.frame_sample_qty  = (XRAUDIO_INPUT_FRAME_PERIOD * state->record.format_in.sample_rate * state->record.format_in.channel_qty) / 1000;
+   state->record.timeout           = state->params.input_frame_period * 1000;
+   state->record.frame_sample_qty  = (state->params.input_frame_period * state->record.format_in.sample_rate * state->record.format_in.channel_qty) / 1000;
    state->record.frame_size_in     = state->record.frame_sample_qty * state->record.format_in.sample_size;
    state->record.frame_group_index = 0;
    state->record.latency_mode      = XRAUDIO_STREAM_LATENCY_NORMAL;
+   memset(state->record.channel_time_us, 0, state->record.channel_mic_qty * sizeof(uint32_t));
+   memset(state->record.channel_cost_us, 0, state->record.channel_mic_qty * sizeof(uint32_t));
+
+   state->record.idle_frame_qty   = state->params.input_idle_frame_qty;
+   state->record.idle_backlog_qty = 0;
+   uint32_t hal_buffer_size = xraudio_hal_input_buffer_size_get(state->params.hal_input_obj);
+   if(state->record.idle_frame_qty > 1 && hal_buffer_size > 0 && state->record.frame_size_in > 0 && hal_buffer_size / state->record.frame_size_in < state->record.idle_frame_qty) { // HAL must buffer the whole batch
+      uint32_t frame_qty = hal_buffer_size / state->record.frame_size_in;
+      XLOGD_WARN("idle frame qty <%u> reduced to <%u> by hal buffer size <%u>", state->record.idle_frame_qty, (frame_qty > 0) ? frame_qty : 1, hal_buffer_size);
+      state->record.idle_frame_qty = (frame_qty > 0) ? frame_qty : 1;
+   }
+
+   memset(&state->record.doa, 0, sizeof(state->record.doa));
+   if(state->record.obj_doa != NULL) {
+      xraudio_doa_reset(state->record.obj_doa);
+   }
+   if(state->record.obj_decimator != NULL) {
+      xraudio_decimator_reset(state->record.obj_decimator);
+   }
 
    state->record.external_frame_group_qty   = XRAUDIO_INPUT_DEFAULT_FRAME_GROUP_QTY;
    state->record.external_frame_group_index = 0;
@@ -978,7 +1369,9 @@ void xraudio_msg_record_idle_start(xraudio_thread_state_t *state, void *msg) {
       }
 
       if(state->record.fd < 0) {
+         uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
          xraudio_process_mic_data(&state->params, &state->record, &timeout_val);
+         xraudio_atomic_int_set(&g_standby_input_first_read_us, (int)(xraudio_in_frame_timestamp_get() - timestamp_begin));
 
          // Update the timeout
          rdkx_timestamp_t timeout;
@@ -997,7 +1390,8 @@ void xraudio_msg_record_idle_start(xraudio_thread_state_t *state, void *msg) {
 void xraudio_msg_record_idle_stop(xraudio_thread_state_t *state, void *msg) {
    xraudio_queue_msg_record_idle_stop_t *idle_stop = (xraudio_queue_msg_record_idle_stop_t *)msg;
    XLOGD_DEBUG("");
-   state->record.recording = false;
+   state->record.recording         = false;
+   state->record.process_timestamp = 0; // the time until the next session is not counted
    if(state->record.fd >= 0) {
       close(state->record.fd);
       state->record.fd = -1;
@@ -1018,9 +1412,27 @@ void xraudio_msg_record_start(xraudio_thread_state_t *state, void *msg) {
 
    XLOGD_DEBUG("<%s> intensity <%s>", record->semaphore ? "SYNC" : "ASYNC", record->fifo_sound_intensity >= 0 ? "YES" : "NO");
 
+   if(record->armed) { // Held until the keyword is detected
+      xraudio_stream_armed_t *armed = &state->record.stream_armed;
+      armed->record       = *record;
+      armed->record.armed = false;
+      armed->armed        = true;
+      armed->detected     = false;
+      xraudio_atomic_int_add(&g_armed_qty, 1);
+      XLOGD_INFO("src <%s> armed for keyword detection", xraudio_devices_input_str(record->source));
+
+      if(state->record.keyword_timestamp != 0) { // The keyword was detected before the stream was armed
+         armed->detected = true;
+         xraudio_in_stream_armed_attach(state);
+      }
+      return;
+   }
+
    xraudio_session_record_inst_t *instance = xraudio_in_source_to_inst(&state->record, record->source);
 
-   instance->frame_group_qty               = record->frame_group_qty;
+   instance->frame_group_qty               = (record->latency_budget_ms > 0) ? XRAUDIO_INPUT_MIN_FRAME_GROUP_QTY : record->frame_group_qty;
+   instance->latency_budget_ms             = record->latency_budget_ms;
+   instance->batch_qty                     = XRAUDIO_INPUT_MIN_FRAME_GROUP_QTY;
    instance->synchronous                   = (record->callback == NULL) ? true : false;
    instance->callback                      = record->callback;
    instance->param                         = record->param;
@@ -1030,13 +1442,19 @@ void xraudio_msg_record_start(xraudio_thread_state_t *state, void *msg) {
    instance->fh                            = record->fh;
    instance->audio_buf_samples             = record->audio_buf_samples;
    instance->audio_buf_sample_qty          = record->audio_buf_sample_qty;
+   instance->audio_buf_circular            = record->audio_buf_circular;
    instance->data_callback                 = record->data_callback;
 
+   instance->framing                       = record->framing;
+   instance->frame_sequence                = 0;
+   instance->frame_flags                   = 0;
+
    for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
       instance->fifo_audio_data[index]     = record->fifo_audio_data[index];
       instance->stream_from[index]         = record->stream_from[index];
       instance->stream_until[index]        = record->stream_until[index];
       instance->stream_begin_offset[index] = record->stream_begin_offset[index];
+      instance->frame_gap[index]           = false;
    }
 
    instance->fifo_sound_intensity          = record->fifo_sound_intensity;
@@ -1044,6 +1462,13 @@ void xraudio_msg_record_start(xraudio_thread_state_t *state, void *msg) {
 
    bool external_src = (XRAUDIO_DEVICE_INPUT_EXTERNAL_GET(instance->source) != XRAUDIO_DEVICE_INPUT_NONE) ? true : false;
 
+   instance->first_byte_armed     = false;
+   instance->first_byte_timestamp = 0;
+   if(!external_src && (instance->fifo_audio_data[0] >= 0 || instance->data_callback != NULL) && state->record.keyword_timestamp != 0) { // Stream following the keyword detection
+      instance->first_byte_timestamp = state->record.keyword_timestamp;
+   }
+   state->record.keyword_timestamp = 0;
+
    #ifdef XRAUDIO_KWD_ENABLED
    uint8_t  active_chan                 = state->record.keyword_detector.active_chan;
    uint32_t pre_detection_samples_avail = xraudio_keyword_detector_session_pd_avail(&state->record.keyword_detector, active_chan);
@@ -1112,21 +1537,45 @@ void xraudio_msg_record_start(xraudio_thread_state_t *state, void *msg) {
    }
 
    // Set timeout for next chunk (in microseconds)
-   state->record.timeout           = XRAUDIO_INPUT_FRAME_PERIOD * 1000;
-   instance->frame_size_out    = (XRAUDIO_INPUT_FRAME_PERIOD * instance->format_out.sample_rate * instance->format_out.channel_qty * instance->format_out.sample_size) / 1000;
-   state->record.frame_sample_qty  = (XRAUDIO_INPUT_FRAME_PERIOD * state->record.format_in.sample_rate * state->record.format_in.channel_qty) / 1000;
+   state->record.timeout           = state->params.input_frame_period * 1000;
+   instance->frame_size_out    = (state->params.input_frame_period * instance->format_out.sample_rate * instance->format_out.channel_qty * instance->format_out.sample_size) / 1000;
+   state->record.frame_sample_qty  = (state->params.input_frame_period * state->record.format_in.sample_rate * state->record.format_in.channel_qty) / 1000;
    state->record.frame_group_index = 0;
 
+   instance->buffer_pool_qty = record->buffer_qty;
+   for(uint8_t index = 0; index < record->buffer_qty; index++) {
+      instance->buffer_pool[index] = (xraudio_stream_buffer_entry_t *)record->buffer_pool[index];
+   }
+
+   instance->sample_format         = record->sample_format;
+   instance->channel_layout        = record->channel_layout;
+   instance->sample_convert        = (instance->sample_format != XRAUDIO_STREAM_SAMPLE_FORMAT_INT16 || instance->channel_layout != XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO);
+   if(instance->sample_convert) {
+      if(instance->format_out.encoding != XRAUDIO_ENCODING_PCM) {
+         XLOGD_WARN("sample format <%s> channel layout <%s> not supported for encoding <%s>", xraudio_stream_sample_format_str(instance->sample_format), xraudio_stream_channel_layout_str(instance->channel_layout), xraudio_encoding_str(instance->format_out.encoding));
+         instance->sample_convert = false;
+      } else {
+         XLOGD_INFO("sample format <%s> channel layout <%s>", xraudio_stream_sample_format_str(instance->sample_format), xraudio_stream_channel_layout_str(instance->channel_layout));
+         #ifdef XRAUDIO_KWD_ENABLED
+         if(instance->channel_layout != XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO && instance->pre_detection_sample_qty > 0) { // Pre detection samples are only kept for the active channel
+            XLOGD_ERROR("pre detection samples <%u> not available in channel layout <%s>", instance->pre_detection_sample_qty, xraudio_stream_channel_layout_str(instance->channel_layout));
+            instance->pre_detection_sample_qty = 0;
+         }
+         #endif
+      }
+   }
+
    instance->latency_mode          = record->latency_mode;
    instance->mode_changed          = true;
    instance->keyword_flush         = false;
    instance->raw_mic_frame_skip    = 0;
    
    if(external_src) {
-      state->record.external_frame_group_qty   = record->frame_group_qty;
-      state->record.external_data_len          = 0;
-      state->record.external_frame_bytes_read  = 0;
-      state->record.external_frame_group_index = 0;
+      state->record.external_frame_group_qty       = instance->frame_group_qty;
+      state->record.external_data_len              = 0;
+      state->record.external_frame_bytes_read      = 0;
+      state->record.external_frame_group_index     = 0;
+      state->record.external_frame_group_timestamp = 0;
    }
 
    bool decoding = false;
@@ -1197,6 +1646,9 @@ void xraudio_msg_record_start(xraudio_thread_state_t *state, void *msg) {
       instance->stats.samples_lost         = 0;
       instance->stats.decoder_failures     = 0;
       instance->stats.samples_buffered_max = 0;
+      instance->stats.buffers_unavailable  = 0;
+      instance->stats.frame_groups_written = 0;
+      instance->stats.frames_written       = 0;
 
       instance->stream_time_min_value = record->stream_time_minimum * state->record.format_in.sample_rate / 1000;
       instance->keyword_end_samples   = (record->stream_keyword_duration != 0) ? record->stream_keyword_begin + record->stream_keyword_duration : 0;
@@ -1249,13 +1701,21 @@ void xraudio_msg_record_start(xraudio_thread_state_t *state, void *msg) {
       }
    }
    if(instance->fifo_audio_data[0] >= 0){ // Stream to pipe
-      instance->record_callback = xraudio_in_write_to_pipe;
+      instance->record_callback     = xraudio_in_write_to_pipe;
+      instance->latency_stage_write = XRAUDIO_LATENCY_STAGE_WRITE_PIPE;
    } else if(instance->fh != NULL) { // Record to file
-      instance->record_callback = xraudio_in_write_to_file;
+      instance->record_callback     = xraudio_in_write_to_file;
+      instance->latency_stage_write = XRAUDIO_LATENCY_STAGE_WRITE_FILE;
    } else if(instance->audio_buf_samples != NULL && instance->audio_buf_sample_qty > 0) { // Record to memory
-      instance->record_callback = xraudio_in_write_to_memory;
+      instance->record_callback     = xraudio_in_write_to_memory;
+      instance->latency_stage_write = XRAUDIO_LATENCY_STAGE_WRITE_MEMORY;
+      if(instance->audio_buf_circular) { // Publish an empty ring until the first frame group is written
+         instance->audio_buf_wrapped = false;
+         xraudio_input_memory_ring_begin(state->params.obj_input, record->source, instance->audio_buf_sample_qty);
+      }
    } else if(instance->data_callback != NULL){ // Stream to user
-      instance->record_callback = xraudio_in_write_to_user;
+      instance->record_callback     = xraudio_in_write_to_user;
+      instance->latency_stage_write = XRAUDIO_LATENCY_STAGE_WRITE_USER;
    }
 
    #ifdef XRAUDIO_DECODE_ADPCM
@@ -1276,14 +1736,26 @@ void xraudio_msg_record_stop(xraudio_thread_state_t *state, void *msg) {
    xraudio_queue_msg_record_stop_t *stop = (xraudio_queue_msg_record_stop_t *)msg;
    XLOGD_DEBUG("");
 
+   if(xraudio_in_stream_armed_release(&state->record, stop->source)) { // The armed stream was not attached so there is no session to end
+      if(stop->synchronous) {
+         if(stop->semaphore == NULL) {
+            XLOGD_ERROR("synchronous stop with no semaphore set!");
+         } else {
+            sem_post(stop->semaphore);
+         }
+      } else if(stop->callback != NULL){
+         xraudio_dispatch_audio_in(state->params.obj_dispatch, stop->callback, stop->source, AUDIO_IN_CALLBACK_EVENT_OK, NULL, stop->param);
+      }
+      return;
+   }
+
    bool more_streams = false;
 
    xraudio_session_record_inst_t *instance = xraudio_in_source_to_inst(&state->record, stop->source);
 
    if(stop->index >= 0 && stop->index < XRAUDIO_FIFO_QTY_MAX) {
       if(instance->fifo_audio_data[stop->index] >= 0) {
-         close(instance->fifo_audio_data[stop->index]);
-         instance->fifo_audio_data[stop->index] = -1;
+         xraudio_in_fifo_close(instance, stop->index);
       }
       for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
          if(instance->fifo_audio_data[index] >= 0) {
@@ -1346,7 +1818,7 @@ void xraudio_msg_record_stop(xraudio_thread_state_t *state, void *msg) {
          sem_post(stop->semaphore);
       }
    } else if(stop->callback != NULL){
-      (*stop->callback)(stop->source, AUDIO_IN_CALLBACK_EVENT_OK, NULL, stop->param);
+      xraudio_dispatch_audio_in(state->params.obj_dispatch, stop->callback, stop->source, AUDIO_IN_CALLBACK_EVENT_OK, NULL, stop->param);
    }
 
    if(!more_streams) {
@@ -1374,6 +1846,73 @@ void xraudio_msg_record_stop(xraudio_thread_state_t *state, void *msg) {
    }
 }
 
+void xraudio_in_stream_armed_attach(xraudio_thread_state_t *state) {
+   xraudio_stream_armed_t *armed = &state->record.stream_armed;
+   if(!armed->detected) {
+      return;
+   }
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+
+   armed->armed    = false;
+   armed->detected = false;
+   xraudio_msg_record_start(state, &armed->record);
+
+   xraudio_session_record_inst_t *instance = xraudio_in_source_to_inst(&state->record, armed->record.source);
+   instance->first_byte_armed = true;
+
+   uint32_t attach_time_us = (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_begin);
+   xraudio_atomic_int_add(&g_armed_attach_qty,     1);
+   xraudio_atomic_int_set(&g_armed_attach_time_us, (int)attach_time_us);
+
+   XLOGD_INFO("src <%s> armed stream attached in <%u> us", xraudio_devices_input_str(armed->record.source), attach_time_us);
+}
+
+bool xraudio_in_stream_armed_release(xraudio_session_record_t *session, xraudio_devices_input_t source) {
+   xraudio_stream_armed_t *armed = &session->stream_armed;
+   if(!armed->armed || xraudio_input_source_to_group(armed->record.source) != xraudio_input_source_to_group(source)) {
+      return(false);
+   }
+   // xraudio main thread is responsible for closing write side of the pipe
+   for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
+      if(armed->record.fifo_audio_data[index] >= 0) {
+         close(armed->record.fifo_audio_data[index]);
+         armed->record.fifo_audio_data[index] = -1;
+      }
+   }
+   armed->armed    = false;
+   armed->detected = false;
+   xraudio_atomic_int_add(&g_armed_release_qty, 1);
+
+   XLOGD_INFO("src <%s> armed stream released", xraudio_devices_input_str(armed->record.source));
+   return(true);
+}
+
+void xraudio_in_stream_armed_report_get(xraudio_stream_armed_report_t *report) {
+   report->armed_qty           = (uint32_t)xraudio_atomic_int_get(&g_armed_qty);
+   report->attach_qty          = (uint32_t)xraudio_atomic_int_get(&g_armed_attach_qty);
+   report->release_qty         = (uint32_t)xraudio_atomic_int_get(&g_armed_release_qty);
+   report->attach_time_us      = (uint32_t)xraudio_atomic_int_get(&g_armed_attach_time_us);
+   report->first_byte_armed_us = (uint32_t)xraudio_atomic_int_get(&g_armed_first_byte_us);
+   report->first_byte_us       = (uint32_t)xraudio_atomic_int_get(&g_first_byte_us);
+}
+
+void xraudio_in_init_report_get(xraudio_init_report_t *report) {
+   report->thread_time_us  = (uint32_t)xraudio_atomic_int_get(&g_init_thread_time_us);
+   report->kwd_time_us     = (uint32_t)xraudio_atomic_int_get(&g_init_kwd_time_us);
+   report->dga_time_us     = (uint32_t)xraudio_atomic_int_get(&g_init_dga_time_us);
+   report->decoder_time_us = (uint32_t)xraudio_atomic_int_get(&g_init_decoder_time_us);
+   report->capture_time_us = (uint32_t)xraudio_atomic_int_get(&g_init_capture_time_us);
+}
+
+void xraudio_in_standby_report_get(xraudio_standby_report_t *report) {
+   report->input_first_read_us  = (uint32_t)xraudio_atomic_int_get(&g_standby_input_first_read_us);
+   report->output_entry_qty     = (uint32_t)xraudio_atomic_int_get(&g_standby_output_entry_qty);
+   report->output_exit_qty      = (uint32_t)xraudio_atomic_int_get(&g_standby_output_exit_qty);
+   report->output_reopen_qty    = (uint32_t)xraudio_atomic_int_get(&g_standby_output_reopen_qty);
+   report->output_entry_time_us = (uint32_t)xraudio_atomic_int_get(&g_standby_output_entry_time_us);
+   report->output_exit_time_us  = (uint32_t)xraudio_atomic_int_get(&g_standby_output_exit_time_us);
+}
+
 void xraudio_msg_capture_start(xraudio_thread_state_t *state, void *msg) {
    xraudio_queue_msg_capture_start_t *capture = (xraudio_queue_msg_capture_start_t *)msg;
    char filename[128];
@@ -1450,7 +1989,7 @@ void xraudio_msg_capture_start(xraudio_thread_state_t *state, void *msg) {
 
       capture_file->format.container   = capture->container;
       capture_file->format.encoding    = state->record.format_in.encoding;
-      capture_file->format.sample_rate = state->record.format_in.sample_rate;
+      capture_file->format.sample_rate = (state->record.obj_decimator != NULL) ? state->params.input_capture_rate : state->record.format_in.sample_rate;
       capture_file->format.sample_size = (state->record.pcm_bit_qty > 16) ? 4 : 2;
       capture_file->format.channel_qty = 1;
 
@@ -1623,7 +2162,11 @@ void xraudio_msg_capture_stop(xraudio_thread_state_t *state, void *msg) {
 }
 
 void xraudio_msg_play_idle(xraudio_thread_state_t *state, void *msg) {
-   XLOGD_DEBUG("");
+   xraudio_queue_msg_play_idle_t *idle = (xraudio_queue_msg_play_idle_t *)msg;
+   XLOGD_DEBUG("wave <%s,%u-bit,%u Hz>", xraudio_channel_qty_str(idle->format.channel_qty), idle->format.sample_size * 8, idle->format.sample_rate);
+
+   state->playback.hal_output_obj       = idle->hal_output_obj;
+   state->playback.format               = idle->format;
    state->playback.synchronous          = false;
    state->playback.callback             = NULL;
    state->playback.param                = NULL;
@@ -1637,16 +2180,28 @@ void xraudio_msg_play_idle(xraudio_thread_state_t *state, void *msg) {
    state->playback.fifo_sound_intensity = -1;
    state->playback.timeout              = XRAUDIO_OUTPUT_FRAME_PERIOD * 1000;
    state->playback.frame_size           = (XRAUDIO_OUTPUT_FRAME_PERIOD * state->playback.format.sample_rate * state->playback.format.sample_size * state->playback.format.channel_qty) / 1000;
+   state->playback.mode_changed         = true;
+   state->playback.standby              = true;
+   state->playback.standby_exit         = false;
 
-   // Send first chunk (2x chunk period) to the speaker
+   // Send first chunk (2x chunk period) of silence to the speaker so the stream is primed for the next playback
    unsigned long first_frame_size = 2 * state->playback.frame_size;
 
-   if(state->playback.playing) { // Only changing back to idle so don't write first data frame
-      return;
+   unsigned long timeout_val = 0;
+   if(state->params.obj_input != NULL && state->record.recording) {
+      xraudio_process_spkr_data(&state->params, &state->playback, first_frame_size, &timeout_val, &state->record.timestamp_next);
+   } else {
+      xraudio_process_spkr_data(&state->params, &state->playback, first_frame_size, &timeout_val, NULL);
    }
 
-   unsigned long timeout_val = 0;
-   xraudio_process_spkr_data(&state->params, &state->playback, first_frame_size, &timeout_val, NULL);
+   uint32_t entry_time_us = (uint32_t)rdkx_timestamp_since_us(idle->timestamp);
+   XLOGD_INFO("speaker standby entry <%u> us", entry_time_us);
+   xraudio_atomic_int_add(&g_standby_output_entry_qty,     1);
+   xraudio_atomic_int_set(&g_standby_output_entry_time_us, (int)entry_time_us);
+
+   if(timeout_val == 0) { // Unable to write to the speaker
+      return;
+   }
 
    // Update the timeout
    rdkx_timestamp_t timeout;
@@ -1683,9 +2238,13 @@ void xraudio_msg_play_start(xraudio_thread_state_t *state, void *msg) {
    state->playback.frame_size   = (XRAUDIO_OUTPUT_FRAME_PERIOD * play->format.channel_qty * play->format.sample_size * play->format.sample_rate) / 1000;
 
    state->playback.mode_changed         = true;
-   #ifdef MASK_FIRST_WRITE_DELAY
-   state->playback.first_write_complete = false;
-   #endif
+   state->playback.standby              = false;
+   state->playback.standby_exit         = play->standby;
+   state->playback.standby_timestamp    = play->timestamp;
+
+   if(play->reopened) { // The stream held in standby was reopened in the format of the playback
+      xraudio_atomic_int_add(&g_standby_output_reopen_qty, 1);
+   }
 
    XLOGD_DEBUG("nominal timeout %u us frame size %u bytes hal buffer size %u", state->playback.timeout, state->playback.frame_size, xraudio_hal_output_buffer_size_get(state->playback.hal_output_obj));
 
@@ -1693,11 +2252,7 @@ void xraudio_msg_play_start(xraudio_thread_state_t *state, void *msg) {
    unsigned long first_frame_size = 2 * state->playback.frame_size;
 
    unsigned long timeout_val = 0;
-   #ifdef MASK_FIRST_READ_DELAY
-   if(state->params.obj_input != NULL && (state->record.recording || !state->record.first_read_complete)) {
-   #else
    if(state->params.obj_input != NULL && state->record.recording) {
-   #endif
       xraudio_process_spkr_data(&state->params, &state->playback, first_frame_size, &timeout_val, &state->record.timestamp_next);
    } else {
       xraudio_process_spkr_data(&state->params, &state->playback, first_frame_size, &timeout_val, NULL);
@@ -1730,6 +2285,8 @@ void xraudio_msg_play_stop(xraudio_thread_state_t *state, void *msg) {
    XLOGD_DEBUG("");
 
    state->playback.hal_output_obj       = NULL;
+   state->playback.standby            = false;
+   state->playback.standby_exit       = false;
    state->playback.fh                 = NULL;
    state->playback.audio_buf          = NULL;
    state->playback.audio_buf_size     = 0;
@@ -1750,7 +2307,7 @@ void xraudio_msg_play_stop(xraudio_thread_state_t *state, void *msg) {
          sem_post(stop->semaphore);
       }
    } else if(stop->callback != NULL){
-      (*stop->callback)(AUDIO_OUT_CALLBACK_EVENT_OK, stop->param);
+      xraudio_dispatch_audio_out(state->params.obj_dispatch, stop->callback, AUDIO_OUT_CALLBACK_EVENT_OK, stop->param);
    }
 }
 
@@ -1762,6 +2319,7 @@ void xraudio_msg_detect(xraudio_thread_state_t *state, void *msg) {
 
    instance->frame_size_out        = 0;
    instance->frame_group_qty       = XRAUDIO_INPUT_DEFAULT_FRAME_GROUP_QTY;
+   instance->latency_budget_ms     = 0;
    instance->record_callback       = NULL;
    instance->stream_until[0]       = XRAUDIO_INPUT_RECORD_UNTIL_INVALID;
    instance->fifo_audio_data[0]    = -1;
@@ -1777,6 +2335,8 @@ void xraudio_msg_detect(xraudio_thread_state_t *state, void *msg) {
    #endif
    instance->fifo_sound_intensity  = -1;
 
+   state->record.keyword_timestamp = 0;
+
    instance->eos_event                    = XRAUDIO_EOS_EVENT_NONE;
    instance->eos_vad_forced               = false;
    instance->eos_end_of_wake_word_samples = 0;
@@ -1797,8 +2357,8 @@ void xraudio_msg_detect(xraudio_thread_state_t *state, void *msg) {
    xraudio_keyword_detector_session_arm(&state->record.keyword_detector, detect->callback, detect->param, detect->sensitivity);
 
    // Set timeout for next chunk (in microseconds)
-   state->record.timeout           = XRAUDIO_INPUT_FRAME_PERIOD * 1000;
-   state->record.frame_sample_qty  = (XRAUDIO_INPUT_FRAME_PERIOD * state->record.format_in.sample_rate * state->record.format_in.channel_qty) / 1000;
+   state->record.timeout           = state->params.input_frame_period * 1000;
+   state->record.frame_sample_qty  = (state->params.input_frame_period * state->record.format_in.sample_rate * state->record.format_in.channel_qty) / 1000;
    state->record.frame_group_index = 0;
 
    xraudio_input_sound_focus_set(state->params.obj_input, XRAUDIO_SDF_MODE_KEYWORD_DETECTION);
@@ -1989,9 +2549,15 @@ void xraudio_msg_power_mode(xraudio_thread_state_t *state, void *msg) {
    xraudio_main_queue_msg_power_mode_t *power_mode = (xraudio_main_queue_msg_power_mode_t *)msg;
 
    xraudio_result_t result = XRAUDIO_RESULT_OK;
+
+   // The DSP plugins may be reinitialized by the power mode change so the adapted state is restored afterwards
+   xraudio_dsp_state_save(state);
+
    // Call HAL to enter the power mode
    if(!xraudio_hal_power_mode(state->params.hal_obj, power_mode->power_mode)) {
       result = XRAUDIO_RESULT_ERROR_INTERNAL;
+   } else {
+      xraudio_dsp_state_restore(state);
    }
 
    if(power_mode->semaphore != NULL) {
@@ -2009,6 +2575,8 @@ void xraudio_msg_privacy_mode(xraudio_thread_state_t *state, void *msg) {
    // Call HAL to enter the privacy mode
    if(!xraudio_hal_privacy_mode(state->params.hal_obj, privacy_mode->enable)) {
       result = XRAUDIO_RESULT_ERROR_INTERNAL;
+   } else {
+      state->record.privacy_mode = privacy_mode->enable;
    }
 
    if(privacy_mode->semaphore != NULL) {
@@ -2026,6 +2594,8 @@ void xraudio_msg_privacy_mode_get(xraudio_thread_state_t *state, void *msg) {
    //Call HAL to get mute state
   if(!xraudio_hal_privacy_mode_get(state->params.hal_obj, privacy_mode_get->enabled)) {
       result = XRAUDIO_RESULT_ERROR_INTERNAL;
+   } else { // The mute state may have been changed outside of xraudio
+      state->record.privacy_mode = *(privacy_mode_get->enabled);
    }
 
    if(privacy_mode_get->semaphore != NULL) {
@@ -2036,8 +2606,66 @@ void xraudio_msg_privacy_mode_get(xraudio_thread_state_t *state, void *msg) {
    }
 }
 
+void xraudio_msg_detect_reload(xraudio_thread_state_t *state, void *msg) {
+   xraudio_queue_msg_detect_reload_t *detect_reload = (xraudio_queue_msg_detect_reload_t *)msg;
+   #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_keyword_detector_t *detector = &state->record.keyword_detector;
+   xraudio_keyword_reload_t *  reload   = &detector->reload;
+   XLOGD_INFO("sensitivity <%f>", detect_reload->sensitivity);
+
+   reload->msgq        = state->params.msgq;
+   reload->jkwd_config = detect_reload->jkwd_config;
+   reload->sensitivity = detect_reload->sensitivity;
+   reload->chan_qty    = detector->active ? detector->instance_qty : 0;
+   reload->kwd_object  = NULL;
+   reload->pending     = false;
+
+   // Load and initialize the new instance in a separate thread so detection continues with the current instance
+   if(!xraudio_thread_create(&reload->thread, "xraudio_kwd_ld", xraudio_thread_kwd_reload, reload)) {
+      XLOGD_ERROR("unable to launch thread");
+      json_decref(reload->jkwd_config);
+      reload->jkwd_config = NULL;
+      xraudio_in_detect_reload_end(XRAUDIO_RESULT_ERROR_INTERNAL, 0, 0, 0);
+   }
+   #else
+   json_decref(detect_reload->jkwd_config);
+   xraudio_in_detect_reload_end(XRAUDIO_RESULT_ERROR_INTERNAL, 0, 0, 0);
+   #endif
+}
+
+void xraudio_msg_detect_reload_ready(xraudio_thread_state_t *state, void *msg) {
+   #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_keyword_detector_t *detector = &state->record.keyword_detector;
+   xraudio_keyword_reload_t *  reload   = &detector->reload;
+
+   xraudio_thread_join(&reload->thread);
+   reload->timestamp_ready = xraudio_in_frame_timestamp_get();
+
+   if(reload->kwd_object == NULL) {
+      json_decref(reload->jkwd_config);
+      reload->jkwd_config = NULL;
+      xraudio_in_detect_reload_end(XRAUDIO_RESULT_ERROR_INTERNAL, reload->load_time_ms, 0, 0);
+      return;
+   }
+   if(detector->active && detector->triggered) { // Keep the current instance until the pending detection is decided
+      XLOGD_INFO("swap deferred until the detection is decided");
+      reload->pending = true;
+      return;
+   }
+   xraudio_keyword_detector_reload_swap(detector);
+   #endif
+}
+
 void timer_frame_process(void *data) {
    xraudio_thread_state_t *state = (xraudio_thread_state_t *)data;
+   #ifdef XRAUDIO_TRACE_ENABLED
+   uint64_t timestamp_frame = xraudio_in_frame_timestamp_get();
+   #endif
+
+   xraudio_in_suspend_update(state);
+   if(state->timer_id_frame == RDXK_TIMER_ID_INVALID) { // Suspended, the frame timer was stopped
+      return;
+   }
 
    unsigned long timeout_mic  = 0;
    unsigned long timeout_spkr = 0;
@@ -2045,14 +2673,45 @@ void timer_frame_process(void *data) {
 
    bool playback_active = false;
 
-   #ifdef MASK_FIRST_READ_DELAY
-   if(state->params.obj_input != NULL && (state->record.recording || !state->record.first_read_complete)) {
-   #else
-   if(state->params.obj_input != NULL && state->record.recording) {
-   #endif
-      xraudio_process_mic_data(&state->params, &state->record, &timeout_mic);
+   if(state->record.suspended) { // Only the speaker is processed
+      xraudio_atomic_int_add(&g_privacy_wakeup_qty, 1);
+   }
+
+   if(state->params.obj_input != NULL && !state->record.suspended && state->record.recording) {
+      uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+      uint8_t  frame_qty       = xraudio_in_idle_frame_qty(state);
+      uint8_t  frame_read_qty  = 0;
+
+      if(frame_qty > 1) { // The batch is read ahead of the frame timestamps
+         state->record.idle_backlog_qty = frame_qty - 1;
+      }
+      for(uint8_t frame = 0; frame < frame_qty; frame++) {
+         xraudio_process_mic_data(&state->params, &state->record, &timeout_mic);
+         xraudio_in_stream_armed_attach(state);
+         frame_read_qty++;
+         if(timeout_mic == 0 || xraudio_in_idle_frame_qty(state) <= 1) { // Keyword triggered or stream started, the remaining buffered frames are processed one per timeout without waiting
+            break;
+         }
+      }
+      if(timeout_mic != 0) {
+         uint8_t frame_qty_next = xraudio_in_idle_frame_qty(state);
+         if(frame_qty_next > 1 && state->record.idle_backlog_qty == 0) { // Sleep until the HAL has buffered the next batch
+            timeout_mic += (frame_qty_next - 1) * state->record.timeout;
+         }
+      }
+      xraudio_in_process_account(&state->record, (frame_qty > 1) ? XRAUDIO_INPUT_PROCESS_MODE_IDLE : XRAUDIO_INPUT_PROCESS_MODE_FRAME, timestamp_begin);
+
       if(state->params.obj_output != NULL) { // Simultaneous record and playback
-         xraudio_process_spkr_data(&state->params, &state->playback, state->playback.frame_size, &timeout_spkr, &state->record.timestamp_next);
+         // A speaker in standby is written a frame of silence for each microphone frame in the batch, otherwise the batch is a single frame
+         for(uint8_t frame = 0; frame < frame_read_qty; frame++) {
+            xraudio_process_spkr_data(&state->params, &state->playback, state->playback.frame_size, &timeout_spkr, &state->record.timestamp_next);
+            if(timeout_spkr == 0) {
+               break;
+            }
+         }
+         if(state->playback.standby && timeout_mic != 0) { // Wake for the next microphone batch rather than each speaker frame
+            timeout_spkr = timeout_mic;
+         }
       }
    } else if(state->params.obj_output != NULL) { // Only playback
       xraudio_process_spkr_data(&state->params, &state->playback, state->playback.frame_size, &timeout_spkr, NULL);
@@ -2083,47 +2742,13 @@ void timer_frame_process(void *data) {
 
       rdkx_timer_update(state->timer_obj, state->timer_id_frame, timeout);
    }
+   XRAUDIO_TRACE(XRAUDIO_TRACE_EVENT_FRAME, 0, timestamp_frame, (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_frame));
 }
 
 void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_session_record_t *session, unsigned long *timeout) {
    int rc = -1;
    audio_in_callback_event_t event = AUDIO_IN_CALLBACK_EVENT_OK;
 
-   #ifdef MASK_FIRST_READ_DELAY
-   if(!session->first_read_complete) {
-      // Deal with long delay in first call to qahw_out_read (several hundred milliseconds)
-      if(!session->first_read_pending && !session->first_read_thread.running) {
-         g_thread_params_read.params  = params;
-         g_thread_params_read.session = session;
-
-         session->first_read_pending = true;
-
-         // Perform first read in a separate thread
-         if(!xraudio_thread_create(&session->first_read_thread, "xraudio_1st_rd", xraudio_thread_first_read, &g_thread_params_read)) {
-            XLOGD_ERROR("unable to launch thread");
-         }
-
-         rdkx_timestamp_get(&session->timestamp_next); // Mark starting timestamp
-      }
-
-      if(session->first_read_pending) { // the first call to qahw_out_read has not completed yet
-         // Add the timeout interval to determine the next timestamp
-         rdkx_timestamp_add_us(&session->timestamp_next, session->timeout);
-         // Calculate the amount of time until next chunk in microseconds
-         uint32_t until = rdkx_timestamp_until_us(session->timestamp_next);
-         if(until == 0) {
-            *timeout = 1;
-         } else {
-            *timeout = until;
-         }
-         return;
-      } else if(session->first_read_thread.running) {
-         xraudio_thread_join(&session->first_read_thread);
-         session->first_read_complete       = true;
-      }
-   }
-   #endif
-
    if(!session->recording) {
       rdkx_timestamp_get(&session->timestamp_next); // Mark starting timestamp
    }
@@ -2135,31 +2760,62 @@ void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_sess
    xraudio_devices_input_t device_input_local = XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input);
    xraudio_devices_input_t device_input_ecref = XRAUDIO_DEVICE_INPUT_EC_REF_GET(session->devices_input);
 
-   uint8_t chan_qty_mic   = (device_input_local == XRAUDIO_DEVICE_INPUT_QUAD) ? 4 : (device_input_local == XRAUDIO_DEVICE_INPUT_TRI) ? 3 : 1;
-   uint8_t chan_qty_ecref = (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_5_1) ? 6 : (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_STEREO) ? 2 : (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_MONO) ? 1 : 0;
+   uint8_t chan_qty_mic   = xraudio_devices_input_mic_qty(device_input_local, params->input_mic_qty);
+   uint8_t chan_qty_ecref = xraudio_devices_input_ec_ref_qty(device_input_ecref);
    uint8_t chan_qty_total = (chan_qty_mic + chan_qty_ecref);
    uint8_t sample_size = (session->pcm_bit_qty > 16) ? 4 : 2;   // HAL sample size does not change even though downstream it may need to be different
 
-   mic_frame_samples = chan_qty_total * XRAUDIO_INPUT_FRAME_PERIOD * session->format_in.sample_rate / 1000;
+   if(chan_qty_total > session->frame_buffer_chan_qty || session->frame_buffer_int16 == NULL) {
+      XLOGD_ERROR("channel qty <%u> exceeds frame buffer channel qty <%u>", chan_qty_total, session->frame_buffer_chan_qty);
+      xraudio_process_mic_error(session);
+      return;
+   }
+
+   uint32_t decimation = (session->obj_decimator != NULL) ? xraudio_decimator_factor_get(session->obj_decimator) : 1;
+
+   mic_frame_samples = chan_qty_total * params->input_frame_period * session->format_in.sample_rate / 1000;
    mic_frame_size = mic_frame_samples * sample_size;    // X channels * (20 msec @ 16kHz * (2 or 4 bytes per sample))  = 640*X bytes or 1280*X bytes per frame
-   uint8_t mic_frame_data[mic_frame_size];
+   uint8_t mic_frame_data[mic_frame_size * decimation]; // HAL frame at the capture rate
+   uint8_t mic_frame_decimated[(decimation > 1) ? mic_frame_size : 1];
+   uint8_t *mic_frame = mic_frame_data;
 
    xraudio_eos_event_t eos_event_hal = XRAUDIO_EOS_EVENT_NONE;
 
-   rc = xraudio_hal_input_read(params->hal_input_obj, mic_frame_data, mic_frame_size, &eos_event_hal);
-   XLOGD_DEBUG("bytes read %d, bytes expected %u, frame size %u", rc, mic_frame_size, session->frame_size_in);
-   if(rc != (int) mic_frame_size) {
+   uint64_t timestamp_stage = xraudio_in_frame_timestamp_get();
+   rc = xraudio_hal_input_read(params->hal_input_obj, mic_frame_data, mic_frame_size * decimation, &eos_event_hal);
+   XLOGD_DEBUG("bytes read %d, bytes expected %u, frame size %u", rc, mic_frame_size * decimation, session->frame_size_in);
+   if(rc != (int)(mic_frame_size * decimation)) {
       if(rc < 0) {
          XLOGD_ERROR("hal mic read: error %d", rc);
       } else {
-         XLOGD_ERROR("hal mic read: got %d, expected %u bytes", rc, mic_frame_size);
+         XLOGD_ERROR("hal mic read: got %d, expected %u bytes", rc, mic_frame_size * decimation);
       }
       // End the session
       xraudio_process_mic_error(session);
       return;
    }
+   xraudio_input_stats_timestamp_frame_read(params->obj_input);
+   xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_HAL_READ, timestamp_stage);
+
+   timestamp_stage = xraudio_in_frame_timestamp_get();
+   if(decimation > 1) {
+      uint32_t sample_qty_channel = (mic_frame_samples * decimation) / chan_qty_total;
+      xraudio_in_capture_session_wideband(session, mic_frame_data, chan_qty_total, sample_qty_channel, sample_size);
+      if(!xraudio_decimator_process(session->obj_decimator, mic_frame_data, mic_frame_decimated, chan_qty_total, sample_qty_channel, sample_size)) {
+         XLOGD_ERROR("unable to decimate frame");
+         xraudio_process_mic_error(session);
+         return;
+      }
+      mic_frame = mic_frame_decimated;
+   }
+
+   uint64_t timestamp_read = xraudio_in_frame_timestamp_get();
+   if(session->frame_group_index == 0) { // The frame was captured during the frame period preceding the read
+      session->frame_group_timestamp = (timestamp_read > params->input_frame_period * 1000) ? timestamp_read - (params->input_frame_period * 1000) : 0;
+   }
 
-   session->handler_unpack(session, mic_frame_data, chan_qty_total, &session->frame_buffer_int16[0], &session->frame_buffer_fp32[0], session->frame_group_index, mic_frame_samples);
+   session->handler_unpack(session, mic_frame, chan_qty_total, &session->frame_buffer_int16[0], &session->frame_buffer_fp32[0], session->frame_group_index, mic_frame_samples);
+   xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_UNPACK, timestamp_stage);
 
    if(!session->recording) { // qahw seems to take 120ms on the first call probably with first time initialization so let's account for this
       session->recording = true;
@@ -2170,33 +2826,69 @@ void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_sess
 
       if(instance->mode_changed) {
          if(XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input) == instance->source && instance->callback != NULL){
-            (*instance->callback)(XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input), AUDIO_IN_CALLBACK_EVENT_FIRST_FRAME, NULL, instance->param);
+            xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input), AUDIO_IN_CALLBACK_EVENT_FIRST_FRAME, NULL, instance->param);
          }
          instance->mode_changed = false;
       }
    }
 
-   xraudio_input_stats_timestamp_frame_read(params->obj_input);
+   xraudio_input_stats_timestamp_frame_convert(params->obj_input);
+
+   // Calculate the frame features once per frame, only when the direction of arrival needs them or a client has read them
+   bool doa_active = (session->obj_doa != NULL && xraudio_doa_mic_qty_get(session->obj_doa) == chan_qty_mic);
+   if(doa_active || xraudio_input_frame_features_requested(params->obj_input)) {
+      float full_scale = (sample_size == 4) ? 2147483648.0 : 32768.0;
+      for(uint8_t chan = 0; chan < chan_qty_mic; ++chan) {
+         uint64_t timestamp_chan = xraudio_in_frame_timestamp_get();
+         xraudio_in_frame_features_calculate(&session->frame_buffer_fp32[chan].frames[session->frame_group_index].samples[0], mic_frame_samples / chan_qty_total, full_scale, &session->frame_features[chan]);
+         xraudio_in_channel_time_add(session, chan, timestamp_chan);
+      }
+      xraudio_input_frame_features_set(params->obj_input, session->frame_features, chan_qty_mic);
+   }
+
+   // Estimate the direction of arrival from the raw mic channels (only updated while the frame features show activity)
+   if(doa_active) {
+      const float *mic_samples[chan_qty_mic];
+      float rms = 0.0;
+      for(uint8_t chan = 0; chan < chan_qty_mic; ++chan) {
+         mic_samples[chan] = (decimation > 1) ? xraudio_decimator_input_get(session->obj_decimator, chan) : &session->frame_buffer_fp32[chan].frames[session->frame_group_index].samples[0];
+         rms += session->frame_features[chan].rms;
+      }
+      xraudio_doa_process(session->obj_doa, mic_samples, (mic_frame_samples * decimation) / chan_qty_total, rms / chan_qty_mic, &session->doa);
+   }
 
    #ifdef XRAUDIO_PPR_ENABLED
-   xraudio_ppr_event_t ppr_event;
-   if (params->dsp_config.ppr_enabled) {
+   xraudio_ppr_event_t ppr_event = XRAUDIO_PPR_EVENT_NONE;
+   if (params->dsp_config.ppr_enabled && session->shed_level < XRAUDIO_SHED_LEVEL_PPR_BYPASS) {
+      timestamp_stage = xraudio_in_frame_timestamp_get();
       xraudio_preprocess_mic_data(params, session, &ppr_event);
+      xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_PPR, timestamp_stage);
    }
    #endif
 
+   #ifdef XRAUDIO_KWD_ENABLED
+   // Replace the keyword channels with their beams ahead of end of speech detection and the stream outputs
+   xraudio_in_beam_route(params, session, chan_qty_mic, sample_size);
+   #endif
+
+   timestamp_stage = xraudio_in_frame_timestamp_get();
    for(uint8_t chan = 0; chan < chan_qty_mic; ++chan) {
       uint32_t sample_qty_chan = session->frame_sample_qty / session->format_in.channel_qty;
       int16_t scaled_eos_samples[sample_qty_chan]; //declaring buffer here instead of EOS because EOS init doesn't know sample_qty
       float *frame_buffer_fp32 = &session->frame_buffer_fp32[chan].frames[session->frame_group_index].samples[0];
 
-      xraudio_eos_event_t eos_event = xraudio_input_eos_run(params->obj_input, chan, frame_buffer_fp32, sample_qty_chan, &scaled_eos_samples[0] );
-
       #if defined(XRAUDIO_KWD_ENABLED)
       uint8_t active_chan = (params->dsp_config.input_asr_max_channel_qty == 0) ? session->keyword_detector.active_chan : 0;   // kwd active ("best") channel
       #else
       uint8_t active_chan = 0;                                       // ASR channel reserved for channel 0
       #endif
+      if(session->shed_level >= XRAUDIO_SHED_LEVEL_EOS_SINGLE && chan != active_chan) { // shed end of speech detection on the other channels
+         continue;
+      }
+
+      uint64_t timestamp_chan = xraudio_in_frame_timestamp_get();
+      xraudio_eos_event_t eos_event = xraudio_input_eos_run(params->obj_input, chan, frame_buffer_fp32, sample_qty_chan, &scaled_eos_samples[0] );
+      xraudio_in_channel_time_add(session, chan, timestamp_chan);
       if(session->recording && chan == active_chan) {
          xraudio_session_record_inst_t *instance = &session->instances[XRAUDIO_INPUT_SESSION_GROUP_DEFAULT];
          instance->eos_event = eos_event;
@@ -2256,6 +2948,7 @@ void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_sess
          }
       }
    }
+   xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_EOS, timestamp_stage);
 
    xraudio_input_stats_timestamp_frame_eos(params->obj_input);
 
@@ -2263,7 +2956,7 @@ void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_sess
    session->frame_group_index++;
 
    // Update the sound focus
-   xraudio_input_sound_focus_update(params->obj_input, session->frame_sample_qty);
+   xraudio_input_sound_focus_update(params->obj_input, session->frame_sample_qty, &session->doa);
 
    xraudio_input_stats_timestamp_frame_sound_focus(params->obj_input);
 
@@ -2272,23 +2965,42 @@ void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_sess
 
       if(instance->record_callback != NULL) { // Recording
 
-         session->hal_mic_frame_ptr  = mic_frame_data;
+         session->hal_mic_frame_ptr  = mic_frame; // decimated to the input sample rate when the capture rate is higher
          session->hal_mic_frame_size = mic_frame_size;
 
+         if(group == XRAUDIO_INPUT_SESSION_GROUP_DEFAULT) { // the frame group index wraps on the default group's quantity
+            bool flush = (instance->eos_event != XRAUDIO_EOS_EVENT_NONE);
+            #ifdef XRAUDIO_KWD_ENABLED
+            flush = flush || (instance->pre_detection_sample_qty > 0);
+            #endif
+            xraudio_in_frame_group_adapt(instance, session->frame_group_index, flush, session->frame_period);
+         }
+
+         timestamp_stage = xraudio_in_frame_timestamp_get();
          rc = instance->record_callback(instance->source, params, session, instance);
+         xraudio_in_latency_record(instance->latency_stage_write, timestamp_stage);
+
+         if(session->frame_group_index >= instance->frame_group_qty) {
+            instance->stats.frame_groups_written++;
+            instance->stats.frames_written += session->frame_group_index;
+         }
       }
    }
 
 
    #ifdef XRAUDIO_KWD_ENABLED
    // stream audio to keyword detector
+   timestamp_stage = xraudio_in_frame_timestamp_get();
    xraudio_in_write_to_keyword_detector(XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input), params, session, &session->instances[XRAUDIO_INPUT_SESSION_GROUP_DEFAULT]);
+   xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_KWD, timestamp_stage);
    #endif // XRAUDIO_KWD_ENABLED
 
    xraudio_input_stats_timestamp_frame_process(params->obj_input);
 
    // Update sound intensity
-   xraudio_in_sound_intensity_transfer(params, session);
+   if(session->shed_level < XRAUDIO_SHED_LEVEL_METERS) {
+      xraudio_in_sound_intensity_transfer(params, session);
+   }
 
    // Wrap the frame group index (based on default group's group qty)
    if(session->frame_group_index >= session->instances[XRAUDIO_INPUT_SESSION_GROUP_DEFAULT].frame_group_qty) {
@@ -2311,8 +3023,21 @@ void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_sess
       } else {
          *timeout = until;
       }
+      bool overrun = (until == 0);
+      if(session->idle_backlog_qty > 0) { // Frame was buffered by the HAL during an idle batch and read ahead of its timestamp
+         session->idle_backlog_qty--;
+         overrun = false;
+      }
+      #ifdef XRAUDIO_TRACE_ENABLED
+      if(overrun) {
+         XRAUDIO_TRACE(XRAUDIO_TRACE_EVENT_OVERRUN, 0, xraudio_in_frame_timestamp_get(), 0);
+      }
+      #endif
+      xraudio_in_governor_update(params, session, timestamp_read, overrun);
    }
 
+   xraudio_in_channel_cost_update(session, chan_qty_mic);
+
    xraudio_input_stats_timestamp_frame_end(params->obj_input);
 
    xraudio_session_record_inst_t *instance = &session->instances[XRAUDIO_INPUT_SESSION_GROUP_DEFAULT];
@@ -2320,14 +3045,14 @@ void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_sess
    if(instance->stream_until[0] == XRAUDIO_INPUT_RECORD_UNTIL_END_OF_SPEECH && event != AUDIO_IN_CALLBACK_EVENT_OK) { // Session ended, notify
 
       // Flush any partial data
+      instance->frame_flags |= XRAUDIO_STREAM_FRAME_FLAG_EOS;
       xraudio_in_flush(XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input), params, session, instance);
       session->frame_group_index = 0;
 
       for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
          if(instance->fifo_audio_data[index] >= 0) { // Close the write side of the pipe so the read side gets EOF
             XLOGD_DEBUG("Close write side of pipe to send EOF to read side");
-            close(instance->fifo_audio_data[index]);
-            instance->fifo_audio_data[index] = -1;
+            xraudio_in_fifo_close(instance, index);
          }
          instance->stream_until[index] = XRAUDIO_INPUT_RECORD_UNTIL_INVALID;
       }
@@ -2358,7 +3083,7 @@ void xraudio_process_mic_data(xraudio_main_thread_params_t *params, xraudio_sess
                XLOGD_DEBUG("HAL samples buffered max <%u> lost <%u>", input_stats.samples_buffered_max, input_stats.samples_lost);
             }
 
-            (*instance->callback)(XRAUDIO_DEVICE_INPUT_LOCAL_GET(instance->source), event, &instance->stats, instance->param);
+            xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, XRAUDIO_DEVICE_INPUT_LOCAL_GET(instance->source), event, &instance->stats, instance->param);
          }
       }
       // Clear the session so no further incoming data is processed
@@ -2384,7 +3109,7 @@ void xraudio_process_mic_error(xraudio_session_record_t *session) {
          xraudio_devices_input_t device_local = XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input);
          xraudio_devices_input_t source_local = XRAUDIO_DEVICE_INPUT_LOCAL_GET(instance->source);
          if((instance->callback != NULL) && (device_local != XRAUDIO_DEVICE_INPUT_NONE) && (source_local != XRAUDIO_DEVICE_INPUT_NONE)) {
-            (*instance->callback)(instance->source, AUDIO_IN_CALLBACK_EVENT_ERROR, NULL, instance->param);
+            xraudio_dispatch_audio_in(session->obj_dispatch, instance->callback, instance->source, AUDIO_IN_CALLBACK_EVENT_ERROR, NULL, instance->param);
          } else if(device_local != XRAUDIO_DEVICE_INPUT_NONE && xraudio_keyword_detector_session_is_armed(&session->keyword_detector)) {
             xraudio_keyword_detector_session_event(&session->keyword_detector, device_local, KEYWORD_CALLBACK_EVENT_ERROR, NULL, session->format_in);
          }
@@ -2416,7 +3141,7 @@ void xraudio_unpack_multi_int16(xraudio_session_record_t *session, void *buffer_
    for(uint32_t chan = 0; chan < chan_qty; chan++) {
       int16_t *samples = &buffer_in_int16[chan * sample_qty_channel];
       xraudio_unpack_mono_int16(session, samples, &audio_group_int16[chan], &audio_group_fp32[chan], frame_group_index, sample_qty_channel);
-      if(session->capture_session.active && session->capture_session.input[chan].file.fh) {
+      if(session->capture_session.active && session->capture_session.input[chan].file.fh && session->obj_decimator == NULL) { // captured at the capture rate before decimation
          int rc_cap = xraudio_in_capture_session_to_file_int16(&session->capture_session.input[chan], samples, sample_qty_channel);
          if(rc_cap < 0) {
             session->capture_session.active = false;
@@ -2454,7 +3179,7 @@ void xraudio_unpack_multi_int32(xraudio_session_record_t *session, void *buffer_
    for(uint32_t chan = 0; chan < chan_qty; chan++) {
       int32_t *samples = &buffer_in_int32[chan * sample_qty_channel];
       xraudio_unpack_mono_int32(session, samples, &audio_group_int16[chan], &audio_group_fp32[chan], frame_group_index, sample_qty_channel);
-      if(session->capture_session.active && session->capture_session.input[chan].file.fh) {
+      if(session->capture_session.active && session->capture_session.input[chan].file.fh && session->obj_decimator == NULL) { // captured at the capture rate before decimation
          int rc_cap = xraudio_in_capture_session_to_file_int32(&session->capture_session.input[chan], samples, sample_qty_channel);
          if(rc_cap < 0) {
             session->capture_session.active = false;
@@ -2463,13 +3188,585 @@ void xraudio_unpack_multi_int32(xraudio_session_record_t *session, void *buffer_
    }
 }
 
-void xraudio_in_flush(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance) {
-   if(source != XRAUDIO_DEVICE_INPUT_MIC_TAP) {
-      instance->frame_group_qty = 1;
+void xraudio_in_capture_session_wideband(xraudio_session_record_t *session, uint8_t *buffer, uint8_t chan_qty, uint32_t sample_qty_channel, uint8_t sample_size) {
+   for(uint32_t chan = 0; chan < chan_qty && session->capture_session.active; chan++) {
+      if(session->capture_session.input[chan].file.fh == NULL) {
+         continue;
+      }
+      int rc_cap;
+      if(sample_size == 4) {
+         rc_cap = xraudio_in_capture_session_to_file_int32(&session->capture_session.input[chan], &((int32_t *)buffer)[chan * sample_qty_channel], sample_qty_channel);
+      } else {
+         rc_cap = xraudio_in_capture_session_to_file_int16(&session->capture_session.input[chan], &((int16_t *)buffer)[chan * sample_qty_channel], sample_qty_channel);
+      }
+      if(rc_cap < 0) {
+         session->capture_session.active = false;
+      }
    }
+}
 
-   if(instance->record_callback) { // Call the record handler to handle all the pending data
-      instance->record_callback(source, params, session, instance);
+// Single pass over the frame, four samples at a time.  Each sample is compared with the one before it for the zero crossings.
+void xraudio_in_frame_features_calculate(const float * restrict samples, uint32_t sample_qty, float full_scale, xraudio_frame_features_t *features) {
+   float    sum            = 0.0;
+   float    sum_sq         = 0.0;
+   float    peak           = 0.0;
+   uint32_t clip_qty       = 0;
+   uint32_t crossing_qty   = 0;
+   float    clip_level     = full_scale * (32767.0 / 32768.0);
+
+   if(sample_qty == 0) {
+      memset(features, 0, sizeof(*features));
+      return;
+   }
+
+   xraudio_f32x4_t zero_x4       = xraudio_f32x4_set(0.0);
+   xraudio_f32x4_t clip_level_x4 = xraudio_f32x4_set(clip_level);
+   xraudio_f32x4_t sum_x4        = zero_x4;
+   xraudio_f32x4_t sum_sq_x4     = zero_x4;
+   xraudio_f32x4_t peak_x4       = zero_x4;
+   xraudio_i32x4_t clip_x4       = xraudio_i32x4_set(0); // lanes count down by one for each match
+   xraudio_i32x4_t crossing_x4   = xraudio_i32x4_set(0);
+   uint32_t i = 1;
+
+   for(; i + 4 <= sample_qty; i += 4) {
+      xraudio_f32x4_t sample    = xraudio_f32x4_load(&samples[i]);
+      xraudio_f32x4_t previous  = xraudio_f32x4_load(&samples[i - 1]);
+      xraudio_f32x4_t magnitude = xraudio_f32x4_abs(sample);
+      sum_x4      = xraudio_f32x4_add(sum_x4, sample);
+      sum_sq_x4   = xraudio_f32x4_madd(sum_sq_x4, sample, sample);
+      peak_x4     = xraudio_f32x4_max(peak_x4, magnitude);
+      clip_x4     = xraudio_i32x4_sub(clip_x4, xraudio_f32x4_cmpge(magnitude, clip_level_x4));
+      crossing_x4 = xraudio_i32x4_sub(crossing_x4, xraudio_i32x4_xor(xraudio_f32x4_cmplt(previous, zero_x4), xraudio_f32x4_cmplt(sample, zero_x4)));
+   }
+   sum          = xraudio_f32x4_sum(sum_x4)  + samples[0];
+   sum_sq       = xraudio_f32x4_sum(sum_sq_x4) + samples[0] * samples[0];
+   peak         = xraudio_f32x4_hmax(peak_x4);
+   peak         = (fabsf(samples[0]) > peak) ? fabsf(samples[0]) : peak;
+   clip_qty     = (uint32_t)xraudio_i32x4_sum(clip_x4) + (fabsf(samples[0]) >= clip_level);
+   crossing_qty = (uint32_t)xraudio_i32x4_sum(crossing_x4);
+
+   for(; i < sample_qty; i++) {
+      float sample     = samples[i];
+      float magnitude  = fabsf(sample);
+      sum             += sample;
+      sum_sq          += sample * sample;
+      peak             = (magnitude > peak) ? magnitude : peak;
+      clip_qty        += (magnitude >= clip_level);
+      crossing_qty    += ((samples[i - 1] < 0.0) != (sample < 0.0));
+   }
+
+   features->rms                = sqrtf(sum_sq / sample_qty) / full_scale;
+   features->peak               = peak / full_scale;
+   features->dc_offset          = (sum / sample_qty) / full_scale;
+   features->zero_crossing_rate = (sample_qty > 1) ? (float)crossing_qty / (sample_qty - 1) : 0.0;
+   features->clip_qty           = clip_qty;
+   features->sample_qty         = sample_qty;
+}
+
+void xraudio_in_flush(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance) {
+   if(source != XRAUDIO_DEVICE_INPUT_MIC_TAP) {
+      instance->frame_group_qty = 1;
+      if(XRAUDIO_DEVICE_INPUT_EXTERNAL_GET(source) == XRAUDIO_DEVICE_INPUT_NONE && session->frame_group_index > 0) { // partial group is written below
+         instance->stats.frame_groups_written++;
+         instance->stats.frames_written += session->frame_group_index;
+      }
+   }
+
+   if(instance->record_callback) { // Call the record handler to handle all the pending data
+      instance->record_callback(source, params, session, instance);
+   }
+
+   if(instance->framing == XRAUDIO_STREAM_FRAMING_HEADER && instance->frame_flags != 0) { // Events that were not carried by a frame group are sent with an empty frame
+      xraudio_in_frame_events_flush(source, instance, xraudio_in_frame_timestamp_get());
+   }
+}
+
+void xraudio_in_frame_group_adapt(xraudio_session_record_inst_t *instance, uint8_t frame_group_index, bool flush, uint32_t frame_period) {
+   if(instance->latency_budget_ms == 0) { // fixed frame group quantity
+      return;
+   }
+   uint32_t batch_max = instance->latency_budget_ms / frame_period;
+   if(batch_max < XRAUDIO_INPUT_MIN_FRAME_GROUP_QTY) {
+      batch_max = XRAUDIO_INPUT_MIN_FRAME_GROUP_QTY;
+   } else if(batch_max > XRAUDIO_INPUT_MAX_FRAME_GROUP_QTY) {
+      batch_max = XRAUDIO_INPUT_MAX_FRAME_GROUP_QTY;
+   }
+
+   if(flush) { // Write the partial group with the event and start again from single frames
+      instance->frame_group_qty = frame_group_index;
+      instance->batch_qty       = XRAUDIO_INPUT_MIN_FRAME_GROUP_QTY;
+      return;
+   }
+   if(instance->batch_qty > batch_max) {
+      instance->batch_qty = batch_max;
+   }
+   instance->frame_group_qty = (frame_group_index > instance->batch_qty) ? frame_group_index : instance->batch_qty;
+
+   if(frame_group_index >= instance->frame_group_qty) { // Group is written on this frame, grow the next group while the speech is steady
+      instance->batch_qty = (instance->batch_qty * 2 > batch_max) ? batch_max : instance->batch_qty * 2;
+   }
+}
+
+uint64_t xraudio_in_frame_timestamp_get(void) {
+   rdkx_timestamp_t timestamp;
+   rdkx_timestamp_get(&timestamp);
+   return(((uint64_t)timestamp.tv_sec * 1000000) + (timestamp.tv_nsec / 1000));
+}
+
+void xraudio_in_latency_record(xraudio_latency_stage_t stage, uint64_t timestamp_begin) {
+   if(timestamp_begin == 0) { // Not timestamped
+      return;
+   }
+   uint32_t latency_us = (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_begin);
+   xraudio_latency_record(stage, latency_us);
+
+   #ifdef XRAUDIO_TRACE_ENABLED
+   if(stage != XRAUDIO_LATENCY_STAGE_CAPTURE_TO_DELIVERY) { // Spans several frames so it would not nest in the timeline
+      XRAUDIO_TRACE(XRAUDIO_TRACE_EVENT_STAGE, stage, timestamp_begin, latency_us);
+   }
+   #endif
+}
+
+void xraudio_in_frame_header_init(xraudio_session_record_inst_t *instance, xraudio_stream_frame_header_t *header, uint16_t flags, uint64_t timestamp, uint32_t sample_qty, uint32_t payload_size) {
+   header->magic        = XRAUDIO_STREAM_FRAME_HEADER_MAGIC;
+   header->header_size  = sizeof(xraudio_stream_frame_header_t);
+   header->flags        = flags;
+   header->sequence     = instance->frame_sequence++;
+   header->sample_qty   = sample_qty;
+   header->timestamp    = timestamp;
+   header->payload_size = payload_size;
+   header->reserved     = 0;
+}
+
+int xraudio_in_frame_write_fifo(xraudio_session_record_inst_t *instance, uint32_t index, const xraudio_stream_frame_header_t *header, const void *data, size_t data_size) {
+   if(header == NULL) { // Not framed
+      int rc = write(instance->fifo_audio_data[index], data, data_size);
+      if(rc == (int)data_size && instance->first_byte_timestamp != 0) {
+         xraudio_in_first_byte_written(instance);
+      }
+      return(rc);
+   }
+   xraudio_stream_frame_header_t header_fifo = *header;
+
+   if(instance->frame_gap[index]) {
+      header_fifo.flags |= XRAUDIO_STREAM_FRAME_FLAG_GAP;
+   }
+
+   if(!xraudio_in_frame_pending_write(instance, index)) { // The previous frame is still incomplete so this one is dropped whole
+      instance->frame_gap[index] = true;
+      errno = EAGAIN;
+      return(-1);
+   }
+
+   // Header and payload are written together so the reader never sees a header without its payload
+   struct iovec iov[2] = { { .iov_base = &header_fifo, .iov_len = sizeof(header_fifo) },
+                           { .iov_base = (void *)data, .iov_len = data_size } };
+   size_t frame_size = sizeof(header_fifo) + data_size;
+
+   ssize_t rc = writev(instance->fifo_audio_data[index], iov, (data_size > 0) ? 2 : 1);
+
+   if(rc <= 0) { // The destination lost this frame group
+      instance->frame_gap[index] = true;
+      return(-1);
+   }
+   if(rc < (ssize_t)frame_size) { // A frame larger than PIPE_BUF was partly written, keep the tail so the frame is completed before the next header
+      xraudio_stream_frame_pending_t *pending = &instance->frame_pending[index];
+      uint32_t size = (uint32_t)(frame_size - rc);
+
+      pending->buffer = (uint8_t *)malloc(size);
+      if(pending->buffer == NULL) {
+         XLOGD_ERROR("out of memory, fifo <%d> frames are no longer aligned", instance->fifo_audio_data[index]);
+         instance->frame_gap[index] = true;
+         return(-1);
+      }
+      uint32_t offset = 0;
+      if((size_t)rc < sizeof(header_fifo)) {
+         memcpy(pending->buffer, ((uint8_t *)&header_fifo) + rc, sizeof(header_fifo) - rc);
+         offset = sizeof(header_fifo) - rc;
+      }
+      if(size > offset) {
+         memcpy(&pending->buffer[offset], ((const uint8_t *)data) + (data_size - (size - offset)), size - offset);
+      }
+      pending->size   = size;
+      pending->offset = 0;
+   } else if(instance->first_byte_timestamp != 0) { // Otherwise recorded once the tail is written
+      xraudio_in_first_byte_written(instance);
+   }
+   instance->frame_gap[index] = false;
+   return((int)data_size);
+}
+
+// Write the tail of a partly written frame.  Returns true when no part of a frame remains unwritten.
+bool xraudio_in_frame_pending_write(xraudio_session_record_inst_t *instance, uint32_t index) {
+   xraudio_stream_frame_pending_t *pending = &instance->frame_pending[index];
+   if(pending->buffer == NULL) {
+      return(true);
+   }
+   ssize_t rc = write(instance->fifo_audio_data[index], &pending->buffer[pending->offset], pending->size - pending->offset);
+   if(rc > 0) {
+      pending->offset += rc;
+   }
+   if(pending->offset < pending->size) {
+      return(false);
+   }
+   free(pending->buffer);
+   pending->buffer = NULL;
+   if(instance->first_byte_timestamp != 0) {
+      xraudio_in_first_byte_written(instance);
+   }
+   return(true);
+}
+
+void xraudio_in_fifo_close(xraudio_session_record_inst_t *instance, uint32_t index) {
+   if(!xraudio_in_frame_pending_write(instance, index)) {
+      xraudio_stream_frame_pending_t *pending = &instance->frame_pending[index];
+      XLOGD_ERROR("fifo <%d> closed with <%u> bytes of the last frame unwritten", instance->fifo_audio_data[index], pending->size - pending->offset);
+      free(pending->buffer);
+      pending->buffer = NULL;
+   }
+   close(instance->fifo_audio_data[index]);
+   instance->fifo_audio_data[index] = -1;
+}
+
+void xraudio_in_first_byte_written(xraudio_session_record_inst_t *instance) {
+   uint32_t first_byte_us = (uint32_t)(xraudio_in_frame_timestamp_get() - instance->first_byte_timestamp);
+   instance->first_byte_timestamp = 0;
+
+   xraudio_atomic_int_set(instance->first_byte_armed ? &g_armed_first_byte_us : &g_first_byte_us, (int)first_byte_us);
+   xraudio_latency_record(XRAUDIO_LATENCY_STAGE_KEYWORD_TO_FIRST_BYTE, first_byte_us);
+
+   XLOGD_INFO("first write <%u> us after keyword detection <%s>", first_byte_us, instance->first_byte_armed ? "ARMED" : "REQUESTED");
+}
+
+void xraudio_in_frame_events_flush(xraudio_devices_input_t source, xraudio_session_record_inst_t *instance, uint64_t timestamp) {
+   xraudio_stream_frame_header_t header;
+
+   xraudio_in_frame_header_init(instance, &header, instance->frame_flags, timestamp, 0, 0);
+   instance->frame_flags = 0;
+
+   if(instance->fifo_audio_data[0] >= 0) {
+      for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
+         if(instance->fifo_audio_data[index] < 0) {
+            break;
+         }
+         errno = 0;
+         if(xraudio_in_frame_write_fifo(instance, index, &header, NULL, 0) < 0) {
+            int errsv = errno;
+            XLOGD_ERROR("unable to write frame header to fifo <%d> <%s>", instance->fifo_audio_data[index], strerror(errsv));
+         }
+      }
+   } else if(instance->data_callback != NULL) {
+      (*instance->data_callback)(source, (xraudio_sample_t *)&header, 0, instance->param);
+   }
+}
+
+// Convert a frame group into the output buffer in the requested sample format and channel layout.  Returns the payload size in bytes.
+uint32_t xraudio_in_samples_out(xraudio_session_record_t *session, xraudio_session_record_inst_t *instance, xraudio_audio_buffer_out_t *buffer_out, bool is_external, uint8_t chan, uint8_t frame_qty, uint32_t *sample_qty_chan, uint8_t *chan_qty) {
+   uint32_t sample_size = (instance->sample_format == XRAUDIO_STREAM_SAMPLE_FORMAT_INT16) ? sizeof(int16_t) : sizeof(int32_t);
+
+   if(is_external) { // External sources are mono int16 after decoding
+      const int16_t *src = (const int16_t *)session->external_frame_buffer;
+      uint32_t sample_qty = (session->external_frame_size_out / sizeof(int16_t)) * frame_qty;
+
+      if(sample_qty > session->frame_buffer_out_sample_qty) {
+         XLOGD_ERROR("sample qty <%u> exceeds maximum <%u>", sample_qty, session->frame_buffer_out_sample_qty);
+         sample_qty = session->frame_buffer_out_sample_qty;
+      }
+
+      switch(instance->sample_format) {
+         case XRAUDIO_STREAM_SAMPLE_FORMAT_INT16:   xraudio_in_samples_copy_int16((int16_t *)buffer_out->samples, &src, 1, sample_qty);       break;
+         case XRAUDIO_STREAM_SAMPLE_FORMAT_INT32:   xraudio_in_samples_copy_int16_int32((int32_t *)buffer_out->samples, &src, 1, sample_qty); break;
+         case XRAUDIO_STREAM_SAMPLE_FORMAT_FLOAT32: xraudio_in_samples_copy_int16_fp32((float *)buffer_out->samples, src, sample_qty);       break;
+         default: break;
+      }
+      *sample_qty_chan = sample_qty;
+      *chan_qty        = 1;
+      return(sample_qty * sample_size);
+   }
+
+   uint8_t chan_first = chan;
+   uint8_t chan_count = 1;
+
+   if(instance->channel_layout != XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO) {
+      xraudio_devices_input_t device_input_local = XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input);
+      chan_first = 0;
+      chan_count = xraudio_devices_input_mic_qty(device_input_local, session->input_mic_qty);
+   }
+
+   uint32_t frame_sample_qty = session->frame_sample_qty / session->format_in.channel_qty;
+   bool     input_int32      = (session->format_in.sample_size > 2); // float frame buffers hold int32 scaled samples for 32-bit input, int16 scaled otherwise
+   float    scale            = input_int32 ? (1.0f / 2147483648.0f) : (1.0f / 32768.0f);
+   bool     interleaved      = (instance->channel_layout == XRAUDIO_STREAM_CHANNEL_LAYOUT_INTERLEAVED);
+   uint8_t  copy_chan_qty    = interleaved ? chan_count : 1; // channels written by each copy
+
+   for(uint8_t frame = 0; frame < frame_qty; frame++) {
+      for(uint8_t index = 0; index < chan_count; index += copy_chan_qty) {
+         const int16_t *src_int16[copy_chan_qty];
+         const float *  src_fp32[copy_chan_qty];
+         uint32_t       offset;
+
+         for(uint8_t copy_chan = 0; copy_chan < copy_chan_qty; copy_chan++) {
+            src_int16[copy_chan] = &session->frame_buffer_int16[chan_first + index + copy_chan].frames[frame].samples[0];
+            src_fp32[copy_chan]  = &session->frame_buffer_fp32[chan_first + index + copy_chan].frames[frame].samples[0];
+         }
+
+         if(interleaved) { // frame by frame, channels interleaved sample by sample
+            offset = frame * frame_sample_qty * chan_count;
+         } else {          // channel by channel, frames contiguous within the channel
+            offset = (index * frame_qty * frame_sample_qty) + (frame * frame_sample_qty);
+         }
+
+         switch(instance->sample_format) {
+            case XRAUDIO_STREAM_SAMPLE_FORMAT_INT16: {
+               xraudio_in_samples_copy_int16(&((int16_t *)buffer_out->samples)[offset], src_int16, copy_chan_qty, frame_sample_qty);
+               break;
+            }
+            case XRAUDIO_STREAM_SAMPLE_FORMAT_INT32: {
+               if(input_int32) {
+                  xraudio_in_samples_copy_fp32_int32(&((int32_t *)buffer_out->samples)[offset], src_fp32, copy_chan_qty, frame_sample_qty);
+               } else {
+                  xraudio_in_samples_copy_int16_int32(&((int32_t *)buffer_out->samples)[offset], src_int16, copy_chan_qty, frame_sample_qty);
+               }
+               break;
+            }
+            case XRAUDIO_STREAM_SAMPLE_FORMAT_FLOAT32: {
+               xraudio_in_samples_copy_fp32_fp32(&((float *)buffer_out->samples)[offset], src_fp32, copy_chan_qty, frame_sample_qty, scale);
+               break;
+            }
+            default: {
+               break;
+            }
+         }
+      }
+   }
+   *sample_qty_chan = frame_sample_qty * frame_qty;
+   *chan_qty        = chan_count;
+   return(frame_sample_qty * frame_qty * chan_count * sample_size);
+}
+
+// Called by the input session on the api thread so the main thread never allocates the pool.  Returns the quantity of buffers allocated.
+uint8_t xraudio_in_stream_buffer_pool_create(xraudio_stream_buffer_t *pool, uint8_t buffer_qty, uint32_t sample_qty) {
+   size_t  size = sizeof(xraudio_stream_buffer_entry_t) + (sample_qty * sizeof(int32_t));
+   uint8_t qty  = 0;
+   for(uint8_t index = 0; index < buffer_qty; index++) {
+      xraudio_stream_buffer_entry_t *entry = (xraudio_stream_buffer_entry_t *)malloc(size);
+      if(entry == NULL) {
+         XLOGD_ERROR("unable to allocate stream buffer <%u> of <%u>", index, buffer_qty);
+         break;
+      }
+      xraudio_atomic_int_set(&entry->refcount, 1);
+      pool[index] = (xraudio_stream_buffer_t)entry;
+      qty         = index + 1;
+   }
+   XLOGD_INFO("stream buffer qty <%u> size <%zu>", qty, size);
+   return(qty);
+}
+
+// Drop the pool's reference to each buffer.  Buffers still retained by the client are freed when they are released.
+void xraudio_in_stream_buffer_pool_destroy(xraudio_stream_buffer_t *pool, uint8_t buffer_qty) {
+   for(uint8_t index = 0; index < buffer_qty; index++) {
+      xraudio_stream_buffer_entry_t *entry = (xraudio_stream_buffer_entry_t *)pool[index];
+      if(xraudio_atomic_int_get(&entry->refcount) > 1) {
+         XLOGD_WARN("stream buffer <%u> retained by client", index);
+      }
+      xraudio_in_stream_buffer_unref(entry);
+      pool[index] = NULL;
+   }
+}
+
+uint32_t xraudio_in_frame_buffer_out_sample_qty(xraudio_devices_input_t devices, uint8_t mic_qty) {
+   uint8_t chan_qty = xraudio_devices_input_mic_qty(devices, mic_qty) + xraudio_devices_input_ec_ref_qty(devices);
+   if(chan_qty == 0) {
+      chan_qty = 1;
+   }
+   return(chan_qty * XRAUDIO_INPUT_FRAME_SAMPLE_QTY * XRAUDIO_INPUT_MAX_FRAME_GROUP_QTY);
+}
+
+xraudio_stream_buffer_entry_t *xraudio_in_buffer_pool_acquire(xraudio_session_record_inst_t *instance) {
+   for(uint8_t index = 0; index < instance->buffer_pool_qty; index++) {
+      xraudio_stream_buffer_entry_t *entry = instance->buffer_pool[index];
+      if(xraudio_atomic_compare_and_set(&entry->refcount, 1, 2)) {
+         return(entry);
+      }
+   }
+   return(NULL);
+}
+
+void xraudio_in_stream_buffer_unref(xraudio_stream_buffer_entry_t *entry) {
+   int refcount;
+   do {
+      refcount = xraudio_atomic_int_get(&entry->refcount);
+      if(refcount <= 0) {
+         XLOGD_ERROR("stream buffer is not referenced");
+         return;
+      }
+   } while(!xraudio_atomic_compare_and_set(&entry->refcount, refcount, refcount - 1));
+
+   if(refcount == 1) { // Last reference, the buffer is no longer in a pool
+      free(entry);
+   }
+}
+
+xraudio_stream_buffer_t xraudio_in_stream_buffer_retain(xraudio_stream_buffer_t buffer) {
+   xraudio_stream_buffer_entry_t *entry = (xraudio_stream_buffer_entry_t *)buffer;
+   if(entry == NULL) {
+      return(NULL);
+   }
+   xraudio_atomic_int_add(&entry->refcount, 1);
+   return((xraudio_stream_buffer_t)entry);
+}
+
+void xraudio_in_stream_buffer_release(xraudio_stream_buffer_t buffer) {
+   xraudio_in_stream_buffer_unref((xraudio_stream_buffer_entry_t *)buffer);
+}
+
+// The sample copy kernels interleave chan_qty source channels into dst (chan_qty of 1 is a contiguous copy).  One, two and four channels are vectorized,
+// the remaining samples and other channel quantities are copied one sample at a time.
+void xraudio_in_samples_copy_int16(int16_t *dst, const int16_t * const *src, uint8_t chan_qty, uint32_t sample_qty) {
+   uint32_t i = 0;
+   switch(chan_qty) {
+      case 1: {
+         memcpy(dst, src[0], sample_qty * sizeof(int16_t));
+         return;
+      }
+      case 2: {
+         for(; i + 8 <= sample_qty; i += 8) {
+            xraudio_i16x8_store2(&dst[i * 2], xraudio_i16x8_load(&src[0][i]), xraudio_i16x8_load(&src[1][i]));
+         }
+         break;
+      }
+      case 4: {
+         for(; i + 8 <= sample_qty; i += 8) {
+            xraudio_i16x8_store4(&dst[i * 4], xraudio_i16x8_load(&src[0][i]), xraudio_i16x8_load(&src[1][i]), xraudio_i16x8_load(&src[2][i]), xraudio_i16x8_load(&src[3][i]));
+         }
+         break;
+      }
+      default: {
+         break;
+      }
+   }
+   for(; i < sample_qty; i++) {
+      for(uint8_t chan = 0; chan < chan_qty; chan++) {
+         dst[(i * chan_qty) + chan] = src[chan][i];
+      }
+   }
+}
+
+void xraudio_in_samples_copy_int16_int32(int32_t *dst, const int16_t * const *src, uint8_t chan_qty, uint32_t sample_qty) {
+   uint32_t i = 0;
+   switch(chan_qty) {
+      case 1: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_i32x4_store(&dst[i], xraudio_i32x4_shl16(xraudio_i32x4_load_i16(&src[0][i])));
+         }
+         break;
+      }
+      case 2: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_i32x4_store2(&dst[i * 2], xraudio_i32x4_shl16(xraudio_i32x4_load_i16(&src[0][i])), xraudio_i32x4_shl16(xraudio_i32x4_load_i16(&src[1][i])));
+         }
+         break;
+      }
+      case 4: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_i32x4_store4(&dst[i * 4], xraudio_i32x4_shl16(xraudio_i32x4_load_i16(&src[0][i])), xraudio_i32x4_shl16(xraudio_i32x4_load_i16(&src[1][i])),
+                                              xraudio_i32x4_shl16(xraudio_i32x4_load_i16(&src[2][i])), xraudio_i32x4_shl16(xraudio_i32x4_load_i16(&src[3][i])));
+         }
+         break;
+      }
+      default: {
+         break;
+      }
+   }
+   for(; i < sample_qty; i++) {
+      for(uint8_t chan = 0; chan < chan_qty; chan++) {
+         dst[(i * chan_qty) + chan] = (int32_t)src[chan][i] * 65536;
+      }
+   }
+}
+
+void xraudio_in_samples_copy_int16_fp32(float *dst, const int16_t *src, uint32_t sample_qty) {
+   xraudio_f32x4_t scale = xraudio_f32x4_set(1.0f / 32768.0f);
+   uint32_t i = 0;
+   for(; i + 4 <= sample_qty; i += 4) {
+      xraudio_f32x4_store(&dst[i], xraudio_f32x4_mul(xraudio_i32x4_to_f32x4(xraudio_i32x4_load_i16(&src[i])), scale));
+   }
+   for(; i < sample_qty; i++) {
+      dst[i] = src[i] * (1.0f / 32768.0f);
+   }
+}
+
+void xraudio_in_samples_copy_fp32_int32(int32_t *dst, const float * const *src, uint8_t chan_qty, uint32_t sample_qty) {
+   uint32_t i = 0;
+   switch(chan_qty) {
+      case 1: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_i32x4_store(&dst[i], xraudio_f32x4_to_i32x4(xraudio_f32x4_load(&src[0][i])));
+         }
+         break;
+      }
+      case 2: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_i32x4_store2(&dst[i * 2], xraudio_f32x4_to_i32x4(xraudio_f32x4_load(&src[0][i])), xraudio_f32x4_to_i32x4(xraudio_f32x4_load(&src[1][i])));
+         }
+         break;
+      }
+      case 4: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_i32x4_store4(&dst[i * 4], xraudio_f32x4_to_i32x4(xraudio_f32x4_load(&src[0][i])), xraudio_f32x4_to_i32x4(xraudio_f32x4_load(&src[1][i])),
+                                              xraudio_f32x4_to_i32x4(xraudio_f32x4_load(&src[2][i])), xraudio_f32x4_to_i32x4(xraudio_f32x4_load(&src[3][i])));
+         }
+         break;
+      }
+      default: {
+         break;
+      }
+   }
+   for(; i < sample_qty; i++) {
+      for(uint8_t chan = 0; chan < chan_qty; chan++) {
+         float sample = src[chan][i];
+         if(sample < (float)INT32_MIN) {
+            dst[(i * chan_qty) + chan] = INT32_MIN;
+         } else if(sample >= 2147483648.0f) {
+            dst[(i * chan_qty) + chan] = INT32_MAX;
+         } else {
+            dst[(i * chan_qty) + chan] = (int32_t)sample;
+         }
+      }
+   }
+}
+
+void xraudio_in_samples_copy_fp32_fp32(float *dst, const float * const *src, uint8_t chan_qty, uint32_t sample_qty, float scale) {
+   xraudio_f32x4_t scale_x4 = xraudio_f32x4_set(scale);
+   uint32_t i = 0;
+   switch(chan_qty) {
+      case 1: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_f32x4_store(&dst[i], xraudio_f32x4_mul(xraudio_f32x4_load(&src[0][i]), scale_x4));
+         }
+         break;
+      }
+      case 2: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_f32x4_store2(&dst[i * 2], xraudio_f32x4_mul(xraudio_f32x4_load(&src[0][i]), scale_x4), xraudio_f32x4_mul(xraudio_f32x4_load(&src[1][i]), scale_x4));
+         }
+         break;
+      }
+      case 4: {
+         for(; i + 4 <= sample_qty; i += 4) {
+            xraudio_f32x4_store4(&dst[i * 4], xraudio_f32x4_mul(xraudio_f32x4_load(&src[0][i]), scale_x4), xraudio_f32x4_mul(xraudio_f32x4_load(&src[1][i]), scale_x4),
+                                              xraudio_f32x4_mul(xraudio_f32x4_load(&src[2][i]), scale_x4), xraudio_f32x4_mul(xraudio_f32x4_load(&src[3][i]), scale_x4));
+         }
+         break;
+      }
+      default: {
+         break;
+      }
+   }
+   for(; i < sample_qty; i++) {
+      for(uint8_t chan = 0; chan < chan_qty; chan++) {
+         dst[(i * chan_qty) + chan] = src[chan][i] * scale;
+      }
    }
 }
 
@@ -2519,7 +3816,7 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
    uint32_t frame_group_index = session->frame_group_index - 1;
    xraudio_devices_input_t device_input_local = XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input);
 
-   uint8_t chan_qty_mic   = (device_input_local == XRAUDIO_DEVICE_INPUT_QUAD) ? 4 : (device_input_local == XRAUDIO_DEVICE_INPUT_TRI) ? 3 : 1;
+   uint8_t chan_qty_mic   = xraudio_devices_input_mic_qty(device_input_local, params->input_mic_qty);
 
    bool all_triggered = true;
    xraudio_keyword_detector_t *detector = &session->keyword_detector;
@@ -2528,6 +3825,12 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
       return(0);
    }
 
+   if(detector->reload.pending && !detector->triggered) { // Swap in the reloaded instance at this frame boundary
+      xraudio_keyword_detector_reload_swap(detector);
+   }
+
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+
    uint32_t chan_sample_qty = session->frame_sample_qty / session->format_in.channel_qty;
    bool is_armed = xraudio_keyword_detector_session_is_armed(detector);
 
@@ -2538,6 +3841,9 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
    uint8_t first_chan_kwd = params->dsp_config.input_asr_max_channel_qty;
    uint8_t last_chan_kwd = params->dsp_config.input_asr_max_channel_qty + params->dsp_config.input_kwd_max_channel_qty - 1;
 
+   // With the beamformer, the keyword channels already carry the beams selected for this frame (see xraudio_in_beam_route)
+   uint8_t beam_qty = detector->beam_qty;
+
    for(uint8_t chan = 0; chan < chan_qty_mic; chan++) {
       if(chan > last_chan_kwd) {
          XLOGD_ERROR("No keyword detector on input channel <%u>", chan);
@@ -2561,9 +3867,18 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
       uint8_t instance_kwd = chan - first_chan_kwd;
 
       float *frame_buffer_fp32 = &session->frame_buffer_fp32[chan].frames[frame_group_index].samples[0];
+      if(session->shed_level >= XRAUDIO_SHED_LEVEL_KWD_SECONDARY && !detector->triggered && chan != detector->active_chan && !(detector->active_chan < first_chan_kwd && instance_kwd == 0)) {
+         all_triggered = false; // a shed channel has not triggered, its score stays at -1 until it runs again
+         continue; // shed the secondary keyword channels (keep the active channel, or the first keyword channel if the active channel is the asr channel)
+      }
+      if(detector->beam_object != NULL && (instance_kwd >= detector->instance_qty || (beam_qty > 0 && instance_kwd >= beam_qty))) { // no kwd instance on this channel
+         continue;
+      }
+      uint64_t timestamp_chan = xraudio_in_frame_timestamp_get();
       if(!xraudio_kwd_run(detector->kwd_object, instance_kwd, frame_buffer_fp32, chan_sample_qty, &detected, &scaled_kwd_samples[0])) {
          XLOGD_ERROR("kwd run fail, chan <%u> instance <%u>", chan, instance_kwd);
       }
+      xraudio_in_channel_time_add(session, chan, timestamp_chan);
       if(session->capture_session.active && session->capture_session.kwd[chan].file.fh) {
          int rc_cap = xraudio_in_capture_session_to_file_int16(&session->capture_session.kwd[chan], &scaled_kwd_samples[0], chan_sample_qty);
          if(rc_cap < 0) {
@@ -2579,7 +3894,7 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
          if(!instance->eos_vad_forced) {   // don't increment post frame counts if EOS enabled and looking for end of wake word
             detector_chan->post_frame_count++;
          }
-      } else if(detected) {
+      } else if(detected && detector->result.keyword_index == XRAUDIO_KEYWORD_INDEX_PRIMARY) { // ignore if an additional keyword was detected first
          XLOGD_DEBUG("keyword detected for channel <%u> instance <%u>", chan, instance_kwd);
 
          if(!detector->triggered) {
@@ -2608,7 +3923,11 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
             // update channel's results
             detector->result.channels[chan].score = detector_chan->score;
             detector->result.channels[chan].snr   = detector_chan->snr;
-            detector->result.channels[chan].doa   = instance_kwd * 90;
+            if(session->doa.valid) { // the direction of arrival estimate overrides the beam or channel angle
+               detector->result.channels[chan].doa = session->doa.angle;
+            } else {
+               detector->result.channels[chan].doa = (beam_qty > 0) ? xraudio_beam_doa_get(detector->beam_object, detector->beams[instance_kwd]) : instance_kwd * 90;
+            }
 
             // update max score or max snr, depending on active channel selection criterion, if clearly the highest so far
             if(detector->result.chan_selected >= params->dsp_config.input_kwd_max_channel_qty ||
@@ -2646,6 +3965,10 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
       }
    }
 
+   if(detector->model_qty > 0 && detector->instance_qty > 0) {
+      xraudio_keyword_models_run(session, first_chan_kwd, chan_sample_qty, is_armed, timestamp_begin);
+   }
+
    detector->post_frame_count_callback++;
 
    if(!is_armed || !detector->triggered) {
@@ -2654,10 +3977,20 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
 
    detector->post_frame_count_trigger++;
 
+   // Stream ahead of the detection decision to the speculative destination, if any
+   xraudio_in_speculative_update(session, frame_group_index, chan_sample_qty);
+
    XLOGD_DEBUG("all triggered <%s> post frame count <%u>", all_triggered ? "YES" : "NO", detector->post_frame_count_trigger);
-   if(!all_triggered && detector->post_frame_count_trigger <= KEYWORD_TRIGGER_DETECT_THRESHOLD) {
-      // Wait up to N frames for other detectors to fire
-      return(0);
+   if(!detector->committed) {
+      xraudio_keyword_commit_reason_t reason = xraudio_keyword_detector_commit_check(detector, all_triggered);
+      if(reason == XRAUDIO_KEYWORD_COMMIT_INVALID) {
+         // Wait for other detectors to fire
+         return(0);
+      }
+      detector->committed               = true;
+      detector->result.commit_reason    = reason;
+      detector->result.commit_delay_ms  = (detector->post_frame_count_trigger - 1) * params->input_frame_period;
+      XLOGD_INFO("keyword commit <%s> chan <%u> delay <%u> ms", xraudio_keyword_commit_reason_str(reason), detector->active_chan, detector->result.commit_delay_ms);
    }
 
    xraudio_keyword_detector_chan_t *detector_chan = &detector->channels[detector->active_chan];
@@ -2698,6 +4031,7 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
 
    if(!xraudio_in_session_group_semaphore_lock(source)) {
       XLOGD_ERROR("could not acquire session");
+      xraudio_in_speculative_end(&detector->speculative, false); // the detection cannot be reported
       return(0);
    }
 
@@ -2760,7 +4094,9 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
 
          instance->dynamic_gain_pcm_bit_qty = session->pcm_bit_qty;
          float dynamic_gain;
+         uint64_t timestamp_dga = xraudio_in_frame_timestamp_get();
          xraudio_dga_calculate(session->obj_dga, &instance->dynamic_gain_pcm_bit_qty, frame_qty, (const float **)samples, sample_qty, &dynamic_gain);
+         xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_DGA, timestamp_dga);
          dynamic_gain -= session->input_aop_adjust_dB;
          detector->result.channels[detector->active_chan].dynamic_gain = dynamic_gain;
          XLOGD_DEBUG("pcm bit qty in <%u> out <%u>", session->pcm_bit_qty, instance->dynamic_gain_pcm_bit_qty);
@@ -2804,99 +4140,962 @@ int xraudio_in_write_to_keyword_detector(xraudio_devices_input_t source, xraudio
    // include AOP adjustment in the reported keyword detector gain
    detector->result.endpoints.kwd_gain -= session->input_aop_adjust_dB;
 
+   xraudio_in_speculative_end(&detector->speculative, true);
+
+   session->keyword_timestamp = xraudio_in_frame_timestamp_get();
+   if(session->stream_armed.armed) { // Attached by the main thread once the frame is processed
+      session->stream_armed.detected = true;
+   }
+
    xraudio_keyword_detector_session_event(detector, source, KEYWORD_CALLBACK_EVENT_DETECTED, &detector->result, session->format_in);
 
    return(0);
 }
 
-void xraudio_in_write_to_keyword_buffer(xraudio_keyword_detector_chan_t *keyword_detector_chan, float *frame_buffer_fp32, uint32_t sample_qty) {
-   if(sample_qty != XRAUDIO_INPUT_FRAME_SAMPLE_QTY) {
-      XLOGD_ERROR("unexpected sample qty <%u>", sample_qty);
+xraudio_keyword_commit_reason_t xraudio_keyword_detector_commit_check(xraudio_keyword_detector_t *detector, bool all_triggered) {
+   if(all_triggered) {
+      return(XRAUDIO_KEYWORD_COMMIT_ALL_TRIGGERED);
+   }
+
+   xraudio_keyword_detector_chan_t *detector_chan = &detector->channels[detector->active_chan];
+   if(detector->commit_margin > 0.0 && detector_chan->triggered) {
+      bool  use_snr    = (detector->criterion == XRAUDIO_KWD_CRITERION_SNR);
+      float value      = use_snr ? detector_chan->snr : detector_chan->score;
+      float value_next = 0.0; // channels which have not triggered are below the detection threshold
+
+      for(uint8_t chan = 0; chan < detector->input_asr_kwd_channel_qty; chan++) {
+         xraudio_keyword_detector_chan_t *other = &detector->channels[chan];
+         if(chan == detector->active_chan || !other->triggered) {
+            continue;
+         }
+         float value_other = use_snr ? other->snr : other->score;
+         if(value_other > value_next) {
+            value_next = value_other;
+         }
+      }
+      float margin  = value - value_next;
+      bool  closing = (detector->post_frame_count_trigger > 1 && margin < detector->commit_margin_prev); // another channel is catching up
+      detector->commit_margin_prev = margin;
+
+      XLOGD_DEBUG("margin <%f> closing <%s>", margin, closing ? "YES" : "NO");
+      if(margin >= detector->commit_margin && !closing) {
+         return(XRAUDIO_KEYWORD_COMMIT_MARGIN);
+      }
+   }
+
+   if(detector->post_frame_count_trigger > detector->commit_frame_qty_max) {
+      return(XRAUDIO_KEYWORD_COMMIT_TIMEOUT);
+   }
+   return(XRAUDIO_KEYWORD_COMMIT_INVALID);
+}
+
+void xraudio_in_speculative_update(xraudio_session_record_t *session, uint32_t frame_group_index, uint32_t sample_qty) {
+   xraudio_keyword_detector_t *   detector    = &session->keyword_detector;
+   xraudio_keyword_speculative_t *speculative = &detector->speculative;
+
+   if(speculative->pipe < 0) {
       return;
    }
+   uint32_t sample_rate = session->format_in.sample_rate;
+   uint64_t timestamp   = session->frame_group_timestamp + ((uint64_t)frame_group_index * session->frame_period * 1000);
+
+   if(speculative->active) {
+      if(detector->committed || detector->active_chan == speculative->chan) { // Continue with the live frame
+         xraudio_in_speculative_samples_write(speculative, &session->frame_buffer_fp32[speculative->chan].frames[frame_group_index].samples[0], sample_qty, timestamp, sample_rate);
+         speculative->frame_qty++;
+         return;
+      }
+      // A better channel triggered so restart from its keyword
+      xraudio_in_speculative_end(speculative, false);
+   } else if(detector->post_frame_count_trigger != 1) { // Only start on the first trigger
+      return;
+   }
+
+   xraudio_keyword_detector_chan_t *detector_chan = &detector->channels[detector->active_chan];
+   uint32_t pre_roll_qty = (detector_chan->endpoints.begin < 0) ? (uint32_t)(-detector_chan->endpoints.begin) : sample_qty;
+   if(pre_roll_qty > detector_chan->pd_sample_qty) {
+      pre_roll_qty = detector_chan->pd_sample_qty;
+   }
+
+   speculative->active     = true;
+   speculative->gap        = false;
+   speculative->chan       = detector->active_chan;
+   speculative->sequence   = 0;
+   speculative->sample_qty = 0;
+   speculative->frame_qty  = 0;
+   xraudio_atomic_int_add(&g_speculative_tentative_qty, 1);
+
+   // The pre-detection buffer already includes the current frame
+   float   *chunk_1_samples = NULL;
+   float   *chunk_2_samples = NULL;
+   uint32_t chunk_1_qty     = 0;
+   uint32_t chunk_2_qty     = 0;
+   if(!xraudio_in_pre_detection_chunks(detector_chan, pre_roll_qty, 0, &chunk_1_samples, &chunk_1_qty, &chunk_2_samples, &chunk_2_qty)) {
+      return;
+   }
+   uint64_t timestamp_end = timestamp + (session->frame_period * 1000);
+   XLOGD_INFO("chan <%u> pre-roll <%u> samples", speculative->chan, pre_roll_qty);
+
+   if(chunk_1_qty > 0) {
+      xraudio_in_speculative_samples_write(speculative, chunk_1_samples, chunk_1_qty, timestamp_end - ((uint64_t)pre_roll_qty * 1000000 / sample_rate), sample_rate);
+   }
+   if(chunk_2_qty > 0) {
+      xraudio_in_speculative_samples_write(speculative, chunk_2_samples, chunk_2_qty, timestamp_end - ((uint64_t)chunk_2_qty * 1000000 / sample_rate), sample_rate);
+   }
+}
+
+// Write the samples in frame sized chunks so the conversion does not modify the pre-detection buffer
+void xraudio_in_speculative_samples_write(xraudio_keyword_speculative_t *speculative, const float *samples, uint32_t sample_qty, uint64_t timestamp, uint32_t sample_rate) {
+   int16_t samples_int16[XRAUDIO_INPUT_FRAME_SAMPLE_QTY];
+
+   while(sample_qty > 0) {
+      uint32_t qty = (sample_qty > XRAUDIO_INPUT_FRAME_SAMPLE_QTY) ? XRAUDIO_INPUT_FRAME_SAMPLE_QTY : sample_qty;
+
+      xraudio_samples_convert_fp32_int16(samples_int16, (float *)samples, qty, 16);
+      xraudio_in_speculative_frame_write(speculative, XRAUDIO_STREAM_FRAME_FLAG_SPECULATIVE, samples_int16, qty, timestamp);
+
+      speculative->sample_qty += qty;
+      samples    += qty;
+      sample_qty -= qty;
+      timestamp  += (uint64_t)qty * 1000000 / sample_rate;
+   }
+}
+
+bool xraudio_in_speculative_frame_write(xraudio_keyword_speculative_t *speculative, uint16_t flags, const int16_t *samples, uint32_t sample_qty, uint64_t timestamp) {
+   xraudio_stream_frame_header_t header;
+   size_t                        size = (samples != NULL) ? sample_qty * sizeof(int16_t) : 0;
+
+   header.magic        = XRAUDIO_STREAM_FRAME_HEADER_MAGIC;
+   header.header_size  = sizeof(xraudio_stream_frame_header_t);
+   header.flags        = flags | (speculative->gap ? XRAUDIO_STREAM_FRAME_FLAG_GAP : 0);
+   header.sequence     = speculative->sequence++;
+   header.sample_qty   = sample_qty;
+   header.timestamp    = timestamp;
+   header.payload_size = size;
+   header.reserved     = 0;
+
+   // Header and payload are written together so the reader never sees a header without its payload
+   struct iovec iov[2] = { { .iov_base = &header,         .iov_len = sizeof(header) },
+                           { .iov_base = (void *)samples, .iov_len = size } };
+
+   errno = 0;
+   ssize_t rc = writev(speculative->pipe, iov, (size > 0) ? 2 : 1);
+
+   if(rc != (ssize_t)(sizeof(header) + size)) {
+      int errsv = errno;
+      if(errsv != EAGAIN && errsv != EWOULDBLOCK) {
+         XLOGD_ERROR("unable to write pipe <%d> <%s>", speculative->pipe, strerror(errsv));
+      }
+      speculative->gap = true;
+      return(false);
+   }
+   speculative->gap = false;
+   return(true);
+}
+
+void xraudio_in_speculative_end(xraudio_keyword_speculative_t *speculative, bool confirm) {
+   if(!speculative->active) {
+      return;
+   }
+   uint16_t flags = XRAUDIO_STREAM_FRAME_FLAG_SPECULATIVE | (confirm ? XRAUDIO_STREAM_FRAME_FLAG_CONFIRM : XRAUDIO_STREAM_FRAME_FLAG_RETRACT);
+
+   // The final header carries the quantity of samples sent in the speculative stream
+   if(!xraudio_in_speculative_frame_write(speculative, flags, NULL, speculative->sample_qty, xraudio_in_frame_timestamp_get())) {
+      XLOGD_WARN("unable to write %s marker", confirm ? "confirm" : "retract");
+   }
+   speculative->active = false;
+
+   if(confirm) {
+      xraudio_atomic_int_add(&g_speculative_hit_qty, 1);
+      xraudio_atomic_int_add(&g_speculative_lead_ms_total, (int)(speculative->frame_qty * speculative->frame_period));
+   } else {
+      xraudio_atomic_int_add(&g_speculative_retract_qty, 1);
+   }
+   XLOGD_INFO("%s chan <%u> samples <%u> lead <%u> ms", confirm ? "confirm" : "retract", speculative->chan, speculative->sample_qty, speculative->frame_qty * speculative->frame_period);
+}
+
+void xraudio_keyword_models_run(xraudio_session_record_t *session, uint8_t chan, uint32_t chan_sample_qty, bool is_armed, uint64_t timestamp_begin) {
+   xraudio_keyword_detector_t *     detector      = &session->keyword_detector;
+   xraudio_keyword_detector_chan_t *detector_chan = &detector->channels[chan];
+   float   samples[chan_sample_qty];
+   int16_t scaled_kwd_samples[chan_sample_qty];
+
+   for(uint8_t index = 0; index < detector->model_qty; index++) {
+      detector->models[index].lag_sample_qty += chan_sample_qty;
+   }
+
+   // Run each model over its buffered samples from the pre-detection history.  Once the budget is spent, the remaining models are deferred until they fall too far behind.
+   for(uint8_t count = 0; count < detector->model_qty; count++) {
+      uint8_t                  index = (detector->model_next + count) % detector->model_qty;
+      xraudio_keyword_model_t *model = &detector->models[index];
+
+      while(model->lag_sample_qty >= chan_sample_qty) {
+         uint64_t timestamp = xraudio_in_frame_timestamp_get();
+         if(detector->model_budget_us > 0 && (timestamp - timestamp_begin) + model->cost_us > detector->model_budget_us && model->lag_sample_qty <= XRAUDIO_KEYWORD_MODEL_LAG_SAMPLES_MAX) {
+            model->defer_qty++;
+            break;
+         }
+         float *  chunk_1_samples = NULL;
+         float *  chunk_2_samples = NULL;
+         uint32_t chunk_1_qty     = 0;
+         uint32_t chunk_2_qty     = 0;
+         if(!xraudio_in_pre_detection_chunks(detector_chan, chan_sample_qty, model->lag_sample_qty - chan_sample_qty, &chunk_1_samples, &chunk_1_qty, &chunk_2_samples, &chunk_2_qty)) {
+            model->lag_sample_qty = 0;
+            break;
+         }
+         memcpy(&samples[0], chunk_1_samples, chunk_1_qty * sizeof(float));
+         if(chunk_2_qty > 0) {
+            memcpy(&samples[chunk_1_qty], chunk_2_samples, chunk_2_qty * sizeof(float));
+         }
+         model->lag_sample_qty -= chan_sample_qty;
+
+         bool detected = false;
+         if(!xraudio_kwd_run(model->kwd_object, 0, &samples[0], chan_sample_qty, &detected, &scaled_kwd_samples[0])) {
+            XLOGD_ERROR("kwd run fail, keyword <%s>", model->name);
+         }
+         uint32_t cost_us = (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp);
+         model->cost_us = (model->cost_us == 0) ? cost_us : (model->cost_us * 7 + cost_us) / 8;
+
+         if(detected && is_armed && !detector->triggered) {
+            xraudio_keyword_models_detected(session, chan, index);
+         }
+      }
+   }
+   detector->model_next = (detector->model_next + 1) % detector->model_qty;
+}
+
+void xraudio_keyword_models_detected(xraudio_session_record_t *session, uint8_t chan, uint8_t index) {
+   xraudio_keyword_detector_t *     detector      = &session->keyword_detector;
+   xraudio_keyword_detector_chan_t *detector_chan = &detector->channels[chan];
+   xraudio_keyword_model_t *        model         = &detector->models[index];
+
+   if(!xraudio_kwd_result(model->kwd_object, 0, &detector_chan->score, &detector_chan->snr, &detector_chan->endpoints)) {
+      XLOGD_ERROR("keyword result keyword <%s>", model->name);
+      return;
+   }
+   XLOGD_INFO("keyword <%s> detected on chan <%u> lag <%u> samples", model->name, chan, model->lag_sample_qty);
+
+   // The endpoints are relative to the last sample processed by the model which may lag behind the live audio
+   detector_chan->endpoints.begin -= model->lag_sample_qty;
+   detector_chan->endpoints.end   -= model->lag_sample_qty;
+   if(detector_chan->endpoints.detector_name != NULL) {
+      detector->result.detector_name = detector_chan->endpoints.detector_name;
+   }
+
+   // Only this model's single instance can detect the keyword so it is committed immediately
+   detector->triggered                   = true;
+   detector->committed                   = true;
+   detector->active_chan                 = chan;
+   detector->result.chan_selected        = chan;
+   detector->result.keyword_index        = index + 1;
+   detector->result.keyword_name         = model->name;
+   detector->result.commit_reason        = XRAUDIO_KEYWORD_COMMIT_ALL_TRIGGERED;
+   detector->result.commit_delay_ms      = 0;
+   detector->result.channels[chan].score = detector_chan->score;
+   detector->result.channels[chan].snr   = detector_chan->snr;
+   detector->result.channels[chan].doa   = session->doa.valid ? session->doa.angle : 0;
+
+   if(detector_chan->pd_sample_qty + detector_chan->endpoints.begin < 0) {
+      XLOGD_ERROR("keyword endpoint out of range <%u> <%d>", detector_chan->pd_sample_qty, detector_chan->endpoints.begin);
+   } else {
+      detector->result.endpoints = detector_chan->endpoints;
+      if(detector_chan->pd_sample_qty + detector->result.endpoints.begin < XRAUDIO_PRE_KWD_STREAM_LAG_SAMPLES) {
+         detector->result.endpoints.pre = 0 - detector_chan->pd_sample_qty;
+      } else {
+         detector->result.endpoints.pre = 0 - (detector_chan->pd_sample_qty - XRAUDIO_PRE_KWD_STREAM_LAG_SAMPLES);
+      }
+   }
+   detector_chan->triggered        = true;
+   detector_chan->post_frame_count = 0;
+}
+
+void *xraudio_thread_kwd_init(void *param) {
+   xraudio_keyword_detector_init_t *init = (xraudio_keyword_detector_init_t *)param;
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+
+   xraudio_keyword_detector_init(init->detector, init->jkwd_config, &init->params->beamformer_config, &init->params->keyword_commit_config, &init->params->keyword_models_config, init->params->input_frame_period, init->params->obj_dispatch);
+
+   uint32_t init_time_us = (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_begin);
+   XLOGD_INFO("keyword detector init <%u> us", init_time_us);
+   xraudio_atomic_int_set(&g_init_kwd_time_us, (int)init_time_us);
+   return(NULL);
+}
+
+void *xraudio_thread_kwd_reload(void *param) {
+   xraudio_keyword_reload_t *reload = (xraudio_keyword_reload_t *)param;
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+
+   if(reload->kwd_object_old != NULL) { // Destroy the instance replaced by the previous reload off the main thread
+      xraudio_kwd_object_destroy(reload->kwd_object_old);
+      reload->kwd_object_old = NULL;
+   }
+   json_decref(reload->jkwd_config_old);
+   reload->jkwd_config_old = NULL;
+
+   reload->kwd_object = xraudio_kwd_object_create(reload->jkwd_config);
+   if(reload->kwd_object == NULL) {
+      XLOGD_ERROR("unable to create kwd object");
+   } else if(reload->chan_qty > 0 && !xraudio_kwd_init(reload->kwd_object, reload->chan_qty, reload->sensitivity, NULL, &reload->criterion)) {
+      XLOGD_ERROR("kwd init failed");
+      xraudio_kwd_object_destroy(reload->kwd_object);
+      reload->kwd_object = NULL;
+   }
+   reload->load_time_ms = (uint32_t)((xraudio_in_frame_timestamp_get() - timestamp_begin) / 1000);
+
+   // Wake up the main thread to swap in the new instance
+   xraudio_main_queue_msg_generic_t msg;
+   msg.header.type = XRAUDIO_MAIN_QUEUE_MSG_TYPE_DETECT_RELOAD_READY;
+   queue_msg_push(reload->msgq, (const char *)&msg, sizeof(msg));
+
+   return(NULL);
+}
+
+void xraudio_keyword_detector_reload_swap(xraudio_keyword_detector_t *detector) {
+   xraudio_keyword_reload_t *reload = &detector->reload;
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+
+   if(detector->active && !detector->suspended) {
+      if(reload->chan_qty != detector->instance_qty) { // The session changed while loading
+         if(reload->chan_qty > 0) {
+            xraudio_kwd_term(reload->kwd_object);
+         }
+         if(detector->instance_qty > 0 && !xraudio_kwd_init(reload->kwd_object, detector->instance_qty, reload->sensitivity, NULL, &reload->criterion)) {
+            XLOGD_ERROR("kwd init failed");
+         }
+      }
+      xraudio_kwd_term(detector->kwd_object);
+      detector->criterion = reload->criterion;
+   } else if(reload->chan_qty > 0) { // The session ended or was suspended while loading, the instance is initialized when the next session begins or resumes
+      xraudio_kwd_term(reload->kwd_object);
+   }
+
+   // The pre-detection buffers and the detector state are kept so the history is preserved across the swap
+   if(detector->snapshot != NULL) { // The saved state belongs to the previous instance
+      detector->snapshot->size = 0;
+   }
+   reload->kwd_object_old     = detector->kwd_object;
+   reload->jkwd_config_old    = reload->jkwd_config_active;
+   reload->jkwd_config_active = reload->jkwd_config;
+   reload->jkwd_config        = NULL;
+   detector->kwd_object       = reload->kwd_object;
+   detector->sensitivity      = reload->sensitivity;
+   reload->kwd_object         = NULL;
+   reload->pending            = false;
+
+   uint64_t timestamp_end = xraudio_in_frame_timestamp_get();
+   uint32_t swap_delay_us = (uint32_t)(timestamp_end - reload->timestamp_ready);
+   uint32_t swap_time_us  = (uint32_t)(timestamp_end - timestamp_begin);
+
+   XLOGD_INFO("sensitivity <%f> load time <%u> ms swap delay <%u> us swap time <%u> us", reload->sensitivity, reload->load_time_ms, swap_delay_us, swap_time_us);
+   xraudio_in_detect_reload_end(XRAUDIO_RESULT_OK, reload->load_time_ms, swap_delay_us, swap_time_us);
+}
+
+void xraudio_in_write_to_keyword_buffer(xraudio_keyword_detector_chan_t *keyword_detector_chan, float *frame_buffer_fp32, uint32_t sample_qty) {
+   if(sample_qty == 0 || sample_qty > XRAUDIO_INPUT_FRAME_SAMPLE_QTY) {
+      XLOGD_ERROR("unexpected sample qty <%u>", sample_qty);
+      return;
+   }
+
+   uint32_t size = sample_qty * sizeof(float);
+   memcpy(&keyword_detector_chan->pre_detection_buffer_fp32[keyword_detector_chan->pd_index_write], frame_buffer_fp32, size);
+   if(keyword_detector_chan->pd_sample_qty < sizeof(keyword_detector_chan->pre_detection_buffer_fp32) / sizeof(float)) {
+      keyword_detector_chan->pd_sample_qty += sample_qty;
+   }
+   keyword_detector_chan->pd_index_write += sample_qty;
+   if(keyword_detector_chan->pd_index_write >= sizeof(keyword_detector_chan->pre_detection_buffer_fp32) / sizeof(float)) {
+      keyword_detector_chan->pd_index_write = 0;
+   }
+}
+
+uint32_t xraudio_keyword_detector_session_pd_avail(xraudio_keyword_detector_t *detector, uint8_t active_chan) {
+   return(detector->channels[active_chan].pd_sample_qty);
+}
+
+// Form the steered beams from the microphone channels and copy the strongest ones over the keyword channels.  Each keyword channel then carries the beam its
+// kwd instance runs on, so the pre-detection buffer, end of speech detection and the stream all follow the selected beam.
+void xraudio_in_beam_route(xraudio_main_thread_params_t *params, xraudio_session_record_t *session, uint8_t chan_qty_mic, uint8_t sample_size) {
+   xraudio_keyword_detector_t *detector = &session->keyword_detector;
+
+   detector->beam_qty = 0;
+   if(detector->beam_object == NULL || !xraudio_keyword_detector_session_is_active(detector) || xraudio_beam_mic_qty_get(detector->beam_object) != chan_qty_mic) {
+      return;
+   }
+   uint32_t     frame_group_index = session->frame_group_index;
+   uint32_t     chan_sample_qty   = session->frame_sample_qty / session->format_in.channel_qty;
+   const float *mic_samples[chan_qty_mic];
+
+   for(uint8_t chan = 0; chan < chan_qty_mic; chan++) {
+      mic_samples[chan] = &session->frame_buffer_fp32[chan].frames[frame_group_index].samples[0];
+   }
+   xraudio_beam_process(detector->beam_object, mic_samples, chan_sample_qty);
+   detector->beam_qty = xraudio_beam_select(detector->beam_object, detector->beams, detector->instance_qty, detector->triggered);
+
+   uint8_t first_chan_kwd = params->dsp_config.input_asr_max_channel_qty;
+   float   scale          = (sample_size == 4) ? (1.0 / 65536.0) : 1.0; // the float samples are at the HAL sample scale
+   for(uint8_t instance_kwd = 0; instance_kwd < detector->beam_qty && first_chan_kwd + instance_kwd < chan_qty_mic; instance_kwd++) {
+      uint8_t  chan          = first_chan_kwd + instance_kwd;
+      float *  samples_fp32  = &session->frame_buffer_fp32[chan].frames[frame_group_index].samples[0];
+      int16_t *samples_int16 = &session->frame_buffer_int16[chan].frames[frame_group_index].samples[0];
+
+      memcpy(samples_fp32, xraudio_beam_samples_get(detector->beam_object, detector->beams[instance_kwd]), chan_sample_qty * sizeof(float));
+      for(uint32_t i = 0; i < chan_sample_qty; i++) {
+         float sample = samples_fp32[i] * scale;
+         samples_int16[i] = (sample <= INT16_MIN) ? INT16_MIN : (sample >= INT16_MAX) ? INT16_MAX : (int16_t)sample;
+      }
+   }
+}
+
+#endif
+
+int xraudio_in_write_to_memory(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance) {
+   uint8_t *frame_buffer      = NULL;
+   uint32_t frame_size        = 0;
+   uint8_t  frame_group_index = 0;
+   if(source != instance->source) {
+      XLOGD_DEBUG("different source is being recorded");
+      return(0);
+   }
+   if(XRAUDIO_DEVICE_INPUT_EXTERNAL_GET(source) != XRAUDIO_DEVICE_INPUT_NONE) {
+      // External source, set frame vars
+      frame_buffer      = session->external_frame_buffer;
+      frame_size        = session->external_frame_size_out;
+      frame_group_index = session->external_frame_group_index;
+   } else {
+      uint8_t chan = 0;
+      #if defined(XRAUDIO_KWD_ENABLED)
+      if(params->dsp_config.input_asr_max_channel_qty == 0) {
+         chan = session->keyword_detector.active_chan;
+      }
+      #endif
+
+      // Local source, set frame vars
+      frame_buffer      = (uint8_t *)&session->frame_buffer_int16[chan].frames[0];
+      frame_size        = instance->frame_size_out;
+      frame_group_index = session->frame_group_index;
+   }
+
+   if(frame_group_index >= instance->frame_group_qty) {
+      size_t data_size = frame_size * frame_group_index;
+      if(!instance->audio_buf_circular && instance->audio_buf_index + data_size > (instance->audio_buf_sample_qty * instance->format_out.sample_size)) {
+         XLOGD_DEBUG("End of buffer reached");
+
+         if(instance->callback != NULL){
+            xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, source, AUDIO_IN_CALLBACK_EVENT_END_OF_BUFFER, NULL, instance->param);
+         }
+         instance->audio_buf_samples    = NULL;
+         instance->audio_buf_sample_qty = 0;
+         instance->audio_buf_index      = 0;
+      } else {
+         unsigned long sample_index = instance->audio_buf_index / instance->format_out.sample_size;
+         xraudio_sample_t *samples    = (xraudio_sample_t *)frame_buffer;
+         #ifdef XRAUDIO_DGA_ENABLED
+         if(instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
+            uint8_t chan = 0;
+            #if defined(XRAUDIO_KWD_ENABLED)
+            if(params->dsp_config.input_asr_max_channel_qty == 0) {
+               chan = session->keyword_detector.active_chan;
+            }
+            #endif
+            float* frame_buffer_fp32 = &session->frame_buffer_fp32[chan].frames[0].samples[0];
+            uint32_t sample_qty = data_size / sizeof(float);
+            // Apply gain to group of audio frames
+            xraudio_in_dga_apply(session->obj_dga, frame_buffer_fp32, sample_qty * frame_group_index);
+            // Convert float to int16
+            xraudio_samples_convert_fp32_int16(samples, frame_buffer_fp32, sample_qty * frame_group_index, instance->dynamic_gain_pcm_bit_qty);
+         }
+         #endif
+
+         if(instance->audio_buf_circular) {
+            xraudio_in_write_to_memory_ring(params->obj_input, source, instance, samples, data_size / instance->format_out.sample_size);
+         } else {
+            memcpy(&instance->audio_buf_samples[sample_index], samples, data_size);
+
+            instance->audio_buf_index += data_size;
+         }
+      }
+   }
+
+   return(frame_size);
+}
+
+void xraudio_in_write_to_memory_ring(xraudio_input_object_t obj_input, xraudio_devices_input_t source, xraudio_session_record_inst_t *instance, const xraudio_sample_t *samples, uint32_t sample_qty) {
+   uint32_t buf_sample_qty = instance->audio_buf_sample_qty;
+   uint32_t sample_index   = instance->audio_buf_index / instance->format_out.sample_size;
+
+   if(sample_qty > buf_sample_qty) { // Only the most recent samples fit in the buffer
+      samples     += sample_qty - buf_sample_qty;
+      sample_qty   = buf_sample_qty;
+   }
+   uint32_t sample_qty_head = buf_sample_qty - sample_index;
+   if(sample_qty_head > sample_qty) {
+      sample_qty_head = sample_qty;
+   }
+   memcpy(&instance->audio_buf_samples[sample_index], samples, sample_qty_head * sizeof(xraudio_sample_t));
+   if(sample_qty_head < sample_qty) {
+      memcpy(&instance->audio_buf_samples[0], &samples[sample_qty_head], (sample_qty - sample_qty_head) * sizeof(xraudio_sample_t));
+   }
+
+   sample_index += sample_qty;
+   if(sample_index >= buf_sample_qty) {
+      sample_index                -= buf_sample_qty;
+      instance->audio_buf_wrapped  = true;
+   }
+   instance->audio_buf_index = sample_index * instance->format_out.sample_size;
+
+   // Publish the write index after the samples are in the buffer
+   xraudio_input_memory_ring_index_set(obj_input, source, instance->audio_buf_wrapped ? sample_index + buf_sample_qty : sample_index);
+}
+
+void xraudio_in_governor_update(xraudio_main_thread_params_t *params, xraudio_session_record_t *session, uint64_t timestamp_begin, bool overrun) {
+   if(session->obj_governor == NULL) {
+      return;
+   }
+   uint32_t frame_time_us = (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_begin);
+   xraudio_shed_level_t level_prev = session->shed_level;
+
+   session->shed_level = xraudio_governor_update(session->obj_governor, frame_time_us, overrun);
+
+   xraudio_governor_stats_t stats;
+   xraudio_governor_stats_read(session->obj_governor, &stats);
+   xraudio_atomic_int_set(&g_governor_level,       stats.level);
+   xraudio_atomic_int_set(&g_governor_change_qty,  stats.change_qty);
+   xraudio_atomic_int_set(&g_governor_overrun_qty, stats.overrun_qty);
+   xraudio_atomic_int_set(&g_governor_load_pct,    stats.load_pct);
+   xraudio_atomic_int_set(&g_governor_level_time_ms[stats.level], stats.level_time_ms[stats.level]);
+
+   if(session->shed_level != level_prev) {
+      if(level_prev < XRAUDIO_SHED_LEVEL_METERS && session->shed_level >= XRAUDIO_SHED_LEVEL_METERS) {
+         XLOGD_WARN("sound intensity meters paused");
+      }
+      xraudio_atomic_int_set(&g_governor_level_time_ms[level_prev], stats.level_time_ms[level_prev]);
+      xraudio_dispatch_governor(params->obj_dispatch, params->governor_callback, level_prev, session->shed_level, params->governor_param);
+   }
+}
+
+void xraudio_in_governor_stats_get(xraudio_governor_stats_t *stats) {
+   stats->level       = (xraudio_shed_level_t)xraudio_atomic_int_get(&g_governor_level);
+   stats->change_qty  = (uint32_t)xraudio_atomic_int_get(&g_governor_change_qty);
+   stats->overrun_qty = (uint32_t)xraudio_atomic_int_get(&g_governor_overrun_qty);
+   stats->load_pct    = (uint32_t)xraudio_atomic_int_get(&g_governor_load_pct);
+   for(uint32_t level = 0; level < XRAUDIO_SHED_LEVEL_INVALID; level++) {
+      stats->level_time_ms[level] = (uint32_t)xraudio_atomic_int_get(&g_governor_level_time_ms[level]);
+   }
+}
+
+bool xraudio_in_channels_create(xraudio_session_record_t *session, xraudio_main_thread_params_t *params) {
+   uint8_t  mic_qty       = xraudio_devices_input_mic_qty(params->input_devices, params->input_mic_qty);
+   uint8_t  ec_ref_qty    = xraudio_devices_input_ec_ref_qty(params->input_devices);
+   uint8_t  chan_qty      = mic_qty + ec_ref_qty;
+   uint32_t out_qty       = XRAUDIO_INPUT_FRAME_SAMPLE_QTY * XRAUDIO_INPUT_MAX_FRAME_GROUP_QTY; // output samples per channel in a frame group
+   uint32_t frame_bytes   = sizeof(xraudio_audio_group_int16_t) + sizeof(xraudio_audio_group_float_t) + (out_qty * sizeof(int32_t));
+   uint8_t  keyword_qty   = 0;
+   uint32_t keyword_bytes = 0;
+
+   if(chan_qty == 0) {
+      chan_qty = 1;
+   }
+   session->frame_buffer_int16 = (xraudio_audio_group_int16_t *)calloc(chan_qty, sizeof(xraudio_audio_group_int16_t));
+   session->frame_buffer_fp32  = (xraudio_audio_group_float_t *)calloc(chan_qty, sizeof(xraudio_audio_group_float_t));
+   session->frame_buffer_out   = (xraudio_audio_buffer_out_t *)malloc(sizeof(xraudio_audio_buffer_out_t) + (chan_qty * out_qty * sizeof(int32_t))); // also holds an int16 frame group for framed user streams
+   session->channel_time_us    = (uint32_t *)calloc((mic_qty > 0) ? mic_qty : 1, sizeof(uint32_t));
+   session->channel_cost_us    = (uint32_t *)calloc((mic_qty > 0) ? mic_qty : 1, sizeof(uint32_t));
+
+   #ifdef XRAUDIO_KWD_ENABLED
+   keyword_qty   = params->dsp_config.input_asr_max_channel_qty + params->dsp_config.input_kwd_max_channel_qty;
+   keyword_bytes = sizeof(xraudio_keyword_detector_chan_t);
+   session->keyword_detector.channels = (xraudio_keyword_detector_chan_t *)calloc((keyword_qty > 0) ? keyword_qty : 1, keyword_bytes); // the active channel is always valid
+   if(session->keyword_detector.channels == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      xraudio_in_channels_destroy(session);
+      return(false);
+   }
+   #endif
+   if(session->frame_buffer_int16 == NULL || session->frame_buffer_fp32 == NULL || session->frame_buffer_out == NULL || session->channel_time_us == NULL || session->channel_cost_us == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      xraudio_in_channels_destroy(session);
+      return(false);
+   }
+   session->frame_buffer_chan_qty       = chan_qty;
+   session->frame_buffer_out_sample_qty = chan_qty * out_qty;
+   session->channel_mic_qty             = mic_qty;
+
+   uint32_t memory_bytes = (chan_qty * frame_bytes) + (keyword_qty * keyword_bytes);
+   xraudio_atomic_int_set(&g_channel_mic_qty,       mic_qty);
+   xraudio_atomic_int_set(&g_channel_ec_ref_qty,    ec_ref_qty);
+   xraudio_atomic_int_set(&g_channel_keyword_qty,   keyword_qty);
+   xraudio_atomic_int_set(&g_channel_frame_bytes,   frame_bytes);
+   xraudio_atomic_int_set(&g_channel_keyword_bytes, keyword_bytes);
+   xraudio_atomic_int_set(&g_channel_memory_bytes,  memory_bytes);
+   for(uint8_t chan = 0; chan < XRAUDIO_INPUT_MAX_CHANNEL_QTY; chan++) {
+      xraudio_atomic_int_set(&g_channel_time_us[chan], 0);
+   }
+   XLOGD_INFO("mic <%u> ec ref <%u> keyword <%u> channels - frame <%u> keyword <%u> total <%u> bytes", mic_qty, ec_ref_qty, keyword_qty, frame_bytes, keyword_bytes, memory_bytes);
+   return(true);
+}
+
+void xraudio_in_channels_destroy(xraudio_session_record_t *session) {
+   if(session->frame_buffer_int16 != NULL) {
+      free(session->frame_buffer_int16);
+      session->frame_buffer_int16 = NULL;
+   }
+   if(session->frame_buffer_fp32 != NULL) {
+      free(session->frame_buffer_fp32);
+      session->frame_buffer_fp32 = NULL;
+   }
+   if(session->frame_buffer_out != NULL) {
+      free(session->frame_buffer_out);
+      session->frame_buffer_out = NULL;
+   }
+   if(session->channel_time_us != NULL) {
+      free(session->channel_time_us);
+      session->channel_time_us = NULL;
+   }
+   if(session->channel_cost_us != NULL) {
+      free(session->channel_cost_us);
+      session->channel_cost_us = NULL;
+   }
+   session->frame_buffer_chan_qty       = 0;
+   session->frame_buffer_out_sample_qty = 0;
+   session->channel_mic_qty             = 0;
+   #ifdef XRAUDIO_KWD_ENABLED
+   if(session->keyword_detector.channels != NULL) {
+      free(session->keyword_detector.channels);
+      session->keyword_detector.channels = NULL;
+   }
+   #endif
+}
+
+void xraudio_in_channel_time_add(xraudio_session_record_t *session, uint8_t chan, uint64_t timestamp_begin) {
+   if(chan < session->channel_mic_qty) {
+      session->channel_time_us[chan] += (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_begin);
+   }
+}
+
+void xraudio_in_channel_cost_update(xraudio_session_record_t *session, uint8_t chan_qty_mic) {
+   for(uint8_t chan = 0; chan < chan_qty_mic && chan < session->channel_mic_qty; chan++) {
+      uint32_t time_us = session->channel_time_us[chan];
+      session->channel_cost_us[chan] = (session->channel_cost_us[chan] == 0) ? time_us : (session->channel_cost_us[chan] * 7 + time_us) / 8;
+      session->channel_time_us[chan] = 0;
+      if(chan < XRAUDIO_INPUT_MAX_CHANNEL_QTY) { // reported channels
+         xraudio_atomic_int_set(&g_channel_time_us[chan], session->channel_cost_us[chan]);
+      }
+   }
+}
+
+void xraudio_in_channel_report_get(xraudio_input_channel_report_t *report) {
+   report->mic_qty              = (uint8_t)xraudio_atomic_int_get(&g_channel_mic_qty);
+   report->ec_ref_qty           = (uint8_t)xraudio_atomic_int_get(&g_channel_ec_ref_qty);
+   report->keyword_chan_qty     = (uint8_t)xraudio_atomic_int_get(&g_channel_keyword_qty);
+   report->frame_memory_bytes   = (uint32_t)xraudio_atomic_int_get(&g_channel_frame_bytes);
+   report->keyword_memory_bytes = (uint32_t)xraudio_atomic_int_get(&g_channel_keyword_bytes);
+   report->memory_bytes         = (uint32_t)xraudio_atomic_int_get(&g_channel_memory_bytes);
+   for(uint8_t chan = 0; chan < XRAUDIO_INPUT_MAX_CHANNEL_QTY; chan++) {
+      report->time_us[chan] = (uint32_t)xraudio_atomic_int_get(&g_channel_time_us[chan]);
+   }
+}
+
+uint8_t xraudio_in_idle_frame_qty(xraudio_thread_state_t *state) {
+   xraudio_session_record_t *session = &state->record;
+
+   if(session->idle_frame_qty <= 1 || !session->recording || session->fd >= 0 || (state->playback.hal_output_obj != NULL && !state->playback.standby)) { // HAL signals each frame or speaker is playing on the same timer
+      return(1);
+   }
+   #ifdef XRAUDIO_KWD_ENABLED
+   if(session->keyword_detector.triggered) {
+      return(1);
+   }
+   #endif
+   for(uint32_t group = XRAUDIO_INPUT_SESSION_GROUP_DEFAULT; group < XRAUDIO_INPUT_SESSION_GROUP_QTY; group++) {
+      if(session->instances[group].record_callback != NULL) { // Streaming
+         return(1);
+      }
+   }
+   return(session->idle_frame_qty);
+}
+
+void xraudio_in_process_account(xraudio_session_record_t *session, xraudio_input_process_mode_t mode, uint64_t timestamp_begin) {
+   uint64_t timestamp_end = xraudio_in_frame_timestamp_get();
+
+   if(session->process_timestamp != 0 && timestamp_begin > session->process_timestamp) { // The interval since the previous wakeup was scheduled in its mode
+      xraudio_in_process_time_add(&g_process_time_ms[session->process_mode], &session->process_time_us[session->process_mode], timestamp_begin - session->process_timestamp);
+   }
+   if(mode != session->process_mode) {
+      XLOGD_INFO("process mode <%s> to <%s>", xraudio_input_process_mode_str(session->process_mode), xraudio_input_process_mode_str(mode));
+   }
+   session->process_mode       = mode;
+   session->process_timestamp  = timestamp_begin;
+   xraudio_in_process_time_add(&g_process_busy_ms[mode], &session->process_busy_us[mode], (timestamp_end > timestamp_begin) ? timestamp_end - timestamp_begin : 0);
+   xraudio_atomic_int_add(&g_process_wakeup_qty[mode], 1);
+
+   xraudio_atomic_int_set(&g_process_mode,           mode);
+   xraudio_atomic_int_set(&g_process_idle_frame_qty, session->idle_frame_qty);
+}
+
+// Add the whole milliseconds of the elapsed time to the report and carry the remainder to the next wakeup
+void xraudio_in_process_time_add(xraudio_atomic_int_t *time_ms, uint32_t *time_us, uint64_t elapsed_us) {
+   uint64_t total_us = *time_us + elapsed_us;
+
+   *time_us = (uint32_t)(total_us % 1000);
+   if(total_us >= 1000) {
+      xraudio_atomic_int_add(time_ms, (int)(total_us / 1000));
+   }
+}
+
+// Read and clear the value
+int xraudio_in_atomic_int_take(xraudio_atomic_int_t *atomic) {
+   int current;
+   do {
+      current = xraudio_atomic_int_get(atomic);
+   } while(!xraudio_atomic_compare_and_set(atomic, current, 0));
+   return(current);
+}
+
+void xraudio_in_suspend_update(xraudio_thread_state_t *state) {
+   xraudio_session_record_t *session = &state->record;
+   bool suspend = session->privacy_mode && session->recording && XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input) != XRAUDIO_DEVICE_INPUT_NONE;
+
+   #ifdef XRAUDIO_KWD_ENABLED
+   if(session->keyword_detector.triggered) { // Detection is pending
+      suspend = false;
+   }
+   #endif
+   for(uint32_t group = XRAUDIO_INPUT_SESSION_GROUP_DEFAULT; group < XRAUDIO_INPUT_SESSION_GROUP_QTY; group++) {
+      if(session->instances[group].record_callback != NULL) { // Streaming
+         suspend = false;
+      }
+   }
+
+   if(suspend && !session->suspended) {
+      xraudio_in_suspend(state);
+   } else if(!suspend && session->suspended) {
+      xraudio_in_resume(state);
+   }
+}
+
+void xraudio_in_suspend(xraudio_thread_state_t *state) {
+   xraudio_session_record_t *session = &state->record;
+
+   #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_keyword_detector_suspend(&session->keyword_detector);
+   #endif
+
+   // The frame buffers stay allocated so neither suspend nor resume touches the heap on this thread
+   if(state->timer_id_frame != RDXK_TIMER_ID_INVALID && state->playback.hal_output_obj == NULL) { // The speaker keeps the timer running
+      if(!rdkx_timer_remove(state->timer_obj, state->timer_id_frame)) {
+         XLOGD_ERROR("timer remove");
+      }
+      state->timer_id_frame = RDXK_TIMER_ID_INVALID;
+   }
+
+   session->suspended         = true;
+   session->suspend_timestamp = xraudio_in_frame_timestamp_get();
+   session->process_timestamp = 0; // the suspension is not counted in the processing modes
+   session->suspend_qty++;
+
+   xraudio_atomic_int_set(&g_privacy_suspend_begin_ms, (int)(uint32_t)(session->suspend_timestamp / 1000));
+   xraudio_atomic_int_set(&g_privacy_suspend_qty,      (int)session->suspend_qty);
+   xraudio_atomic_int_set(&g_privacy_memory_bytes,     0);
+   xraudio_atomic_int_set(&g_privacy_suspended,        1);
+
+   XLOGD_INFO("input suspended");
+}
+
+void xraudio_in_resume(xraudio_thread_state_t *state) {
+   xraudio_session_record_t *session = &state->record;
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+
+   session->suspended        = false;
+   session->suspend_time_us += timestamp_begin - session->suspend_timestamp;
+
+   #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_keyword_detector_resume(&session->keyword_detector);
+   #endif
+
+   // Audio resumes without the history from before the suspension
+   session->frame_group_index = 0;
+   session->idle_backlog_qty  = 0;
+   memset(&session->doa, 0, sizeof(session->doa));
+   if(session->obj_doa != NULL) {
+      xraudio_doa_reset(session->obj_doa);
+   }
+   if(session->obj_decimator != NULL) {
+      xraudio_decimator_reset(session->obj_decimator);
+   }
+
+   if(session->recording && session->fd < 0) {
+      rdkx_timestamp_get(&session->timestamp_next);
+      if(state->timer_id_frame == RDXK_TIMER_ID_INVALID) {
+         state->timer_id_frame = rdkx_timer_insert(state->timer_obj, session->timestamp_next, timer_frame_process, state);
+      }
+   }
+
+   uint32_t resume_time_us = (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_begin);
+   if(resume_time_us > session->resume_time_max_us) {
+      session->resume_time_max_us = resume_time_us;
+   }
+   xraudio_atomic_int_set(&g_privacy_suspend_time_ms,    (int)(session->suspend_time_us / 1000));
+   xraudio_atomic_int_set(&g_privacy_resume_time_us,     (int)resume_time_us);
+   xraudio_atomic_int_set(&g_privacy_resume_time_max_us, (int)session->resume_time_max_us);
+   xraudio_atomic_int_set(&g_privacy_suspended,          0);
+
+   XLOGD_INFO("input resumed in <%u> us", resume_time_us);
+}
+
+void xraudio_in_privacy_report_get(xraudio_privacy_report_t *report) {
+   report->suspended             = xraudio_atomic_int_get(&g_privacy_suspended) ? true : false;
+   report->suspend_qty           = (uint32_t)xraudio_atomic_int_get(&g_privacy_suspend_qty);
+   report->suspend_time_ms       = (uint32_t)xraudio_atomic_int_get(&g_privacy_suspend_time_ms);
+   report->wakeup_qty            = (uint32_t)xraudio_atomic_int_get(&g_privacy_wakeup_qty);
+   report->memory_released_bytes = (uint32_t)xraudio_atomic_int_get(&g_privacy_memory_bytes);
+   report->resume_time_us        = (uint32_t)xraudio_atomic_int_get(&g_privacy_resume_time_us);
+   report->resume_time_max_us    = (uint32_t)xraudio_atomic_int_get(&g_privacy_resume_time_max_us);
+   if(report->suspended) { // Add the current suspension
+      report->suspend_time_ms += (uint32_t)(xraudio_in_frame_timestamp_get() / 1000) - (uint32_t)xraudio_atomic_int_get(&g_privacy_suspend_begin_ms);
+   }
+}
+
+void xraudio_in_power_report_get(xraudio_input_power_report_t *report) {
+   report->mode           = (xraudio_input_process_mode_t)xraudio_atomic_int_get(&g_process_mode);
+   report->idle_frame_qty = (uint8_t)xraudio_atomic_int_get(&g_process_idle_frame_qty);
+   for(uint32_t mode = XRAUDIO_INPUT_PROCESS_MODE_FRAME; mode < XRAUDIO_INPUT_PROCESS_MODE_INVALID; mode++) {
+      report->wakeup_qty[mode]      = (uint32_t)xraudio_in_atomic_int_take(&g_process_wakeup_qty[mode]);
+      report->time_ms[mode]         = (uint32_t)xraudio_in_atomic_int_take(&g_process_time_ms[mode]);
+      report->busy_ms[mode]         = (uint32_t)xraudio_in_atomic_int_take(&g_process_busy_ms[mode]);
+      report->wakeups_per_sec[mode] = (report->time_ms[mode] > 0) ? (report->wakeup_qty[mode] * 1000.0) / report->time_ms[mode] : 0.0;
+      report->residency_pct[mode]   = (report->time_ms[mode] > 0) ? (report->busy_ms[mode] * 100.0) / report->time_ms[mode] : 0.0;
+   }
+}
+
+void xraudio_in_dsp_state_report_get(xraudio_dsp_state_report_t *report) {
+   for(uint32_t plugin = XRAUDIO_DSP_PLUGIN_EOS; plugin < XRAUDIO_DSP_PLUGIN_INVALID; plugin++) {
+      report->save_qty[plugin]        = (uint32_t)xraudio_atomic_int_get(&g_dsp_save_qty[plugin]);
+      report->restore_qty[plugin]     = (uint32_t)xraudio_atomic_int_get(&g_dsp_restore_qty[plugin]);
+      report->reject_qty[plugin]      = (uint32_t)xraudio_atomic_int_get(&g_dsp_reject_qty[plugin]);
+      report->size_bytes[plugin]      = (uint32_t)xraudio_atomic_int_get(&g_dsp_size_bytes[plugin]);
+      report->restore_time_us[plugin] = (uint32_t)xraudio_atomic_int_get(&g_dsp_restore_time_us[plugin]);
+   }
+}
 
-   uint32_t size = sample_qty * sizeof(float);
-   memcpy(&keyword_detector_chan->pre_detection_buffer_fp32[keyword_detector_chan->pd_index_write], frame_buffer_fp32, size);
-   if(keyword_detector_chan->pd_sample_qty < sizeof(keyword_detector_chan->pre_detection_buffer_fp32) / sizeof(float)) {
-      keyword_detector_chan->pd_sample_qty += sample_qty;
+void xraudio_dsp_state_save(xraudio_thread_state_t *state) {
+   if(state->params.obj_input != NULL) { // EOS and preprocess
+      xraudio_input_dsp_state_save(state->params.obj_input);
    }
-   keyword_detector_chan->pd_index_write += sample_qty;
-   if(keyword_detector_chan->pd_index_write >= sizeof(keyword_detector_chan->pre_detection_buffer_fp32) / sizeof(float)) {
-      keyword_detector_chan->pd_index_write = 0;
+   #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_keyword_detector_t *detector = &state->record.keyword_detector;
+   if(detector->active && !detector->suspended && detector->instance_qty > 0) {
+      xraudio_keyword_detector_state_save(detector);
    }
+   #endif
+   #if defined(XRAUDIO_DGA_ENABLED) && defined(XRAUDIO_DSP_STATE_ENABLED)
+   xraudio_dsp_snapshot_save(state->params.dsp_snapshot_dga, XRAUDIO_DSP_PLUGIN_DGA, state->record.obj_dga, xraudio_dga_snapshot_size, xraudio_dga_snapshot_save);
+   #endif
 }
 
-uint32_t xraudio_keyword_detector_session_pd_avail(xraudio_keyword_detector_t *detector, uint8_t active_chan) {
-   return(detector->channels[active_chan].pd_sample_qty);
+void xraudio_dsp_state_restore(xraudio_thread_state_t *state) {
+   if(state->params.obj_input != NULL) {
+      xraudio_input_dsp_state_restore(state->params.obj_input);
+   }
+   #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_keyword_detector_t *detector = &state->record.keyword_detector;
+   if(detector->active && !detector->suspended && detector->instance_qty > 0) {
+      xraudio_keyword_detector_state_restore(detector);
+   }
+   #endif
+   #if defined(XRAUDIO_DGA_ENABLED) && defined(XRAUDIO_DSP_STATE_ENABLED)
+   xraudio_dsp_snapshot_restore(state->params.dsp_snapshot_dga, XRAUDIO_DSP_PLUGIN_DGA, state->record.obj_dga, xraudio_dga_snapshot_restore);
+   #endif
 }
 
-#endif
+bool xraudio_dsp_snapshot_save(xraudio_dsp_snapshot_t *snapshot, xraudio_dsp_plugin_t plugin, void *object, xraudio_dsp_snapshot_size_t size_get, xraudio_dsp_snapshot_save_t save) {
+   if(snapshot == NULL || object == NULL) {
+      return(false);
+   }
+   snapshot->size = 0;
 
-int xraudio_in_write_to_memory(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance) {
-   uint8_t *frame_buffer      = NULL;
-   uint32_t frame_size        = 0;
-   uint8_t  frame_group_index = 0;
-   if(source != instance->source) {
-      XLOGD_DEBUG("different source is being recorded");
-      return(0);
+   uint32_t size = (*size_get)(object);
+   if(size == 0) { // The plugin does not support snapshots
+      return(false);
    }
-   if(XRAUDIO_DEVICE_INPUT_EXTERNAL_GET(source) != XRAUDIO_DEVICE_INPUT_NONE) {
-      // External source, set frame vars
-      frame_buffer      = session->external_frame_buffer;
-      frame_size        = session->external_frame_size_out;
-      frame_group_index = session->external_frame_group_index;
-   } else {
-      uint8_t chan = 0;
-      #if defined(XRAUDIO_KWD_ENABLED)
-      if(params->dsp_config.input_asr_max_channel_qty == 0) {
-         chan = session->keyword_detector.active_chan;
+   if(size > snapshot->capacity) {
+      void *data = realloc(snapshot->data, size);
+      if(data == NULL) {
+         XLOGD_ERROR("unable to allocate <%u> bytes for <%s> state", size, xraudio_dsp_plugin_str(plugin));
+         return(false);
       }
-      #endif
+      snapshot->data     = data;
+      snapshot->capacity = size;
+   }
+   if(!(*save)(object, snapshot->data, size)) {
+      XLOGD_WARN("unable to save <%s> state", xraudio_dsp_plugin_str(plugin));
+      return(false);
+   }
+   snapshot->size = size;
 
-      // Local source, set frame vars
-      frame_buffer      = (uint8_t *)&session->frame_buffer_int16[chan].frames[0];
-      frame_size        = instance->frame_size_out;
-      frame_group_index = session->frame_group_index;
+   xraudio_atomic_int_add(&g_dsp_save_qty[plugin],   1);
+   xraudio_atomic_int_set(&g_dsp_size_bytes[plugin], (int)size);
+   XLOGD_DEBUG("<%s> state saved <%u> bytes", xraudio_dsp_plugin_str(plugin), size);
+   return(true);
+}
+
+bool xraudio_dsp_snapshot_restore(xraudio_dsp_snapshot_t *snapshot, xraudio_dsp_plugin_t plugin, void *object, xraudio_dsp_snapshot_restore_t restore) {
+   if(snapshot == NULL || object == NULL || snapshot->size == 0) {
+      return(false);
    }
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+   bool restored = (*restore)(object, snapshot->data, snapshot->size);
+   uint32_t restore_time_us = (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_begin);
 
-   if(frame_group_index >= instance->frame_group_qty) {
-      if(instance->audio_buf_index + (frame_size * frame_group_index) > (instance->audio_buf_sample_qty * instance->format_out.sample_size * frame_group_index)) {
-         XLOGD_DEBUG("End of buffer reached");
+   snapshot->size = 0; // A snapshot is only restored once
 
-         if(instance->callback != NULL){
-            (*instance->callback)(source, AUDIO_IN_CALLBACK_EVENT_END_OF_BUFFER, NULL, instance->param);
-         }
-         instance->audio_buf_samples    = NULL;
-         instance->audio_buf_sample_qty = 0;
-         instance->audio_buf_index      = 0;
-      } else {
-         unsigned long sample_index = instance->audio_buf_index / instance->format_out.sample_size;
-         size_t            data_size  = frame_size * frame_group_index;
-         xraudio_sample_t *samples    = (xraudio_sample_t *)frame_buffer;
-         #ifdef XRAUDIO_DGA_ENABLED
-         if(instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
-            uint8_t chan = 0;
-            #if defined(XRAUDIO_KWD_ENABLED)
-            if(params->dsp_config.input_asr_max_channel_qty == 0) {
-               chan = session->keyword_detector.active_chan;
-            }
-            #endif
-            float* frame_buffer_fp32 = &session->frame_buffer_fp32[chan].frames[0].samples[0];
-            uint32_t sample_qty = data_size / sizeof(float);
-            // Apply gain to group of audio frames
-            xraudio_dga_apply(session->obj_dga, frame_buffer_fp32, sample_qty * frame_group_index);
-            // Convert float to int16
-            xraudio_samples_convert_fp32_int16(samples, frame_buffer_fp32, sample_qty * frame_group_index, instance->dynamic_gain_pcm_bit_qty);
-         }
-         #endif
+   if(!restored) {
+      XLOGD_WARN("<%s> state rejected", xraudio_dsp_plugin_str(plugin));
+      xraudio_atomic_int_add(&g_dsp_reject_qty[plugin], 1);
+      return(false);
+   }
+   xraudio_atomic_int_add(&g_dsp_restore_qty[plugin],     1);
+   xraudio_atomic_int_set(&g_dsp_restore_time_us[plugin], (int)restore_time_us);
+   XLOGD_INFO("<%s> state restored in <%u> us", xraudio_dsp_plugin_str(plugin), restore_time_us);
+   return(true);
+}
+
+void xraudio_dsp_snapshot_free(xraudio_dsp_snapshot_t *snapshot) {
+   if(snapshot->data != NULL) {
+      free(snapshot->data);
+      snapshot->data = NULL;
+   }
+   snapshot->capacity = 0;
+   snapshot->size     = 0;
+}
 
-         memcpy(&instance->audio_buf_samples[sample_index], samples, data_size);
+bool xraudio_in_detect_reload_begin(void) {
+   return(xraudio_atomic_compare_and_set(&g_detect_reload_in_progress, 0, 1));
+}
 
-         instance->audio_buf_index += (frame_size * frame_group_index);
-      }
+void xraudio_in_detect_reload_end(xraudio_result_t result, uint32_t load_time_ms, uint32_t swap_delay_us, uint32_t swap_time_us) {
+   xraudio_atomic_int_set(&g_detect_reload_result,        result);
+   xraudio_atomic_int_set(&g_detect_reload_load_time_ms,  load_time_ms);
+   xraudio_atomic_int_set(&g_detect_reload_swap_delay_us, swap_delay_us);
+   xraudio_atomic_int_set(&g_detect_reload_swap_time_us,  swap_time_us);
+   if(result == XRAUDIO_RESULT_OK) {
+      xraudio_atomic_int_add(&g_detect_reload_qty, 1);
    }
+   xraudio_atomic_int_set(&g_detect_reload_in_progress, 0);
+}
 
-   return(frame_size);
+void xraudio_in_detect_reload_status_get(xraudio_detect_reload_status_t *status) {
+   status->in_progress   = (xraudio_atomic_int_get(&g_detect_reload_in_progress) != 0);
+   status->result        = (xraudio_result_t)xraudio_atomic_int_get(&g_detect_reload_result);
+   status->reload_qty    = (uint32_t)xraudio_atomic_int_get(&g_detect_reload_qty);
+   status->load_time_ms  = (uint32_t)xraudio_atomic_int_get(&g_detect_reload_load_time_ms);
+   status->swap_delay_us = (uint32_t)xraudio_atomic_int_get(&g_detect_reload_swap_delay_us);
+   status->swap_time_us  = (uint32_t)xraudio_atomic_int_get(&g_detect_reload_swap_time_us);
+}
+
+void xraudio_in_speculative_stats_get(xraudio_stream_speculative_stats_t *stats) {
+   stats->tentative_qty = (uint32_t)xraudio_atomic_int_get(&g_speculative_tentative_qty);
+   stats->hit_qty       = (uint32_t)xraudio_atomic_int_get(&g_speculative_hit_qty);
+   stats->retract_qty   = (uint32_t)xraudio_atomic_int_get(&g_speculative_retract_qty);
+   stats->lead_ms_total = (uint32_t)xraudio_atomic_int_get(&g_speculative_lead_ms_total);
 }
 
 int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance) {
@@ -2963,31 +5162,40 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
 
          if(chunk_1_sample_qty) {
             #ifdef XRAUDIO_DGA_ENABLED
-            if(instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
-               xraudio_dga_apply(session->obj_dga, chunk_1_samples_fp32, chunk_1_sample_qty);
+            if(!instance->sample_convert && instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
+               xraudio_in_dga_apply(session->obj_dga, chunk_1_samples_fp32, chunk_1_sample_qty);
                bit_qty = instance->dynamic_gain_pcm_bit_qty;
             }
             #endif
+            if(instance->sample_convert) {
+               xraudio_in_pre_detection_write_converted(source, session, instance, chunk_1_samples_fp32, chunk_1_sample_qty, session->frame_group_timestamp - ((uint64_t)(chunk_1_sample_qty + chunk_2_sample_qty) * 1000000 / session->format_in.sample_rate));
+            }
             int16_t *chunk_1_samples_int16 = (int16_t *)chunk_1_samples_fp32; // use same buffer
 
             // Convert float to int16
             xraudio_samples_convert_fp32_int16(chunk_1_samples_int16, chunk_1_samples_fp32, chunk_1_sample_qty, bit_qty);
 
             uint32_t size = chunk_1_sample_qty * sizeof(int16_t);
-            for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
-               if(instance->fifo_audio_data[index] < 0) {
-                  break;
+            if(!instance->sample_convert) { // Converted samples were written above
+               xraudio_stream_frame_header_t header;
+               if(instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) {
+                  xraudio_in_frame_header_init(instance, &header, 0, session->frame_group_timestamp - ((uint64_t)(chunk_1_sample_qty + chunk_2_sample_qty) * 1000000 / session->format_in.sample_rate), chunk_1_sample_qty, size);
                }
-               errno = 0;
-               rc = write(instance->fifo_audio_data[index], chunk_1_samples_int16, size);
-               if(rc != (int)size) {
-                  int errsv = errno;
-                  if(errsv == EAGAIN || errsv == EWOULDBLOCK) { // Data is lost due to insufficient space in the pipe
-                     if(instance->callback != NULL){
-                        (*instance->callback)(source, AUDIO_IN_CALLBACK_EVENT_OVERFLOW, NULL, instance->param);
+               for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
+                  if(instance->fifo_audio_data[index] < 0) {
+                     break;
+                  }
+                  errno = 0;
+                  rc = xraudio_in_frame_write_fifo(instance, index, (instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) ? &header : NULL, chunk_1_samples_int16, size);
+                  if(rc != (int)size) {
+                     int errsv = errno;
+                     if(errsv == EAGAIN || errsv == EWOULDBLOCK) { // Data is lost due to insufficient space in the pipe
+                        if(instance->callback != NULL){
+                           xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, source, AUDIO_IN_CALLBACK_EVENT_OVERFLOW, NULL, instance->param);
+                        }
+                     } else {
+                        XLOGD_ERROR("unable to write fifo <%d> <%s>", instance->fifo_audio_data[index], strerror(errsv));
                      }
-                  } else {
-                     XLOGD_ERROR("unable to write fifo <%d> <%s>", instance->fifo_audio_data[index], strerror(errsv));
                   }
                }
             }
@@ -3006,32 +5214,41 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
          }
          if(chunk_2_sample_qty) {
             #ifdef XRAUDIO_DGA_ENABLED
-            if(instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
-               xraudio_dga_apply(session->obj_dga, chunk_2_samples_fp32, chunk_2_sample_qty);
+            if(!instance->sample_convert && instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
+               xraudio_in_dga_apply(session->obj_dga, chunk_2_samples_fp32, chunk_2_sample_qty);
                bit_qty = instance->dynamic_gain_pcm_bit_qty;
             }
             #endif
+            if(instance->sample_convert) {
+               xraudio_in_pre_detection_write_converted(source, session, instance, chunk_2_samples_fp32, chunk_2_sample_qty, session->frame_group_timestamp - ((uint64_t)chunk_2_sample_qty * 1000000 / session->format_in.sample_rate));
+            }
             int16_t *chunk_2_samples_int16 = (int16_t *)chunk_2_samples_fp32; // use same buffer
 
             // Convert float to int16
             xraudio_samples_convert_fp32_int16(chunk_2_samples_int16, chunk_2_samples_fp32, chunk_2_sample_qty, bit_qty);
 
             uint32_t size = chunk_2_sample_qty * sizeof(int16_t);
-            for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
-               if(instance->fifo_audio_data[index] < 0) {
-                  break;
+            if(!instance->sample_convert) { // Converted samples were written above
+               xraudio_stream_frame_header_t header;
+               if(instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) {
+                  xraudio_in_frame_header_init(instance, &header, 0, session->frame_group_timestamp - ((uint64_t)chunk_2_sample_qty * 1000000 / session->format_in.sample_rate), chunk_2_sample_qty, size);
                }
-               errno = 0;
-               rc = write(instance->fifo_audio_data[index], chunk_2_samples_int16, size);
-
-               if(rc != (int)size) {
-                  int errsv = errno;
-                  if(errsv == EAGAIN || errsv == EWOULDBLOCK) { // Data is lost due to insufficient space in the pipe
-                     if(instance->callback != NULL){
-                        (*instance->callback)(source, AUDIO_IN_CALLBACK_EVENT_OVERFLOW, NULL, instance->param);
+               for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
+                  if(instance->fifo_audio_data[index] < 0) {
+                     break;
+                  }
+                  errno = 0;
+                  rc = xraudio_in_frame_write_fifo(instance, index, (instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) ? &header : NULL, chunk_2_samples_int16, size);
+
+                  if(rc != (int)size) {
+                     int errsv = errno;
+                     if(errsv == EAGAIN || errsv == EWOULDBLOCK) { // Data is lost due to insufficient space in the pipe
+                        if(instance->callback != NULL){
+                           xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, source, AUDIO_IN_CALLBACK_EVENT_OVERFLOW, NULL, instance->param);
+                        }
+                     } else {
+                        XLOGD_ERROR("unable to write fifo <%d> <%s>", instance->fifo_audio_data[index], strerror(errsv));
                      }
-                  } else {
-                     XLOGD_ERROR("unable to write fifo <%d> <%s>", instance->fifo_audio_data[index], strerror(errsv));
                   }
                }
             }
@@ -3063,7 +5280,7 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
 
       if((instance->stream_time_min_value > 0) && (instance->stats.samples_processed >= instance->stream_time_min_value)) {
          if(instance->callback) {
-            (*instance->callback)(instance->source, AUDIO_IN_CALLBACK_EVENT_STREAM_TIME_MINIMUM, NULL, instance->param);
+            xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, instance->source, AUDIO_IN_CALLBACK_EVENT_STREAM_TIME_MINIMUM, NULL, instance->param);
          }
          instance->stream_time_min_value = 0;
       }
@@ -3072,10 +5289,15 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
          if(instance->callback != NULL) {
             xraudio_stream_keyword_info_t kwd_info;
             kwd_info.byte_qty = instance->keyword_end_samples;
-            (*instance->callback)(instance->source, AUDIO_IN_CALLBACK_EVENT_STREAM_KWD_INFO, &kwd_info, instance->param);
+            xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, instance->source, AUDIO_IN_CALLBACK_EVENT_STREAM_KWD_INFO, &kwd_info, instance->param);
          }
          instance->keyword_end_samples = 0;
          instance->keyword_flush       = true;
+         instance->frame_flags        |= XRAUDIO_STREAM_FRAME_FLAG_KEYWORD_END;
+         if(instance->latency_budget_ms > 0) { // Write the keyword end without waiting for the rest of the group
+            instance->frame_group_qty = frame_group_index;
+            instance->batch_qty       = XRAUDIO_INPUT_MIN_FRAME_GROUP_QTY;
+         }
       }
    }
 
@@ -3083,12 +5305,21 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
       if(instance->format_out.encoding == XRAUDIO_ENCODING_PCM_RAW && instance->raw_mic_frame_skip > 0) {
          instance->raw_mic_frame_skip--;
       } else {
-         size_t data_size;
-         void * data_ptr;
+         size_t   data_size;
+         void *   data_ptr;
+         uint32_t frame_qty = 1;
+         uint32_t sample_qty_out = 0;
 
          if(instance->format_out.encoding == XRAUDIO_ENCODING_PCM_RAW) {
             data_size = session->hal_mic_frame_size;
             data_ptr  = session->hal_mic_frame_ptr;
+         } else if(instance->sample_convert) { // Requested sample format and channel layout
+            uint8_t chan_qty = 0;
+            uint64_t timestamp_convert = xraudio_in_frame_timestamp_get();
+            data_size = xraudio_in_samples_out(session, instance, session->frame_buffer_out, is_external, chan, frame_group_index, &sample_qty_out, &chan_qty);
+            xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_CONVERT, timestamp_convert);
+            data_ptr  = session->frame_buffer_out->samples;
+            frame_qty = frame_group_index;
          } else if(instance->format_out.encoding == XRAUDIO_ENCODING_PCM && instance->format_out.sample_size == 4) { // 32-bit PCM
             if(instance->format_out.channel_qty > 1) { // All channels
                data_size = session->hal_mic_frame_size;
@@ -3100,6 +5331,7 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
          } else {
             data_size = frame_size_int16 * frame_group_index;
             data_ptr  = frame_buffer_int16;
+            frame_qty = frame_group_index;
 
             #ifdef XRAUDIO_DGA_ENABLED
             if(instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
@@ -3111,13 +5343,27 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
                   frame_buffer_temp[index] = frame_buffer_fp32[index];
                }
                // Apply gain to group of audio frames
-               xraudio_dga_apply(session->obj_dga, frame_buffer_temp, sample_qty);
+               xraudio_in_dga_apply(session->obj_dga, frame_buffer_temp, sample_qty);
                // Convert float to int16
                xraudio_samples_convert_fp32_int16(frame_buffer_int16, frame_buffer_temp, sample_qty, instance->dynamic_gain_pcm_bit_qty);
             }
             #endif
          }
 
+         xraudio_stream_frame_header_t header;
+         if(instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) {
+            uint32_t sample_qty = 0;
+            if(instance->sample_convert) {
+               sample_qty = sample_qty_out;
+            } else if(!is_external) {
+               sample_qty = frame_qty * (session->frame_sample_qty / session->format_in.channel_qty);
+            } else if(instance->format_out.encoding == XRAUDIO_ENCODING_PCM) {
+               sample_qty = data_size / sizeof(int16_t);
+            }
+            xraudio_in_frame_header_init(instance, &header, instance->frame_flags, is_external ? session->external_frame_group_timestamp : session->frame_group_timestamp, sample_qty, data_size);
+            instance->frame_flags = 0;
+         }
+
          for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
             //XLOGD_DEBUG("streaming channel %d", chan);
             if(instance->fifo_audio_data[index] < 0) {
@@ -3125,7 +5371,7 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
             }
             //XLOGD_INFO("src <%s> pipe <%d> size <%u> hal_mic_frame_size <%u> frame_size_out <%u>", xraudio_devices_input_str(source), instance->fifo_audio_data[index], data_size, session->hal_mic_frame_size, instance->frame_size_out);
             errno = 0;
-            rc = write(instance->fifo_audio_data[index], data_ptr, data_size);
+            rc = xraudio_in_frame_write_fifo(instance, index, (instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) ? &header : NULL, data_ptr, data_size);
 
             if(rc != (int)(data_size)) {
                int errsv = errno;
@@ -3133,7 +5379,7 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
                   // Data is lost due to insufficient space in the pipe
                   rc = 0;
                   if(instance->callback != NULL){
-                     (*instance->callback)(source, AUDIO_IN_CALLBACK_EVENT_OVERFLOW, NULL, instance->param);
+                     xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, source, AUDIO_IN_CALLBACK_EVENT_OVERFLOW, NULL, instance->param);
                   }
                } else {
                   XLOGD_ERROR("unable to write fifo %d <%s>", instance->fifo_audio_data[index], strerror(errsv));
@@ -3141,12 +5387,17 @@ int xraudio_in_write_to_pipe(xraudio_devices_input_t source, xraudio_main_thread
             } else if(flush_audio_data && instance->stream_until[index] == XRAUDIO_INPUT_RECORD_UNTIL_END_OF_KEYWORD) {
                if(instance->fifo_audio_data[index] >= 0) { // Close the write side of the pipe so the read side gets EOF
                   XLOGD_DEBUG("Close write side of pipe to send EOF to read side");
-                  close(instance->fifo_audio_data[index]);
-                  instance->fifo_audio_data[index] = -1;
+                  xraudio_in_fifo_close(instance, index);
                }
                instance->stream_until[index] = XRAUDIO_INPUT_RECORD_UNTIL_INVALID;
             }
          }
+         xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_CAPTURE_TO_DELIVERY, is_external ? session->external_frame_group_timestamp : session->frame_group_timestamp);
+
+         if(instance->sample_convert) { // Captures are in the stream's native int16 format
+            data_size = frame_size_int16 * frame_group_index;
+            data_ptr  = frame_buffer_int16;
+         }
          if(session->capture_session.active && session->capture_session.output.file.fh) {
             uint32_t sample_qty = data_size / sizeof(int16_t);
 
@@ -3173,6 +5424,8 @@ int xraudio_in_write_to_user(xraudio_devices_input_t source, xraudio_main_thread
    uint8_t *frame_buffer      = NULL;
    uint8_t  frame_group_index = 0;
    uint32_t sample_qty        = 0;
+   uint32_t frame_size        = 0;
+   uint64_t timestamp         = 0;
    if(source != instance->source) {
       XLOGD_DEBUG("different source is being recorded");
       return(0);
@@ -3183,6 +5436,8 @@ int xraudio_in_write_to_user(xraudio_devices_input_t source, xraudio_main_thread
       frame_buffer      = session->external_frame_buffer;
       frame_group_index = session->external_frame_group_index;
       sample_qty        = session->external_frame_size_out;
+      frame_size        = session->external_frame_size_out;
+      timestamp         = session->external_frame_group_timestamp;
    } else {
       uint8_t chan = 0;
       #if defined(XRAUDIO_KWD_ENABLED)
@@ -3195,13 +5450,17 @@ int xraudio_in_write_to_user(xraudio_devices_input_t source, xraudio_main_thread
       frame_buffer      = (uint8_t *)&session->frame_buffer_int16[chan].frames[0];
       frame_group_index = session->frame_group_index;
       sample_qty        = session->frame_sample_qty;
+      frame_size        = session->frame_sample_qty * sizeof(xraudio_sample_t);
+      timestamp         = session->frame_group_timestamp;
    }
 
    if(frame_group_index >= instance->frame_group_qty) {
       errno = 0;
       xraudio_sample_t *samples = (xraudio_sample_t *)frame_buffer;
+      uint64_t timestamp_callback;
+
       #ifdef XRAUDIO_DGA_ENABLED
-      if(instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
+      if(!instance->sample_convert && instance->dynamic_gain_set && params->dsp_config.dga_enabled) {
          uint8_t chan = 0;
          #if defined(XRAUDIO_KWD_ENABLED)
          if(params->dsp_config.input_asr_max_channel_qty == 0) {
@@ -3210,13 +5469,79 @@ int xraudio_in_write_to_user(xraudio_devices_input_t source, xraudio_main_thread
          #endif
          float* frame_buffer_fp32 = &session->frame_buffer_fp32[chan].frames[0].samples[0];
          // Apply gain to group of audio frames
-         xraudio_dga_apply(session->obj_dga, frame_buffer_fp32, sample_qty * frame_group_index);
+         xraudio_in_dga_apply(session->obj_dga, frame_buffer_fp32, sample_qty * frame_group_index);
          // Convert float to int16
          xraudio_samples_convert_fp32_int16(samples, frame_buffer_fp32, sample_qty * frame_group_index, instance->dynamic_gain_pcm_bit_qty);
       }
       #endif
 
-      rc = (*instance->data_callback)(source, samples, sample_qty * frame_group_index, instance->param);
+      if(instance->sample_convert || instance->buffer_pool_qty > 0) { // Deliver from the output buffer or a lent buffer
+         xraudio_audio_buffer_out_t *   buffer_out      = session->frame_buffer_out;
+         xraudio_stream_buffer_entry_t *entry           = NULL;
+         bool                           is_external     = (XRAUDIO_DEVICE_INPUT_EXTERNAL_GET(source) != XRAUDIO_DEVICE_INPUT_NONE);
+         uint32_t                       sample_qty_chan = 0;
+         uint8_t                        chan_qty        = 0;
+         uint8_t                        chan            = 0;
+         #if defined(XRAUDIO_KWD_ENABLED)
+         if(params->dsp_config.input_asr_max_channel_qty == 0) {
+            chan = session->keyword_detector.active_chan;
+         }
+         #endif
+
+         if(instance->buffer_pool_qty > 0) {
+            entry = xraudio_in_buffer_pool_acquire(instance);
+            if(entry == NULL) { // All buffers are retained by the client
+               instance->stats.buffers_unavailable++;
+            } else {
+               buffer_out = &entry->buffer;
+            }
+         }
+
+         uint64_t timestamp_convert = xraudio_in_frame_timestamp_get();
+         uint32_t data_size = xraudio_in_samples_out(session, instance, buffer_out, is_external, chan, frame_group_index, &sample_qty_chan, &chan_qty);
+         void *   data_ptr  = buffer_out->samples;
+         xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_CONVERT, timestamp_convert);
+
+         if(instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) { // The output buffer reserves room for the header ahead of the payload
+            xraudio_in_frame_header_init(instance, &buffer_out->header, instance->frame_flags, timestamp, sample_qty_chan, data_size);
+            instance->frame_flags = 0;
+            data_ptr = &buffer_out->header;
+         }
+
+         *params->stream_buffer_lent = (xraudio_stream_buffer_t)entry;
+         timestamp_callback   = xraudio_in_frame_timestamp_get();
+         rc = (*instance->data_callback)(source, (xraudio_sample_t *)data_ptr, sample_qty_chan * chan_qty, instance->param);
+         xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_CALLBACK, timestamp_callback);
+         *params->stream_buffer_lent = NULL;
+
+         if(entry != NULL) { // Drop the main thread's reference
+            xraudio_in_stream_buffer_unref(entry);
+         }
+      } else if(instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) { // Copy the payload behind the header room of the output buffer
+         xraudio_audio_buffer_out_t *buffer_out = session->frame_buffer_out;
+         uint32_t                    data_size  = frame_size * frame_group_index;
+
+         if(data_size > session->frame_buffer_out_sample_qty * sizeof(int32_t)) {
+            XLOGD_ERROR("data size <%u> exceeds output buffer size <%u>", data_size, (uint32_t)(session->frame_buffer_out_sample_qty * sizeof(int32_t)));
+            rc = -1;
+         } else {
+            xraudio_in_frame_header_init(instance, &buffer_out->header, instance->frame_flags, timestamp, (instance->format_out.encoding == XRAUDIO_ENCODING_PCM) ? data_size / sizeof(xraudio_sample_t) : 0, data_size);
+            instance->frame_flags = 0;
+            memcpy(buffer_out->samples, samples, data_size);
+
+            timestamp_callback = xraudio_in_frame_timestamp_get();
+            rc = (*instance->data_callback)(source, (xraudio_sample_t *)&buffer_out->header, sample_qty * frame_group_index, instance->param);
+            xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_CALLBACK, timestamp_callback);
+         }
+      } else {
+         timestamp_callback = xraudio_in_frame_timestamp_get();
+         rc = (*instance->data_callback)(source, samples, sample_qty * frame_group_index, instance->param);
+         xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_CALLBACK, timestamp_callback);
+      }
+      if(rc >= 0 && instance->first_byte_timestamp != 0) { // The client accepted the first frame group
+         xraudio_in_first_byte_written(instance);
+      }
+      xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_CAPTURE_TO_DELIVERY, timestamp);
    }
 
    return(rc);
@@ -3262,12 +5587,58 @@ void xraudio_in_sound_intensity_transfer(xraudio_main_thread_params_t *params, x
 }
 
 #ifdef XRAUDIO_KWD_ENABLED
-void xraudio_keyword_detector_init(xraudio_keyword_detector_t *detector, json_t *jkwd_config) {
+void xraudio_keyword_detector_init(xraudio_keyword_detector_t *detector, json_t *jkwd_config, const xraudio_beamformer_config_t *beamformer_config, const xraudio_keyword_commit_config_t *commit_config, const xraudio_keyword_models_config_t *models_config, uint32_t frame_period, xraudio_dispatch_object_t obj_dispatch) {
    XLOGD_DEBUG("");
    detector->kwd_object                = xraudio_kwd_object_create(jkwd_config);
+   detector->instance_qty              = 0;
+   detector->suspended                 = false;
+   detector->model_qty                 = 0;
+   detector->model_next                = 0;
+   detector->model_budget_us           = models_config->budget_us;
+   for(uint8_t index = 0; index < models_config->model_qty && index < XRAUDIO_KEYWORD_MODEL_QTY_MAX; index++) {
+      const xraudio_keyword_model_config_t *model_config = &models_config->models[index];
+      xraudio_keyword_model_t *model = &detector->models[detector->model_qty];
+
+      model->kwd_object = xraudio_kwd_object_create(model_config->jkwd_config);
+      if(model->kwd_object == NULL) {
+         XLOGD_ERROR("unable to create kwd object for keyword <%s>", model_config->name);
+         continue;
+      }
+      snprintf(model->name, sizeof(model->name), "%s", model_config->name);
+      model->sensitivity    = model_config->sensitivity;
+      model->lag_sample_qty = 0;
+      model->cost_us        = 0;
+      model->defer_qty      = 0;
+      detector->model_qty++;
+   }
+   detector->beam_object               = NULL;
+   detector->beam_qty                  = 0;
+   if(beamformer_config->enable) {
+      detector->beam_object = xraudio_beam_object_create(beamformer_config, XRAUDIO_INPUT_DEFAULT_SAMPLE_RATE, (XRAUDIO_INPUT_MAX_SAMPLE_RATE * frame_period) / 1000);
+      if(detector->beam_object == NULL) {
+         XLOGD_ERROR("unable to create beamformer");
+      }
+   }
    detector->sensitivity               = 0.0;
    detector->active                    = false;
    detector->triggered                 = false;
+   detector->committed                 = false;
+   detector->commit_frame_qty_max      = commit_config->latency_max_ms / frame_period;
+   detector->obj_dispatch              = obj_dispatch;
+   detector->speculative.frame_period  = frame_period;
+   detector->commit_margin             = commit_config->margin;
+   detector->commit_margin_prev        = 0.0;
+   detector->result.commit_reason      = XRAUDIO_KEYWORD_COMMIT_INVALID;
+   detector->result.commit_delay_ms    = 0;
+   detector->result.keyword_index      = XRAUDIO_KEYWORD_INDEX_PRIMARY;
+   detector->result.keyword_name       = NULL;
+   detector->speculative.active        = false;
+   detector->speculative.gap           = false;
+   detector->speculative.chan          = 0;
+   detector->speculative.sequence      = 0;
+   detector->speculative.sample_qty    = 0;
+   detector->speculative.frame_qty     = 0;
+   memset(&detector->reload, 0, sizeof(detector->reload));
    detector->post_frame_count_trigger  = 0;
    detector->post_frame_count_callback = 0;
    detector->active_chan               = 0;
@@ -3302,10 +5673,37 @@ void xraudio_keyword_detector_init(xraudio_keyword_detector_t *detector, json_t
 }
 
 void xraudio_keyword_detector_term(xraudio_keyword_detector_t *detector) {
+   xraudio_keyword_reload_t *reload = &detector->reload;
+   if(reload->thread.running) {
+      xraudio_thread_join(&reload->thread);
+   }
+   if(reload->kwd_object != NULL) {
+      xraudio_kwd_object_destroy(reload->kwd_object);
+      reload->kwd_object = NULL;
+   }
+   if(reload->kwd_object_old != NULL) {
+      xraudio_kwd_object_destroy(reload->kwd_object_old);
+      reload->kwd_object_old = NULL;
+   }
    if(detector->kwd_object != NULL) {
       xraudio_kwd_object_destroy(detector->kwd_object);
       detector->kwd_object = NULL;
    }
+   for(uint8_t index = 0; index < detector->model_qty; index++) {
+      xraudio_kwd_object_destroy(detector->models[index].kwd_object);
+      detector->models[index].kwd_object = NULL;
+   }
+   detector->model_qty = 0;
+   json_decref(reload->jkwd_config);
+   json_decref(reload->jkwd_config_active);
+   json_decref(reload->jkwd_config_old);
+   reload->jkwd_config        = NULL;
+   reload->jkwd_config_active = NULL;
+   reload->jkwd_config_old    = NULL;
+   if(detector->beam_object != NULL) {
+      xraudio_beam_object_destroy(detector->beam_object);
+      detector->beam_object = NULL;
+   }
 }
 
 void xraudio_keyword_detector_session_init(xraudio_keyword_detector_t *detector, uint8_t chan_qty, xraudio_keyword_sensitivity_t sensitivity) {
@@ -3316,6 +5714,9 @@ void xraudio_keyword_detector_session_init(xraudio_keyword_detector_t *detector,
    }
    detector->active                    = true;
    detector->triggered                 = false;
+   detector->committed                 = false;
+   detector->result.commit_reason      = XRAUDIO_KEYWORD_COMMIT_INVALID;
+   detector->result.commit_delay_ms    = 0;
    detector->sensitivity               = sensitivity;
    detector->post_frame_count_trigger  = 0;
    detector->post_frame_count_callback = 0;
@@ -3327,6 +5728,14 @@ void xraudio_keyword_detector_session_init(xraudio_keyword_detector_t *detector,
       XLOGD_INFO("kwd instances <%u> requested more than max kwd instances <%u> allowed", chan_qty, detector->input_kwd_max_channel_qty);
       chan_qty = detector->input_kwd_max_channel_qty;
    }
+   if(detector->beam_object != NULL) { // Only the selected beams are processed by the keyword detector
+      uint8_t beam_qty_kwd = xraudio_beam_kwd_qty_get(detector->beam_object);
+      if(chan_qty > beam_qty_kwd) {
+         chan_qty = beam_qty_kwd;
+      }
+      xraudio_beam_reset(detector->beam_object);
+   }
+   detector->instance_qty = chan_qty;
 
    XLOGD_INFO("init <%u> kwd instances", chan_qty);
 
@@ -3358,11 +5767,89 @@ void xraudio_keyword_detector_session_init(xraudio_keyword_detector_t *detector,
       }
    }
 
+   detector->model_next = 0;
+   for(uint8_t index = 0; index < detector->model_qty; index++) {
+      xraudio_keyword_model_t *model = &detector->models[index];
+      model->lag_sample_qty = 0;
+      model->defer_qty      = 0;
+   }
+
+   if(detector->suspended) { // The instances are initialized on resume
+      return;
+   }
    if(!xraudio_kwd_init(detector->kwd_object, chan_qty, sensitivity, NULL, &detector->criterion)) {
       XLOGD_ERROR("kwd init failed");
+   } else {
+      xraudio_keyword_detector_state_restore(detector);
+   }
+
+   for(uint8_t index = 0; index < detector->model_qty; index++) {
+      xraudio_keyword_model_t *model = &detector->models[index];
+      xraudio_kwd_criterion_t criterion;
+      if(!xraudio_kwd_init(model->kwd_object, 1, model->sensitivity, NULL, &criterion)) {
+         XLOGD_ERROR("kwd init failed for keyword <%s>", model->name);
+      }
+   }
+}
+
+void xraudio_keyword_detector_suspend(xraudio_keyword_detector_t *detector) {
+   if(detector->suspended) {
+      return;
+   }
+   detector->suspended = true;
+
+   // Audio captured before the suspension is not prepended to a later stream
+   for(uint8_t chan = 0; chan < detector->input_asr_kwd_channel_qty; chan++) {
+      detector->channels[chan].pd_sample_qty  = 0;
+      detector->channels[chan].pd_index_write = 0;
+   }
+   if(!detector->active || detector->instance_qty == 0) {
+      return;
+   }
+   xraudio_keyword_detector_state_save(detector);
+   xraudio_kwd_term(detector->kwd_object);
+
+   for(uint8_t index = 0; index < detector->model_qty; index++) {
+      xraudio_kwd_term(detector->models[index].kwd_object);
+   }
+}
+
+void xraudio_keyword_detector_resume(xraudio_keyword_detector_t *detector) {
+   if(!detector->suspended) {
+      return;
+   }
+   detector->suspended = false;
+
+   if(!detector->active || detector->instance_qty == 0) {
+      return;
+   }
+   if(!xraudio_kwd_init(detector->kwd_object, detector->instance_qty, detector->sensitivity, NULL, &detector->criterion)) {
+      XLOGD_ERROR("kwd init failed");
+   } else {
+      xraudio_keyword_detector_state_restore(detector);
+   }
+
+   for(uint8_t index = 0; index < detector->model_qty; index++) {
+      xraudio_keyword_model_t *model = &detector->models[index];
+      xraudio_kwd_criterion_t criterion;
+      if(!xraudio_kwd_init(model->kwd_object, 1, model->sensitivity, NULL, &criterion)) {
+         XLOGD_ERROR("kwd init failed for keyword <%s>", model->name);
+      }
    }
 }
 
+void xraudio_keyword_detector_state_save(xraudio_keyword_detector_t *detector) {
+   #ifdef XRAUDIO_DSP_STATE_ENABLED
+   xraudio_dsp_snapshot_save(detector->snapshot, XRAUDIO_DSP_PLUGIN_KWD, detector->kwd_object, xraudio_kwd_snapshot_size, xraudio_kwd_snapshot_save);
+   #endif
+}
+
+void xraudio_keyword_detector_state_restore(xraudio_keyword_detector_t *detector) {
+   #ifdef XRAUDIO_DSP_STATE_ENABLED
+   xraudio_dsp_snapshot_restore(detector->snapshot, XRAUDIO_DSP_PLUGIN_KWD, detector->kwd_object, xraudio_kwd_snapshot_restore);
+   #endif
+}
+
 bool xraudio_keyword_detector_session_is_active(xraudio_keyword_detector_t *detector) {
    return(detector->active);
 }
@@ -3373,11 +5860,27 @@ void xraudio_keyword_detector_session_term(xraudio_keyword_detector_t *detector)
       XLOGD_ERROR("Invalid parameters");
       return;
    }
+   xraudio_in_speculative_end(&detector->speculative, false);
    detector->active   = false;
    detector->callback = NULL;
    detector->cb_param = NULL;
 
-   xraudio_kwd_term(detector->kwd_object);
+   if(!detector->suspended && detector->instance_qty > 0) { // The instances were already released by the suspension
+      xraudio_keyword_detector_state_save(detector);
+      xraudio_kwd_term(detector->kwd_object);
+   }
+
+   for(uint8_t index = 0; index < detector->model_qty; index++) {
+      xraudio_keyword_model_t *model = &detector->models[index];
+      XLOGD_INFO("keyword <%s> cost <%u> us deferred frames <%u>", model->name, model->cost_us, model->defer_qty);
+      if(!detector->suspended && detector->instance_qty > 0) {
+         xraudio_kwd_term(model->kwd_object);
+      }
+   }
+
+   if(detector->reload.pending) { // No detection can be pending without a session
+      xraudio_keyword_detector_reload_swap(detector);
+   }
 }
 #endif
 
@@ -3385,7 +5888,9 @@ void xraudio_keyword_detector_session_disarm(xraudio_keyword_detector_t *detecto
    detector->callback          = NULL;
    detector->cb_param          = NULL;
    #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_in_speculative_end(&detector->speculative, false);
    detector->triggered         = false;
+   detector->committed         = false;
    XLOGD_DEBUG("");
 
    for(uint8_t chan = 0; chan < detector->input_asr_kwd_channel_qty; chan++) {
@@ -3407,8 +5912,14 @@ void xraudio_keyword_detector_session_arm(xraudio_keyword_detector_t *detector,
    detector->callback                  = callback;
    detector->cb_param                  = cb_param;
    detector->result.chan_selected      = detector->input_kwd_max_channel_qty;
+   detector->result.commit_reason      = XRAUDIO_KEYWORD_COMMIT_INVALID;
+   detector->result.commit_delay_ms    = 0;
+   detector->result.keyword_index      = XRAUDIO_KEYWORD_INDEX_PRIMARY;
+   detector->result.keyword_name       = NULL;
    #ifdef XRAUDIO_KWD_ENABLED
+   xraudio_in_speculative_end(&detector->speculative, false); // the detection was rejected
    detector->triggered                 = false;
+   detector->committed                 = false;
    detector->post_frame_count_trigger  = 0;
    detector->post_frame_count_callback = 0;
    detector->active_chan               = 0;
@@ -3466,7 +5977,7 @@ void xraudio_keyword_detector_session_event(xraudio_keyword_detector_t *detector
       return;
    }
 
-   detector->callback(source, event, detector->cb_param, detector_result, format);
+   xraudio_dispatch_keyword(detector->obj_dispatch, detector->callback, source, event, detector->cb_param, detector_result, format);
    xraudio_keyword_detector_session_disarm(detector);
 }
 
@@ -3481,50 +5992,19 @@ void xraudio_process_spkr_data(xraudio_main_thread_params_t *params, xraudio_ses
       session->playing = true;
    }
    if(session->mode_changed) {
-      #ifdef MASK_FIRST_WRITE_DELAY
-      if(!session->first_write_complete) {
-         // Deal with long delay in first call to qahw_out_write (several hundred milliseconds)
-         if(!session->first_write_pending && !session->first_write_thread.running) {
-            g_thread_params_write.params  = params;
-            g_thread_params_write.session = session;
-
-            session->first_write_pending = true;
-
-            // Perform first write (of silence) in a separate thread
-            if(!xraudio_thread_create(&session->first_write_thread, "xraudio_1st_wr", xraudio_thread_first_write, &g_thread_params_write)) {
-               XLOGD_ERROR("unable to launch thread");
-            }
-            rdkx_timestamp_get(&session->timestamp_next); // Mark starting timestamp
-         }
-
-         if(session->first_write_pending) { // the first call to qahw_out_write has not completed yet
-            if(timestamp_sync != NULL) { // Sync time with mic
-               session->timestamp_next = *timestamp_sync;
-            } else {
-               // Add the timeout interval to determine the next timestamp
-               rdkx_timestamp_add_us(&session->timestamp_next, session->timeout);
-            }
-            // Calculate the amount of time until next chunk in microseconds
-            uint32_t until = rdkx_timestamp_until_us(session->timestamp_next);
-            if(until == 0) {
-               *timeout = 1;
-            } else {
-               *timeout = until;
-            }
-            return;
-         } else if(session->first_write_thread.running) {
-            xraudio_thread_join(&session->first_write_thread);
-            session->first_write_complete = true;
-         }
-      }
-      #endif
-
       if(timestamp_sync == NULL) { // not syncing time with mic
          rdkx_timestamp_get(&session->timestamp_next); // Mark starting timestamp
       }
 
       if(session->callback != NULL){
-         (*session->callback)(AUDIO_OUT_CALLBACK_EVENT_FIRST_FRAME, session->param);
+         xraudio_dispatch_audio_out(params->obj_dispatch, session->callback, AUDIO_OUT_CALLBACK_EVENT_FIRST_FRAME, session->param);
+      }
+      if(session->standby_exit) { // First frame of the playback on the stream held in standby
+         uint32_t exit_time_us = (uint32_t)rdkx_timestamp_since_us(session->standby_timestamp);
+         XLOGD_INFO("speaker standby exit <%u> us", exit_time_us);
+         xraudio_atomic_int_add(&g_standby_output_exit_qty,     1);
+         xraudio_atomic_int_set(&g_standby_output_exit_time_us, (int)exit_time_us);
+         session->standby_exit = false;
       }
       session->mode_changed = false;
    }
@@ -3577,64 +6057,11 @@ void xraudio_process_spkr_data(xraudio_main_thread_params_t *params, xraudio_ses
             session->semaphore = NULL;
          }
       } else if(session->callback != NULL){
-         (*session->callback)(rc < 0 ? AUDIO_OUT_CALLBACK_EVENT_ERROR : AUDIO_OUT_CALLBACK_EVENT_EOF, session->param);
+         xraudio_dispatch_audio_out(params->obj_dispatch, session->callback, rc < 0 ? AUDIO_OUT_CALLBACK_EVENT_ERROR : AUDIO_OUT_CALLBACK_EVENT_EOF, session->param);
       }
    }
 }
 
-#ifdef MASK_FIRST_WRITE_DELAY
-void *xraudio_thread_first_write(void *param) {
-   xraudio_thread_first_write_params_t params = *((xraudio_thread_first_write_params_t *)param);
-
-   #if 0
-   rdkx_timestamp_t start, finish;
-   rdkx_timestamp_get(&start);
-   #endif
-   // Perform first write
-   xraudio_out_write_silence(params.params, params.session, params.session->frame_size);
-
-   #if 0
-   rdkx_timestamp_get(&finish);
-   XLOGD_INFO("write silence end %lld us frame size %u", rdkx_timestamp_subtract_us(start, finish), params.session->frame_size);
-   #endif
-   // Send message to signal completion
-   params.session->first_write_pending = false;
-   return(NULL);
-}
-#endif
-
-#ifdef MASK_FIRST_READ_DELAY
-void *xraudio_thread_first_read(void *param) {
-   xraudio_thread_first_read_params_t params = *((xraudio_thread_first_read_params_t *)param);
-
-   #if 0
-   rdkx_timestamp_t start, finish;
-   rdkx_timestamp_get(&start);
-   #endif
-   // Perform first read
-   uint8_t  mic_frame_data[XRAUDIO_INPUT_FRAME_SIZE_MAX];
-   uint32_t mic_frame_size;
-
-   xraudio_devices_input_t device_input_local = XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input);
-   xraudio_devices_input_t device_input_ecref = XRAUDIO_DEVICE_INPUT_EC_REF_GET(session->devices_input);
-
-   uint8_t chan_qty_mic   = (device_input_local == XRAUDIO_DEVICE_INPUT_QUAD) ? 4 : (device_input_local == XRAUDIO_DEVICE_INPUT_TRI) ? 3 : 1;
-   uint8_t chan_qty_ecref = (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_5_1) ? 6 : (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_STEREO) ? 2 : (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_MONO) ? 1 : 0;
-
-   mic_frame_size = (chan_qty_mic + chan_qty_ecref) * params.session->frame_size_in;  // normal frame @ 16kHz = 640 bytes. compressed frame @ 48kHz = 2560 bytes
-
-   xraudio_hal_input_read(params.params->hal_input_obj, mic_frame_data, mic_frame_size, NULL);
-
-   #if 0
-   rdkx_timestamp_get(&finish);
-   XLOGD_INFO("read end %lld us frame size %u", rdkx_timestamp_subtract_us(start, finish), params.session->frame_size);
-   #endif
-   // Send message to signal completion
-   params.session->first_read_pending = false;
-   return(NULL);
-}
-#endif
-
 int xraudio_out_write_from_file(xraudio_main_thread_params_t *params, xraudio_session_playback_t *session, unsigned long frame_size) {
    int rc = 0;
 
@@ -3714,7 +6141,7 @@ int xraudio_out_write_from_pipe(xraudio_main_thread_params_t *params, xraudio_se
             // Fill the frame with silence
             memset(session->frame_buffer, 0, frame_size);
             if(session->callback != NULL){
-               (*session->callback)(AUDIO_OUT_CALLBACK_EVENT_UNDERFLOW, session->param);
+               xraudio_dispatch_audio_out(params->obj_dispatch, session->callback, AUDIO_OUT_CALLBACK_EVENT_UNDERFLOW, session->param);
             }
          } else {
             XLOGD_ERROR("unable to read from pipe %d <%s>", rc, strerror(errsv));
@@ -3797,7 +6224,11 @@ int xraudio_out_write_hal(xraudio_main_thread_params_t *params, xraudio_session_
    int32_t chans = (int32_t)session->format.channel_qty;
    xraudio_output_volume_gain_apply(params->obj_output, buffer, frame_size, chans);
 
+   #ifdef XRAUDIO_TRACE_ENABLED
+   uint64_t timestamp_write = xraudio_in_frame_timestamp_get();
+   #endif
    int rc = xraudio_hal_output_write(session->hal_output_obj, buffer, frame_size);
+   XRAUDIO_TRACE(XRAUDIO_TRACE_EVENT_HAL_WRITE, 0, timestamp_write, (uint32_t)(xraudio_in_frame_timestamp_get() - timestamp_write));
    if(rc < 0) {
       XLOGD_ERROR("Audio out write failed %d stream handle %p", rc, session->hal_output_obj);
    } else if(rc < (int)frame_size) {
@@ -3883,6 +6314,51 @@ void xraudio_record_container_process_end(FILE *fh, xraudio_input_format_t forma
 }
 
 #ifdef XRAUDIO_KWD_ENABLED
+// Write pre-detection samples to the fifos in the stream's sample format.  The samples are converted through the output buffer in frame group sized slices so the
+// float samples are left in place for the captures.
+void xraudio_in_pre_detection_write_converted(xraudio_devices_input_t source, xraudio_session_record_t *session, xraudio_session_record_inst_t *instance, const float *samples, uint32_t sample_qty, uint64_t timestamp) {
+   xraudio_audio_buffer_out_t *buffer_out = session->frame_buffer_out;
+
+   while(sample_qty > 0) {
+      uint32_t slice_qty = (sample_qty > session->frame_buffer_out_sample_qty) ? session->frame_buffer_out_sample_qty : sample_qty;
+      uint32_t size      = slice_qty * sizeof(int32_t);
+
+      switch(instance->sample_format) {
+         case XRAUDIO_STREAM_SAMPLE_FORMAT_INT32:   xraudio_in_samples_copy_fp32_int32((int32_t *)buffer_out->samples, &samples, 1, slice_qty);                          break;
+         case XRAUDIO_STREAM_SAMPLE_FORMAT_FLOAT32: xraudio_in_samples_copy_fp32_fp32((float *)buffer_out->samples, &samples, 1, slice_qty, 1.0f / 2147483648.0f); break; // int32 scaled
+         default: {
+            XLOGD_ERROR("unsupported sample format <%s>", xraudio_stream_sample_format_str(instance->sample_format));
+            return;
+         }
+      }
+
+      xraudio_stream_frame_header_t header;
+      if(instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) {
+         xraudio_in_frame_header_init(instance, &header, 0, timestamp, slice_qty, size);
+      }
+      for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
+         if(instance->fifo_audio_data[index] < 0) {
+            break;
+         }
+         errno = 0;
+         int rc = xraudio_in_frame_write_fifo(instance, index, (instance->framing == XRAUDIO_STREAM_FRAMING_HEADER) ? &header : NULL, buffer_out->samples, size);
+         if(rc != (int)size) {
+            int errsv = errno;
+            if(errsv == EAGAIN || errsv == EWOULDBLOCK) { // Data is lost due to insufficient space in the pipe
+               if(instance->callback != NULL){
+                  xraudio_dispatch_audio_in(session->obj_dispatch, instance->callback, source, AUDIO_IN_CALLBACK_EVENT_OVERFLOW, NULL, instance->param);
+               }
+            } else {
+               XLOGD_ERROR("unable to write fifo <%d> <%s>", instance->fifo_audio_data[index], strerror(errsv));
+            }
+         }
+      }
+      samples    += slice_qty;
+      sample_qty -= slice_qty;
+      timestamp  += (uint64_t)slice_qty * 1000000 / session->format_in.sample_rate;
+   }
+}
+
 bool xraudio_in_pre_detection_chunks(xraudio_keyword_detector_chan_t *kwd_detector_chan, uint32_t sample_qty, uint32_t offset_from_end, float **chunk_1_data, uint32_t *chunk_1_qty, float **chunk_2_data, uint32_t *chunk_2_qty) {
    int samples_in_buffer = kwd_detector_chan->pd_sample_qty;
    *chunk_1_qty  = *chunk_2_qty  = 0;
@@ -3961,6 +6437,13 @@ void xraudio_in_capture_internal_input_begin(xraudio_input_format_t *native, xra
    captures[0] = &capture_instance->native;
    captures[1] = (decoded != NULL) ? &capture_instance->decoded : NULL;
 
+   if(!capture_internal->indexed) { // Scan the capture directory at the first capture rather than when xraudio is opened
+      uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+      capture_internal->file_index = xraudio_capture_next_file_index(capture_internal->dir_path, capture_internal->file_qty_max);
+      capture_internal->indexed    = true;
+      xraudio_atomic_int_set(&g_init_capture_time_us, (int)(xraudio_in_frame_timestamp_get() - timestamp_begin));
+   }
+
    capture_instance->active = true;
 
    capture_instance->native.format = *native;
@@ -4546,6 +7029,7 @@ void xraudio_process_input_external_data(xraudio_main_thread_params_t *params, x
 
    if(bytes_read <= 0) {
       if(instance->stream_until[0] == XRAUDIO_INPUT_RECORD_UNTIL_END_OF_STREAM) { // Session ended, notify
+         instance->frame_flags |= XRAUDIO_STREAM_FRAME_FLAG_EOS;
          xraudio_in_flush(XRAUDIO_DEVICE_INPUT_EXTERNAL_GET(instance->source), params, session, instance);
 
          for(uint32_t index = 0; index < XRAUDIO_FIFO_QTY_MAX; index++) {
@@ -4553,8 +7037,7 @@ void xraudio_process_input_external_data(xraudio_main_thread_params_t *params, x
                break;
             }
             if(instance->fifo_audio_data[index] >= 0) { // Close the write side of the pipe so the read side gets EOF
-               close(instance->fifo_audio_data[index]);
-               instance->fifo_audio_data[index] = -1;
+               xraudio_in_fifo_close(instance, index);
             }
             instance->stream_until[index] = XRAUDIO_INPUT_RECORD_UNTIL_INVALID;
          }
@@ -4583,7 +7066,7 @@ void xraudio_process_input_external_data(xraudio_main_thread_params_t *params, x
                      stats.decoder_failures     = adpcm_stats.failed_decodes;
                      stats.samples_buffered_max = 0;
                   }
-                  (*instance->callback)(instance->source, AUDIO_IN_CALLBACK_EVENT_EOS, &stats, instance->param);
+                  xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, instance->source, AUDIO_IN_CALLBACK_EVENT_EOS, &stats, instance->param);
                   break;
                }
                case XRAUDIO_ENCODING_ADPCM_XVP: {
@@ -4598,12 +7081,12 @@ void xraudio_process_input_external_data(xraudio_main_thread_params_t *params, x
                      stats.decoder_failures     = adpcm_stats.failed_decodes;
                      stats.samples_buffered_max = 0;
                   }
-                  (*instance->callback)(instance->source, AUDIO_IN_CALLBACK_EVENT_EOS, &stats, instance->param);
+                  xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, instance->source, AUDIO_IN_CALLBACK_EVENT_EOS, &stats, instance->param);
                   break;
                }
             #endif
                default: {
-                  (*instance->callback)(instance->source, AUDIO_IN_CALLBACK_EVENT_EOS, NULL, instance->param);
+                  xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, instance->source, AUDIO_IN_CALLBACK_EVENT_EOS, NULL, instance->param);
                   break;
                }
             }
@@ -4628,7 +7111,7 @@ void xraudio_process_input_external_data(xraudio_main_thread_params_t *params, x
       session->external_data_len               < instance->stream_time_min_value &&
       session->external_data_len + bytes_read >= instance->stream_time_min_value &&
       instance->callback) {
-         (*instance->callback)(instance->source, AUDIO_IN_CALLBACK_EVENT_STREAM_TIME_MINIMUM, NULL, instance->param);
+         xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, instance->source, AUDIO_IN_CALLBACK_EVENT_STREAM_TIME_MINIMUM, NULL, instance->param);
    }
 
    session->external_data_len += bytes_read;
@@ -4637,14 +7120,23 @@ void xraudio_process_input_external_data(xraudio_main_thread_params_t *params, x
       if(instance->callback != NULL) {
          xraudio_stream_keyword_info_t kwd_info;
          kwd_info.byte_qty = (instance->keyword_end_samples * sizeof(int16_t)); // 16-bit pcm
-         (*instance->callback)(instance->source, AUDIO_IN_CALLBACK_EVENT_STREAM_KWD_INFO, &kwd_info, instance->param);
+         xraudio_dispatch_audio_in(params->obj_dispatch, instance->callback, instance->source, AUDIO_IN_CALLBACK_EVENT_STREAM_KWD_INFO, &kwd_info, instance->param);
       }
       instance->keyword_end_samples = 0;
       instance->keyword_flush       = true;
+      instance->frame_flags        |= XRAUDIO_STREAM_FRAME_FLAG_KEYWORD_END;
    }
 
+   if(session->external_frame_group_index == 0) {
+      session->external_frame_group_timestamp = xraudio_in_frame_timestamp_get();
+   }
    session->external_frame_group_index++;
 
+   if(instance->latency_budget_ms > 0) {
+      xraudio_in_frame_group_adapt(instance, session->external_frame_group_index, instance->keyword_flush, session->frame_period);
+      session->external_frame_group_qty = instance->frame_group_qty;
+   }
+
    int rc = -1;
    if(instance->record_callback) {
       rc = instance->record_callback(XRAUDIO_DEVICE_INPUT_EXTERNAL_GET(instance->source), params, session, instance);
@@ -4743,6 +7235,7 @@ void xraudio_encoding_parameters_get(xraudio_input_format_t *format, uint32_t fr
 #if defined(XRAUDIO_KWD_ENABLED) || defined(XRAUDIO_DGA_ENABLED)
 void xraudio_samples_convert_fp32_int16(int16_t *samples_int16, float *samples_fp32, uint32_t sample_qty, uint32_t bit_qty) {
    XLOGD_DEBUG("sample qty <%u> bit qty <%u>", sample_qty, bit_qty);
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
 
    for(uint32_t i = 0; i < sample_qty; i++) {
       if(*samples_fp32 < INT32_MIN) {
@@ -4756,8 +7249,16 @@ void xraudio_samples_convert_fp32_int16(int16_t *samples_int16, float *samples_f
       samples_fp32++;
       samples_int16++;
    }
+   xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_CONVERT, timestamp_begin);
 }
 #endif //defined(XRAUDIO_KWD_ENABLED) || defined(XRAUDIO_DGA_ENABLED)
+#ifdef XRAUDIO_DGA_ENABLED
+void xraudio_in_dga_apply(xraudio_dga_object_t object, float *samples, uint32_t sample_qty) {
+   uint64_t timestamp_begin = xraudio_in_frame_timestamp_get();
+   xraudio_dga_apply(object, samples, sample_qty);
+   xraudio_in_latency_record(XRAUDIO_LATENCY_STAGE_DGA, timestamp_begin);
+}
+#endif
 #ifdef XRAUDIO_PPR_ENABLED
 /*void xraudio_samples_convert_int16_int32(int16_t *int16buf, int32_t *int32buf, uint32_t sample_qty_frame, uint32_t bit_qty) {
    uint32_t sample;
@@ -5026,10 +7527,11 @@ bool xraudio_in_aop_adjust_apply(int32_t *buffer, uint32_t sample_qty_frame, int
 void xraudio_preprocess_mic_data(xraudio_main_thread_params_t *params, xraudio_session_record_t *session, xraudio_ppr_event_t *ppr_event) {
    xraudio_devices_input_t device_input_local = XRAUDIO_DEVICE_INPUT_LOCAL_GET(session->devices_input);
    xraudio_devices_input_t device_input_ecref = XRAUDIO_DEVICE_INPUT_EC_REF_GET(session->devices_input);
-   uint8_t chan_qty_mic   = (device_input_local == XRAUDIO_DEVICE_INPUT_QUAD) ? 4 : (device_input_local == XRAUDIO_DEVICE_INPUT_TRI) ? 3 : 1;
-   uint8_t chan_qty_ecref = (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_5_1) ? 6 : (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_STEREO) ? 2 : (device_input_ecref == XRAUDIO_DEVICE_INPUT_EC_REF_MONO) ? 1 : 0;
+   uint8_t chan_qty_mic   = xraudio_devices_input_mic_qty(device_input_local, params->input_mic_qty);
+   uint8_t chan_qty_ecref = xraudio_devices_input_ec_ref_qty(device_input_ecref);
    uint8_t chan_qty_total = (chan_qty_mic + chan_qty_ecref);
    uint32_t bit_qty = session->pcm_bit_qty;
+   uint32_t frame_sample_qty = session->frame_sample_qty / session->format_in.channel_qty;
 
    // Preprocess mic and ref input buffers and postprocess kwd, asr, and ref output buffers
    // Declare arrays of pointers to int32 frame buffers needed for preprocess
@@ -5053,11 +7555,11 @@ void xraudio_preprocess_mic_data(xraudio_main_thread_params_t *params, xraudio_s
       if(chan < chan_qty_mic) {
          pf32 = &session->frame_buffer_fp32[chan].frames[session->frame_group_index].samples[0];
          pi32 = &ppmic_input_buffers[chan].samples[0];
-         xraudio_samples_convert_fp32_int32(pf32, pi32, XRAUDIO_INPUT_FRAME_SAMPLE_QTY, bit_qty);
+         xraudio_samples_convert_fp32_int32(pf32, pi32, frame_sample_qty, bit_qty);
       } else {
          pf32 = &session->frame_buffer_fp32[chan].frames[session->frame_group_index].samples[0];
          pi32 = &ppref_input_buffers[ref_chan].samples[0];
-         xraudio_samples_convert_fp32_int32(pf32, pi32, XRAUDIO_INPUT_FRAME_SAMPLE_QTY, bit_qty);
+         xraudio_samples_convert_fp32_int32(pf32, pi32, frame_sample_qty, bit_qty);
          ref_chan++;
       }
    }
@@ -5065,14 +7567,14 @@ void xraudio_preprocess_mic_data(xraudio_main_thread_params_t *params, xraudio_s
 
    #ifdef XRAUDIO_PPR_DEBUG
    // bypass xraudio_ppr for debugging
-   memcpy((uint8_t *)ppasr_outputs, (const uint8_t *)ppmic_inputs, sizeof(int32_t)*params->dsp_config.input_asr_max_channel_qty*XRAUDIO_INPUT_FRAME_SAMPLE_QTY);
-   memcpy((uint8_t *)ppkwd_outputs, (const uint8_t *)ppmic_inputs + sizeof(int32_t)*params->dsp_config.input_asr_max_channel_qty*XRAUDIO_INPUT_FRAME_SAMPLE_QTY, sizeof(int32_t)*params->dsp_config.input_kwd_max_channel_qty*XRAUDIO_INPUT_FRAME_SAMPLE_QTY);
-   memcpy((uint8_t *)ppref_outputs, (const uint8_t *)ppref_inputs, sizeof(int32_t)*chan_qty_ecref*XRAUDIO_INPUT_FRAME_SAMPLE_QTY);
+   memcpy((uint8_t *)ppasr_outputs, (const uint8_t *)ppmic_inputs, sizeof(int32_t)*params->dsp_config.input_asr_max_channel_qty*frame_sample_qty);
+   memcpy((uint8_t *)ppkwd_outputs, (const uint8_t *)ppmic_inputs + sizeof(int32_t)*params->dsp_config.input_asr_max_channel_qty*frame_sample_qty, sizeof(int32_t)*params->dsp_config.input_kwd_max_channel_qty*frame_sample_qty);
+   memcpy((uint8_t *)ppref_outputs, (const uint8_t *)ppref_inputs, sizeof(int32_t)*chan_qty_ecref*frame_sample_qty);
    *ppr_event = XRAUDIO_PPR_EVENT_NONE;
    #else
    *ppr_event = xraudio_input_ppr_run(
          params->obj_input,
-         XRAUDIO_INPUT_FRAME_SAMPLE_QTY,
+         frame_sample_qty,
          (const int32_t **)&ppmic_inputs,
          (const int32_t **)&ppref_inputs,
          (int32_t **)&ppkwd_outputs,
@@ -5089,21 +7591,21 @@ void xraudio_preprocess_mic_data(xraudio_main_thread_params_t *params, xraudio_s
          pi32 = &ppasr_output_buffers[chan].samples[0];
          pi16 = &session->frame_buffer_int16[chan].frames[session->frame_group_index].samples[0];
          pf32 = &session->frame_buffer_fp32[chan].frames[session->frame_group_index].samples[0];
-         xraudio_samples_convert_int32_int16(pi32, pi16, XRAUDIO_INPUT_FRAME_SAMPLE_QTY, bit_qty);
-         xraudio_samples_convert_int32_fp32(pi32, pf32, XRAUDIO_INPUT_FRAME_SAMPLE_QTY, bit_qty);
+         xraudio_samples_convert_int32_int16(pi32, pi16, frame_sample_qty, bit_qty);
+         xraudio_samples_convert_int32_fp32(pi32, pf32, frame_sample_qty, bit_qty);
       } else if(chan < params->dsp_config.input_kwd_max_channel_qty + params->dsp_config.input_asr_max_channel_qty) {
          pi32 = &ppkwd_output_buffers[kwd_chan].samples[0];
          pi16 = &session->frame_buffer_int16[chan].frames[session->frame_group_index].samples[0];
          pf32 = &session->frame_buffer_fp32[chan].frames[session->frame_group_index].samples[0];
-         xraudio_samples_convert_int32_int16(pi32, pi16, XRAUDIO_INPUT_FRAME_SAMPLE_QTY, bit_qty);
-         xraudio_samples_convert_int32_fp32(pi32, pf32, XRAUDIO_INPUT_FRAME_SAMPLE_QTY, bit_qty);
+         xraudio_samples_convert_int32_int16(pi32, pi16, frame_sample_qty, bit_qty);
+         xraudio_samples_convert_int32_fp32(pi32, pf32, frame_sample_qty, bit_qty);
          kwd_chan++;
       } else if(chan >= chan_qty_mic) {
          pi32 = &ppref_output_buffers[ref_chan].samples[0];
          pi16 = &session->frame_buffer_int16[chan].frames[session->frame_group_index].samples[0];
          pf32 = &session->frame_buffer_fp32[chan].frames[session->frame_group_index].samples[0];
-         xraudio_samples_convert_int32_int16(pi32, pi16, XRAUDIO_INPUT_FRAME_SAMPLE_QTY, bit_qty);
-         xraudio_samples_convert_int32_fp32(pi32, pf32, XRAUDIO_INPUT_FRAME_SAMPLE_QTY, bit_qty);
+         xraudio_samples_convert_int32_int16(pi32, pi16, frame_sample_qty, bit_qty);
+         xraudio_samples_convert_int32_fp32(pi32, pf32, frame_sample_qty, bit_qty);
          ref_chan++;
       }
    }
@@ -0,0 +1,353 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // pthread_getname_np
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include "xraudio.h"
+#include "xraudio_private.h"
+#include "xraudio_atomic.h"
+#include "xraudio_trace.h"
+
+#ifdef XRAUDIO_TRACE_ENABLED
+// Trace recorder.  Each event is written to a slot of a preallocated ring which is claimed with compare and set, so any thread can record
+// an event without locking and the oldest events are overwritten.  The ring is only read or freed once recording is disabled and the
+// writers in progress have finished.  The trace is exported as Chrome trace event JSON, which is also loaded by Perfetto.
+// A triggered export is written by a worker thread which is launched when the trace is started, so the thread that hits the trigger
+// only signals it.
+
+#define XRAUDIO_TRACE_THREAD_QTY_MAX        (16)
+#define XRAUDIO_TRACE_FILENAME_SIZE_MAX     (256)
+
+typedef struct {
+   uint64_t timestamp_us;
+   uint32_t duration_us;
+   uint32_t tid;
+   uint16_t id;
+   uint8_t  type;
+   uint8_t  reserved;
+} xraudio_trace_event_t;
+
+typedef struct {
+   uint32_t tid;
+   char     name[16];
+} xraudio_trace_thread_t;
+
+static void        xraudio_trace_thread_register(void);
+static void        xraudio_trace_writers_wait(void);
+static void        xraudio_trace_trigger(void);
+static void        xraudio_trace_export_wait(void);
+static void *      xraudio_trace_export_thread(void *param);
+static bool        xraudio_trace_write(const char *filename, const xraudio_trace_event_t *events, uint32_t event_qty, uint32_t pos);
+static const char *xraudio_trace_event_name(const xraudio_trace_event_t *event);
+static const char *xraudio_trace_event_type_str(xraudio_trace_event_type_t type);
+
+static pthread_mutex_t        g_trace_mutex = PTHREAD_MUTEX_INITIALIZER; // serializes start, stop, export and close and guards the export thread handle
+static pthread_mutex_t        g_trace_export_mutex = PTHREAD_MUTEX_INITIALIZER; // guards the export thread's pending, busy and exit flags
+static pthread_cond_t         g_trace_export_cond  = PTHREAD_COND_INITIALIZER;
+static bool                   g_trace_export_pending = false; // triggered, not yet picked up by the export thread
+static bool                   g_trace_export_busy    = false; // export thread is writing the ring
+static bool                   g_trace_export_exit    = false;
+static xraudio_thread_t       g_trace_export_thread  = { .running = false };
+static xraudio_atomic_int_t   g_trace_enabled;
+static xraudio_atomic_int_t   g_trace_writers;   // events being written
+static xraudio_atomic_int_t   g_trace_pos;       // position of the next event, the slot is the position modulo the event qty
+static xraudio_trace_event_t *g_trace_events    = NULL;
+static uint32_t               g_trace_event_qty = 0; // power of 2
+static uint32_t               g_trace_trigger_frame_us;
+static bool                   g_trace_trigger_overrun;
+static char                   g_trace_trigger_filename[XRAUDIO_TRACE_FILENAME_SIZE_MAX];
+static xraudio_trace_thread_t g_trace_threads[XRAUDIO_TRACE_THREAD_QTY_MAX];
+static xraudio_atomic_int_t   g_trace_thread_qty;
+static __thread uint32_t      g_trace_tid = 0;
+
+bool xraudio_trace_recorder_start(const xraudio_trace_config_t *config) {
+   uint32_t event_qty = 1;
+   while(event_qty < config->event_qty) {
+      event_qty <<= 1;
+   }
+
+   pthread_mutex_lock(&g_trace_mutex);
+   xraudio_atomic_int_set(&g_trace_enabled, 0);
+   xraudio_trace_writers_wait();
+   xraudio_trace_export_wait();
+
+   if(event_qty != g_trace_event_qty) {
+      xraudio_trace_event_t *events = (xraudio_trace_event_t *)malloc(sizeof(xraudio_trace_event_t) * event_qty);
+      if(events == NULL) {
+         XLOGD_ERROR("Out of memory.");
+         pthread_mutex_unlock(&g_trace_mutex);
+         return(false);
+      }
+      free(g_trace_events);
+      g_trace_events    = events;
+      g_trace_event_qty = event_qty;
+   }
+   g_trace_trigger_frame_us = config->trigger_frame_us;
+   g_trace_trigger_overrun  = config->trigger_overrun;
+   g_trace_trigger_filename[0] = '\0';
+   if(config->trigger_filename != NULL) {
+      snprintf(g_trace_trigger_filename, sizeof(g_trace_trigger_filename), "%s", config->trigger_filename);
+   }
+   if(g_trace_trigger_filename[0] != '\0' && !g_trace_export_thread.running) {
+      if(!xraudio_thread_create(&g_trace_export_thread, "xraudio_trace", xraudio_trace_export_thread, NULL)) {
+         XLOGD_ERROR("unable to launch trace export thread");
+         g_trace_trigger_filename[0] = '\0';
+         pthread_mutex_unlock(&g_trace_mutex);
+         return(false);
+      }
+   }
+   xraudio_atomic_int_set(&g_trace_pos, 0);
+   xraudio_atomic_int_set(&g_trace_enabled, 1);
+
+   XLOGD_INFO("event qty <%u> size <%u> trigger frame <%u> us overrun <%s> file <%s>", event_qty, (uint32_t)(sizeof(xraudio_trace_event_t) * event_qty), g_trace_trigger_frame_us, g_trace_trigger_overrun ? "YES" : "NO", g_trace_trigger_filename);
+   pthread_mutex_unlock(&g_trace_mutex);
+   return(true);
+}
+
+void xraudio_trace_recorder_stop(void) {
+   pthread_mutex_lock(&g_trace_mutex);
+   xraudio_atomic_int_set(&g_trace_enabled, 0);
+   xraudio_trace_writers_wait();
+   xraudio_trace_export_wait();
+   pthread_mutex_unlock(&g_trace_mutex);
+}
+
+void xraudio_trace_recorder_close(void) {
+   pthread_mutex_lock(&g_trace_mutex);
+   xraudio_atomic_int_set(&g_trace_enabled, 0);
+   xraudio_trace_writers_wait();
+
+   // A pending export is written before the thread exits
+   pthread_mutex_lock(&g_trace_export_mutex);
+   g_trace_export_exit = true;
+   pthread_cond_broadcast(&g_trace_export_cond);
+   pthread_mutex_unlock(&g_trace_export_mutex);
+   xraudio_thread_join(&g_trace_export_thread);
+   g_trace_export_exit = false;
+
+   free(g_trace_events);
+   g_trace_events    = NULL;
+   g_trace_event_qty = 0;
+   pthread_mutex_unlock(&g_trace_mutex);
+}
+
+bool xraudio_trace_recorder_export(const char *filename) {
+   pthread_mutex_lock(&g_trace_mutex);
+   xraudio_trace_export_wait();
+
+   if(g_trace_events == NULL) {
+      XLOGD_ERROR("trace was not started");
+      pthread_mutex_unlock(&g_trace_mutex);
+      return(false);
+   }
+   xraudio_trace_event_t *events = (xraudio_trace_event_t *)malloc(sizeof(xraudio_trace_event_t) * g_trace_event_qty);
+   if(events == NULL) {
+      XLOGD_ERROR("Out of memory.");
+      pthread_mutex_unlock(&g_trace_mutex);
+      return(false);
+   }
+
+   // Recording is only paused while the ring is copied, the file is written from the copy
+   bool     enabled = xraudio_atomic_int_get(&g_trace_enabled);
+   xraudio_atomic_int_set(&g_trace_enabled, 0);
+   xraudio_trace_writers_wait();
+   uint32_t pos = (uint32_t)xraudio_atomic_int_get(&g_trace_pos);
+   memcpy(events, g_trace_events, sizeof(xraudio_trace_event_t) * g_trace_event_qty);
+   xraudio_atomic_int_set(&g_trace_enabled, enabled);
+
+   bool result = xraudio_trace_write(filename, events, g_trace_event_qty, pos);
+   free(events);
+   pthread_mutex_unlock(&g_trace_mutex);
+   return(result);
+}
+
+void xraudio_trace_record(xraudio_trace_event_type_t type, uint16_t id, uint64_t timestamp_us, uint32_t duration_us) {
+   if(!xraudio_atomic_int_get(&g_trace_enabled)) {
+      return;
+   }
+   xraudio_atomic_int_add(&g_trace_writers, 1);
+
+   if(xraudio_atomic_int_get(&g_trace_enabled)) { // Recording may have been disabled before this writer was counted
+      if(g_trace_tid == 0) {
+         xraudio_trace_thread_register();
+      }
+      int pos = xraudio_atomic_int_add(&g_trace_pos, 1);
+
+      xraudio_trace_event_t *event = &g_trace_events[(uint32_t)pos & (g_trace_event_qty - 1)];
+      event->timestamp_us = timestamp_us;
+      event->duration_us  = duration_us;
+      event->tid          = g_trace_tid;
+      event->id           = id;
+      event->type         = (uint8_t)type;
+
+      // Triggered while still counted as a writer so the trace can't be closed before the export thread is signaled
+      if((type == XRAUDIO_TRACE_EVENT_OVERRUN && g_trace_trigger_overrun) || (type == XRAUDIO_TRACE_EVENT_FRAME && g_trace_trigger_frame_us > 0 && duration_us > g_trace_trigger_frame_us)) {
+         xraudio_trace_trigger();
+      }
+   }
+
+   xraudio_atomic_int_add(&g_trace_writers, -1);
+}
+
+void xraudio_trace_thread_register(void) {
+   g_trace_tid = (uint32_t)syscall(SYS_gettid);
+
+   int index;
+   do {
+      index = xraudio_atomic_int_get(&g_trace_thread_qty);
+      if(index >= XRAUDIO_TRACE_THREAD_QTY_MAX) { // The thread's events are exported without its name
+         return;
+      }
+   } while(!xraudio_atomic_compare_and_set(&g_trace_thread_qty, index, index + 1));
+
+   g_trace_threads[index].tid = g_trace_tid;
+   if(pthread_getname_np(pthread_self(), g_trace_threads[index].name, sizeof(g_trace_threads[index].name)) != 0) {
+      g_trace_threads[index].name[0] = '\0';
+   }
+}
+
+void xraudio_trace_writers_wait(void) {
+   while(xraudio_atomic_int_get(&g_trace_writers) != 0) {
+      sched_yield();
+   }
+}
+
+// Keep the events leading up to the trigger.  The ring is exported by the export thread and recording stays disabled until the trace is started again.
+void xraudio_trace_trigger(void) {
+   if(g_trace_trigger_filename[0] == '\0' || !xraudio_atomic_compare_and_set(&g_trace_enabled, 1, 0)) {
+      return;
+   }
+   pthread_mutex_lock(&g_trace_export_mutex);
+   g_trace_export_pending = true;
+   pthread_cond_broadcast(&g_trace_export_cond);
+   pthread_mutex_unlock(&g_trace_export_mutex);
+}
+
+// Called with the trace mutex held and recording disabled, so no export can be triggered while waiting
+void xraudio_trace_export_wait(void) {
+   pthread_mutex_lock(&g_trace_export_mutex);
+   while(g_trace_export_pending || g_trace_export_busy) {
+      pthread_cond_wait(&g_trace_export_cond, &g_trace_export_mutex);
+   }
+   pthread_mutex_unlock(&g_trace_export_mutex);
+}
+
+void *xraudio_trace_export_thread(void *param) {
+   pthread_mutex_lock(&g_trace_export_mutex);
+   while(1) {
+      while(!g_trace_export_pending && !g_trace_export_exit) {
+         pthread_cond_wait(&g_trace_export_cond, &g_trace_export_mutex);
+      }
+      if(!g_trace_export_pending) { // exit
+         break;
+      }
+      g_trace_export_pending = false;
+      g_trace_export_busy    = true;
+      pthread_mutex_unlock(&g_trace_export_mutex);
+
+      XLOGD_WARN("trace triggered, exporting to <%s>", g_trace_trigger_filename);
+      xraudio_trace_writers_wait();
+      xraudio_trace_write(g_trace_trigger_filename, g_trace_events, g_trace_event_qty, (uint32_t)xraudio_atomic_int_get(&g_trace_pos));
+
+      pthread_mutex_lock(&g_trace_export_mutex);
+      g_trace_export_busy = false;
+      pthread_cond_broadcast(&g_trace_export_cond);
+   }
+   pthread_mutex_unlock(&g_trace_export_mutex);
+   return(NULL);
+}
+
+bool xraudio_trace_write(const char *filename, const xraudio_trace_event_t *events, uint32_t event_qty, uint32_t pos) {
+   FILE *fh = fopen(filename, "w");
+   if(fh == NULL) {
+      int errsv = errno;
+      XLOGD_ERROR("unable to open file <%s> <%s>", filename, strerror(errsv));
+      return(false);
+   }
+   int  pid   = (int)getpid();
+   bool first = true;
+
+   fprintf(fh, "{\"traceEvents\":[\n");
+
+   int thread_qty = xraudio_atomic_int_get(&g_trace_thread_qty);
+   for(int index = 0; index < thread_qty && index < XRAUDIO_TRACE_THREAD_QTY_MAX; index++) {
+      fprintf(fh, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", pid, g_trace_threads[index].tid, g_trace_threads[index].name);
+      first = false;
+   }
+
+   // Oldest event first
+   uint32_t qty   = (pos < event_qty) ? pos : event_qty;
+   uint32_t begin = pos - qty;
+   for(uint32_t index = 0; index < qty; index++) {
+      const xraudio_trace_event_t *event = &events[(begin + index) & (event_qty - 1)];
+      const char *name     = xraudio_trace_event_name(event);
+      const char *category = xraudio_trace_event_type_str((xraudio_trace_event_type_t)event->type);
+
+      if(event->type == XRAUDIO_TRACE_EVENT_OVERRUN) {
+         fprintf(fh, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"p\",\"ts\":%llu,\"pid\":%d,\"tid\":%u}", first ? "" : ",\n", name, category, (unsigned long long)event->timestamp_us, pid, event->tid);
+      } else {
+         fprintf(fh, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%u,\"pid\":%d,\"tid\":%u,\"args\":{\"id\":%u}}", first ? "" : ",\n", name, category, (unsigned long long)event->timestamp_us, event->duration_us, pid, event->tid, event->id);
+      }
+      first = false;
+   }
+   fprintf(fh, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+   bool result = (ferror(fh) == 0);
+   if(fclose(fh) != 0) {
+      result = false;
+   }
+   if(!result) {
+      XLOGD_ERROR("unable to write file <%s>", filename);
+   } else {
+      XLOGD_INFO("exported <%u> events to <%s>", qty, filename);
+   }
+   return(result);
+}
+
+const char *xraudio_trace_event_name(const xraudio_trace_event_t *event) {
+   switch(event->type) {
+      case XRAUDIO_TRACE_EVENT_STAGE: return(xraudio_latency_stage_str((xraudio_latency_stage_t)event->id));
+      case XRAUDIO_TRACE_EVENT_MSG:   return(xraudio_main_queue_msg_type_str((xraudio_main_queue_msg_type_t)event->id));
+   }
+   return(xraudio_trace_event_type_str((xraudio_trace_event_type_t)event->type));
+}
+
+const char *xraudio_trace_event_type_str(xraudio_trace_event_type_t type) {
+   switch(type) {
+      case XRAUDIO_TRACE_EVENT_STAGE:     return("STAGE");
+      case XRAUDIO_TRACE_EVENT_FRAME:     return("FRAME");
+      case XRAUDIO_TRACE_EVENT_MSG:       return("MSG");
+      case XRAUDIO_TRACE_EVENT_HAL_WRITE: return("HAL_WRITE");
+      case XRAUDIO_TRACE_EVENT_CALLBACK:  return("CALLBACK");
+      case XRAUDIO_TRACE_EVENT_OVERRUN:   return("OVERRUN");
+      case XRAUDIO_TRACE_EVENT_INVALID:   return("INVALID");
+   }
+   return("UNKNOWN");
+}
+#endif
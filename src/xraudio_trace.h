@@ -0,0 +1,51 @@
+/*
+##########################################################################
+# If not stated otherwise in this file or this component's LICENSE
+# file the following copyright and licenses apply:
+#
+# Copyright 2019 RDK Management
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+*/
+#ifndef __XRAUDIO_TRACE_H__
+#define __XRAUDIO_TRACE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xraudio.h"
+
+typedef enum {
+   XRAUDIO_TRACE_EVENT_STAGE     = 0, // microphone pipeline stage, the id is the xraudio_latency_stage_t
+   XRAUDIO_TRACE_EVENT_FRAME     = 1, // frame timer wakeup
+   XRAUDIO_TRACE_EVENT_MSG       = 2, // main thread message, the id is the xraudio_main_queue_msg_type_t
+   XRAUDIO_TRACE_EVENT_HAL_WRITE = 3, // speaker frame written to the HAL
+   XRAUDIO_TRACE_EVENT_CALLBACK  = 4, // callback invoked by the dispatch thread
+   XRAUDIO_TRACE_EVENT_OVERRUN   = 5, // microphone frame finished after the next frame was due (no duration)
+   XRAUDIO_TRACE_EVENT_INVALID   = 6,
+} xraudio_trace_event_type_t;
+
+#ifdef XRAUDIO_TRACE_ENABLED
+// The arguments are not evaluated when the trace is compiled out
+#define XRAUDIO_TRACE(type, id, timestamp_us, duration_us) xraudio_trace_record((type), (id), (timestamp_us), (duration_us))
+
+bool xraudio_trace_recorder_start(const xraudio_trace_config_t *config);
+void xraudio_trace_recorder_stop(void);
+void xraudio_trace_recorder_close(void);
+bool xraudio_trace_recorder_export(const char *filename);
+void xraudio_trace_record(xraudio_trace_event_type_t type, uint16_t id, uint64_t timestamp_us, uint32_t duration_us);
+#else
+#define XRAUDIO_TRACE(type, id, timestamp_us, duration_us)
+#endif
+
+#endif
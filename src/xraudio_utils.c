@@ -128,6 +128,7 @@ bool xraudio_devices_input_local_is_valid(xraudio_devices_input_t devices) {
       case XRAUDIO_DEVICE_INPUT_SINGLE:
       case XRAUDIO_DEVICE_INPUT_TRI:
       case XRAUDIO_DEVICE_INPUT_QUAD:
+      case XRAUDIO_DEVICE_INPUT_ARRAY:
       case XRAUDIO_DEVICE_INPUT_HFP:
       case XRAUDIO_DEVICE_INPUT_MIC_TAP: {
          break;
@@ -164,6 +165,24 @@ bool xraudio_devices_input_is_valid(xraudio_devices_input_t devices) {
    return(xraudio_devices_input_local_is_valid(devices) && xraudio_devices_input_external_is_valid(devices));
 }
 
+uint8_t xraudio_devices_input_mic_qty(xraudio_devices_input_t devices, uint8_t array_mic_qty) {
+   switch(XRAUDIO_DEVICE_INPUT_LOCAL_GET(devices)) {
+      case XRAUDIO_DEVICE_INPUT_ARRAY: return(array_mic_qty);
+      case XRAUDIO_DEVICE_INPUT_QUAD:  return(4);
+      case XRAUDIO_DEVICE_INPUT_TRI:   return(3);
+   }
+   return(1);
+}
+
+uint8_t xraudio_devices_input_ec_ref_qty(xraudio_devices_input_t devices) {
+   switch(XRAUDIO_DEVICE_INPUT_EC_REF_GET(devices)) {
+      case XRAUDIO_DEVICE_INPUT_EC_REF_5_1:    return(6);
+      case XRAUDIO_DEVICE_INPUT_EC_REF_STEREO: return(2);
+      case XRAUDIO_DEVICE_INPUT_EC_REF_MONO:   return(1);
+   }
+   return(0);
+}
+
 bool xraudio_devices_output_is_valid(xraudio_devices_output_t devices) {
    bool ret = true;
    switch(devices) {
@@ -208,6 +227,13 @@ const char *xraudio_devices_input_str(xraudio_devices_input_t type) {
          strlcat(str, "QUAD", sizeof(str));
       }
    }
+   if(type & XRAUDIO_DEVICE_INPUT_ARRAY) {
+      if(str[0] != '\0') {
+         strlcat(str, ", ARRAY", sizeof(str));
+      } else {
+         strlcat(str, "ARRAY", sizeof(str));
+      }
+   }
    if(type & XRAUDIO_DEVICE_INPUT_HFP) {
       if(str[0] != '\0') {
          strlcat(str, ", HFP", sizeof(str));
@@ -383,6 +409,8 @@ const char *xraudio_main_queue_msg_type_str(xraudio_main_queue_msg_type_t type)
       case XRAUDIO_MAIN_QUEUE_MSG_TYPE_POWER_MODE:                      return("POWER_MODE");
       case XRAUDIO_MAIN_QUEUE_MSG_TYPE_PRIVACY_MODE:                    return("PRIVACY_MODE");
       case XRAUDIO_MAIN_QUEUE_MSG_TYPE_PRIVACY_MODE_GET:                return("PRIVACY_MODE_GET");
+      case XRAUDIO_MAIN_QUEUE_MSG_TYPE_DETECT_RELOAD:                   return("DETECT_RELOAD");
+      case XRAUDIO_MAIN_QUEUE_MSG_TYPE_DETECT_RELOAD_READY:             return("DETECT_RELOAD_READY");
       case XRAUDIO_MAIN_QUEUE_MSG_TYPE_INVALID:                         return("INVALID");
    }
    return(xraudio_invalid_return(type));
@@ -456,6 +484,107 @@ const char *xraudio_stream_latency_mode_str(xraudio_stream_latency_mode_t type)
    return(xraudio_invalid_return(type));
 }
 
+const char *xraudio_stream_framing_str(xraudio_stream_framing_t type) {
+   switch(type) {
+      case XRAUDIO_STREAM_FRAMING_NONE:    return("NONE");
+      case XRAUDIO_STREAM_FRAMING_HEADER:  return("HEADER");
+      case XRAUDIO_STREAM_FRAMING_INVALID: return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
+const char *xraudio_stream_sample_format_str(xraudio_stream_sample_format_t type) {
+   switch(type) {
+      case XRAUDIO_STREAM_SAMPLE_FORMAT_INT16:   return("INT16");
+      case XRAUDIO_STREAM_SAMPLE_FORMAT_INT32:   return("INT32");
+      case XRAUDIO_STREAM_SAMPLE_FORMAT_FLOAT32: return("FLOAT32");
+      case XRAUDIO_STREAM_SAMPLE_FORMAT_INVALID: return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
+const char *xraudio_stream_channel_layout_str(xraudio_stream_channel_layout_t type) {
+   switch(type) {
+      case XRAUDIO_STREAM_CHANNEL_LAYOUT_MONO:        return("MONO");
+      case XRAUDIO_STREAM_CHANNEL_LAYOUT_INTERLEAVED: return("INTERLEAVED");
+      case XRAUDIO_STREAM_CHANNEL_LAYOUT_PLANAR:      return("PLANAR");
+      case XRAUDIO_STREAM_CHANNEL_LAYOUT_INVALID:     return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
+const char *xraudio_callback_dispatch_str(xraudio_callback_dispatch_t type) {
+   switch(type) {
+      case XRAUDIO_CALLBACK_DISPATCH_INLINE:  return("INLINE");
+      case XRAUDIO_CALLBACK_DISPATCH_THREAD:  return("THREAD");
+      case XRAUDIO_CALLBACK_DISPATCH_INVALID: return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
+const char *xraudio_keyword_commit_reason_str(xraudio_keyword_commit_reason_t type) {
+   switch(type) {
+      case XRAUDIO_KEYWORD_COMMIT_ALL_TRIGGERED: return("ALL_TRIGGERED");
+      case XRAUDIO_KEYWORD_COMMIT_MARGIN:        return("MARGIN");
+      case XRAUDIO_KEYWORD_COMMIT_TIMEOUT:       return("TIMEOUT");
+      case XRAUDIO_KEYWORD_COMMIT_INVALID:       return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
+const char *xraudio_shed_level_str(xraudio_shed_level_t type) {
+   switch(type) {
+      case XRAUDIO_SHED_LEVEL_NONE:          return("NONE");
+      case XRAUDIO_SHED_LEVEL_METERS:        return("METERS");
+      case XRAUDIO_SHED_LEVEL_KWD_SECONDARY: return("KWD_SECONDARY");
+      case XRAUDIO_SHED_LEVEL_EOS_SINGLE:    return("EOS_SINGLE");
+      case XRAUDIO_SHED_LEVEL_PPR_BYPASS:    return("PPR_BYPASS");
+      case XRAUDIO_SHED_LEVEL_INVALID:       return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
+const char *xraudio_input_process_mode_str(xraudio_input_process_mode_t type) {
+   switch(type) {
+      case XRAUDIO_INPUT_PROCESS_MODE_FRAME:   return("FRAME");
+      case XRAUDIO_INPUT_PROCESS_MODE_IDLE:    return("IDLE");
+      case XRAUDIO_INPUT_PROCESS_MODE_INVALID: return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
+const char *xraudio_dsp_plugin_str(xraudio_dsp_plugin_t type) {
+   switch(type) {
+      case XRAUDIO_DSP_PLUGIN_EOS:     return("EOS");
+      case XRAUDIO_DSP_PLUGIN_KWD:     return("KWD");
+      case XRAUDIO_DSP_PLUGIN_DGA:     return("DGA");
+      case XRAUDIO_DSP_PLUGIN_PPR:     return("PPR");
+      case XRAUDIO_DSP_PLUGIN_INVALID: return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
+const char *xraudio_latency_stage_str(xraudio_latency_stage_t type) {
+   switch(type) {
+      case XRAUDIO_LATENCY_STAGE_HAL_READ:              return("HAL_READ");
+      case XRAUDIO_LATENCY_STAGE_UNPACK:                return("UNPACK");
+      case XRAUDIO_LATENCY_STAGE_PPR:                   return("PPR");
+      case XRAUDIO_LATENCY_STAGE_DGA:                   return("DGA");
+      case XRAUDIO_LATENCY_STAGE_KWD:                   return("KWD");
+      case XRAUDIO_LATENCY_STAGE_EOS:                   return("EOS");
+      case XRAUDIO_LATENCY_STAGE_CONVERT:               return("CONVERT");
+      case XRAUDIO_LATENCY_STAGE_WRITE_PIPE:            return("WRITE_PIPE");
+      case XRAUDIO_LATENCY_STAGE_WRITE_FILE:            return("WRITE_FILE");
+      case XRAUDIO_LATENCY_STAGE_WRITE_MEMORY:          return("WRITE_MEMORY");
+      case XRAUDIO_LATENCY_STAGE_WRITE_USER:            return("WRITE_USER");
+      case XRAUDIO_LATENCY_STAGE_CALLBACK:              return("CALLBACK");
+      case XRAUDIO_LATENCY_STAGE_CAPTURE_TO_DELIVERY:   return("CAPTURE_TO_DELIVERY");
+      case XRAUDIO_LATENCY_STAGE_KEYWORD_TO_FIRST_BYTE: return("KEYWORD_TO_FIRST_BYTE");
+      case XRAUDIO_LATENCY_STAGE_INVALID:               return("INVALID");
+   }
+   return(xraudio_invalid_return(type));
+}
+
 const char *audio_out_callback_event_str(audio_out_callback_event_t type) {
    switch(type) {
       case AUDIO_OUT_CALLBACK_EVENT_OK:          return("OK");